@@ -214,7 +214,7 @@ std::shared_ptr<Analyzer::Expr> OffsetInFragment::deep_copy() const {
 
 std::shared_ptr<Analyzer::Expr> WindowFunction::deep_copy() const {
   return makeExpr<WindowFunction>(
-      type_info, kind_, args_, partition_keys_, order_keys_, collation_);
+      type_info, kind_, args_, partition_keys_, order_keys_, collation_, frame_);
 }
 
 ExpressionPtr ArrayExpr::deep_copy() const {
@@ -2445,7 +2445,8 @@ bool WindowFunction::operator==(const Expr& rhs) const {
   }
   if (kind_ != rhs_window->kind_ || args_.size() != rhs_window->args_.size() ||
       partition_keys_.size() != rhs_window->partition_keys_.size() ||
-      order_keys_.size() != rhs_window->order_keys_.size()) {
+      order_keys_.size() != rhs_window->order_keys_.size() ||
+      frame_ != rhs_window->frame_) {
     return false;
   }
   return expr_list_match(args_, rhs_window->args_) &&
@@ -2857,11 +2858,28 @@ std::string OffsetInFragment::toString() const {
   return "(OffsetInFragment) ";
 }
 
+std::string WindowFrame::toString() const {
+  const auto bound_to_string = [](const std::optional<int64_t>& bound) {
+    if (!bound) {
+      return std::string("UNBOUNDED");
+    }
+    if (*bound == 0) {
+      return std::string("CURRENT ROW");
+    }
+    return std::to_string(std::abs(*bound)) + (*bound < 0 ? " PRECEDING" : " FOLLOWING");
+  };
+  return std::string(is_rows ? "ROWS" : "RANGE") + " BETWEEN " + bound_to_string(lower) +
+         " AND " + bound_to_string(upper);
+}
+
 std::string WindowFunction::toString() const {
   std::string result = "WindowFunction(" + ::toString(kind_);
   for (const auto& arg : args_) {
     result += " " + arg->toString();
   }
+  if (frame_) {
+    result += " " + frame_->toString();
+  }
   return result + ") ";
 }
 
@@ -1580,6 +1580,26 @@ struct OrderEntry {
   bool nulls_first; /* true if nulls are ordered first.  otherwise last. */
 };
 
+/*
+ * @type WindowFrame
+ * @brief An explicit ROWS or RANGE frame of an aggregate window function. The bounds
+ * are offsets from the current row, negative for PRECEDING and positive for FOLLOWING,
+ * none for UNBOUNDED. RANGE offsets are in units of the single order key.
+ */
+struct WindowFrame {
+  bool is_rows;
+  std::optional<int64_t> lower;
+  std::optional<int64_t> upper;
+
+  bool operator==(const WindowFrame& rhs) const {
+    return is_rows == rhs.is_rows && lower == rhs.lower && upper == rhs.upper;
+  }
+
+  bool operator!=(const WindowFrame& rhs) const { return !(*this == rhs); }
+
+  std::string toString() const;
+};
+
 /*
  * @type WindowFunction
  * @brief A window function.
@@ -1591,13 +1611,15 @@ class WindowFunction : public Expr {
                  const std::vector<std::shared_ptr<Analyzer::Expr>>& args,
                  const std::vector<std::shared_ptr<Analyzer::Expr>>& partition_keys,
                  const std::vector<std::shared_ptr<Analyzer::Expr>>& order_keys,
-                 const std::vector<OrderEntry>& collation)
+                 const std::vector<OrderEntry>& collation,
+                 const std::optional<WindowFrame>& frame = std::nullopt)
       : Expr(ti)
       , kind_(kind)
       , args_(args)
       , partition_keys_(partition_keys)
       , order_keys_(order_keys)
-      , collation_(collation){};
+      , collation_(collation)
+      , frame_(frame){};
 
   std::shared_ptr<Analyzer::Expr> deep_copy() const override;
 
@@ -1618,12 +1640,17 @@ class WindowFunction : public Expr {
 
   const std::vector<OrderEntry>& getCollation() const { return collation_; }
 
+  // The explicit frame, none for the default one: the whole partition without order
+  // keys, up to the last peer of the current row otherwise.
+  const std::optional<WindowFrame>& getFrame() const { return frame_; }
+
  private:
   const SqlWindowFunctionKind kind_;
   const std::vector<std::shared_ptr<Analyzer::Expr>> args_;
   const std::vector<std::shared_ptr<Analyzer::Expr>> partition_keys_;
   const std::vector<std::shared_ptr<Analyzer::Expr>> order_keys_;
   const std::vector<OrderEntry> collation_;
+  const std::optional<WindowFrame> frame_;
 };
 
 /*
@@ -289,6 +289,16 @@ void Catalog::updateTableDescriptorSchema() {
       string queryString("ALTER TABLE mapd_tables ADD is_system_table BOOLEAN DEFAULT 0");
       sqliteConnector_.query(queryString);
     }
+    if (std::find(cols.begin(), cols.end(), std::string("bloom_filter_columns")) ==
+        cols.end()) {
+      sqliteConnector_.query(
+          "ALTER TABLE mapd_tables ADD bloom_filter_columns TEXT DEFAULT ''");
+    }
+    if (std::find(cols.begin(), cols.end(), std::string("page_compression")) ==
+        cols.end()) {
+      sqliteConnector_.query(
+          "ALTER TABLE mapd_tables ADD page_compression TEXT DEFAULT ''");
+    }
   } catch (std::exception& e) {
     sqliteConnector_.query("ROLLBACK TRANSACTION");
     throw;
@@ -946,6 +956,25 @@ std::string getUserFromId(const int32_t id) {
   // a user could be deleted and a dashboard still exist?
   return "Unknown";
 }
+
+// the Bloom filter columns of a table are stored as a comma separated list of ids
+std::string serialize_column_ids(const std::vector<int>& column_ids) {
+  std::string serialized_ids;
+  for (const auto column_id : column_ids) {
+    serialized_ids += (serialized_ids.empty() ? "" : ",") + std::to_string(column_id);
+  }
+  return serialized_ids;
+}
+
+std::vector<int> deserialize_column_ids(const std::string& serialized_ids) {
+  std::vector<int> column_ids;
+  std::istringstream ids_stream(serialized_ids);
+  std::string column_id;
+  while (std::getline(ids_stream, column_id, ',')) {
+    column_ids.push_back(std::stoi(column_id));
+  }
+  return column_ids;
+}
 }  // namespace
 
 void Catalog::buildMaps() {
@@ -974,7 +1003,8 @@ void Catalog::buildMaps() {
       "SELECT tableid, name, ncolumns, isview, fragments, frag_type, max_frag_rows, "
       "max_chunk_size, frag_page_size, "
       "max_rows, partitions, shard_column_id, shard, num_shards, key_metainfo, userid, "
-      "sort_column_id, storage_type, max_rollback_epochs, is_system_table "
+      "sort_column_id, storage_type, max_rollback_epochs, is_system_table, "
+      "bloom_filter_columns, page_compression "
       "from mapd_tables");
   sqliteConnector_.query(tableQuery);
   numRows = sqliteConnector_.getNumRows();
@@ -1021,6 +1051,10 @@ void Catalog::buildMaps() {
     }
     td->maxRollbackEpochs = sqliteConnector_.getData<int>(r, 18);
     td->is_system_table = sqliteConnector_.getData<bool>(r, 19);
+    td->bloomFilterColumnIds = deserialize_column_ids(
+        sqliteConnector_.isNull(r, 20) ? "" : sqliteConnector_.getData<string>(r, 20));
+    td->pageCompression =
+        sqliteConnector_.isNull(r, 21) ? "" : sqliteConnector_.getData<string>(r, 21);
     td->hasDeletedCol = false;
 
     tableDescriptorMap_[to_upper(td->tableName)] = td;
@@ -1443,32 +1477,37 @@ void Catalog::instantiateFragmenter(TableDescriptor* td) const {
     getAllColumnMetadataForTableImpl(td, columnDescs, true, false, true);
     Chunk::translateColumnDescriptorsToChunkVec(columnDescs, chunkVec);
     ChunkKey chunkKeyPrefix = {currentDB_.dbId, td->tableId};
+    std::shared_ptr<InsertOrderFragmenter> fragmenter;
     if (td->sortedColumnId > 0) {
-      td->fragmenter = std::make_shared<SortedOrderFragmenter>(chunkKeyPrefix,
-                                                               chunkVec,
-                                                               dataMgr_.get(),
-                                                               const_cast<Catalog*>(this),
-                                                               td->tableId,
-                                                               td->shard,
-                                                               td->maxFragRows,
-                                                               td->maxChunkSize,
-                                                               td->fragPageSize,
-                                                               td->maxRows,
-                                                               td->persistenceLevel);
+      fragmenter = std::make_shared<SortedOrderFragmenter>(chunkKeyPrefix,
+                                                           chunkVec,
+                                                           dataMgr_.get(),
+                                                           const_cast<Catalog*>(this),
+                                                           td->tableId,
+                                                           td->shard,
+                                                           td->maxFragRows,
+                                                           td->maxChunkSize,
+                                                           td->fragPageSize,
+                                                           td->maxRows,
+                                                           td->persistenceLevel);
     } else {
-      td->fragmenter = std::make_shared<InsertOrderFragmenter>(chunkKeyPrefix,
-                                                               chunkVec,
-                                                               dataMgr_.get(),
-                                                               const_cast<Catalog*>(this),
-                                                               td->tableId,
-                                                               td->shard,
-                                                               td->maxFragRows,
-                                                               td->maxChunkSize,
-                                                               td->fragPageSize,
-                                                               td->maxRows,
-                                                               td->persistenceLevel,
-                                                               !td->storageType.empty());
-    }
+      fragmenter = std::make_shared<InsertOrderFragmenter>(chunkKeyPrefix,
+                                                           chunkVec,
+                                                           dataMgr_.get(),
+                                                           const_cast<Catalog*>(this),
+                                                           td->tableId,
+                                                           td->shard,
+                                                           td->maxFragRows,
+                                                           td->maxChunkSize,
+                                                           td->fragPageSize,
+                                                           td->maxRows,
+                                                           td->persistenceLevel,
+                                                           !td->storageType.empty());
+    }
+    fragmenter->setBloomFilterColumns(td->bloomFilterColumnIds);
+    fragmenter->setPageCompression(
+        File_Namespace::parse_page_compression(td->pageCompression));
+    td->fragmenter = fragmenter;
   });
   LOG(INFO) << "Instantiating Fragmenter for table " << td->tableName << " took "
             << time_ms << "ms";
@@ -2322,7 +2361,7 @@ void Catalog::createTable(
   if (td.persistenceLevel == Data_Namespace::MemoryLevel::DISK_LEVEL) {
     try {
       sqliteConnector_.query_with_text_params(
-          R"(INSERT INTO mapd_tables (name, userid, ncolumns, isview, fragments, frag_type, max_frag_rows, max_chunk_size, frag_page_size, max_rows, partitions, shard_column_id, shard, num_shards, sort_column_id, storage_type, max_rollback_epochs, is_system_table, key_metainfo) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?))",
+          R"(INSERT INTO mapd_tables (name, userid, ncolumns, isview, fragments, frag_type, max_frag_rows, max_chunk_size, frag_page_size, max_rows, partitions, shard_column_id, shard, num_shards, sort_column_id, storage_type, max_rollback_epochs, is_system_table, key_metainfo, bloom_filter_columns, page_compression) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?, ?))",
           std::vector<std::string>{td.tableName,
                                    std::to_string(td.userId),
                                    std::to_string(td.nColumns),
@@ -2341,7 +2380,9 @@ void Catalog::createTable(
                                    td.storageType,
                                    std::to_string(td.maxRollbackEpochs),
                                    std::to_string(td.is_system_table),
-                                   td.keyMetainfo});
+                                   td.keyMetainfo,
+                                   serialize_column_ids(td.bloomFilterColumnIds),
+                                   td.pageCompression});
 
       // now get the auto generated tableid
       sqliteConnector_.query_with_text_param(
@@ -4501,6 +4542,17 @@ std::vector<std::string> Catalog::getTableDictDirectories(
 // returns table schema in a string
 // NOTE(sy): Might be able to replace dumpSchema() later with
 //           dumpCreateTable() after a deeper review of the TableArchiver code.
+std::string Catalog::getBloomFilterColumnNames(const TableDescriptor* td) const {
+  std::vector<std::string> column_names;
+  for (const auto column_id : td->bloomFilterColumnIds) {
+    // dropped columns keep their id in the list
+    if (const auto cd = getMetadataForColumn(td->tableId, column_id)) {
+      column_names.push_back(cd->columnName);
+    }
+  }
+  return boost::algorithm::join(column_names, ",");
+}
+
 std::string Catalog::dumpSchema(const TableDescriptor* td) const {
   CHECK(!td->is_system_table);
   cat_read_lock read_lock(this);
@@ -4597,6 +4649,13 @@ std::string Catalog::dumpSchema(const TableDescriptor* td) const {
     CHECK(sort_cd);
     with_options.push_back("SORT_COLUMN='" + sort_cd->columnName + "'");
   }
+  if (const auto bloom_filter_columns = getBloomFilterColumnNames(td);
+      !bloom_filter_columns.empty()) {
+    with_options.push_back("BLOOM_FILTER_COLUMNS='" + bloom_filter_columns + "'");
+  }
+  if (!td->pageCompression.empty()) {
+    with_options.push_back("PAGE_COMPRESSION='" + td->pageCompression + "'");
+  }
   if (td->maxRollbackEpochs != DEFAULT_MAX_ROLLBACK_EPOCHS &&
       td->maxRollbackEpochs != -1) {
     with_options.push_back("MAX_ROLLBACK_EPOCHS=" +
@@ -4777,6 +4836,13 @@ std::string Catalog::dumpCreateTable(const TableDescriptor* td,
     CHECK(sort_cd);
     with_options.push_back("SORT_COLUMN='" + sort_cd->columnName + "'");
   }
+  if (const auto bloom_filter_columns = getBloomFilterColumnNames(td);
+      !foreign_table && !bloom_filter_columns.empty()) {
+    with_options.push_back("BLOOM_FILTER_COLUMNS='" + bloom_filter_columns + "'");
+  }
+  if (!foreign_table && !td->pageCompression.empty()) {
+    with_options.push_back("PAGE_COMPRESSION='" + td->pageCompression + "'");
+  }
 
   if (!with_options.empty()) {
     if (!multiline_formatting) {
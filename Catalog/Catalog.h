@@ -309,6 +309,8 @@ class Catalog final {
   std::vector<std::string> getTableDataDirectories(const TableDescriptor* td) const;
   std::vector<std::string> getTableDictDirectories(const TableDescriptor* td) const;
   std::string getColumnDictDirectory(const ColumnDescriptor* cd) const;
+  // comma separated names of the columns with Bloom filter indexes
+  std::string getBloomFilterColumnNames(const TableDescriptor* td) const;
   std::string dumpSchema(const TableDescriptor* td) const;
   std::string dumpCreateTable(const TableDescriptor* td,
                               bool multiline_formatting = true,
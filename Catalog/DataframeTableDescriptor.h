@@ -56,6 +56,8 @@ struct DataframeTableDescriptor : TableDescriptor {
     nShards = td.nShards;
     shardedColumnId = td.shardedColumnId;
     sortedColumnId = td.sortedColumnId;
+    bloomFilterColumnIds = td.bloomFilterColumnIds;
+    pageCompression = td.pageCompression;
     persistenceLevel = td.persistenceLevel;
     hasDeletedCol = td.hasDeletedCol;
     columnIdBySpi_ = td.columnIdBySpi_;
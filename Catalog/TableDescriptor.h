@@ -19,6 +19,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 #include "DataMgr/MemoryLevel.h"
 #include "Fragmenter/AbstractFragmenter.h"
@@ -66,6 +67,8 @@ struct TableDescriptor {
       nShards;  // # of shards, i.e. physical tables for this logical table (default: 0)
   int shardedColumnId;  // Id of the column to be sharded on
   int sortedColumnId;   // Id of the column to be sorted on
+  std::vector<int> bloomFilterColumnIds;  // Ids of the columns with Bloom filter indexes
+  std::string pageCompression;            // Codec of the pages of new chunks, or empty
   Data_Namespace::MemoryLevel persistenceLevel;
   bool hasDeletedCol;  // Does table has a delete col, Yes (VACUUM = DELAYED)
                        //                              No  (VACUUM = IMMEDIATE)
@@ -86,6 +86,10 @@ class AbstractBuffer {
   virtual size_t reservedSize() const = 0;
   virtual MemoryLevel getType() const = 0;
 
+  // Serves the `num_bytes` at `mem`, which a lower memory level owns, instead of copying
+  // them into the buffer. Returns false if the buffer does not support it.
+  virtual bool mapMemory(int8_t* mem, const size_t num_bytes) { return false; }
+
   // Next three methods are dummy methods so FileBuffer does not implement these
   virtual inline int pin() { return 0; }
   virtual inline int unPin() { return 0; }
@@ -0,0 +1,196 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/BloomFilter.h"
+
+#include "Logger/Logger.h"
+
+#include <algorithm>
+#include <cmath>
+
+size_t g_bloom_filter_bits_per_value{10};
+
+namespace {
+
+constexpr size_t kMaxBitsPerValue{64};
+
+uint64_t mix(uint64_t x) {
+  x ^= x >> 33;
+  x *= 0xff51afd7ed558ccdULL;
+  x ^= x >> 33;
+  x *= 0xc4ceb9fe1a85ec53ULL;
+  x ^= x >> 33;
+  return x;
+}
+
+// optimal number of hash functions for the given number of bits per value
+size_t get_num_hashes(const size_t bits_per_value) {
+  return std::max(size_t(1),
+                  std::min(size_t(16),
+                           static_cast<size_t>(std::lround(bits_per_value * M_LN2))));
+}
+
+template <typename T>
+void write_value(std::ostream& os, const T& val) {
+  os.write(reinterpret_cast<const char*>(&val), sizeof(T));
+}
+
+template <typename T>
+bool read_value(std::istream& is, T& val) {
+  is.read(reinterpret_cast<char*>(&val), sizeof(T));
+  return static_cast<bool>(is);
+}
+
+}  // namespace
+
+BloomFilter::Stage::Stage(const size_t capacity, const size_t bits_per_value)
+    : capacity(capacity)
+    , num_words((capacity * bits_per_value + 63) / 64)
+    , words(new std::atomic<uint64_t>[num_words]) {
+  for (size_t i = 0; i < num_words; ++i) {
+    words[i].store(0, std::memory_order_relaxed);
+  }
+}
+
+BloomFilter::BloomFilter()
+    : BloomFilter(std::clamp(g_bloom_filter_bits_per_value, size_t(1), kMaxBitsPerValue),
+                  get_num_hashes(std::clamp(
+                      g_bloom_filter_bits_per_value, size_t(1), kMaxBitsPerValue))) {
+  addStage(kFirstStageCapacity);
+}
+
+BloomFilter::BloomFilter(const size_t bits_per_value, const size_t num_hashes)
+    : bits_per_value_(bits_per_value), num_hashes_(num_hashes) {}
+
+void BloomFilter::addStage(const size_t capacity) {
+  const auto num_stages = num_stages_.load(std::memory_order_relaxed);
+  CHECK_LT(num_stages, kMaxStages);
+  stages_[num_stages] = std::make_unique<Stage>(capacity, bits_per_value_);
+  // publishes the new stage to the concurrent lookups
+  num_stages_.store(num_stages + 1, std::memory_order_release);
+}
+
+void BloomFilter::add(const int64_t val) {
+  auto stage = stages_[num_stages_.load(std::memory_order_relaxed) - 1].get();
+  if (stage->num_values >= stage->capacity) {
+    addStage(2 * stage->capacity);
+    stage = stages_[num_stages_.load(std::memory_order_relaxed) - 1].get();
+  }
+  const auto num_bits = stage->num_words * 64;
+  const auto hash = mix(static_cast<uint64_t>(val));
+  const auto delta = (hash >> 32 | hash << 32) | 1;
+  auto bit = hash;
+  for (size_t i = 0; i < num_hashes_; ++i, bit += delta) {
+    const auto bit_idx = bit % num_bits;
+    stage->words[bit_idx / 64].fetch_or(uint64_t(1) << (bit_idx % 64),
+                                        std::memory_order_relaxed);
+  }
+  ++stage->num_values;
+  num_values_.fetch_add(1, std::memory_order_relaxed);
+}
+
+bool BloomFilter::mayContain(const int64_t val) const {
+  const auto hash = mix(static_cast<uint64_t>(val));
+  const auto delta = (hash >> 32 | hash << 32) | 1;
+  const auto num_stages = num_stages_.load(std::memory_order_acquire);
+  for (size_t stage_idx = 0; stage_idx < num_stages; ++stage_idx) {
+    const auto stage = stages_[stage_idx].get();
+    const auto num_bits = stage->num_words * 64;
+    bool found = true;
+    auto bit = hash;
+    for (size_t i = 0; i < num_hashes_ && found; ++i, bit += delta) {
+      const auto bit_idx = bit % num_bits;
+      found = stage->words[bit_idx / 64].load(std::memory_order_relaxed) &
+              (uint64_t(1) << (bit_idx % 64));
+    }
+    if (found) {
+      return true;
+    }
+  }
+  return false;
+}
+
+size_t BloomFilter::getSizeBytes() const {
+  size_t size_bytes{0};
+  const auto num_stages = num_stages_.load(std::memory_order_acquire);
+  for (size_t stage_idx = 0; stage_idx < num_stages; ++stage_idx) {
+    size_bytes += stages_[stage_idx]->num_words * sizeof(uint64_t);
+  }
+  return size_bytes;
+}
+
+uint64_t BloomFilter::getChecksum() const {
+  uint64_t checksum = mix(num_values_ ^ (bits_per_value_ << 32));
+  const auto num_stages = num_stages_.load(std::memory_order_acquire);
+  for (size_t stage_idx = 0; stage_idx < num_stages; ++stage_idx) {
+    const auto stage = stages_[stage_idx].get();
+    for (size_t i = 0; i < stage->num_words; ++i) {
+      checksum = mix(checksum ^ stage->words[i].load(std::memory_order_relaxed));
+    }
+  }
+  return checksum;
+}
+
+void BloomFilter::write(std::ostream& os) const {
+  const auto num_stages = num_stages_.load(std::memory_order_acquire);
+  write_value(os, bits_per_value_);
+  write_value(os, num_hashes_);
+  write_value(os, num_stages);
+  for (size_t stage_idx = 0; stage_idx < num_stages; ++stage_idx) {
+    const auto stage = stages_[stage_idx].get();
+    write_value(os, stage->capacity);
+    write_value(os, stage->num_values);
+    for (size_t i = 0; i < stage->num_words; ++i) {
+      write_value(os, stage->words[i].load(std::memory_order_relaxed));
+    }
+  }
+}
+
+std::shared_ptr<BloomFilter> BloomFilter::read(std::istream& is) {
+  size_t bits_per_value{0};
+  size_t num_hashes{0};
+  size_t num_stages{0};
+  if (!read_value(is, bits_per_value) || !read_value(is, num_hashes) ||
+      !read_value(is, num_stages) || bits_per_value == 0 ||
+      bits_per_value > kMaxBitsPerValue || num_hashes == 0 || num_stages == 0 ||
+      num_stages > kMaxStages) {
+    return nullptr;
+  }
+  // the constructor is private, can't use make_shared
+  std::shared_ptr<BloomFilter> bloom_filter(new BloomFilter(bits_per_value, num_hashes));
+  size_t expected_capacity = kFirstStageCapacity;
+  for (size_t stage_idx = 0; stage_idx < num_stages; ++stage_idx) {
+    size_t capacity{0};
+    size_t num_values{0};
+    if (!read_value(is, capacity) || !read_value(is, num_values) ||
+        capacity != expected_capacity || num_values > capacity) {
+      return nullptr;
+    }
+    bloom_filter->addStage(capacity);
+    auto stage = bloom_filter->stages_[stage_idx].get();
+    for (size_t i = 0; i < stage->num_words; ++i) {
+      uint64_t word{0};
+      if (!read_value(is, word)) {
+        return nullptr;
+      }
+      stage->words[i].store(word, std::memory_order_relaxed);
+    }
+    stage->num_values = num_values;
+    bloom_filter->num_values_ += num_values;
+    expected_capacity *= 2;
+  }
+  return bloom_filter;
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    BloomFilter.h
+ * @brief   Bloom filter of the values of a chunk.
+ *
+ * Min / max stats can't skip fragments for equality predicates on high cardinality
+ * columns, whose values are spread across all the fragments. The Bloom filter of a
+ * chunk answers whether a value may be in the chunk, with a false positive rate set by
+ * g_bloom_filter_bits_per_value.
+ *
+ * The filter grows with the chunk: it is made of stages of doubling capacity, values are
+ * added to the last stage and looked up in all of them, so that small chunks only pay for
+ * the values they hold. Bits are only ever set, atomically, so queries can look up values
+ * while rows are being appended to the chunk.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+
+extern size_t g_bloom_filter_bits_per_value;
+
+class BloomFilter {
+ public:
+  BloomFilter();
+
+  // Not thread safe with respect to other calls to add, safe with respect to lookups.
+  void add(const int64_t val);
+
+  bool mayContain(const int64_t val) const;
+
+  size_t getNumValues() const { return num_values_; }
+
+  size_t getSizeBytes() const;
+
+  // Digest of the contents of the filter, to validate a persisted filter against the
+  // chunk metadata.
+  uint64_t getChecksum() const;
+
+  void write(std::ostream& os) const;
+
+  // returns nullptr if the stream does not hold a valid filter
+  static std::shared_ptr<BloomFilter> read(std::istream& is);
+
+ private:
+  struct Stage {
+    Stage(const size_t capacity, const size_t bits_per_value);
+
+    const size_t capacity;  // number of values
+    const size_t num_words;
+    std::unique_ptr<std::atomic<uint64_t>[]> words;
+    size_t num_values{0};
+  };
+
+  BloomFilter(const size_t bits_per_value, const size_t num_hashes);
+
+  void addStage(const size_t capacity);
+
+  static constexpr size_t kMaxStages{40};
+  static constexpr size_t kFirstStageCapacity{1024};
+
+  const size_t bits_per_value_;
+  const size_t num_hashes_;
+  std::array<std::unique_ptr<Stage>, kMaxStages> stages_;
+  std::atomic<size_t> num_stages_{0};
+  std::atomic<size_t> num_values_{0};
+};
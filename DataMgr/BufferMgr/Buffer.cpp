@@ -64,6 +64,16 @@ void Buffer::reserve(const size_t num_bytes) {
   }
 }
 
+void Buffer::releasePages() {
+  CHECK_EQ(size_, size_t(0));
+  if (num_pages_ > 0) {
+    seg_it_ = bm_->releasePages(seg_it_);
+  }
+  mem_ = nullptr;
+  num_pages_ = 0;
+  page_dirty_flags_.clear();
+}
+
 void Buffer::read(int8_t* const dst,
                   const size_t num_bytes,
                   const size_t offset,
@@ -21,6 +21,7 @@
  */
 #pragma once
 
+#include <atomic>
 #include <iostream>
 #include <mutex>
 
@@ -123,24 +124,18 @@ class Buffer : public AbstractBuffer {
   /// Returns the size in bytes of each page in the buffer.
   inline size_t pageSize() const override { return page_size_; }
 
-  inline int pin() override {
-    std::lock_guard<std::mutex> pin_lock(pin_mutex_);
-    return (++pin_count_);
-  }
+  inline int pin() override { return (++pin_count_); }
 
-  inline int unPin() override {
-    std::lock_guard<std::mutex> pin_lock(pin_mutex_);
-    return (--pin_count_);
-  }
-  inline int getPinCount() override {
-    std::lock_guard<std::mutex> pin_lock(pin_mutex_);
-    return (pin_count_);
-  }
+  inline int unPin() override { return (--pin_count_); }
+  inline int getPinCount() override { return (pin_count_); }
 
   // Added for testing.
   int32_t getSlabNum() const { return seg_it_->slab_num; }
 
  protected:
+  /// Returns the pages of the empty buffer to the buffer pool.
+  void releasePages();
+
   int8_t* mem_;  /// pointer to beginning of buffer's memory
 
  private:
@@ -163,8 +158,7 @@ class Buffer : public AbstractBuffer {
   size_t num_pages_;
   int epoch_;  /// indicates when the buffer was last flushed
   std::vector<bool> page_dirty_flags_;
-  int pin_count_;
-  std::mutex pin_mutex_;
+  std::atomic<int> pin_count_;
 };
 
 }  // namespace Buffer_Namespace
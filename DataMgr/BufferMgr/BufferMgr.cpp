@@ -44,6 +44,90 @@ std::string BufferMgr::keyToString(const ChunkKey& key) {
   return oss.str();
 }
 
+BufferMgr::ChunkIndexShard& BufferMgr::getChunkIndexShard(const ChunkKey& key) {
+  CHECK(!key.empty());
+  // shard by database and table
+  size_t hash = static_cast<uint32_t>(key[0]);
+  if (key.size() > 1) {
+    hash = hash * 31 + static_cast<uint32_t>(key[1]);
+  }
+  return chunk_index_[hash % kNumChunkIndexShards];
+}
+
+std::vector<std::unique_lock<std::shared_mutex>> BufferMgr::lockChunkIndex() {
+  std::vector<std::unique_lock<std::shared_mutex>> locks;
+  locks.reserve(kNumChunkIndexShards);
+  for (auto& shard : chunk_index_) {
+    locks.emplace_back(shard.mutex);
+  }
+  return locks;
+}
+
+template <typename FUNC>
+void BufferMgr::forEachChunkIndexShard(const ChunkKey& key_prefix, FUNC func) {
+  if (key_prefix.size() > 1) {
+    auto& shard = getChunkIndexShard(key_prefix);
+    std::lock_guard<std::shared_mutex> chunk_index_lock(shard.mutex);
+    func(shard);
+    return;
+  }
+  for (auto& shard : chunk_index_) {
+    std::lock_guard<std::shared_mutex> chunk_index_lock(shard.mutex);
+    func(shard);
+  }
+}
+
+AbstractBuffer* BufferMgr::pinFetchedBuffer(const ChunkKey& key, const size_t num_bytes) {
+  auto& shard = getChunkIndexShard(key);
+  std::shared_lock<std::shared_mutex> chunk_index_lock(shard.mutex);
+  auto buffer_it = shard.index.find(key);
+  if (buffer_it == shard.index.end() || !buffer_it->second->fetched) {
+    return nullptr;
+  }
+  auto buffer = buffer_it->second->buffer;
+  CHECK(buffer);
+  // evictions hold the shard exclusively, so the buffer cannot be evicted before the pin
+  buffer->pin();
+  if (buffer->size() < num_bytes) {
+    buffer->unPin();
+    return nullptr;
+  }
+  // concurrent lookups of the chunk may store their epochs in any order, either one is
+  // recent enough for the eviction scoring
+  buffer_it->second->last_touched = buffer_epoch_++;
+  chunk_index_lock.unlock();
+  if (eviction_algorithm_) {
+    // the buffer is pinned, so it cannot be evicted before it is touched
+    eviction_algorithm_->touchChunk(key);
+  }
+  return buffer;
+}
+
+void BufferMgr::markFetched(const ChunkKey& key) {
+  auto& shard = getChunkIndexShard(key);
+  std::lock_guard<std::shared_mutex> chunk_index_lock(shard.mutex);
+  auto buffer_it = shard.index.find(key);
+  if (buffer_it == shard.index.end()) {
+    return;
+  }
+  const bool first_fetch = !buffer_it->second->fetched;
+  buffer_it->second->fetched = true;
+  if (eviction_algorithm_) {
+    eviction_algorithm_->touchChunk(key);
+    if (first_fetch && refetch_cost_) {
+      eviction_algorithm_->setRefetchCost(key,
+                                          refetch_cost_(key, buffer_it->second->buffer));
+    }
+  }
+}
+
+void BufferMgr::setEvictionAlgorithm(
+    std::unique_ptr<RankedCacheEvictionAlgorithm> algorithm,
+    RefetchCostFunc refetch_cost) {
+  eviction_algorithm_ = std::move(algorithm);
+  refetch_cost_ = std::move(refetch_cost);
+}
+
 /// Allocates memSize bytes for the buffer pool and initializes the free memory map.
 BufferMgr::BufferMgr(const int device_id,
                      const size_t max_buffer_pool_size,
@@ -93,14 +177,18 @@ void BufferMgr::reinit() {
 
 void BufferMgr::clear() {
   std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
-  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
+  auto chunk_index_locks = lockChunkIndex();
   std::lock_guard<std::mutex> unsized_segs_lock(unsized_segs_mutex_);
 
-  for (auto& buf : chunk_index_) {
-    delete buf.second->buffer;
+  for (auto& shard : chunk_index_) {
+    for (auto& buf : shard.index) {
+      delete buf.second->buffer;
+      if (eviction_algorithm_) {
+        eviction_algorithm_->removeChunk(buf.first);
+      }
+    }
+    shard.index.clear();
   }
-
-  chunk_index_.clear();
   slabs_.clear();
   slab_segments_.clear();
   unsized_segs_.clear();
@@ -118,36 +206,41 @@ AbstractBuffer* BufferMgr::createBuffer(const ChunkKey& chunk_key,
   }
 
   // chunk_page_size is just for recording dirty pages
+  auto& shard = getChunkIndexShard(chunk_key);
+  BufferList::iterator seg_it;
   {
-    std::lock_guard<std::mutex> lock(chunk_index_mutex_);
-    CHECK(chunk_index_.find(chunk_key) == chunk_index_.end());
+    std::lock_guard<std::shared_mutex> chunk_index_lock(shard.mutex);
+    CHECK(shard.index.find(chunk_key) == shard.index.end());
     BufferSeg buffer_seg(BufferSeg(-1, 0, USED));
     buffer_seg.chunk_key = chunk_key;
     std::lock_guard<std::mutex> unsizedSegsLock(unsized_segs_mutex_);
     unsized_segs_.push_back(buffer_seg);  // race condition?
-    chunk_index_[chunk_key] =
-        std::prev(unsized_segs_.end(),
-                  1);  // need to do this before allocating Buffer because doing so could
-                       // change the segment used
+    seg_it = std::prev(unsized_segs_.end(), 1);
+    shard.index[chunk_key] = seg_it;  // need to do this before allocating Buffer because
+                                      // doing so could change the segment used
   }
   // following should be safe outside the lock b/c first thing Buffer
   // constructor does is pin (and its still in unsized segs at this point
   // so can't be evicted)
   try {
-    allocateBuffer(chunk_index_[chunk_key], actual_chunk_page_size, initial_size);
+    allocateBuffer(seg_it, actual_chunk_page_size, initial_size);
   } catch (const OutOfMemory&) {
-    auto buffer_it = chunk_index_.find(chunk_key);
-    CHECK(buffer_it != chunk_index_.end());
-    buffer_it->second->buffer =
-        nullptr;  // constructor failed for the buffer object so make sure to mark it null
-                  // so deleteBuffer doesn't try to delete it
+    {
+      std::lock_guard<std::shared_mutex> chunk_index_lock(shard.mutex);
+      auto buffer_it = shard.index.find(chunk_key);
+      CHECK(buffer_it != shard.index.end());
+      buffer_it->second->buffer = nullptr;  // constructor failed for the buffer object so
+                                            // make sure to mark it null so deleteBuffer
+                                            // doesn't try to delete it
+    }
     deleteBuffer(chunk_key);
     throw;
   }
-  CHECK(initial_size == 0 || chunk_index_[chunk_key]->buffer->getMemoryPtr());
-  // chunk_index_[chunk_key]->buffer->pin();
-  std::lock_guard<std::mutex> lock(chunk_index_mutex_);
-  return chunk_index_[chunk_key]->buffer;
+  std::lock_guard<std::shared_mutex> chunk_index_lock(shard.mutex);
+  auto buffer_it = shard.index.find(chunk_key);
+  CHECK(buffer_it != shard.index.end());
+  CHECK(initial_size == 0 || buffer_it->second->buffer->getMemoryPtr());
+  return buffer_it->second->buffer;
 }
 
 BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
@@ -156,6 +249,7 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
   // We can assume here that buffer for evictStart either doesn't exist
   // (evictStart is first buffer) or was not free, so don't need ot merge
   // it
+  // The caller holds the locks of all the shards of the chunk index.
   auto evict_it = evict_start;
   size_t num_pages = 0;
   size_t start_page = evict_start->start_page;
@@ -165,7 +259,10 @@ BufferList::iterator BufferMgr::evict(BufferList::iterator& evict_start,
     }
     num_pages += evict_it->num_pages;
     if (evict_it->mem_status == USED && evict_it->chunk_key.size() > 0) {
-      chunk_index_.erase(evict_it->chunk_key);
+      getChunkIndexShard(evict_it->chunk_key).index.erase(evict_it->chunk_key);
+      if (eviction_algorithm_) {
+        eviction_algorithm_->removeChunk(evict_it->chunk_key);
+      }
     }
     if (evict_it->buffer != nullptr) {
       // If we don't delete buffers here then we lose reference to them later and cause a
@@ -241,13 +338,40 @@ BufferList::iterator BufferMgr::reserveBuffer(
                                   new_seg_it->buffer->getType(),
                                   device_id_);
   }
+  new_seg_it->fetched = seg_it->fetched;
+  // the index is pointed at the new segment before the old one is freed, as the lookups
+  // of pinFetchedBuffer do not take the global lock
+  {
+    auto& shard = getChunkIndexShard(new_seg_it->chunk_key);
+    std::lock_guard<std::shared_mutex> chunk_index_lock(shard.mutex);
+    shard.index[new_seg_it->chunk_key] = new_seg_it;
+  }
   // Decrement pin count to reverse effect above
   removeSegment(seg_it);
+
+  return new_seg_it;
+}
+
+BufferList::iterator BufferMgr::releasePages(BufferList::iterator& seg_it) {
+  if (seg_it->slab_num < 0) {
+    return seg_it;
+  }
+  BufferSeg unsized_seg(-1, 0, USED);
+  unsized_seg.buffer = seg_it->buffer;
+  unsized_seg.chunk_key = seg_it->chunk_key;
+  unsized_seg.fetched = seg_it->fetched;
+  BufferList::iterator new_seg_it;
   {
-    std::lock_guard<std::mutex> lock(chunk_index_mutex_);
-    chunk_index_[new_seg_it->chunk_key] = new_seg_it;
+    std::lock_guard<std::mutex> unsized_segs_lock(unsized_segs_mutex_);
+    unsized_segs_.push_back(unsized_seg);
+    new_seg_it = std::prev(unsized_segs_.end());
   }
-
+  {
+    auto& shard = getChunkIndexShard(new_seg_it->chunk_key);
+    std::lock_guard<std::shared_mutex> chunk_index_lock(shard.mutex);
+    shard.index[new_seg_it->chunk_key] = new_seg_it;
+  }
+  removeSegment(seg_it);
   return new_seg_it;
 }
 
@@ -350,6 +474,9 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
   }
 
   // If here then we can't add a slab - so we need to evict
+  // Buffers are only pinned under the locks of their chunk index shards, so this keeps
+  // the buffers selected for eviction unpinned until they are evicted.
+  auto chunk_index_locks = lockChunkIndex();
 
   size_t min_score = std::numeric_limits<size_t>::max();
   // We're going for lowest score here, like golf
@@ -374,9 +501,9 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
       bool solution_found = false;
       auto evict_it = buffer_it;
       for (; evict_it != slab_segments_[slab_num].end(); ++evict_it) {
-        // pinCount should never go up - only down because we have
-        // global lock on buffer pool and pin count only increments
-        // on getChunk
+        // pinCount should never go up - only down because we hold
+        // the locks of all the chunk index shards and pin count only
+        // increments on getChunk
         if (evict_it->mem_status == USED && evict_it->buffer->getPinCount() > 0) {
           break;
         }
@@ -389,7 +516,11 @@ BufferList::iterator BufferMgr::findFreeBuffer(size_t num_bytes) {
           // chunk score was larger than one large chunk so it always would evict a large
           // chunk so under memory pressure a query would evict its own current chunks and
           // cause reloads rather than evict several smaller unused older chunks.
-          score = std::max(score, static_cast<size_t>(evict_it->last_touched));
+          score = std::max(
+              score,
+              eviction_algorithm_
+                  ? eviction_algorithm_->getRetentionScore(evict_it->chunk_key)
+                  : static_cast<size_t>(evict_it->last_touched));
         }
         if (page_count >= num_pages_requested) {
           solution_found = true;
@@ -472,6 +603,23 @@ std::string BufferMgr::printSlabs() {
 
 void BufferMgr::clearSlabs() {
   bool pinned_exists = false;
+  // buffers mapping the memory of the parent, which do not use the slabs
+  std::vector<ChunkKey> unsized_keys;
+  {
+    std::lock_guard<std::mutex> unsized_segs_lock(unsized_segs_mutex_);
+    for (auto& segment : unsized_segs_) {
+      if (!segment.buffer) {
+        // no need to free
+      } else if (segment.buffer->getPinCount() < 1) {
+        unsized_keys.push_back(segment.chunk_key);
+      } else {
+        pinned_exists = true;
+      }
+    }
+  }
+  for (const auto& key : unsized_keys) {
+    deleteBuffer(key, true);
+  }
   for (auto& segment_list : slab_segments_) {
     for (auto& segment : segment_list) {
       if (segment.mem_status == FREE) {
@@ -550,17 +698,12 @@ std::string BufferMgr::printMap() {
   tss << std::endl
       << "Map Contents: "
       << " " << getStringMgrType() << ":" << device_id_ << std::endl;
-  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
-  for (auto seg_it = chunk_index_.begin(); seg_it != chunk_index_.end();
-       ++seg_it, ++seg_num) {
-    //    tss << "Map Entry " << seg_num << ": ";
-    //    for (auto vec_it = seg_it->first.begin(); vec_it != seg_it->first.end();
-    //    ++vec_it)
-    //    {
-    //      tss << *vec_it << ",";
-    //    }
-    //    tss << " " << std::endl;
-    tss << printSeg(seg_it->second);
+  for (auto& shard : chunk_index_) {
+    std::shared_lock<std::shared_mutex> chunk_index_lock(shard.mutex);
+    for (auto seg_it = shard.index.begin(); seg_it != shard.index.end();
+         ++seg_it, ++seg_num) {
+      tss << printSeg(seg_it->second);
+    }
   }
   tss << "--------------------" << std::endl;
   return tss.str();
@@ -586,8 +729,9 @@ void BufferMgr::printSegs() {
 }
 
 bool BufferMgr::isBufferOnDevice(const ChunkKey& key) {
-  std::lock_guard<std::mutex> chunkIndexLock(chunk_index_mutex_);
-  if (chunk_index_.find(key) == chunk_index_.end()) {
+  auto& shard = getChunkIndexShard(key);
+  std::shared_lock<std::shared_mutex> chunk_index_lock(shard.mutex);
+  if (shard.index.find(key) == shard.index.end()) {
     return false;
   } else {
     return true;
@@ -597,13 +741,17 @@ bool BufferMgr::isBufferOnDevice(const ChunkKey& key) {
 /// This method throws a runtime_error when deleting a Chunk that does not exist.
 void BufferMgr::deleteBuffer(const ChunkKey& key, const bool) {
   // Note: purge is unused
-  std::unique_lock<std::mutex> chunk_index_lock(chunk_index_mutex_);
+  auto& shard = getChunkIndexShard(key);
+  std::unique_lock<std::shared_mutex> chunk_index_lock(shard.mutex);
 
   // lookup the buffer for the Chunk in chunk_index_
-  auto buffer_it = chunk_index_.find(key);
-  CHECK(buffer_it != chunk_index_.end());
+  auto buffer_it = shard.index.find(key);
+  CHECK(buffer_it != shard.index.end());
   auto seg_it = buffer_it->second;
-  chunk_index_.erase(buffer_it);
+  shard.index.erase(buffer_it);
+  if (eviction_algorithm_) {
+    eviction_algorithm_->removeChunk(key);
+  }
   chunk_index_lock.unlock();
   std::lock_guard<std::mutex> sized_segs_lock(sized_segs_mutex_);
   if (seg_it->buffer) {
@@ -619,33 +767,33 @@ void BufferMgr::deleteBuffersWithPrefix(const ChunkKey& key_prefix, const bool)
   std::lock_guard<std::mutex> sized_segs_lock(
       sized_segs_mutex_);  // Take this lock early to prevent deadlock with
                            // reserveBuffer which needs segs_mutex_ and then
-                           // chunk_index_mutex_
-  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
-  auto startChunkIt = chunk_index_.lower_bound(key_prefix);
-  if (startChunkIt == chunk_index_.end()) {
-    return;
-  }
-
-  auto buffer_it = startChunkIt;
-  while (buffer_it != chunk_index_.end() &&
-         std::search(buffer_it->first.begin(),
-                     buffer_it->first.begin() + key_prefix.size(),
-                     key_prefix.begin(),
-                     key_prefix.end()) != buffer_it->first.begin() + key_prefix.size()) {
-    auto seg_it = buffer_it->second;
-    if (seg_it->buffer) {
-      if (seg_it->buffer->getPinCount() != 0) {
-        // leave the buffer and buffer segment in place, they are in use elsewhere. once
-        // unpinned, the buffer will be inaccessible and evicted
-        buffer_it++;
-        continue;
+                           // the chunk index shard locks
+  forEachChunkIndexShard(key_prefix, [&](ChunkIndexShard& shard) {
+    auto buffer_it = shard.index.lower_bound(key_prefix);
+    const auto prefix_size = key_prefix.size();
+    while (buffer_it != shard.index.end() &&
+           std::search(buffer_it->first.begin(),
+                       buffer_it->first.begin() + prefix_size,
+                       key_prefix.begin(),
+                       key_prefix.end()) != buffer_it->first.begin() + prefix_size) {
+      auto seg_it = buffer_it->second;
+      if (seg_it->buffer) {
+        if (seg_it->buffer->getPinCount() != 0) {
+          // leave the buffer and buffer segment in place, they are in use elsewhere. once
+          // unpinned, the buffer will be inaccessible and evicted
+          buffer_it++;
+          continue;
+        }
+        delete seg_it->buffer;  // Delete Buffer for segment
+        seg_it->buffer = nullptr;
       }
-      delete seg_it->buffer;  // Delete Buffer for segment
-      seg_it->buffer = nullptr;
+      removeSegment(seg_it);
+      if (eviction_algorithm_) {
+        eviction_algorithm_->removeChunk(buffer_it->first);
+      }
+      shard.index.erase(buffer_it++);
     }
-    removeSegment(seg_it);
-    chunk_index_.erase(buffer_it++);
-  }
+  });
 }
 
 void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
@@ -681,32 +829,34 @@ void BufferMgr::removeSegment(BufferList::iterator& seg_it) {
 
 void BufferMgr::checkpoint() {
   std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
-  std::lock_guard<std::mutex> chunkIndexLock(chunk_index_mutex_);
-
-  for (auto& chunk_itr : chunk_index_) {
-    // checks that buffer is actual chunk (not just buffer) and is dirty
-    auto& buffer_itr = chunk_itr.second;
-    if (buffer_itr->chunk_key[0] != -1 && buffer_itr->buffer->isDirty()) {
-      parent_mgr_->putBuffer(buffer_itr->chunk_key, buffer_itr->buffer);
-      buffer_itr->buffer->clearDirtyBits();
+
+  forEachChunkIndexShard({}, [&](ChunkIndexShard& shard) {
+    for (auto& chunk_itr : shard.index) {
+      // checks that buffer is actual chunk (not just buffer) and is dirty
+      auto& buffer_itr = chunk_itr.second;
+      if (buffer_itr->chunk_key[0] != -1 && buffer_itr->buffer->isDirty()) {
+        parent_mgr_->putBuffer(buffer_itr->chunk_key, buffer_itr->buffer);
+        buffer_itr->buffer->clearDirtyBits();
+      }
     }
-  }
+  });
 }
 
 void BufferMgr::checkpoint(const int db_id, const int tb_id) {
   std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
-  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
 
   ChunkKey key_prefix;
   key_prefix.push_back(db_id);
   key_prefix.push_back(tb_id);
-  auto start_chunk_it = chunk_index_.lower_bound(key_prefix);
-  if (start_chunk_it == chunk_index_.end()) {
+  auto& shard = getChunkIndexShard(key_prefix);
+  std::lock_guard<std::shared_mutex> chunk_index_lock(shard.mutex);
+  auto start_chunk_it = shard.index.lower_bound(key_prefix);
+  if (start_chunk_it == shard.index.end()) {
     return;
   }
 
   auto buffer_it = start_chunk_it;
-  while (buffer_it != chunk_index_.end() &&
+  while (buffer_it != shard.index.end() &&
          std::search(buffer_it->first.begin(),
                      buffer_it->first.begin() + key_prefix.size(),
                      key_prefix.begin(),
@@ -725,26 +875,33 @@ void BufferMgr::checkpoint(const int db_id, const int tb_id) {
 /// Returns a pointer to the Buffer holding the chunk, if it exists; otherwise,
 /// throws a runtime_error.
 AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes) {
+  // hits on resident chunks do not take the global lock
+  if (auto buffer = pinFetchedBuffer(key, num_bytes)) {
+    return buffer;
+  }
   std::lock_guard<std::mutex> lock(global_mutex_);  // granular lock
 
   std::unique_lock<std::mutex> sized_segs_lock(sized_segs_mutex_);
-  std::unique_lock<std::mutex> chunk_index_lock(chunk_index_mutex_);
-  auto buffer_it = chunk_index_.find(key);
-  bool found_buffer = buffer_it != chunk_index_.end();
-  chunk_index_lock.unlock();
+  auto& shard = getChunkIndexShard(key);
+  std::unique_lock<std::shared_mutex> chunk_index_lock(shard.mutex);
+  auto buffer_it = shard.index.find(key);
+  bool found_buffer = buffer_it != shard.index.end();
   if (found_buffer) {
-    CHECK(buffer_it->second->buffer);
-    buffer_it->second->buffer->pin();
+    auto buffer = buffer_it->second->buffer;
+    CHECK(buffer);
+    buffer->pin();
+    buffer_it->second->last_touched = buffer_epoch_++;
+    chunk_index_lock.unlock();
     sized_segs_lock.unlock();
 
-    buffer_it->second->last_touched = buffer_epoch_++;  // race
-
-    if (buffer_it->second->buffer->size() < num_bytes) {
+    if (buffer->size() < num_bytes) {
       // need to fetch part of buffer we don't have - up to numBytes
-      parent_mgr_->fetchBuffer(key, buffer_it->second->buffer, num_bytes);
+      parent_mgr_->fetchBuffer(key, buffer, num_bytes);
     }
-    return buffer_it->second->buffer;
+    markFetched(key);
+    return buffer;
   } else {  // If wasn't in pool then we need to fetch it
+    chunk_index_lock.unlock();
     sized_segs_lock.unlock();
     // createChunk pins for us
     AbstractBuffer* buffer = createBuffer(key, page_size_, num_bytes);
@@ -760,6 +917,7 @@ AbstractBuffer* BufferMgr::getBuffer(const ChunkKey& key, const size_t num_bytes
       LOG(FATAL) << "Get chunk - Could not find chunk " << keyToString(key)
                  << " in buffer pool or parent buffer pools. Error was " << error.what();
     }
+    markFetched(key);
     return buffer;
   }
 }
@@ -769,13 +927,14 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
                             const size_t num_bytes) {
   std::unique_lock<std::mutex> lock(global_mutex_);  // granular lock
   std::unique_lock<std::mutex> sized_segs_lock(sized_segs_mutex_);
-  std::unique_lock<std::mutex> chunk_index_lock(chunk_index_mutex_);
+  auto& shard = getChunkIndexShard(key);
+  std::unique_lock<std::shared_mutex> chunk_index_lock(shard.mutex);
 
-  auto buffer_it = chunk_index_.find(key);
-  bool found_buffer = buffer_it != chunk_index_.end();
-  chunk_index_lock.unlock();
+  auto buffer_it = shard.index.find(key);
+  bool found_buffer = buffer_it != shard.index.end();
   AbstractBuffer* buffer;
   if (!found_buffer) {
+    chunk_index_lock.unlock();
     sized_segs_lock.unlock();
     CHECK(parent_mgr_ != 0);
     buffer = createBuffer(key, page_size_, num_bytes);  // will pin buffer
@@ -787,6 +946,7 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
   } else {
     buffer = buffer_it->second->buffer;
     buffer->pin();
+    chunk_index_lock.unlock();
     if (num_bytes > buffer->size()) {
       try {
         parent_mgr_->fetchBuffer(key, buffer, num_bytes);
@@ -796,6 +956,7 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
     }
     sized_segs_lock.unlock();
   }
+  markFetched(key);
   lock.unlock();
   buffer->copyTo(dest_buffer, num_bytes);
   buffer->unPin();
@@ -804,15 +965,14 @@ void BufferMgr::fetchBuffer(const ChunkKey& key,
 AbstractBuffer* BufferMgr::putBuffer(const ChunkKey& key,
                                      AbstractBuffer* src_buffer,
                                      const size_t num_bytes) {
-  std::unique_lock<std::mutex> chunk_index_lock(chunk_index_mutex_);
-  auto buffer_it = chunk_index_.find(key);
-  bool found_buffer = buffer_it != chunk_index_.end();
+  auto& shard = getChunkIndexShard(key);
+  std::shared_lock<std::shared_mutex> chunk_index_lock(shard.mutex);
+  auto buffer_it = shard.index.find(key);
+  bool found_buffer = buffer_it != shard.index.end();
+  AbstractBuffer* buffer = found_buffer ? buffer_it->second->buffer : nullptr;
   chunk_index_lock.unlock();
-  AbstractBuffer* buffer;
   if (!found_buffer) {
     buffer = createBuffer(key, page_size_);
-  } else {
-    buffer = buffer_it->second->buffer;
   }
   size_t old_buffer_size = buffer->size();
   size_t new_buffer_size = num_bytes == 0 ? src_buffer->size() : num_bytes;
@@ -862,8 +1022,12 @@ void BufferMgr::free(AbstractBuffer* buffer) {
 }
 
 size_t BufferMgr::getNumChunks() {
-  std::lock_guard<std::mutex> chunk_index_lock(chunk_index_mutex_);
-  return chunk_index_.size();
+  size_t num_chunks{0};
+  for (auto& shard : chunk_index_) {
+    std::shared_lock<std::shared_mutex> chunk_index_lock(shard.mutex);
+    num_chunks += shard.index.size();
+  }
+  return num_chunks;
 }
 
 size_t BufferMgr::size() {
@@ -26,14 +26,21 @@
 
 #define BOOST_STACKTRACE_GNU_SOURCE_NOT_REQUIRED 1
 
+#include <array>
+#include <atomic>
+#include <functional>
 #include <iostream>
 #include <list>
 #include <map>
+#include <memory>
 #include <mutex>
+#include <shared_mutex>
+#include <vector>
 
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/AbstractBufferMgr.h"
 #include "DataMgr/BufferMgr/BufferSeg.h"
+#include "DataMgr/ForeignStorage/CacheEvictionAlgorithms/CacheEvictionAlgorithm.h"
 #include "Shared/boost_stacktrace.hpp"
 #include "Shared/types.h"
 
@@ -137,6 +144,12 @@ class BufferMgr : public AbstractBufferMgr {  // implements
 
   /// Returns the a pointer to the chunk with the specified key.
   AbstractBuffer* getBuffer(const ChunkKey& key, const size_t num_bytes = 0) override;
+  /**
+   * @brief Pins and returns the buffer of the chunk if it was fetched and holds at least
+   * `num_bytes`, otherwise returns nullptr. Only takes the shared lock of the shard of
+   * the chunk.
+   */
+  AbstractBuffer* pinFetchedBuffer(const ChunkKey& key, const size_t num_bytes);
 
   /**
    * @brief Puts the contents of d into the Buffer with ChunkKey key.
@@ -165,9 +178,20 @@ class BufferMgr : public AbstractBufferMgr {  // implements
 
   BufferList::iterator reserveBuffer(BufferList::iterator& seg_it,
                                      const size_t num_bytes);
+  /// Frees the pages of the segment and moves its buffer to an unsized segment.
+  BufferList::iterator releasePages(BufferList::iterator& seg_it);
   void getChunkMetadataVecForKeyPrefix(ChunkMetadataVector& chunk_metadata_vec,
                                        const ChunkKey& key_prefix) override;
 
+  using RefetchCostFunc = std::function<size_t(const ChunkKey&, const AbstractBuffer*)>;
+  /**
+   * @brief Ranks the chunks of the runs of segments considered for eviction with the
+   * algorithm, instead of by their last touch. The chunks are weighted by `refetch_cost`
+   * when first fetched. Must be set before the pool is used.
+   */
+  void setEvictionAlgorithm(std::unique_ptr<RankedCacheEvictionAlgorithm> algorithm,
+                            RefetchCostFunc refetch_cost);
+
  protected:
   const size_t
       max_buffer_pool_size_;    /// max number of bytes allocated for the buffer pool
@@ -194,13 +218,38 @@ class BufferMgr : public AbstractBufferMgr {  // implements
                               const size_t num_bytes) = 0;
   void clear();
 
-  std::mutex chunk_index_mutex_;
+  /**
+   * @brief A shard of the chunk index. The chunks of a table all live in the same shard,
+   * so the lookups of the chunks of different tables do not contend and the operations
+   * on a table prefix only visit one shard.
+   *
+   * The pins of the resident buffers are only taken under the lock of their shard, in
+   * shared mode for the lookups of getBuffer, so holding the locks of all the shards
+   * exclusively guarantees that the pin counts of the unpinned buffers stay at zero.
+   */
+  struct ChunkIndexShard {
+    std::shared_mutex mutex;
+    std::map<ChunkKey, BufferList::iterator> index;
+  };
+
+  static constexpr size_t kNumChunkIndexShards{64};
+
+  ChunkIndexShard& getChunkIndexShard(const ChunkKey& key);
+  /// Locks all the shards of the chunk index exclusively, in shard order.
+  std::vector<std::unique_lock<std::shared_mutex>> lockChunkIndex();
+  /// Calls `func` with the shards, locked exclusively, which may hold chunks of the
+  /// prefix.
+  template <typename FUNC>
+  void forEachChunkIndexShard(const ChunkKey& key_prefix, FUNC func);
+  /// Lets pinFetchedBuffer serve the chunk, once its data was fetched from the parent.
+  void markFetched(const ChunkKey& key);
+
   std::mutex sized_segs_mutex_;
   std::mutex unsized_segs_mutex_;
   std::mutex buffer_id_mutex_;
   std::mutex global_mutex_;
 
-  std::map<ChunkKey, BufferList::iterator> chunk_index_;
+  std::array<ChunkIndexShard, kNumChunkIndexShards> chunk_index_;
   size_t max_buffer_pool_num_pages_;  // max number of pages for buffer pool
   size_t num_pages_allocated_;
   size_t min_num_pages_per_slab_;
@@ -209,7 +258,9 @@ class BufferMgr : public AbstractBufferMgr {  // implements
   bool allocations_capped_;
   AbstractBufferMgr* parent_mgr_;
   int max_buffer_id_;
-  unsigned int buffer_epoch_;
+  std::atomic<unsigned int> buffer_epoch_;
+  std::unique_ptr<RankedCacheEvictionAlgorithm> eviction_algorithm_;
+  RefetchCostFunc refetch_cost_;
 
   BufferList unsized_segs_;
 
@@ -36,6 +36,9 @@ struct BufferSeg {
   unsigned int pin_count;
   int slab_num;
   unsigned int last_touched;
+  // set once the chunk was fetched from the parent, buffers still being filled are not
+  // returned by the lookups which bypass the global lock of the BufferMgr
+  bool fetched{false};
 
   BufferSeg()
       : mem_status(FREE), buffer(0), pin_count(0), slab_num(-1), last_touched(0) {}
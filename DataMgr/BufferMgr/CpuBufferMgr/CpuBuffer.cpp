@@ -16,6 +16,7 @@
 
 #include "DataMgr/BufferMgr/CpuBufferMgr/CpuBuffer.h"
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
@@ -32,6 +33,30 @@ CpuBuffer::CpuBuffer(BufferMgr* bm,
                      const size_t num_bytes)
     : Buffer(bm, segment_iter, device_id, page_size, num_bytes), cuda_mgr_(cuda_mgr) {}
 
+bool CpuBuffer::mapMemory(int8_t* mem, const size_t num_bytes) {
+  if (size_ > 0 || num_bytes == 0) {
+    return false;
+  }
+  // the pages reserved up front for the data are not needed
+  releasePages();
+  mem_ = mem;
+  size_ = num_bytes;
+  is_mapped_ = true;
+  return true;
+}
+
+void CpuBuffer::reserve(const size_t num_bytes) {
+  if (is_mapped_) {
+    int8_t* mapped_mem = mem_;
+    mem_ = nullptr;
+    is_mapped_ = false;
+    Buffer::reserve(std::max(num_bytes, size_));
+    memcpy(mem_, mapped_mem, size_);
+    return;
+  }
+  Buffer::reserve(num_bytes);
+}
+
 void CpuBuffer::readData(int8_t* const dst,
                          const size_t num_bytes,
                          const size_t offset,
@@ -34,6 +34,15 @@ class CpuBuffer : public Buffer {
 
   inline Data_Namespace::MemoryLevel getType() const override { return CPU_LEVEL; }
 
+  /// Points the buffer at memory owned by the storage level, like a memory mapped data
+  /// file, which takes no space in the buffer pool. The first reserve copies the data
+  /// into the buffer pool.
+  bool mapMemory(int8_t* mem, const size_t num_bytes) override;
+
+  void reserve(const size_t num_bytes) override;
+
+  inline bool isMapped() const { return is_mapped_; }
+
  private:
   void readData(int8_t* const dst,
                 const size_t num_bytes,
@@ -47,5 +56,6 @@ class CpuBuffer : public Buffer {
                  const int src_device_id = -1) override;
 
   CudaMgr_Namespace::CudaMgr* cuda_mgr_;
+  bool is_mapped_{false};
 };
 }  // namespace Buffer_Namespace
@@ -17,11 +17,15 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
+#include <vector>
 #include "../Shared/sqltypes.h"
 #include "Shared/types.h"
 
 #include "Logger/Logger.h"
 
+class BloomFilter;
+
 struct ChunkStats {
   Datum min;
   Datum max;
@@ -33,6 +37,13 @@ struct ChunkMetadata {
   size_t numBytes;
   size_t numElements;
   ChunkStats chunkStats;
+  // Stats of consecutive blocks of rowsPerZone rows of the chunk, empty if the chunk has
+  // no zone maps. Not considered by the comparison, since they only refine chunkStats.
+  std::vector<ChunkStats> zoneStats;
+  size_t rowsPerZone{0};
+  // Values of the chunk, if the column has a Bloom filter index. Shared with the encoder
+  // of the chunk, which keeps adding the appended values.
+  std::shared_ptr<const BloomFilter> bloomFilter;
 
   std::string dump() const {
     auto type = sqlType.is_array() ? sqlType.get_elem_type() : sqlType;
@@ -71,58 +82,63 @@ struct ChunkMetadata {
 
   template <typename T>
   void fillChunkStats(const T min, const T max, const bool has_nulls) {
-    chunkStats.has_nulls = has_nulls;
+    fillStats(chunkStats, min, max, has_nulls);
+  }
+
+  template <typename T>
+  void fillStats(ChunkStats& stats, const T min, const T max, const bool has_nulls) const {
+    stats.has_nulls = has_nulls;
     switch (sqlType.get_type()) {
       case kBOOLEAN: {
-        chunkStats.min.tinyintval = min;
-        chunkStats.max.tinyintval = max;
+        stats.min.tinyintval = min;
+        stats.max.tinyintval = max;
         break;
       }
       case kTINYINT: {
-        chunkStats.min.tinyintval = min;
-        chunkStats.max.tinyintval = max;
+        stats.min.tinyintval = min;
+        stats.max.tinyintval = max;
         break;
       }
       case kSMALLINT: {
-        chunkStats.min.smallintval = min;
-        chunkStats.max.smallintval = max;
+        stats.min.smallintval = min;
+        stats.max.smallintval = max;
         break;
       }
       case kINT: {
-        chunkStats.min.intval = min;
-        chunkStats.max.intval = max;
+        stats.min.intval = min;
+        stats.max.intval = max;
         break;
       }
       case kBIGINT:
       case kNUMERIC:
       case kDECIMAL: {
-        chunkStats.min.bigintval = min;
-        chunkStats.max.bigintval = max;
+        stats.min.bigintval = min;
+        stats.max.bigintval = max;
         break;
       }
       case kTIME:
       case kTIMESTAMP:
       case kDATE: {
-        chunkStats.min.bigintval = min;
-        chunkStats.max.bigintval = max;
+        stats.min.bigintval = min;
+        stats.max.bigintval = max;
         break;
       }
       case kFLOAT: {
-        chunkStats.min.floatval = min;
-        chunkStats.max.floatval = max;
+        stats.min.floatval = min;
+        stats.max.floatval = max;
         break;
       }
       case kDOUBLE: {
-        chunkStats.min.doubleval = min;
-        chunkStats.max.doubleval = max;
+        stats.min.doubleval = min;
+        stats.max.doubleval = max;
         break;
       }
       case kVARCHAR:
       case kCHAR:
       case kTEXT:
         if (sqlType.get_compression() == kENCODING_DICT) {
-          chunkStats.min.intval = min;
-          chunkStats.max.intval = max;
+          stats.min.intval = min;
+          stats.max.intval = max;
         }
         break;
       default: {
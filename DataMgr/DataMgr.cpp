@@ -25,6 +25,7 @@
 #include "BufferMgr/GpuCudaBufferMgr/GpuCudaBufferMgr.h"
 #include "CudaMgr/CudaMgr.h"
 #include "FileMgr/GlobalFileMgr.h"
+#include "ForeignStorage/CacheEvictionAlgorithms/LRUKEvictionAlgorithm.h"
 #include "PersistentStorageMgr/PersistentStorageMgr.h"
 
 #ifdef __APPLE__
@@ -164,6 +165,45 @@ size_t DataMgr::getTotalSystemMemory() {
 #endif
 }
 
+namespace {
+
+// the costs of fetching the chunks again, relative to reading them from disk
+constexpr size_t kDecodedRefetchCost{2};
+constexpr size_t kForeignRefetchCost{8};
+
+void set_eviction_policy(AbstractBufferMgr* buffer_mgr,
+                         const std::string& policy,
+                         PersistentStorageMgr* persistent_storage_mgr) {
+  if (policy == "lru") {
+    // the default ranking of BufferMgr, by last touch
+    return;
+  }
+  if (policy != "lru-k") {
+    throw std::runtime_error("Invalid buffer pool eviction policy " + policy +
+                             ", expected lru or lru-k.");
+  }
+  auto bm = dynamic_cast<Buffer_Namespace::BufferMgr*>(buffer_mgr);
+  CHECK(bm);
+  bm->setEvictionAlgorithm(
+      std::make_unique<LRUKEvictionAlgorithm>(),
+      [persistent_storage_mgr](const ChunkKey& key, const AbstractBuffer* buffer) {
+        if (key[CHUNK_KEY_DB_IDX] < 0) {
+          // not a chunk, allocated for the queries
+          return size_t(1);
+        }
+        if (persistent_storage_mgr && persistent_storage_mgr->isForeignStorage(key)) {
+          return kForeignRefetchCost;
+        }
+        if (buffer && buffer->hasEncoder() &&
+            buffer->getEncoder()->isCompressedInStorage()) {
+          return kDecodedRefetchCost;
+        }
+        return size_t(1);
+      });
+}
+
+}  // namespace
+
 void DataMgr::allocateCpuBufferMgr(int32_t device_id,
                                    size_t total_cpu_size,
                                    size_t minCpuSlabSize,
@@ -286,6 +326,18 @@ void DataMgr::populateMgrs(const SystemParameters& system_parameters,
         0, total_cpu_size, minCpuSlabSize, maxCpuSlabSize, page_size, cpu_tier_sizes);
     levelSizes_.push_back(1);
   }
+
+  auto persistent_storage_mgr = dynamic_cast<PersistentStorageMgr*>(bufferMgrs_[0][0]);
+  set_eviction_policy(bufferMgrs_[1][0],
+                      system_parameters.cpu_buffer_eviction_policy,
+                      persistent_storage_mgr);
+  if (bufferMgrs_.size() > 2) {
+    for (auto gpu_buffer_mgr : bufferMgrs_[2]) {
+      set_eviction_policy(gpu_buffer_mgr,
+                          system_parameters.gpu_buffer_eviction_policy,
+                          persistent_storage_mgr);
+    }
+  }
 }
 
 void DataMgr::convertDB(const std::string basePath) {
@@ -448,6 +500,21 @@ bool DataMgr::isBufferOnDevice(const ChunkKey& key,
   return bufferMgrs_[memLevel][deviceId]->isBufferOnDevice(key);
 }
 
+void DataMgr::prefetchChunks(const std::vector<ChunkKey>& keys) {
+  std::vector<ChunkKey> keys_to_prefetch;
+  {
+    std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
+    for (const auto& key : keys) {
+      if (!bufferMgrs_[MemoryLevel::CPU_LEVEL][0]->isBufferOnDevice(key)) {
+        keys_to_prefetch.push_back(key);
+      }
+    }
+  }
+  if (!keys_to_prefetch.empty()) {
+    getGlobalFileMgr()->prefetchBuffers(keys_to_prefetch);
+  }
+}
+
 void DataMgr::getChunkMetadataVecForKeyPrefix(ChunkMetadataVector& chunkMetadataVec,
                                               const ChunkKey& keyPrefix) {
   std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
@@ -467,10 +534,17 @@ AbstractBuffer* DataMgr::getChunkBuffer(const ChunkKey& key,
                                         const MemoryLevel memoryLevel,
                                         const int deviceId,
                                         const size_t numBytes) {
-  std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
   const auto level = static_cast<size_t>(memoryLevel);
   CHECK_LT(level, levelSizes_.size());     // make sure we have a legit buffermgr
   CHECK_LT(deviceId, levelSizes_[level]);  // make sure we have a legit buffermgr
+  // the chunks resident in a buffer pool are pinned without taking the buffer access lock
+  if (auto buffer_mgr =
+          dynamic_cast<Buffer_Namespace::BufferMgr*>(bufferMgrs_[level][deviceId])) {
+    if (auto buffer = buffer_mgr->pinFetchedBuffer(key, numBytes)) {
+      return buffer;
+    }
+  }
+  std::lock_guard<std::mutex> buffer_lock(buffer_access_mutex_);
   return bufferMgrs_[level][deviceId]->getBuffer(key, numBytes);
 }
 
@@ -194,6 +194,8 @@ class DataMgr {
   bool isBufferOnDevice(const ChunkKey& key,
                         const MemoryLevel memLevel,
                         const int deviceId);
+  // hints the disk reads of the chunks not in CPU memory, without waiting for them
+  void prefetchChunks(const std::vector<ChunkKey>& keys);
   std::vector<MemoryInfo> getMemoryInfo(const MemoryLevel memLevel);
   std::string dumpLevel(const MemoryLevel memLevel);
   void clearMemory(const MemoryLevel memLevel);
@@ -0,0 +1,193 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    DiffEncoder.h
+ * @brief   Encoder of DIFF (differential) encoded columns.
+ *
+ * The disk level chunk stores every row as the difference to the previous non null row,
+ * zigzag encoded into a varint, so that sorted or slowly changing values such as
+ * timestamps take one or two bytes per row. The first row is stored as the difference to
+ * zero, nulls as the otherwise unused two bytes varint of zero.
+ *
+ * The memory levels hold the decoded rows, see Encoder::isCompressedInStorage.
+ */
+
+#pragma once
+
+#include "NoneEncoder.h"
+
+#include <vector>
+
+template <typename T>
+class DiffEncoder : public NoneEncoder<T> {
+ public:
+  DiffEncoder(Data_Namespace::AbstractBuffer* buffer) : NoneEncoder<T>(buffer) {}
+
+  using NoneEncoder<T>::getMetadata;
+
+  void getMetadata(const std::shared_ptr<ChunkMetadata>& chunk_metadata) override {
+    NoneEncoder<T>::getMetadata(chunk_metadata);
+    // the number of bytes fetched into memory
+    chunk_metadata->numBytes = getDecodedSize();
+  }
+
+  void copyMetadata(const Encoder* copyFromEncoder) override {
+    NoneEncoder<T>::copyMetadata(copyFromEncoder);
+    last_value_known_ = false;
+  }
+
+  void readMetadata(FILE* f) override {
+    NoneEncoder<T>::readMetadata(f);
+    last_value_known_ = false;
+  }
+
+  bool isCompressedInStorage() const override { return true; }
+
+  size_t getDecodedSize() const override { return this->num_elems_ * sizeof(T); }
+
+  void decodeTo(int8_t* dst, const size_t offset, const size_t num_bytes) override {
+    CHECK_EQ(offset % sizeof(T), size_t(0));
+    CHECK_EQ(num_bytes % sizeof(T), size_t(0));
+    const auto first_row = offset / sizeof(T);
+    const auto end_row = first_row + num_bytes / sizeof(T);
+    auto out = reinterpret_cast<T*>(dst);
+    const auto num_rows = decodeRows([&](const size_t row_idx, const T value) {
+      if (row_idx >= first_row && row_idx < end_row) {
+        out[row_idx - first_row] = value;
+      }
+      return row_idx + 1 < end_row;
+    });
+    CHECK_GE(num_rows, end_row) << "Differential encoded chunk is shorter than requested";
+  }
+
+  void encodeFrom(int8_t* src, const size_t num_bytes) override {
+    CHECK_EQ(num_bytes % sizeof(T), size_t(0));
+    last_value_ = 0;
+    last_value_known_ = true;
+    std::vector<int8_t> encoded;
+    encodeRows(encoded, reinterpret_cast<const T*>(src), num_bytes / sizeof(T));
+    auto buffer = this->buffer_;
+    if (!encoded.empty()) {
+      buffer->write(encoded.data(), encoded.size(), 0);
+    }
+    buffer->setSize(encoded.size());
+    buffer->setUpdated();
+  }
+
+ protected:
+  void storeData(int8_t* data, const size_t num_elems, const int64_t offset) override {
+    if (this->buffer_->getType() != Data_Namespace::DISK_LEVEL) {
+      NoneEncoder<T>::storeData(data, num_elems, offset);
+      return;
+    }
+    const auto rows = reinterpret_cast<const T*>(data);
+    if (offset != -1) {
+      // rows written in place, encode the chunk again
+      std::vector<T> decoded(offset + num_elems);
+      decodeRows([&](const size_t row_idx, const T value) {
+        if (row_idx < static_cast<size_t>(offset)) {
+          decoded[row_idx] = value;
+        }
+        return row_idx + 1 < static_cast<size_t>(offset);
+      });
+      std::copy(rows, rows + num_elems, decoded.begin() + offset);
+      encodeFrom(reinterpret_cast<int8_t*>(decoded.data()), decoded.size() * sizeof(T));
+      return;
+    }
+    if (!last_value_known_) {
+      last_value_ = 0;
+      decodeRows([this](const size_t, const T value) {
+        if (value != none_encoded_null_value<T>()) {
+          last_value_ = value;
+        }
+        return true;
+      });
+      last_value_known_ = true;
+    }
+    std::vector<int8_t> encoded;
+    encodeRows(encoded, rows, num_elems);
+    this->buffer_->append(encoded.data(), encoded.size());
+  }
+
+ private:
+  // the two bytes varint of zero
+  static constexpr uint8_t kNullFirstByte{0x80};
+  static constexpr uint8_t kNullSecondByte{0x00};
+
+  // Encodes the rows as differences to last_value_ and updates it.
+  void encodeRows(std::vector<int8_t>& encoded, const T* rows, const size_t num_rows) {
+    encoded.reserve(encoded.size() + num_rows * 2);
+    for (size_t i = 0; i < num_rows; ++i) {
+      if (rows[i] == none_encoded_null_value<T>()) {
+        encoded.push_back(static_cast<int8_t>(kNullFirstByte));
+        encoded.push_back(static_cast<int8_t>(kNullSecondByte));
+        continue;
+      }
+      const auto delta = static_cast<int64_t>(static_cast<uint64_t>(rows[i]) -
+                                              static_cast<uint64_t>(last_value_));
+      auto zigzag =
+          (static_cast<uint64_t>(delta) << 1) ^ static_cast<uint64_t>(delta >> 63);
+      while (zigzag >= 0x80) {
+        encoded.push_back(static_cast<int8_t>((zigzag & 0x7f) | 0x80));
+        zigzag >>= 7;
+      }
+      encoded.push_back(static_cast<int8_t>(zigzag));
+      last_value_ = rows[i];
+    }
+  }
+
+  // Calls `callback` with the index and value of every row until it returns false,
+  // returns the number of rows decoded.
+  template <typename Callback>
+  size_t decodeRows(Callback callback) const {
+    std::vector<uint8_t> encoded(this->buffer_->size());
+    if (!encoded.empty()) {
+      this->buffer_->read(reinterpret_cast<int8_t*>(encoded.data()), encoded.size());
+    }
+    T value{0};
+    size_t row_idx{0};
+    for (size_t pos = 0; pos < encoded.size();) {
+      if (encoded[pos] == kNullFirstByte && pos + 1 < encoded.size() &&
+          encoded[pos + 1] == kNullSecondByte) {
+        pos += 2;
+        if (!callback(row_idx++, none_encoded_null_value<T>())) {
+          break;
+        }
+        continue;
+      }
+      uint64_t zigzag{0};
+      for (size_t shift = 0;; shift += 7) {
+        CHECK_LT(pos, encoded.size()) << "Truncated differential encoded chunk";
+        const auto byte = encoded[pos++];
+        zigzag |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+          break;
+        }
+      }
+      const auto delta = (zigzag >> 1) ^ (~(zigzag & 1) + 1);
+      value = static_cast<T>(static_cast<uint64_t>(value) + delta);
+      if (!callback(row_idx++, value)) {
+        break;
+      }
+    }
+    return row_idx;
+  }
+
+  T last_value_{0};
+  // the last value must be decoded from the buffer after the metadata has been loaded
+  bool last_value_known_{false};
+};
@@ -17,12 +17,45 @@
 #include "Encoder.h"
 #include "ArrayNoneEncoder.h"
 #include "DateDaysEncoder.h"
+#include "DiffEncoder.h"
 #include "FixedLengthArrayNoneEncoder.h"
 #include "FixedLengthEncoder.h"
 #include "Logger/Logger.h"
 #include "NoneEncoder.h"
+#include "RunLengthEncoder.h"
 #include "StringNoneEncoder.h"
 
+bool g_enable_zone_maps{false};
+size_t g_zone_map_min_rows{65536};
+
+namespace {
+
+// encoders of the RL and DIFF encodings, see Encoder::isCompressedInStorage
+template <template <typename> class STORAGE_ENCODER>
+Encoder* create_storage_encoder(Data_Namespace::AbstractBuffer* buffer,
+                                const SQLTypeInfo& sql_type) {
+  switch (sql_type.get_type()) {
+    case kBOOLEAN:
+    case kTINYINT:
+      return new STORAGE_ENCODER<int8_t>(buffer);
+    case kSMALLINT:
+      return new STORAGE_ENCODER<int16_t>(buffer);
+    case kINT:
+      return new STORAGE_ENCODER<int32_t>(buffer);
+    case kBIGINT:
+    case kNUMERIC:
+    case kDECIMAL:
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+      return new STORAGE_ENCODER<int64_t>(buffer);
+    default:
+      return 0;
+  }
+}
+
+}  // namespace
+
 Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
                          const SQLTypeInfo sqlType) {
   switch (sqlType.get_compression()) {
@@ -210,6 +243,10 @@ Encoder* Encoder::Create(Data_Namespace::AbstractBuffer* buffer,
       }
       break;
     }
+    case kENCODING_RL:
+      return create_storage_encoder<RunLengthEncoder>(buffer, sqlType);
+    case kENCODING_DIFF:
+      return create_storage_encoder<DiffEncoder>(buffer, sqlType);
     default: {
       return 0;
       break;
@@ -228,4 +265,5 @@ void Encoder::getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) {
   chunkMetadata->sqlType = buffer_->getSqlType();
   chunkMetadata->numBytes = buffer_->size();
   chunkMetadata->numElements = num_elems_;
+  chunkMetadata->bloomFilter = bloom_filter_;
 }
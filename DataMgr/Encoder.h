@@ -20,11 +20,13 @@
 #include "../Shared/DateConverters.h"
 #include "../Shared/sqltypes.h"
 #include "../Shared/types.h"
+#include "BloomFilter.h"
 #include "ChunkMetadata.h"
 
 #include <cmath>
 #include <iostream>
 #include <limits>
+#include <memory>
 #include <stdexcept>
 #include <vector>
 
@@ -214,6 +216,11 @@ class Encoder {
   virtual void writeMetadata(FILE* f /*, const size_t offset*/) = 0;
   virtual void readMetadata(FILE* f /*, const size_t offset*/) = 0;
 
+  // Zone maps are persisted right after the rest of the metadata, only encoders of fixed
+  // width scalar types keep them.
+  virtual void writeZoneMaps(FILE* f) {}
+  virtual void readZoneMaps(FILE* f) {}
+
   /**
    * @brief: Reset chunk level stats (min, max, nulls) using new values from the argument.
    * @return: True if an update occurred and the chunk needs to be flushed. False
@@ -233,8 +240,38 @@ class Encoder {
   size_t getNumElems() const { return num_elems_; }
   void setNumElems(const size_t num_elems) { num_elems_ = num_elems; }
 
+  // The Bloom filter of the values of the chunk is only built for the columns listed in
+  // the bloom_filter_columns option of their table, by the encoders of integer columns.
+  // It can only be enabled on an empty chunk, and it's dropped for good once the chunk
+  // is updated in place.
+  void enableBloomFilter() {
+    CHECK_EQ(num_elems_, size_t(0));
+    bloom_filter_ = std::make_shared<BloomFilter>();
+  }
+  std::shared_ptr<BloomFilter> getBloomFilter() const { return bloom_filter_; }
+  void setBloomFilter(std::shared_ptr<BloomFilter> bloom_filter) {
+    bloom_filter_ = std::move(bloom_filter);
+  }
+
+  // The encoders of RL and DIFF encoded columns compress the disk level chunks only, the
+  // memory levels hold the decoded fixed width rows. The rows are decoded when the chunk
+  // is fetched from disk, and a chunk modified in memory is encoded again as a whole when
+  // it's written back.
+  virtual bool isCompressedInStorage() const { return false; }
+  virtual size_t getDecodedSize() const {
+    UNREACHABLE();
+    return 0;
+  }
+  // Decodes `num_bytes` bytes of the decoded chunk, starting at byte `offset`.
+  virtual void decodeTo(int8_t* dst, const size_t offset, const size_t num_bytes) {
+    UNREACHABLE();
+  }
+  // Replaces the content of the buffer with the encoding of the given decoded rows.
+  virtual void encodeFrom(int8_t* src, const size_t num_bytes) { UNREACHABLE(); }
+
  protected:
   size_t num_elems_;
+  std::shared_ptr<BloomFilter> bloom_filter_;
 
   Data_Namespace::AbstractBuffer* buffer_;
 
@@ -0,0 +1,219 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/FileMgr/AsyncFileReader.h"
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <future>
+#include <numeric>
+
+#ifdef HAVE_IO_URING
+#include <liburing.h>
+#endif
+
+#include "Logger/Logger.h"
+
+namespace File_Namespace {
+
+namespace {
+
+void pread_fully(const FileReadRequest& request) {
+  size_t bytes_read{0};
+  while (bytes_read < request.size) {
+    const auto ret = ::pread(request.fd,
+                             request.dst + bytes_read,
+                             request.size - bytes_read,
+                             request.offset + bytes_read);
+    if (ret < 0 && errno == EINTR) {
+      continue;
+    }
+    CHECK_GT(ret, 0) << "Failed to read " << request.size << " bytes at offset "
+                     << request.offset << ": "
+                     << (ret ? std::strerror(errno) : "unexpected end of file");
+    bytes_read += ret;
+  }
+}
+
+#ifdef HAVE_IO_URING
+constexpr unsigned kQueueDepth{64};
+
+// one ring per thread, as the submission and completion queues are not thread safe
+class IoUring {
+ public:
+  IoUring() { initialized_ = io_uring_queue_init(kQueueDepth, &ring_, 0) == 0; }
+
+  ~IoUring() {
+    if (initialized_) {
+      io_uring_queue_exit(&ring_);
+    }
+  }
+
+  io_uring* get() { return initialized_ ? &ring_ : nullptr; }
+
+ private:
+  io_uring ring_;
+  bool initialized_{false};
+};
+
+void read_with_io_uring(io_uring* ring, const std::vector<FileReadRequest>& requests) {
+  std::vector<size_t> bytes_read(requests.size(), 0);
+  // the requests to submit, short reads are submitted again for their remaining bytes
+  std::deque<size_t> pending(requests.size());
+  std::iota(pending.begin(), pending.end(), size_t(0));
+  size_t in_flight{0};
+  while (!pending.empty() || in_flight) {
+    while (!pending.empty() && in_flight < kQueueDepth) {
+      auto sqe = io_uring_get_sqe(ring);
+      if (!sqe) {
+        break;
+      }
+      const auto idx = pending.front();
+      pending.pop_front();
+      const auto& request = requests[idx];
+      io_uring_prep_read(sqe,
+                         request.fd,
+                         request.dst + bytes_read[idx],
+                         request.size - bytes_read[idx],
+                         request.offset + bytes_read[idx]);
+      io_uring_sqe_set_data(sqe, reinterpret_cast<void*>(idx));
+      ++in_flight;
+    }
+    const auto ret = io_uring_submit_and_wait(ring, 1);
+    CHECK(ret >= 0 || ret == -EINTR) << "io_uring submission failed: "
+                                     << std::strerror(-ret);
+    io_uring_cqe* cqe;
+    unsigned head;
+    unsigned num_completed{0};
+    io_uring_for_each_cqe(ring, head, cqe) {
+      ++num_completed;
+      --in_flight;
+      const auto idx = reinterpret_cast<size_t>(io_uring_cqe_get_data(cqe));
+      if (cqe->res == -EINTR || cqe->res == -EAGAIN) {
+        pending.push_back(idx);
+        continue;
+      }
+      const auto& request = requests[idx];
+      CHECK_GT(cqe->res, 0) << "Failed to read " << request.size << " bytes at offset "
+                            << request.offset << ": "
+                            << (cqe->res ? std::strerror(-cqe->res)
+                                         : "unexpected end of file");
+      bytes_read[idx] += cqe->res;
+      if (bytes_read[idx] < request.size) {
+        pending.push_back(idx);
+      }
+    }
+    io_uring_cq_advance(ring, num_completed);
+  }
+}
+#endif
+
+}  // namespace
+
+AsyncFileReader& AsyncFileReader::instance() {
+  static AsyncFileReader reader;
+  return reader;
+}
+
+AsyncFileReader::AsyncFileReader()
+    : prefetch_thread_([this] { prefetchLoop(); }) {}
+
+AsyncFileReader::~AsyncFileReader() {
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    stop_prefetch_ = true;
+  }
+  prefetch_cv_.notify_one();
+  prefetch_thread_.join();
+}
+
+void AsyncFileReader::read(const std::vector<FileReadRequest>& requests,
+                           const size_t max_threads) {
+  if (requests.empty()) {
+    return;
+  }
+#ifdef HAVE_IO_URING
+  thread_local IoUring ring;
+  if (auto ring_ptr = ring.get()) {
+    read_with_io_uring(ring_ptr, requests);
+    return;
+  }
+  // the kernel does not support io_uring, fall back to the reader threads
+#endif
+  const size_t num_threads = std::min(std::max(max_threads, size_t(1)), requests.size());
+  if (num_threads == 1) {
+    for (const auto& request : requests) {
+      pread_fully(request);
+    }
+    return;
+  }
+  const size_t requests_per_thread = (requests.size() + num_threads - 1) / num_threads;
+  std::vector<std::future<void>> threads;
+  for (size_t begin = 0; begin < requests.size(); begin += requests_per_thread) {
+    const auto end = std::min(begin + requests_per_thread, requests.size());
+    threads.push_back(std::async(std::launch::async, [&requests, begin, end] {
+      for (size_t i = begin; i < end; ++i) {
+        pread_fully(requests[i]);
+      }
+    }));
+  }
+  for (auto& p : threads) {
+    p.wait();
+  }
+  for (auto& p : threads) {
+    p.get();
+  }
+}
+
+void AsyncFileReader::prefetch(const std::vector<FileReadRequest>& ranges) {
+  if (ranges.empty()) {
+    return;
+  }
+  {
+    std::lock_guard<std::mutex> lock(prefetch_mutex_);
+    for (const auto& range : ranges) {
+      if (prefetch_queue_.size() >= kMaxQueuedPrefetches) {
+        break;
+      }
+      prefetch_queue_.push_back(range);
+    }
+  }
+  prefetch_cv_.notify_one();
+}
+
+void AsyncFileReader::prefetchLoop() {
+  while (true) {
+    FileReadRequest range;
+    {
+      std::unique_lock<std::mutex> lock(prefetch_mutex_);
+      prefetch_cv_.wait(
+          lock, [this] { return stop_prefetch_ || !prefetch_queue_.empty(); });
+      if (stop_prefetch_) {
+        return;
+      }
+      range = prefetch_queue_.front();
+      prefetch_queue_.pop_front();
+    }
+    // starts the read ahead of the kernel, the hint is harmless if the file was closed
+    // since it was queued
+    ::posix_fadvise(range.fd, range.offset, range.size, POSIX_FADV_WILLNEED);
+  }
+}
+
+}  // namespace File_Namespace
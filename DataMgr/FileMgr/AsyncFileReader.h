@@ -0,0 +1,78 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    AsyncFileReader.h
+ * @brief   Batched positional reads of the FileMgr data files.
+ *
+ * The reads of a batch are submitted to io_uring when the server is built with
+ * ENABLE_IO_URING and the kernel supports it, and are otherwise split over reader
+ * threads issuing pread calls. Either way the reads do not go through the FILE stream of
+ * the file, so they do not serialize on the lock of its FileInfo.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace File_Namespace {
+
+struct FileReadRequest {
+  int fd;
+  size_t offset;
+  size_t size;
+  int8_t* dst;  // unused by prefetches
+};
+
+class AsyncFileReader {
+ public:
+  static AsyncFileReader& instance();
+
+  ~AsyncFileReader();
+
+  /**
+   * @brief Reads all the requests and returns once they completed. The thread fallback
+   * uses at most `max_threads` threads.
+   */
+  void read(const std::vector<FileReadRequest>& requests, const size_t max_threads);
+
+  /**
+   * @brief Queues the file ranges to be read ahead into the page cache of the OS and
+   * returns without waiting for them. Hints are dropped while the queue is full.
+   */
+  void prefetch(const std::vector<FileReadRequest>& ranges);
+
+ private:
+  AsyncFileReader();
+
+  void prefetchLoop();
+
+  static constexpr size_t kMaxQueuedPrefetches{4096};
+
+  std::mutex prefetch_mutex_;
+  std::condition_variable prefetch_cv_;
+  std::deque<FileReadRequest> prefetch_queue_;
+  bool stop_prefetch_{false};
+  std::thread prefetch_thread_;
+};
+
+}  // namespace File_Namespace
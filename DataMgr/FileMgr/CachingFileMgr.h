@@ -282,6 +282,9 @@ class CachingFileMgr : public FileMgr {
    **/
   inline bool failOnReadError() const override { return false; }
 
+  // The cache evicts and rewrites its pages, so they are never mapped.
+  inline bool mapsDataFiles() const override { return false; }
+
   /**
    * @brief deletes a buffer if it exists in the mgr.  Otherwise do nothing.
    **/
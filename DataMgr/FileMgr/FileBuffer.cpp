@@ -22,12 +22,15 @@
 
 #include "DataMgr/FileMgr/FileBuffer.h"
 
+#include <fstream>
 #include <future>
 #include <map>
 #include <thread>
 #include <utility>  // std::pair
 
+#include "DataMgr/FileMgr/AsyncFileReader.h"
 #include "DataMgr/FileMgr/FileMgr.h"
+#include "DataMgr/ZoneMap.h"
 #include "Shared/File.h"
 #include "Shared/checked_alloc.h"
 
@@ -182,11 +185,14 @@ size_t FileBuffer::freeChunkPages() {
       freePage(pageIt->page, false /* isRolloff */);
     }
   }
+  std::lock_guard<std::mutex> lock(multiPagesMutex_);
   multiPages_.clear();
   return num_pages_freed;
 }
 
 size_t FileBuffer::freePages() {
+  boost::system::error_code ec;
+  boost::filesystem::remove(getBloomFilterPath(), ec);
   return freeMetadataPages() + freeChunkPages();
 }
 
@@ -228,58 +234,6 @@ void FileBuffer::freePagesBeforeEpoch(const int32_t targetEpoch) {
   }
 }
 
-struct readThreadDS {
-  FileMgr* t_fm;       // ptr to FileMgr
-  size_t t_startPage;  // start page for the thread
-  size_t t_endPage;    // last page for the thread
-  int8_t* t_curPtr;    // pointer to the current location of the target for the thread
-  size_t t_bytesLeft;  // number of bytes to be read in the thread
-  size_t t_startPageOffset;  // offset - used for the first page of the buffer
-  bool t_isFirstPage;        // true - for first page of the buffer, false - otherwise
-  std::vector<MultiPage> multiPages;  // MultiPages of the FileBuffer passed to the thread
-};
-
-static size_t readForThread(FileBuffer* fileBuffer, const readThreadDS threadDS) {
-  size_t startPage = threadDS.t_startPage;  // start reading at startPage, including it
-  size_t endPage = threadDS.t_endPage;      // stop reading at endPage, not including it
-  int8_t* curPtr = threadDS.t_curPtr;
-  size_t bytesLeft = threadDS.t_bytesLeft;
-  size_t totalBytesRead = 0;
-  bool isFirstPage = threadDS.t_isFirstPage;
-
-  // Traverse the logical pages
-  for (size_t pageNum = startPage; pageNum < endPage; ++pageNum) {
-    CHECK(threadDS.multiPages[pageNum].pageSize == fileBuffer->pageSize());
-    Page page = threadDS.multiPages[pageNum].current().page;
-
-    FileInfo* fileInfo = threadDS.t_fm->getFileInfoForFileId(page.fileId);
-    CHECK(fileInfo);
-
-    // Read the page into the destination (dst) buffer at its
-    // current (cur) location
-    size_t bytesRead = 0;
-    if (isFirstPage) {
-      bytesRead = fileInfo->read(
-          page.pageNum * fileBuffer->pageSize() + threadDS.t_startPageOffset +
-              fileBuffer->reservedHeaderSize(),
-          min(fileBuffer->pageDataSize() - threadDS.t_startPageOffset, bytesLeft),
-          curPtr);
-      isFirstPage = false;
-    } else {
-      bytesRead = fileInfo->read(
-          page.pageNum * fileBuffer->pageSize() + fileBuffer->reservedHeaderSize(),
-          min(fileBuffer->pageDataSize(), bytesLeft),
-          curPtr);
-    }
-    curPtr += bytesRead;
-    bytesLeft -= bytesRead;
-    totalBytesRead += bytesRead;
-  }
-  CHECK(bytesLeft == 0);
-
-  return (totalBytesRead);
-}
-
 void FileBuffer::read(int8_t* const dst,
                       const size_t numBytes,
                       const size_t offset,
@@ -288,99 +242,265 @@ void FileBuffer::read(int8_t* const dst,
   if (dstBufferType != CPU_LEVEL) {
     LOG(FATAL) << "Unsupported Buffer type";
   }
+  if (isPageCompressed()) {
+    readCompressed(dst, numBytes, offset);
+    return;
+  }
+  readPages(dst, numBytes, offset);
+}
 
-  // variable declarations
+void FileBuffer::readPages(int8_t* const dst,
+                           const size_t numBytes,
+                           const size_t offset) {
   size_t startPage = offset / pageDataSize_;
   size_t startPageOffset = offset % pageDataSize_;
   size_t numPagesToRead =
       (numBytes + startPageOffset + pageDataSize_ - 1) / pageDataSize_;
-  /*
-  if (startPage + numPagesToRead > multiPages_.size()) {
-      cout << "Start page: " << startPage << endl;
-      cout << "Num pages to read: " << numPagesToRead << endl;
-      cout << "Num multipages: " << multiPages_.size() << endl;
-      cout << "Offset: " << offset << endl;
-      cout << "Num bytes: " << numBytes << endl;
+  CHECK(startPage + numPagesToRead <= multiPages_.size());
+
+  if (fm_->mapsDataFiles()) {
+    int8_t* curPtr = dst;
+    size_t bytesLeft = numBytes;
+    for (size_t pageNum = startPage; pageNum < startPage + numPagesToRead; ++pageNum) {
+      Page page = multiPages_[pageNum].current().page;
+      FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+      CHECK(fileInfo);
+      const size_t pageOffset = pageNum == startPage ? startPageOffset : 0;
+      const size_t bytesToRead = min(pageDataSize_ - pageOffset, bytesLeft);
+      memcpy(curPtr,
+             fileInfo->getMapping() + page.pageNum * pageSize_ + reservedHeaderSize_ +
+                 pageOffset,
+             bytesToRead);
+      curPtr += bytesToRead;
+      bytesLeft -= bytesToRead;
+    }
+    CHECK(bytesLeft == 0);
+    return;
   }
-  */
 
-  CHECK(startPage + numPagesToRead <= multiPages_.size());
+  // read all the pages in one batch
+  std::vector<FileReadRequest> requests;
+  requests.reserve(numPagesToRead);
+  int8_t* curPtr = dst;
+  size_t bytesLeft = numBytes;
+  for (size_t pageNum = startPage; pageNum < startPage + numPagesToRead; ++pageNum) {
+    CHECK(multiPages_[pageNum].pageSize == pageSize_);
+    Page page = multiPages_[pageNum].current().page;
+    FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+    CHECK(fileInfo);
+    const size_t pageOffset = pageNum == startPage ? startPageOffset : 0;
+    const size_t bytesToRead = min(pageDataSize_ - pageOffset, bytesLeft);
+    requests.push_back({fileInfo->getReadDescriptor(),
+                        page.pageNum * pageSize_ + reservedHeaderSize_ + pageOffset,
+                        bytesToRead,
+                        curPtr});
+    curPtr += bytesToRead;
+    bytesLeft -= bytesToRead;
+  }
+  CHECK(bytesLeft == 0);
+  AsyncFileReader::instance().read(requests, fm_->getNumReaderThreads());
+}
+
+int8_t* FileBuffer::getMappedData() {
+  if (!fm_->mapsDataFiles() || isPageCompressed() || size_ == 0 ||
+      size_ > pageDataSize_ || multiPages_.empty()) {
+    return nullptr;
+  }
+  Page page = multiPages_[0].current().page;
+  FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+  CHECK(fileInfo);
+  return fileInfo->getMapping() + page.pageNum * pageSize_ + reservedHeaderSize_;
+}
+
+void FileBuffer::prefetch() {
+  // copy the current pages, the writes to the chunk may add pages meanwhile
+  std::vector<Page> pages;
+  {
+    std::lock_guard<std::mutex> lock(multiPagesMutex_);
+    const auto numPages = (storedSize() + pageDataSize_ - 1) / pageDataSize_;
+    pages.reserve(std::min(numPages, multiPages_.size()));
+    for (size_t pageNum = 0; pageNum < std::min(numPages, multiPages_.size());
+         ++pageNum) {
+      pages.push_back(multiPages_[pageNum].current().page);
+    }
+  }
+  // the pages of a chunk are mostly consecutive in their files, hint contiguous ranges
+  std::vector<FileReadRequest> ranges;
+  for (const auto& page : pages) {
+    FileInfo* fileInfo = fm_->getFileInfoForFileId(page.fileId);
+    CHECK(fileInfo);
+    const auto fd = fileInfo->getReadDescriptor();
+    const size_t pageOffset = page.pageNum * pageSize_;
+    if (!ranges.empty() && ranges.back().fd == fd &&
+        ranges.back().offset + ranges.back().size == pageOffset) {
+      ranges.back().size += pageSize_;
+    } else {
+      ranges.push_back({fd, pageOffset, pageSize_, nullptr});
+    }
+  }
+  AsyncFileReader::instance().prefetch(ranges);
+}
+
+void FileBuffer::setPageCompression(const PageCompression page_compression) {
+  CHECK_EQ(size_, size_t(0)) << "Cannot change the page compression of the chunk "
+                             << show_chunk(chunkKey_) << " once written";
+  page_compression_ = page_compression;
+  compressed_size_ = 0;
+  frames_.clear();
+  frames_loaded_ = true;
+}
+
+void FileBuffer::loadFrames() {
+  std::lock_guard<std::mutex> lock(frames_mutex_);
+  if (frames_loaded_) {
+    return;
+  }
+  frames_.clear();
+  for (size_t offset = 0; offset < compressed_size_;) {
+    uint32_t header[2];
+    readPages(reinterpret_cast<int8_t*>(header), kFrameHeaderSize, offset);
+    CompressedFrame frame{offset, header[0], header[1]};
+    CHECK(frame.size > 0 && frame.size <= pageDataSize_ &&
+          frame.compressed_size <= frame.size &&
+          offset + kFrameHeaderSize + frame.compressed_size <= compressed_size_)
+        << "Corrupted compressed page in chunk " << show_chunk(chunkKey_);
+    frames_.push_back(frame);
+    offset += kFrameHeaderSize + frame.compressed_size;
+  }
+  frames_loaded_ = true;
+}
 
-  size_t numPagesPerThread = 0;
-  size_t numBytesCurrent = numBytes;  // total number of bytes still to be read
-  size_t bytesRead = 0;               // total number of bytes already being read
-  size_t bytesLeftForThread = 0;      // number of bytes to be read in the thread
-  size_t numExtraPages = 0;  // extra pages to be assigned one per thread as needed
-  size_t numThreads = fm_->getNumReaderThreads();
-  std::vector<readThreadDS>
-      threadDSArr;  // array of threadDS, needed to avoid racing conditions
-
-  if (numPagesToRead > numThreads) {
-    numPagesPerThread = numPagesToRead / numThreads;
-    numExtraPages = numPagesToRead - (numThreads * numPagesPerThread);
-  } else {
-    numThreads = numPagesToRead;
-    numPagesPerThread = 1;
-  }
-
-  /* set threadDS for the first thread */
-  readThreadDS threadDS;
-  threadDS.t_fm = fm_;
-  threadDS.t_startPage = offset / pageDataSize_;
-  if (numExtraPages > 0) {
-    threadDS.t_endPage = threadDS.t_startPage + numPagesPerThread + 1;
-    numExtraPages--;
-  } else {
-    threadDS.t_endPage = threadDS.t_startPage + numPagesPerThread;
-  }
-  threadDS.t_curPtr = dst;
-  threadDS.t_startPageOffset = offset % pageDataSize_;
-  threadDS.t_isFirstPage = true;
-
-  bytesLeftForThread = min(((threadDS.t_endPage - threadDS.t_startPage) * pageDataSize_ -
-                            threadDS.t_startPageOffset),
-                           numBytesCurrent);
-  threadDS.t_bytesLeft = bytesLeftForThread;
-  threadDS.multiPages = getMultiPage();
-
-  if (numThreads == 1) {
-    bytesRead += readForThread(this, threadDS);
-  } else {
-    std::vector<std::future<size_t>> threads;
-
-    for (size_t i = 0; i < numThreads; i++) {
-      threadDSArr.push_back(threadDS);
-      threads.push_back(
-          std::async(std::launch::async, readForThread, this, threadDSArr[i]));
-
-      // calculate elements of threadDS
-      threadDS.t_fm = fm_;
-      threadDS.t_isFirstPage = false;
-      threadDS.t_curPtr += bytesLeftForThread;
-      threadDS.t_startPage +=
-          threadDS.t_endPage -
-          threadDS.t_startPage;  // based on # of pages read on previous iteration
-      if (numExtraPages > 0) {
-        threadDS.t_endPage = threadDS.t_startPage + numPagesPerThread + 1;
-        numExtraPages--;
+void FileBuffer::readCompressed(int8_t* const dst,
+                                const size_t numBytes,
+                                const size_t offset) {
+  if (numBytes == 0) {
+    return;
+  }
+  loadFrames();
+  const size_t first_frame = offset / pageDataSize_;
+  const size_t end_frame = (offset + numBytes - 1) / pageDataSize_ + 1;
+  CHECK_LE(end_frame, frames_.size());
+  const auto stored_begin = frames_[first_frame].offset;
+  const auto& last_frame = frames_[end_frame - 1];
+  const auto stored_end =
+      last_frame.offset + kFrameHeaderSize + last_frame.compressed_size;
+  std::vector<int8_t> stored(stored_end - stored_begin);
+  readPages(stored.data(), stored.size(), stored_begin);
+
+  auto decompress_frames = [&](const size_t begin, const size_t end) {
+    std::vector<int8_t> decompressed;
+    for (size_t frame_idx = begin; frame_idx < end; ++frame_idx) {
+      const auto& frame = frames_[frame_idx];
+      const auto frame_begin = frame_idx * pageDataSize_;
+      const auto copy_begin = std::max(frame_begin, offset);
+      const auto copy_end = std::min(frame_begin + frame.size, offset + numBytes);
+      CHECK_LT(copy_begin, copy_end);
+      const auto data = stored.data() + frame.offset - stored_begin + kFrameHeaderSize;
+      if (frame.compressed_size == frame.size) {
+        memcpy(dst + copy_begin - offset,
+               data + copy_begin - frame_begin,
+               copy_end - copy_begin);
+      } else if (copy_end - copy_begin == frame.size) {
+        decompress_page(
+            data, frame.compressed_size, dst + copy_begin - offset, frame.size);
       } else {
-        threadDS.t_endPage = threadDS.t_startPage + numPagesPerThread;
+        // the first or last frame of the range is only partially read
+        decompressed.resize(frame.size);
+        decompress_page(data, frame.compressed_size, decompressed.data(), frame.size);
+        memcpy(dst + copy_begin - offset,
+               decompressed.data() + copy_begin - frame_begin,
+               copy_end - copy_begin);
       }
-      numBytesCurrent -= bytesLeftForThread;
-      bytesLeftForThread = min(
-          ((threadDS.t_endPage - threadDS.t_startPage) * pageDataSize_), numBytesCurrent);
-      threadDS.t_bytesLeft = bytesLeftForThread;
-      threadDS.multiPages = getMultiPage();
     }
+  };
 
-    for (auto& p : threads) {
-      p.wait();
-    }
-    for (auto& p : threads) {
-      bytesRead += p.get();
+  const size_t num_frames = end_frame - first_frame;
+  const size_t num_threads = std::min(fm_->getNumReaderThreads(), num_frames);
+  if (num_threads <= 1) {
+    decompress_frames(first_frame, end_frame);
+    return;
+  }
+  const size_t frames_per_thread = (num_frames + num_threads - 1) / num_threads;
+  std::vector<std::future<void>> threads;
+  for (size_t begin = first_frame; begin < end_frame; begin += frames_per_thread) {
+    threads.push_back(std::async(std::launch::async,
+                                 decompress_frames,
+                                 begin,
+                                 std::min(begin + frames_per_thread, end_frame)));
+  }
+  for (auto& p : threads) {
+    p.wait();
+  }
+  for (auto& p : threads) {
+    p.get();
+  }
+}
+
+void FileBuffer::writeCompressed(int8_t* src,
+                                 const size_t numBytes,
+                                 const size_t offset) {
+  loadFrames();
+  // the frames after a size reduced by setSize are dropped as well
+  const auto kept_end = std::min(offset, size_);
+  const size_t first_frame = kept_end / pageDataSize_;
+  const auto data_begin = first_frame * pageDataSize_;
+  // a gap between the end of the chunk and the offset is filled with zeros
+  std::vector<int8_t> data(std::max(size_, offset + numBytes) - data_begin);
+  if (kept_end > data_begin) {
+    readCompressed(data.data(), kept_end - data_begin, data_begin);
+  }
+  if (offset + numBytes < size_) {
+    readCompressed(data.data() + offset + numBytes - data_begin,
+                   size_ - offset - numBytes,
+                   offset + numBytes);
+  }
+  if (numBytes > 0) {
+    memcpy(data.data() + offset - data_begin, src, numBytes);
+  }
+  rewriteFrames(first_frame, data.data(), data.size());
+}
+
+void FileBuffer::rewriteFrames(const size_t first_frame,
+                               const int8_t* src,
+                               const size_t numBytes) {
+  CHECK_LE(first_frame, frames_.size());
+  const auto stored_offset =
+      first_frame < frames_.size() ? frames_[first_frame].offset : compressed_size_;
+  frames_.resize(first_frame);
+  const auto type_size = getCompressionTypeSize();
+  std::vector<int8_t> stored;
+  for (size_t pos = 0; pos < numBytes; pos += pageDataSize_) {
+    CompressedFrame frame{stored_offset + stored.size(),
+                          static_cast<uint32_t>(std::min(pageDataSize_, numBytes - pos)),
+                          0};
+    stored.resize(stored.size() + kFrameHeaderSize + frame.size);
+    auto data = stored.data() + stored.size() - frame.size;
+    // only keep the compressed bytes if they are smaller
+    frame.compressed_size = compress_page(
+        page_compression_, src + pos, frame.size, type_size, data, frame.size - 1);
+    if (!frame.compressed_size) {
+      memcpy(data, src + pos, frame.size);
+      frame.compressed_size = frame.size;
     }
+    stored.resize(stored.size() - frame.size + frame.compressed_size);
+    const uint32_t header[2]{frame.size, frame.compressed_size};
+    memcpy(stored.data() + frame.offset - stored_offset, header, kFrameHeaderSize);
+    frames_.push_back(frame);
   }
-  CHECK(bytesRead == numBytes);
+  if (!stored.empty()) {
+    writePages(stored.data(), stored.size(), stored_offset, false);
+  }
+  compressed_size_ = stored_offset + stored.size();
+  size_ = first_frame * pageDataSize_ + numBytes;
+}
+
+size_t FileBuffer::getCompressionTypeSize() const {
+  // shuffle the bytes of fixed length values, so that their high bytes compress together
+  if (hasEncoder() && !encoder_->isCompressedInStorage() && !sql_type_.is_varlen() &&
+      !sql_type_.is_array() && sql_type_.get_size() > 0) {
+    return sql_type_.get_size();
+  }
+  return 1;
 }
 
 void FileBuffer::copyPage(Page& srcPage,
@@ -407,6 +527,7 @@ Page FileBuffer::addNewMultiPage(const int32_t epoch) {
   Page page = fm_->requestFreePage(pageSize_, false);
   MultiPage multiPage(pageSize_);
   multiPage.push(page, epoch);
+  std::lock_guard<std::mutex> lock(multiPagesMutex_);
   multiPages_.emplace_back(multiPage);
   return page;
 }
@@ -440,7 +561,17 @@ void FileBuffer::readMetadata(const Page& page) {
                       // encodingType, encodingBits all as int
   fread((int8_t*)&(typeData[0]), sizeof(int32_t), typeData.size(), f);
   int32_t version = typeData[0];
-  CHECK(version == METADATA_VERSION);  // add backward compatibility code here
+  CHECK(version >= METADATA_VERSION_NO_ZONE_MAPS && version <= METADATA_VERSION);
+  page_compression_ = PageCompression::kNone;
+  compressed_size_ = 0;
+  if (version >= METADATA_VERSION) {
+    int32_t page_compression{0};
+    fread((int8_t*)&page_compression, sizeof(int32_t), 1, f);
+    fread((int8_t*)&compressed_size_, sizeof(size_t), 1, f);
+    page_compression_ = static_cast<PageCompression>(page_compression);
+  }
+  frames_.clear();
+  frames_loaded_ = !isPageCompressed();
   bool has_encoder = static_cast<bool>(typeData[1]);
   if (has_encoder) {
     sql_type_.set_type(static_cast<SQLTypes>(typeData[2]));
@@ -453,6 +584,14 @@ void FileBuffer::readMetadata(const Page& page) {
     sql_type_.set_size(typeData[9]);
     initEncoder(sql_type_);
     encoder_->readMetadata(f);
+    if (version >= METADATA_VERSION_ZONE_MAPS) {
+      encoder_->readZoneMaps(f);
+    }
+    if (version >= METADATA_VERSION_BLOOM_FILTER) {
+      uint64_t bloom_filter_checksum{0};
+      fread((int8_t*)&bloom_filter_checksum, sizeof(uint64_t), 1, f);
+      encoder_->setBloomFilter(readBloomFilter(bloom_filter_checksum));
+    }
   }
 }
 
@@ -468,7 +607,13 @@ void FileBuffer::writeMetadata(const int32_t epoch) {
   vector<int32_t> typeData(
       NUM_METADATA);  // assumes we will encode hasEncoder, bufferType,
                       // encodingType, encodingBits all as int32_t
-  typeData[0] = METADATA_VERSION;
+  // keep writing the previous versions while zone maps, Bloom filters and page
+  // compression are not used, so that the data files remain readable by older servers
+  const auto bloom_filter = hasEncoder() ? encoder_->getBloomFilter() : nullptr;
+  typeData[0] = isPageCompressed()   ? METADATA_VERSION
+                : bloom_filter       ? METADATA_VERSION_BLOOM_FILTER
+                : g_enable_zone_maps ? METADATA_VERSION_ZONE_MAPS
+                                     : METADATA_VERSION_NO_ZONE_MAPS;
   typeData[1] = static_cast<int32_t>(hasEncoder());
   if (hasEncoder()) {
     typeData[2] = static_cast<int32_t>(sql_type_.get_type());
@@ -481,17 +626,81 @@ void FileBuffer::writeMetadata(const int32_t epoch) {
     typeData[9] = sql_type_.get_size();
   }
   fwrite((int8_t*)&(typeData[0]), sizeof(int32_t), typeData.size(), f);
+  if (typeData[0] >= METADATA_VERSION) {
+    const auto page_compression = static_cast<int32_t>(page_compression_);
+    fwrite((int8_t*)&page_compression, sizeof(int32_t), 1, f);
+    fwrite((int8_t*)&compressed_size_, sizeof(size_t), 1, f);
+  }
   if (hasEncoder()) {  // redundant
     encoder_->writeMetadata(f);
+    if (typeData[0] >= METADATA_VERSION_ZONE_MAPS) {
+      encoder_->writeZoneMaps(f);
+    }
+    if (typeData[0] >= METADATA_VERSION_BLOOM_FILTER) {
+      const auto bloom_filter_checksum =
+          bloom_filter ? writeBloomFilter(*bloom_filter) : uint64_t(0);
+      fwrite((int8_t*)&bloom_filter_checksum, sizeof(uint64_t), 1, f);
+    }
   }
   metadataPages_.push(page, epoch);
 }
 
+std::string FileBuffer::getBloomFilterPath() const {
+  std::string file_name{"bloom_filter"};
+  for (const auto key_component : chunkKey_) {
+    file_name += "_" + std::to_string(key_component);
+  }
+  return fm_->getFilePath(file_name).string();
+}
+
+uint64_t FileBuffer::writeBloomFilter(const BloomFilter& bloom_filter) const {
+  // the metadata of older epochs may still point to the previous file, which is then
+  // rejected by its checksum, write to a temporary file to never leave a partial one
+  const auto path = getBloomFilterPath();
+  const auto tmp_path = path + ".tmp";
+  const auto checksum = bloom_filter.getChecksum();
+  {
+    std::ofstream bloom_filter_file(tmp_path, std::ios::binary | std::ios::trunc);
+    bloom_filter.write(bloom_filter_file);
+    if (!bloom_filter_file) {
+      LOG(WARNING) << "Failed to write the Bloom filter file " << tmp_path;
+      return 0;
+    }
+  }
+  boost::system::error_code ec;
+  boost::filesystem::rename(tmp_path, path, ec);
+  if (ec) {
+    LOG(WARNING) << "Failed to write the Bloom filter file " << path << ": "
+                 << ec.message();
+    return 0;
+  }
+  return checksum;
+}
+
+std::shared_ptr<BloomFilter> FileBuffer::readBloomFilter(const uint64_t checksum) const {
+  if (!checksum) {
+    return nullptr;
+  }
+  const auto path = getBloomFilterPath();
+  std::ifstream bloom_filter_file(path, std::ios::binary);
+  auto bloom_filter = BloomFilter::read(bloom_filter_file);
+  if (!bloom_filter || bloom_filter->getChecksum() != checksum) {
+    // the chunk is still readable, only fragment skipping for its column is lost
+    LOG(WARNING) << "Ignoring the missing or outdated Bloom filter file " << path;
+    return nullptr;
+  }
+  return bloom_filter;
+}
+
 void FileBuffer::append(int8_t* src,
                         const size_t numBytes,
                         const MemoryLevel srcBufferType,
                         const int32_t deviceId) {
   setAppended();
+  if (isPageCompressed()) {
+    writeCompressed(src, numBytes, size_);
+    return;
+  }
 
   size_t startPage = size_ / pageDataSize_;
   size_t startPageOffset = size_ % pageDataSize_;
@@ -547,9 +756,21 @@ void FileBuffer::write(int8_t* src,
     tempIsAppended = true;  // because is_appended_ could have already been true - to
                             // avoid rewriting header
     setAppended();
-    size_ = offset + numBytes;
+    if (!isPageCompressed()) {
+      size_ = offset + numBytes;
+    }
+  }
+  if (isPageCompressed()) {
+    writeCompressed(src, numBytes, offset);
+    return;
   }
+  writePages(src, numBytes, offset, tempIsAppended);
+}
 
+void FileBuffer::writePages(int8_t* src,
+                            const size_t numBytes,
+                            const size_t offset,
+                            const bool writeSizeHeader) {
   size_t startPage = offset / pageDataSize_;
   size_t startPageOffset = offset % pageDataSize_;
   size_t numPagesToWrite =
@@ -577,7 +798,10 @@ void FileBuffer::write(int8_t* src,
                          // last page
       Page lastPage = multiPages_[pageNum].current().page;
       page = fm_->requestFreePage(pageSize_, false);
-      multiPages_[pageNum].push(page, epoch);
+      {
+        std::lock_guard<std::mutex> lock(multiPagesMutex_);
+        multiPages_[pageNum].push(page, epoch);
+      }
       if (pageNum == startPage && startPageOffset > 0) {
         // copyPage takes care of header offset so don't worry
         // about it
@@ -612,7 +836,7 @@ void FileBuffer::write(int8_t* src,
     }
     curPtr += bytesWritten;
     bytesLeft -= bytesWritten;
-    if (tempIsAppended && pageNum == startPage + numPagesToWrite - 1) {  // if last page
+    if (writeSizeHeader && pageNum == startPage + numPagesToWrite - 1) {  // if last page
       //@todo below can lead to undefined - we're overwriting num
       // bytes valid at checkpoint
       writeHeader(page, 0, multiPages_[0].current().epoch, true);
@@ -631,6 +855,10 @@ std::string FileBuffer::dump() const {
   ss << "chunk_key = " << show_chunk(chunkKey_) << "\n";
   ss << "has_encoder = " << (hasEncoder() ? "true\n" : "false\n");
   ss << "size_ = " << size_ << "\n";
+  if (isPageCompressed()) {
+    ss << "page_compression = " << to_string(page_compression_) << "\n";
+    ss << "compressed_size_ = " << compressed_size_ << "\n";
+  }
   return ss.str();
 }
 
@@ -643,7 +871,10 @@ void FileBuffer::initMetadataAndPageDataSize() {
 bool FileBuffer::isMissingPages() const {
   // Detect the case where a page is missing by comparing the amount of pages read
   // with the metadata size.
-  return ((size() + pageDataSize_ - 1) / pageDataSize_ != multiPages_.size());
+  const auto num_pages = (storedSize() + pageDataSize_ - 1) / pageDataSize_;
+  // rewriting the last frames of a compressed buffer may leave unused pages behind
+  return isPageCompressed() ? num_pages > multiPages_.size()
+                            : num_pages != multiPages_.size();
 }
 
 size_t FileBuffer::numChunkPages() const {
@@ -24,8 +24,10 @@
 
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/FileMgr/Page.h"
+#include "DataMgr/FileMgr/PageCompression.h"
 
 #include <iostream>
+#include <mutex>
 #include <stdexcept>
 
 #include "Logger/Logger.h"
@@ -33,7 +35,13 @@
 using namespace Data_Namespace;
 
 #define NUM_METADATA 10
-#define METADATA_VERSION 0
+// version 1 adds the zone maps of the chunk after the encoder metadata, version 2 adds
+// the checksum of the Bloom filter of the chunk, which is stored in a separate file,
+// version 3 adds the page compression codec and the compressed size of the chunk
+#define METADATA_VERSION 3
+#define METADATA_VERSION_BLOOM_FILTER 2
+#define METADATA_VERSION_ZONE_MAPS 1
+#define METADATA_VERSION_NO_ZONE_MAPS 0
 #define METADATA_PAGE_SIZE 4096
 
 namespace File_Namespace {
@@ -156,6 +164,27 @@ class FileBuffer : public AbstractBuffer {
 
   inline size_t numMetadataPages() const { return metadataPages_.pageVersions.size(); };
 
+  /// Compresses the pages of the buffer with the given codec, the buffer must be empty.
+  void setPageCompression(const PageCompression page_compression);
+  inline PageCompression getPageCompression() const { return page_compression_; }
+  inline bool isPageCompressed() const {
+    return page_compression_ != PageCompression::kNone;
+  }
+
+  /// Returns the number of bytes held by the pages, less than size() once compressed.
+  inline size_t storedSize() const {
+    return isPageCompressed() ? compressed_size_ : size_;
+  }
+
+  /// Starts reading the pages of the buffer into the page cache of the OS, without
+  /// waiting for them.
+  void prefetch();
+
+  /// Returns the data of the buffer in its memory mapped data file, or nullptr if the
+  /// data files are not mapped or the data is not stored contiguously, as only the data
+  /// of uncompressed buffers held by a single page is.
+  int8_t* getMappedData();
+
   bool isMissingPages() const;
   size_t numChunkPages() const;
   std::string dump() const;
@@ -179,6 +208,27 @@ class FileBuffer : public AbstractBuffer {
                    const bool writeMetadata = false);
   void writeMetadata(const int32_t epoch);
   void readMetadata(const Page& page);
+
+  // read and write the bytes stored in the pages, the data of compressed buffers is a
+  // sequence of frames, see CompressedFrame
+  void readPages(int8_t* const dst, const size_t numBytes, const size_t offset);
+  void writePages(int8_t* src,
+                  const size_t numBytes,
+                  const size_t offset,
+                  const bool writeSizeHeader);
+
+  void loadFrames();
+  void readCompressed(int8_t* const dst, const size_t numBytes, const size_t offset);
+  void writeCompressed(int8_t* src, const size_t numBytes, const size_t offset);
+  // replaces the frames from first_frame on with the given data
+  void rewriteFrames(const size_t first_frame, const int8_t* src, const size_t numBytes);
+  size_t getCompressionTypeSize() const;
+
+  std::string getBloomFilterPath() const;
+  // returns the checksum of the written filter, 0 if it couldn't be written
+  uint64_t writeBloomFilter(const BloomFilter& bloom_filter) const;
+  // returns nullptr if the file does not hold the filter with the given checksum
+  std::shared_ptr<BloomFilter> readBloomFilter(const uint64_t checksum) const;
   void calcHeaderBuffer();
 
   void freePage(const Page& page, const bool isRolloff);
@@ -192,10 +242,33 @@ class FileBuffer : public AbstractBuffer {
                  // files
   MultiPage metadataPages_;
   std::vector<MultiPage> multiPages_;
+  // guards the changes to the page list made by writes against prefetch(), which may run
+  // concurrently with them
+  std::mutex multiPagesMutex_;
   size_t pageSize_;
   size_t pageDataSize_;
   size_t reservedHeaderSize_;  // lets make this a constant now for simplicity - 128 bytes
   ChunkKey chunkKey_;
+
+  /**
+   * Every frame holds pageDataSize_ bytes of the chunk, but the last one which may hold
+   * less, and is stored in the pages as a header of its size and compressed size
+   * followed by its compressed bytes. The bytes are stored as they are if they do not
+   * compress, with a compressed size equal to the size.
+   */
+  struct CompressedFrame {
+    size_t offset;  // of the header of the frame in the stored bytes
+    uint32_t size;
+    uint32_t compressed_size;
+  };
+  static constexpr size_t kFrameHeaderSize{2 * sizeof(uint32_t)};
+
+  PageCompression page_compression_{PageCompression::kNone};
+  size_t compressed_size_{0};
+  // loaded from the frame headers on the first access after reading the metadata
+  std::vector<CompressedFrame> frames_;
+  bool frames_loaded_{true};
+  std::mutex frames_mutex_;
 };
 
 }  // namespace File_Namespace
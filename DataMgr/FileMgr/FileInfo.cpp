@@ -38,6 +38,9 @@ FileInfo::FileInfo(FileMgr* fileMgr,
 }
 
 FileInfo::~FileInfo() {
+  if (mapping_) {
+    omnisci::checked_munmap(mapping_, size());
+  }
   // close file, if applicable
   if (f) {
     close(f);
@@ -60,6 +63,7 @@ void FileInfo::initNewFile() {
 size_t FileInfo::write(const size_t offset, const size_t size, const int8_t* buf) {
   std::lock_guard<std::mutex> lock(readWriteMutex_);
   isDirty = true;
+  hasUnflushedWrites_ = true;
   return File_Namespace::write(f, offset, size, buf);
 }
 
@@ -68,6 +72,27 @@ size_t FileInfo::read(const size_t offset, const size_t size, int8_t* buf) {
   return File_Namespace::read(f, offset, size, buf);
 }
 
+int FileInfo::getReadDescriptor() {
+  std::lock_guard<std::mutex> lock(readWriteMutex_);
+  if (hasUnflushedWrites_) {
+    if (fflush(f) != 0) {
+      LOG(FATAL) << "Error trying to flush changes to disk, the error was: "
+                 << std::strerror(errno);
+    }
+    hasUnflushedWrites_ = false;
+  }
+  return fileno(f);
+}
+
+int8_t* FileInfo::getMapping() {
+  std::lock_guard<std::mutex> lock(readWriteMutex_);
+  if (!mapping_) {
+    mapping_ =
+        reinterpret_cast<int8_t*>(omnisci::checked_mmap_private(fileno(f), size()));
+  }
+  return mapping_;
+}
+
 void FileInfo::openExistingFile(std::vector<HeaderInfo>& headerVec) {
   // HeaderInfo is defined in Page.h
 
@@ -223,6 +248,7 @@ int32_t FileInfo::syncToDisk() {
       LOG(FATAL) << "Error trying to flush changes to disk, the error was: "
                  << std::strerror(errno);
     }
+    hasUnflushedWrites_ = false;
 #ifdef __APPLE__
     const int32_t sync_result = fcntl(fileno(f), 51);
 #else
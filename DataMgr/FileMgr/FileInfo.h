@@ -30,6 +30,7 @@
 #include "OSDependent/omnisci_fs.h"
 #include "Page.h"
 extern bool g_read_only;
+extern bool g_enable_mmap_reads;
 namespace File_Namespace {
 
 struct Page;
@@ -59,9 +60,11 @@ struct FileInfo {
   size_t pageSize;             /// the fixed size of each page in the file
   size_t numPages;             /// the number of pages in the file
   bool isDirty{false};         // True if writes have occured since last sync
+  bool hasUnflushedWrites_{false};  // True if the stream may buffer written bytes
   std::set<size_t> freePages;  /// set of page numbers of free pages
   std::mutex freePagesMutex_;
   std::mutex readWriteMutex_;
+  int8_t* mapping_{nullptr};
 
   /// Constructor
   FileInfo(FileMgr* fileMgr,
@@ -84,6 +87,15 @@ struct FileInfo {
   size_t write(const size_t offset, const size_t size, const int8_t* buf);
   size_t read(const size_t offset, const size_t size, int8_t* buf);
 
+  /// Returns the descriptor of the file for positional reads, which bypass the stream
+  /// and its lock, after flushing the bytes buffered by the stream
+  int getReadDescriptor();
+
+  /// Returns the file memory mapped copy-on-write, mapping it on the first call. Later
+  /// writes to the file are not guaranteed to be visible, so only read-only servers map
+  /// their files.
+  int8_t* getMapping();
+
   void openExistingFile(std::vector<HeaderInfo>& headerVec);
   /// Prints a summary of the file to stdout
   void print(bool pagesummary);
@@ -42,6 +42,8 @@
 
 using namespace std;
 
+bool g_enable_mmap_reads{false};
+
 namespace File_Namespace {
 
 FileMgr::FileMgr(const int32_t deviceId,
@@ -761,6 +763,18 @@ FileBuffer* FileMgr::getBuffer(const ChunkKey& key, const size_t num_bytes) {
   return getBufferUnlocked(chunk_it, num_bytes);
 }
 
+void FileMgr::prefetchBuffers(const std::vector<ChunkKey>& keys) {
+  mapd_shared_lock<mapd_shared_mutex> chunk_index_read_lock(chunkIndexMutex_);
+  for (const auto& key : keys) {
+    for (auto chunk_it = chunkIndex_.lower_bound(key);
+         chunk_it != chunkIndex_.end() && chunk_it->first.size() >= key.size() &&
+         std::equal(key.begin(), key.end(), chunk_it->first.begin());
+         ++chunk_it) {
+      chunk_it->second->prefetch();
+    }
+  }
+}
+
 FileBuffer* FileMgr::getBufferUnlocked(const ChunkKeyToChunkMap::iterator chunk_it,
                                        const size_t num_bytes) {
   CHECK(chunk_it != chunkIndex_.end())
@@ -776,7 +790,25 @@ void FileMgr::fetchBuffer(const ChunkKey& key,
   CHECK(!destBuffer->isDirty())
       << "Aborting attempt to fetch a chunk marked dirty. Chunk inconsistency for key: "
       << show_chunk(key);
-  AbstractBuffer* chunk = getBuffer(key);
+  FileBuffer* chunk = getBuffer(key);
+  if (chunk->hasEncoder() && chunk->getEncoder()->isCompressedInStorage()) {
+    // the memory levels hold the decoded rows
+    auto encoder = chunk->getEncoder();
+    const size_t chunk_size = numBytes > 0 ? numBytes : encoder->getDecodedSize();
+    if (chunk_size > encoder->getDecodedSize()) {
+      LOG(FATAL) << "Chunk retrieved for key `" << show_chunk(key) << "` is smaller ("
+                 << encoder->getDecodedSize() << ") than number of bytes requested ("
+                 << numBytes << ")";
+    }
+    const size_t offset = chunk->isUpdated() ? 0 : destBuffer->size();
+    destBuffer->reserve(chunk_size);
+    if (chunk_size > offset) {
+      encoder->decodeTo(destBuffer->getMemoryPtr() + offset, offset, chunk_size - offset);
+    }
+    destBuffer->setSize(chunk_size);
+    destBuffer->syncEncoder(chunk);
+    return;
+  }
   // chunk's size is either specified in function call with numBytes or we
   // just look at pageSize * numPages in FileBuffer
   if (numBytes > 0 && numBytes > chunk->size()) {
@@ -784,6 +816,15 @@ void FileMgr::fetchBuffer(const ChunkKey& key,
                << chunk->size() << ") than number of bytes requested (" << numBytes
                << ")";
   }
+  if (destBuffer->size() == 0) {
+    // serve the chunk from the page cache without copying it when possible
+    auto mapped_data = chunk->getMappedData();
+    if (mapped_data &&
+        destBuffer->mapMemory(mapped_data, numBytes > 0 ? numBytes : chunk->size())) {
+      destBuffer->syncEncoder(chunk);
+      return;
+    }
+  }
   chunk->copyTo(destBuffer, numBytes);
 }
 
@@ -804,6 +845,17 @@ FileBuffer* FileMgr::putBuffer(const ChunkKey& key,
     }
   }
   CHECK(srcBuffer->isDirty()) << "putBuffer expects a dirty buffer";
+  if (srcBuffer->hasEncoder() && srcBuffer->getEncoder()->isCompressedInStorage()) {
+    // encode the rows again as a whole, appends to the disk level chunk go through its
+    // encoder directly
+    if (!chunk->hasEncoder()) {
+      chunk->initEncoder(srcBuffer->getSqlType());
+    }
+    chunk->getEncoder()->encodeFrom(srcBuffer->getMemoryPtr(), newChunkSize);
+    srcBuffer->clearDirtyBits();
+    chunk->syncEncoder(srcBuffer);
+    return chunk;
+  }
   if (srcBuffer->isUpdated()) {
     // chunk size is not changed when fixed rows are updated or are marked as deleted.
     // but when rows are vacuumed or varlen rows are updated (new rows are appended),
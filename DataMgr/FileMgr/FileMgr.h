@@ -188,6 +188,10 @@ class FileMgr : public AbstractBufferMgr {  // implements
   /// Returns the a pointer to the chunk with the specified key.
   FileBuffer* getBuffer(const ChunkKey& key, const size_t numBytes = 0) override;
 
+  /// Starts reading the pages of the chunks with the given keys, or key prefixes for
+  /// variable length chunks, into the page cache. Unknown keys are ignored.
+  void prefetchBuffers(const std::vector<ChunkKey>& keys);
+
   void fetchBuffer(const ChunkKey& key,
                    AbstractBuffer* destBuffer,
                    const size_t numBytes) override;
@@ -356,6 +360,14 @@ class FileMgr : public AbstractBufferMgr {  // implements
    **/
   inline virtual bool failOnReadError() const { return true; }
 
+  /**
+   * @brief True if the chunks are read from memory mapped data files, which only
+   * read-only servers do.
+   **/
+  inline virtual bool mapsDataFiles() const {
+    return g_read_only && g_enable_mmap_reads;
+  }
+
   // Used to describe the manager in logging and error messages.
   virtual std::string describeSelf() const;
 
@@ -26,6 +26,7 @@
 #include <algorithm>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
+#include <map>
 #include <string>
 #include <thread>
 #include <utility>
@@ -87,6 +88,22 @@ void GlobalFileMgr::checkpoint(const int32_t db_id, const int32_t tb_id) {
   getFileMgr(db_id, tb_id)->checkpoint();
 }
 
+void GlobalFileMgr::prefetchBuffers(const std::vector<ChunkKey>& keys) {
+  std::map<std::pair<int32_t, int32_t>, std::vector<ChunkKey>> table_keys;
+  for (const auto& key : keys) {
+    CHECK_GE(key.size(), size_t(2));
+    table_keys[get_table_prefix(key)].push_back(key);
+  }
+  for (const auto& [table_prefix, keys_for_table] : table_keys) {
+    // do not create the FileMgr of tables without data on disk
+    auto file_mgr = dynamic_cast<FileMgr*>(
+        findFileMgr(table_prefix.first, table_prefix.second));
+    if (file_mgr) {
+      file_mgr->prefetchBuffers(keys_for_table);
+    }
+  }
+}
+
 size_t GlobalFileMgr::getNumChunks() {
   mapd_shared_lock<mapd_shared_mutex> read_lock(fileMgrs_mutex_);
   size_t num_chunks = 0;
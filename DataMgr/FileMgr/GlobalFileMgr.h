@@ -75,6 +75,9 @@ class GlobalFileMgr : public AbstractBufferMgr {  // implements
     return getFileMgr(key)->isBufferOnDevice(key);
   }
 
+  /// Starts reading the given chunks into the page cache, see FileMgr::prefetchBuffers.
+  void prefetchBuffers(const std::vector<ChunkKey>& keys);
+
   /// Deletes the chunk with the specified key
   // Purge == true means delete the data chunks -
   // can't undelete and revert to previous
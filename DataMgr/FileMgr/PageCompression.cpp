@@ -0,0 +1,124 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "DataMgr/FileMgr/PageCompression.h"
+
+#include <blosc.h>
+#include <boost/algorithm/string.hpp>
+#include <stdexcept>
+
+#include "Logger/Logger.h"
+
+namespace File_Namespace {
+
+namespace {
+
+// the compression level of blosc, 1 to 9
+constexpr int kCompressionLevel{5};
+
+const char* get_compressor_name(const PageCompression page_compression) {
+  switch (page_compression) {
+    case PageCompression::kLz4:
+      return BLOSC_LZ4_COMPNAME;
+    case PageCompression::kZstd:
+      return BLOSC_ZSTD_COMPNAME;
+    case PageCompression::kBloscLz:
+      return BLOSC_BLOSCLZ_COMPNAME;
+    default:
+      UNREACHABLE();
+  }
+  return nullptr;
+}
+
+}  // namespace
+
+PageCompression parse_page_compression(const std::string& name) {
+  const auto lower_name = boost::algorithm::to_lower_copy(name);
+  if (lower_name.empty() || lower_name == "none") {
+    return PageCompression::kNone;
+  }
+  if (lower_name == "lz4") {
+    return PageCompression::kLz4;
+  }
+  if (lower_name == "zstd") {
+    return PageCompression::kZstd;
+  }
+  if (lower_name == "blosclz" || lower_name == "blosc") {
+    return PageCompression::kBloscLz;
+  }
+  throw std::runtime_error("Unsupported page compression " + name +
+                           ", must be one of NONE, LZ4, ZSTD or BLOSCLZ.");
+}
+
+std::string to_string(const PageCompression page_compression) {
+  switch (page_compression) {
+    case PageCompression::kNone:
+      return "NONE";
+    case PageCompression::kLz4:
+      return "LZ4";
+    case PageCompression::kZstd:
+      return "ZSTD";
+    case PageCompression::kBloscLz:
+      return "BLOSCLZ";
+  }
+  UNREACHABLE();
+  return "";
+}
+
+size_t compress_page(const PageCompression page_compression,
+                     const int8_t* src,
+                     const size_t num_bytes,
+                     const size_t type_size,
+                     int8_t* dst,
+                     const size_t dst_capacity) {
+  CHECK(page_compression != PageCompression::kNone);
+  const auto compressed_num_bytes =
+      blosc_compress_ctx(kCompressionLevel,
+                         type_size > 1 ? BLOSC_SHUFFLE : BLOSC_NOSHUFFLE,
+                         type_size,
+                         num_bytes,
+                         src,
+                         dst,
+                         dst_capacity,
+                         get_compressor_name(page_compression),
+                         0,
+                         1);
+  if (compressed_num_bytes < 0) {
+    LOG(WARNING) << "Failed to compress a page of " << num_bytes << " bytes with "
+                 << to_string(page_compression) << ", storing it uncompressed";
+    return 0;
+  }
+  return static_cast<size_t>(compressed_num_bytes);
+}
+
+void decompress_page(const int8_t* src,
+                     const size_t compressed_num_bytes,
+                     int8_t* dst,
+                     const size_t num_bytes) {
+  size_t expected_num_bytes{0};
+  size_t expected_compressed_num_bytes{0};
+  size_t block_size{0};
+  blosc_cbuffer_sizes(
+      src, &expected_num_bytes, &expected_compressed_num_bytes, &block_size);
+  if (expected_num_bytes != num_bytes ||
+      expected_compressed_num_bytes != compressed_num_bytes ||
+      blosc_decompress_ctx(src, dst, num_bytes, 1) != static_cast<int>(num_bytes)) {
+    throw std::runtime_error("Failed to decompress a page of " +
+                             std::to_string(compressed_num_bytes) + " bytes");
+  }
+}
+
+}  // namespace File_Namespace
@@ -0,0 +1,59 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    PageCompression.h
+ * @brief   Codecs of the compressed FileBuffer pages, chosen by the PAGE_COMPRESSION
+ *          table option.
+ *
+ * All the codecs go through the blosc library. Unlike BloscCompressor, which serializes
+ * all the calls on the global blosc state, the page codecs use the blosc context API so
+ * that the pages of a chunk can be decompressed concurrently by the reader threads.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace File_Namespace {
+
+// persisted in the metadata pages, only append new codecs
+enum class PageCompression : int32_t { kNone = 0, kLz4 = 1, kZstd = 2, kBloscLz = 3 };
+
+// Throws for unknown codec names. The empty name and "none" disable compression.
+PageCompression parse_page_compression(const std::string& name);
+
+std::string to_string(const PageCompression page_compression);
+
+// Returns the compressed size, or 0 if the data does not fit into `dst_capacity` bytes
+// once compressed. `type_size` is the width of the values of the data, used to shuffle
+// their bytes before compressing them.
+size_t compress_page(const PageCompression page_compression,
+                     const int8_t* src,
+                     const size_t num_bytes,
+                     const size_t type_size,
+                     int8_t* dst,
+                     const size_t dst_capacity);
+
+// Throws if the page is corrupted.
+void decompress_page(const int8_t* src,
+                     const size_t compressed_num_bytes,
+                     int8_t* dst,
+                     const size_t num_bytes);
+
+}  // namespace File_Namespace
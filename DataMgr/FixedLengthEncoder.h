@@ -23,6 +23,7 @@
 #include <stdexcept>
 #include "AbstractBuffer.h"
 #include "Encoder.h"
+#include "ZoneMap.h"
 
 #include <Shared/DatumFetchers.h>
 #include <tbb/parallel_for.h>
@@ -49,9 +50,16 @@ class FixedLengthEncoder : public Encoder {
 
     T* unencoded_data = reinterpret_cast<T*>(src_data);
     auto encoded_data = std::make_unique<V[]>(num_elems_to_append);
+    const size_t start_row = offset == -1 ? num_elems_ : static_cast<size_t>(offset);
     for (size_t i = 0; i < num_elems_to_append; ++i) {
       size_t ri = replicating ? 0 : i;
-      encoded_data.get()[i] = encodeDataAndUpdateStats(unencoded_data[ri]);
+      const auto encoded = encodeDataAndUpdateStats(unencoded_data[ri]);
+      const bool is_null = encoded == std::numeric_limits<V>::min();
+      encoded_data.get()[i] = encoded;
+      zone_map_.update(start_row + i, encoded, is_null);
+      if (bloom_filter_ && !is_null) {
+        bloom_filter_->add(encoded);
+      }
     }
 
     // assume always CPU_BUFFER?
@@ -78,6 +86,7 @@ class FixedLengthEncoder : public Encoder {
   void getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) override {
     Encoder::getMetadata(chunkMetadata);  // call on parent class
     chunkMetadata->fillChunkStats(dataMin, dataMax, has_nulls);
+    zone_map_.fillMetadata(*chunkMetadata, num_elems_);
   }
 
   // Only called from the executor for synthesized meta-information.
@@ -89,6 +98,8 @@ class FixedLengthEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const int64_t val, const bool is_null) override {
+    zone_map_.invalidate();
+    bloom_filter_.reset();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -100,6 +111,8 @@ class FixedLengthEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const double val, const bool is_null) override {
+    zone_map_.invalidate();
+    bloom_filter_.reset();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -110,6 +123,8 @@ class FixedLengthEncoder : public Encoder {
   }
 
   void updateStats(const int8_t* const src_data, const size_t num_elements) override {
+    zone_map_.invalidate();
+    bloom_filter_.reset();
     const T* unencoded_data = reinterpret_cast<const T*>(src_data);
     for (size_t i = 0; i < num_elements; ++i) {
       encodeDataAndUpdateStats(unencoded_data[i]);
@@ -118,6 +133,8 @@ class FixedLengthEncoder : public Encoder {
 
   void updateStatsEncoded(const int8_t* const dst_data,
                           const size_t num_elements) override {
+    zone_map_.invalidate();
+    bloom_filter_.reset();
     const V* data = reinterpret_cast<const V*>(dst_data);
 
     std::tie(dataMin, dataMax, has_nulls) = tbb::parallel_reduce(
@@ -159,6 +176,8 @@ class FixedLengthEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) override {
+    zone_map_.invalidate();
+    bloom_filter_.reset();
     const auto that_typed = static_cast<const FixedLengthEncoder<T, V>&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
@@ -174,6 +193,8 @@ class FixedLengthEncoder : public Encoder {
     dataMin = castedEncoder->dataMin;
     dataMax = castedEncoder->dataMax;
     has_nulls = castedEncoder->has_nulls;
+    zone_map_ = castedEncoder->zone_map_;
+    bloom_filter_ = castedEncoder->bloom_filter_;
   }
 
   void writeMetadata(FILE* f) override {
@@ -192,6 +213,10 @@ class FixedLengthEncoder : public Encoder {
     fread((int8_t*)&has_nulls, 1, sizeof(bool), f);
   }
 
+  void writeZoneMaps(FILE* f) override { zone_map_.write(f); }
+
+  void readZoneMaps(FILE* f) override { zone_map_.read(f); }
+
   bool resetChunkStats(const ChunkStats& stats) override {
     const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
     const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
@@ -207,6 +232,10 @@ class FixedLengthEncoder : public Encoder {
   }
 
   void resetChunkStats() override {
+    zone_map_.reset();
+    if (bloom_filter_) {
+      bloom_filter_ = std::make_shared<BloomFilter>();
+    }
     dataMin = std::numeric_limits<T>::max();
     dataMax = std::numeric_limits<T>::lowest();
     has_nulls = false;
@@ -236,6 +265,8 @@ class FixedLengthEncoder : public Encoder {
     }
     return encoded_data;
   }
+
+  ZoneMap<T> zone_map_;
 };  // FixedLengthEncoder
 
 #endif  // FIXED_LENGTH_ENCODER_H
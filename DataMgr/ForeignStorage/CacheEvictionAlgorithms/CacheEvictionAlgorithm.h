@@ -22,6 +22,9 @@
  * quickly slot out different caching algorithms for the FSI cache.
  * A caching algorithm can be queried to determine which chunks should be evicted in what
  * order and needs to be updated with cache usage data.
+ *
+ * The buffer pools evict contiguous runs of pages rather than single chunks, so their
+ * algorithms also rank the chunks, see RankedCacheEvictionAlgorithm.
  */
 
 #pragma once
@@ -41,3 +44,14 @@ class CacheEvictionAlgorithm {
   virtual void touchChunk(const ChunkKey&) = 0;
   virtual void removeChunk(const ChunkKey&) = 0;
 };
+
+class RankedCacheEvictionAlgorithm : public CacheEvictionAlgorithm {
+ public:
+  ~RankedCacheEvictionAlgorithm() override {}
+  // Returns how valuable the chunk is to keep cached, the chunks of lower scores are
+  // evicted first.
+  virtual size_t getRetentionScore(const ChunkKey&) = 0;
+  // Sets the cost of fetching the chunk again once evicted, relative to reading it from
+  // disk.
+  virtual void setRefetchCost(const ChunkKey&, const size_t refetch_cost) = 0;
+};
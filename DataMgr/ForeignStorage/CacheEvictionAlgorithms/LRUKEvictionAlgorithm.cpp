@@ -0,0 +1,117 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "LRUKEvictionAlgorithm.h"
+
+#include <algorithm>
+
+#include "Logger/Logger.h"
+
+LRUKEvictionAlgorithm::LRUKEvictionAlgorithm(const size_t k,
+                                             const size_t max_retained_history)
+    : k_(k), max_retained_history_(max_retained_history) {
+  CHECK_GT(k_, size_t(0));
+}
+
+const ChunkKey LRUKEvictionAlgorithm::evictNextChunk() {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  if (cached_chunks_.empty()) {
+    throw NoEntryFoundException();
+  }
+  auto victim_it = cached_chunks_.begin();
+  size_t min_score = getRetentionScore(victim_it->second);
+  for (auto it = std::next(victim_it); it != cached_chunks_.end(); ++it) {
+    const auto score = getRetentionScore(it->second);
+    if (score < min_score) {
+      min_score = score;
+      victim_it = it;
+    }
+  }
+  const auto key = victim_it->first;
+  retainHistory(key, std::move(victim_it->second));
+  cached_chunks_.erase(victim_it);
+  return key;
+}
+
+void LRUKEvictionAlgorithm::touchChunk(const ChunkKey& key) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto it = cached_chunks_.find(key);
+  if (it == cached_chunks_.end()) {
+    History history;
+    auto retained_it = retained_history_.find(key);
+    if (retained_it != retained_history_.end()) {
+      history = std::move(retained_it->second.first);
+      retained_order_.erase(retained_it->second.second);
+      retained_history_.erase(retained_it);
+    }
+    it = cached_chunks_.emplace(key, std::move(history)).first;
+  }
+  auto& touches = it->second.touches;
+  touches.push_front(++clock_);
+  if (touches.size() > k_) {
+    touches.pop_back();
+  }
+}
+
+void LRUKEvictionAlgorithm::removeChunk(const ChunkKey& key) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto it = cached_chunks_.find(key);
+  if (it == cached_chunks_.end()) {
+    return;
+  }
+  retainHistory(key, std::move(it->second));
+  cached_chunks_.erase(it);
+}
+
+size_t LRUKEvictionAlgorithm::getRetentionScore(const ChunkKey& key) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto it = cached_chunks_.find(key);
+  return it == cached_chunks_.end() ? 0 : getRetentionScore(it->second);
+}
+
+void LRUKEvictionAlgorithm::setRefetchCost(const ChunkKey& key,
+                                           const size_t refetch_cost) {
+  std::lock_guard<std::mutex> lock(cache_mutex_);
+  auto it = cached_chunks_.find(key);
+  if (it != cached_chunks_.end()) {
+    it->second.refetch_cost = std::max(refetch_cost, size_t(1));
+  }
+}
+
+size_t LRUKEvictionAlgorithm::getRetentionScore(const History& history) const {
+  if (history.touches.empty()) {
+    return 0;
+  }
+  const bool has_k_touches = history.touches.size() >= k_;
+  // the K-th most recent touch, or the most recent one for the chunks touched fewer
+  // than K times, which all rank below the chunks touched K times
+  const size_t ref_touch =
+      has_k_touches ? history.touches.back() : history.touches.front();
+  const size_t score = clock_ - (clock_ - ref_touch) / history.refetch_cost;
+  return has_k_touches ? clock_ + 1 + score : score;
+}
+
+void LRUKEvictionAlgorithm::retainHistory(const ChunkKey& key, History&& history) {
+  if (!max_retained_history_) {
+    return;
+  }
+  if (retained_history_.size() >= max_retained_history_) {
+    retained_history_.erase(retained_order_.front());
+    retained_order_.pop_front();
+  }
+  retained_order_.push_back(key);
+  retained_history_[key] = {std::move(history), std::prev(retained_order_.end())};
+}
@@ -0,0 +1,75 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file LRUKEvictionAlgorithm.h
+ *
+ * This file includes the class specification for the LRU-K cache eviction algorithm,
+ * used by the buffer pools.
+ *
+ * The chunks are ranked by the time of their K-th most recent touch, and the chunks
+ * touched fewer than K times are all evicted before the others. A scan touching many
+ * chunks once therefore evicts the chunks of the previous scans rather than the working
+ * set of the repeated queries. The age of the touches is divided by the refetch cost of
+ * the chunks, so the chunks which are expensive to fetch again are kept longer.
+ *
+ * The touch history of the evicted chunks is retained for a bounded number of chunks,
+ * so a chunk of the working set evicted once does not lose its history.
+ */
+
+#pragma once
+
+#include <deque>
+#include <list>
+#include <map>
+#include <mutex>
+
+#include "CacheEvictionAlgorithm.h"
+
+class LRUKEvictionAlgorithm : public RankedCacheEvictionAlgorithm {
+ public:
+  LRUKEvictionAlgorithm(const size_t k = 2,
+                        const size_t max_retained_history = kDefaultMaxRetainedHistory);
+  ~LRUKEvictionAlgorithm() override {}
+  // Returns the chunk of lowest retention score and evicts it.
+  const ChunkKey evictNextChunk() override;
+  void touchChunk(const ChunkKey&) override;
+  // Evicts the chunk if present, its touch history is retained.
+  void removeChunk(const ChunkKey&) override;
+  size_t getRetentionScore(const ChunkKey&) override;
+  void setRefetchCost(const ChunkKey&, const size_t refetch_cost) override;
+
+  static constexpr size_t kDefaultMaxRetainedHistory{65536};
+
+ private:
+  struct History {
+    std::deque<size_t> touches;  // most recent first, at most k
+    size_t refetch_cost{1};
+  };
+
+  size_t getRetentionScore(const History& history) const;
+  void retainHistory(const ChunkKey& key, History&& history);
+
+  const size_t k_;
+  const size_t max_retained_history_;
+  size_t clock_{0};
+  std::map<ChunkKey, History> cached_chunks_;
+  // the history of the evicted chunks, and their keys in eviction order
+  std::map<ChunkKey, std::pair<History, std::list<ChunkKey>::iterator>>
+      retained_history_;
+  std::list<ChunkKey> retained_order_;
+  std::mutex cache_mutex_;
+};
@@ -19,6 +19,7 @@
 
 #include "AbstractBuffer.h"
 #include "Encoder.h"
+#include "ZoneMap.h"
 
 #include <Shared/DatumFetchers.h>
 
@@ -52,18 +53,24 @@ class NoneEncoder : public Encoder {
     if (replicating) {
       encoded_data.resize(num_elems_to_append);
     }
+    const size_t start_row = offset == -1 ? num_elems_ : static_cast<size_t>(offset);
     for (size_t i = 0; i < num_elems_to_append; ++i) {
       size_t ri = replicating ? 0 : i;
       T data = validateDataAndUpdateStats(unencodedData[ri]);
+      const bool is_null = data == none_encoded_null_value<T>();
+      zone_map_.update(start_row + i, data, is_null);
+      if (bloom_filter_ && !is_null) {
+        bloom_filter_->add(static_cast<int64_t>(data));
+      }
       if (replicating) {
         encoded_data[i] = data;
       }
     }
     if (offset == -1) {
       num_elems_ += num_elems_to_append;
-      buffer_->append(
-          replicating ? reinterpret_cast<int8_t*>(encoded_data.data()) : src_data,
-          num_elems_to_append * sizeof(T));
+      storeData(replicating ? reinterpret_cast<int8_t*>(encoded_data.data()) : src_data,
+                num_elems_to_append,
+                offset);
       if (!replicating) {
         src_data += num_elems_to_append * sizeof(T);
       }
@@ -71,8 +78,7 @@ class NoneEncoder : public Encoder {
       num_elems_ = offset + num_elems_to_append;
       CHECK(!replicating);
       CHECK_GE(offset, 0);
-      buffer_->write(
-          src_data, num_elems_to_append * sizeof(T), static_cast<size_t>(offset));
+      storeData(src_data, num_elems_to_append, offset);
     }
     auto chunk_metadata = std::make_shared<ChunkMetadata>();
     getMetadata(chunk_metadata);
@@ -82,6 +88,7 @@ class NoneEncoder : public Encoder {
   void getMetadata(const std::shared_ptr<ChunkMetadata>& chunkMetadata) override {
     Encoder::getMetadata(chunkMetadata);  // call on parent class
     chunkMetadata->fillChunkStats(dataMin, dataMax, has_nulls);
+    zone_map_.fillMetadata(*chunkMetadata, num_elems_);
   }
 
   // Only called from the executor for synthesized meta-information.
@@ -93,6 +100,8 @@ class NoneEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const int64_t val, const bool is_null) override {
+    zone_map_.invalidate();
+    bloom_filter_.reset();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -104,6 +113,8 @@ class NoneEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void updateStats(const double val, const bool is_null) override {
+    zone_map_.invalidate();
+    bloom_filter_.reset();
     if (is_null) {
       has_nulls = true;
     } else {
@@ -114,6 +125,8 @@ class NoneEncoder : public Encoder {
   }
 
   void updateStats(const int8_t* const src_data, const size_t num_elements) override {
+    zone_map_.invalidate();
+    bloom_filter_.reset();
     const T* unencoded_data = reinterpret_cast<const T*>(src_data);
     for (size_t i = 0; i < num_elements; ++i) {
       validateDataAndUpdateStats(unencoded_data[i]);
@@ -122,6 +135,8 @@ class NoneEncoder : public Encoder {
 
   void updateStatsEncoded(const int8_t* const dst_data,
                           const size_t num_elements) override {
+    zone_map_.invalidate();
+    bloom_filter_.reset();
     const T* data = reinterpret_cast<const T*>(dst_data);
 
     std::tie(dataMin, dataMax, has_nulls) = tbb::parallel_reduce(
@@ -163,6 +178,8 @@ class NoneEncoder : public Encoder {
 
   // Only called from the executor for synthesized meta-information.
   void reduceStats(const Encoder& that) override {
+    zone_map_.invalidate();
+    bloom_filter_.reset();
     const auto that_typed = static_cast<const NoneEncoder&>(that);
     if (that_typed.has_nulls) {
       has_nulls = true;
@@ -187,6 +204,10 @@ class NoneEncoder : public Encoder {
     fread((int8_t*)&has_nulls, sizeof(bool), 1, f);
   }
 
+  void writeZoneMaps(FILE* f) override { zone_map_.write(f); }
+
+  void readZoneMaps(FILE* f) override { zone_map_.read(f); }
+
   bool resetChunkStats(const ChunkStats& stats) override {
     const auto new_min = DatumFetcher::getDatumVal<T>(stats.min);
     const auto new_max = DatumFetcher::getDatumVal<T>(stats.max);
@@ -207,9 +228,15 @@ class NoneEncoder : public Encoder {
     dataMin = castedEncoder->dataMin;
     dataMax = castedEncoder->dataMax;
     has_nulls = castedEncoder->has_nulls;
+    zone_map_ = castedEncoder->zone_map_;
+    bloom_filter_ = castedEncoder->bloom_filter_;
   }
 
   void resetChunkStats() override {
+    zone_map_.reset();
+    if (bloom_filter_) {
+      bloom_filter_ = std::make_shared<BloomFilter>();
+    }
     dataMin = std::numeric_limits<T>::max();
     dataMax = std::numeric_limits<T>::lowest();
     has_nulls = false;
@@ -219,6 +246,16 @@ class NoneEncoder : public Encoder {
   T dataMax;
   bool has_nulls;
 
+ protected:
+  // Writes the rows to the buffer, appends them if the offset is -1.
+  virtual void storeData(int8_t* data, const size_t num_elems, const int64_t offset) {
+    if (offset == -1) {
+      buffer_->append(data, num_elems * sizeof(T));
+    } else {
+      buffer_->write(data, num_elems * sizeof(T), static_cast<size_t>(offset));
+    }
+  }
+
  private:
   T validateDataAndUpdateStats(const T& unencoded_data) {
     if (unencoded_data == none_encoded_null_value<T>()) {
@@ -230,6 +267,8 @@ class NoneEncoder : public Encoder {
     }
     return unencoded_data;
   }
+
+  ZoneMap<T> zone_map_;
 };  // class NoneEncoder
 
 #endif  // NONE_ENCODER_H
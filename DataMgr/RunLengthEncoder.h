@@ -0,0 +1,187 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    RunLengthEncoder.h
+ * @brief   Encoder of RL (run length) encoded columns.
+ *
+ * The disk level chunk is a sequence of runs, each made of the value of the run
+ * followed by the number of rows of the run as a 32-bit integer. Nulls are stored as
+ * their sentinel value. Appending rows extends the last run of the chunk in place when
+ * possible.
+ *
+ * The memory levels hold the decoded rows, see Encoder::isCompressedInStorage.
+ */
+
+#pragma once
+
+#include "NoneEncoder.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+template <typename T>
+class RunLengthEncoder : public NoneEncoder<T> {
+ public:
+  RunLengthEncoder(Data_Namespace::AbstractBuffer* buffer) : NoneEncoder<T>(buffer) {}
+
+  using NoneEncoder<T>::getMetadata;
+
+  void getMetadata(const std::shared_ptr<ChunkMetadata>& chunk_metadata) override {
+    NoneEncoder<T>::getMetadata(chunk_metadata);
+    // the number of bytes fetched into memory
+    chunk_metadata->numBytes = getDecodedSize();
+  }
+
+  bool isCompressedInStorage() const override { return true; }
+
+  size_t getDecodedSize() const override { return this->num_elems_ * sizeof(T); }
+
+  void decodeTo(int8_t* dst, const size_t offset, const size_t num_bytes) override {
+    CHECK_EQ(offset % sizeof(T), size_t(0));
+    CHECK_EQ(num_bytes % sizeof(T), size_t(0));
+    const auto encoded = readEncoded();
+    auto out = reinterpret_cast<T*>(dst);
+    size_t row_idx{0};
+    const size_t first_row = offset / sizeof(T);
+    const size_t end_row = first_row + num_bytes / sizeof(T);
+    for (size_t pos = 0; pos < encoded.size() && row_idx < end_row; pos += kRunSize) {
+      T value;
+      uint32_t length;
+      readRun(encoded.data() + pos, value, length);
+      const auto run_begin = std::max(row_idx, first_row);
+      const auto run_end = std::min(row_idx + length, end_row);
+      if (run_begin < run_end) {
+        std::fill(out + run_begin - first_row, out + run_end - first_row, value);
+      }
+      row_idx += length;
+    }
+    CHECK_GE(row_idx, end_row) << "Run length encoded chunk is shorter than requested";
+  }
+
+  void encodeFrom(int8_t* src, const size_t num_bytes) override {
+    CHECK_EQ(num_bytes % sizeof(T), size_t(0));
+    std::vector<int8_t> encoded;
+    encodeRuns(encoded, reinterpret_cast<const T*>(src), num_bytes / sizeof(T));
+    replaceEncoded(encoded);
+  }
+
+ protected:
+  void storeData(int8_t* data, const size_t num_elems, const int64_t offset) override {
+    auto buffer = this->buffer_;
+    if (buffer->getType() != Data_Namespace::DISK_LEVEL) {
+      NoneEncoder<T>::storeData(data, num_elems, offset);
+      return;
+    }
+    const auto rows = reinterpret_cast<const T*>(data);
+    if (offset != -1) {
+      // rows written in place, encode the chunk again
+      std::vector<T> decoded(offset + num_elems);
+      const auto num_old_rows = std::min(countRows(), static_cast<size_t>(offset));
+      decodeTo(reinterpret_cast<int8_t*>(decoded.data()), 0, num_old_rows * sizeof(T));
+      std::copy(rows, rows + num_elems, decoded.begin() + offset);
+      encodeFrom(reinterpret_cast<int8_t*>(decoded.data()), decoded.size() * sizeof(T));
+      return;
+    }
+    size_t i{0};
+    const auto encoded_size = buffer->size();
+    if (encoded_size >= kRunSize) {
+      // extend the last run
+      int8_t last_run[kRunSize];
+      buffer->read(last_run, kRunSize, encoded_size - kRunSize);
+      T value;
+      uint32_t length;
+      readRun(last_run, value, length);
+      const auto old_length = length;
+      while (i < num_elems && rows[i] == value &&
+             length < std::numeric_limits<uint32_t>::max()) {
+        ++length;
+        ++i;
+      }
+      if (length != old_length) {
+        writeRun(last_run, value, length);
+        buffer->write(last_run, kRunSize, encoded_size - kRunSize);
+      }
+    }
+    if (i < num_elems) {
+      std::vector<int8_t> encoded;
+      encodeRuns(encoded, rows + i, num_elems - i);
+      buffer->append(encoded.data(), encoded.size());
+    }
+  }
+
+ private:
+  static constexpr size_t kRunSize{sizeof(T) + sizeof(uint32_t)};
+
+  static void readRun(const int8_t* src, T& value, uint32_t& length) {
+    std::memcpy(&value, src, sizeof(T));
+    std::memcpy(&length, src + sizeof(T), sizeof(uint32_t));
+  }
+
+  static void writeRun(int8_t* dst, const T value, const uint32_t length) {
+    std::memcpy(dst, &value, sizeof(T));
+    std::memcpy(dst + sizeof(T), &length, sizeof(uint32_t));
+  }
+
+  static void encodeRuns(std::vector<int8_t>& encoded,
+                         const T* rows,
+                         const size_t num_rows) {
+    size_t i{0};
+    while (i < num_rows) {
+      const auto value = rows[i];
+      uint32_t length{0};
+      while (i < num_rows && rows[i] == value &&
+             length < std::numeric_limits<uint32_t>::max()) {
+        ++length;
+        ++i;
+      }
+      encoded.resize(encoded.size() + kRunSize);
+      writeRun(encoded.data() + encoded.size() - kRunSize, value, length);
+    }
+  }
+
+  std::vector<int8_t> readEncoded() const {
+    std::vector<int8_t> encoded(this->buffer_->size());
+    if (!encoded.empty()) {
+      this->buffer_->read(encoded.data(), encoded.size());
+    }
+    CHECK_EQ(encoded.size() % kRunSize, size_t(0));
+    return encoded;
+  }
+
+  size_t countRows() const {
+    const auto encoded = readEncoded();
+    size_t num_rows{0};
+    for (size_t pos = 0; pos < encoded.size(); pos += kRunSize) {
+      T value;
+      uint32_t length;
+      readRun(encoded.data() + pos, value, length);
+      num_rows += length;
+    }
+    return num_rows;
+  }
+
+  void replaceEncoded(std::vector<int8_t>& encoded) {
+    auto buffer = this->buffer_;
+    if (!encoded.empty()) {
+      buffer->write(encoded.data(), encoded.size(), 0);
+    }
+    buffer->setSize(encoded.size());
+    buffer->setUpdated();
+  }
+};
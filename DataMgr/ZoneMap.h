@@ -0,0 +1,167 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    ZoneMap.h
+ * @brief   Min / max / has nulls stats of blocks of consecutive rows of a chunk.
+ *
+ * The chunk stats only give a single value range per fragment, which rarely allows
+ * skipping a large fragment for a selective filter. Zone maps keep the stats of
+ * consecutive blocks ("zones") of rows, so the executor can skip a fragment if no zone
+ * qualifies, and otherwise restrict the scan to the rows between the first and the last
+ * qualifying zone.
+ *
+ * Zones start with g_zone_map_min_rows rows. Once a chunk outgrows kMaxZones zones,
+ * adjacent zones are merged and the number of rows per zone doubles, so that the zone
+ * maps always fit into the metadata page of the chunk.
+ */
+
+#pragma once
+
+#include "ChunkMetadata.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <limits>
+#include <vector>
+
+extern bool g_enable_zone_maps;
+extern size_t g_zone_map_min_rows;
+
+template <typename T>
+class ZoneMap {
+ public:
+  static constexpr size_t kMaxZones{64};
+
+  ZoneMap() { reset(); }
+
+  // Starts over with an empty chunk.
+  void reset() {
+    valid_ = g_enable_zone_maps;
+    rows_per_zone_ = std::max(g_zone_map_min_rows, size_t(1));
+    num_rows_ = 0;
+    mins_.clear();
+    maxs_.clear();
+    has_nulls_.clear();
+  }
+
+  // The stats of the chunk changed without knowing the positions of the changed rows, the
+  // zone maps can't be trusted anymore until the chunk is rewritten.
+  void invalidate() {
+    reset();
+    valid_ = false;
+  }
+
+  // Adds the value of the row at the given position of the chunk. Rewriting a row only
+  // widens the range of its zone, since the previous value of the row is unknown.
+  void update(const size_t row_idx, const T val, const bool is_null) {
+    if (!valid_) {
+      return;
+    }
+    if (row_idx > num_rows_) {
+      // a gap in the covered rows
+      invalidate();
+      return;
+    }
+    if (row_idx == num_rows_) {
+      ++num_rows_;
+    }
+    auto zone_idx = row_idx / rows_per_zone_;
+    if (zone_idx >= mins_.size()) {
+      if (zone_idx >= kMaxZones) {
+        mergeZones();
+        zone_idx = row_idx / rows_per_zone_;
+      }
+      CHECK_EQ(zone_idx, mins_.size());
+      mins_.push_back(std::numeric_limits<T>::max());
+      maxs_.push_back(std::numeric_limits<T>::lowest());
+      has_nulls_.push_back(false);
+    }
+    if (is_null) {
+      has_nulls_[zone_idx] = true;
+    } else {
+      mins_[zone_idx] = std::min(mins_[zone_idx], val);
+      maxs_[zone_idx] = std::max(maxs_[zone_idx], val);
+    }
+  }
+
+  // Exposes the zone maps through the chunk metadata, provided they cover all the rows of
+  // the chunk and there is more than one zone.
+  void fillMetadata(ChunkMetadata& chunk_metadata, const size_t num_elems) const {
+    chunk_metadata.zoneStats.clear();
+    chunk_metadata.rowsPerZone = 0;
+    if (!valid_ || num_rows_ != num_elems || mins_.size() < 2) {
+      return;
+    }
+    chunk_metadata.rowsPerZone = rows_per_zone_;
+    chunk_metadata.zoneStats.resize(mins_.size());
+    for (size_t i = 0; i < mins_.size(); ++i) {
+      chunk_metadata.fillStats(
+          chunk_metadata.zoneStats[i], mins_[i], maxs_[i], has_nulls_[i]);
+    }
+  }
+
+  void write(FILE* f) const {
+    const size_t num_zones = mins_.size();
+    fwrite((int8_t*)&valid_, sizeof(bool), 1, f);
+    fwrite((int8_t*)&rows_per_zone_, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&num_rows_, sizeof(size_t), 1, f);
+    fwrite((int8_t*)&num_zones, sizeof(size_t), 1, f);
+    fwrite((int8_t*)mins_.data(), sizeof(T), num_zones, f);
+    fwrite((int8_t*)maxs_.data(), sizeof(T), num_zones, f);
+    fwrite((int8_t*)has_nulls_.data(), sizeof(int8_t), num_zones, f);
+  }
+
+  void read(FILE* f) {
+    size_t num_zones{0};
+    fread((int8_t*)&valid_, sizeof(bool), 1, f);
+    fread((int8_t*)&rows_per_zone_, sizeof(size_t), 1, f);
+    fread((int8_t*)&num_rows_, sizeof(size_t), 1, f);
+    fread((int8_t*)&num_zones, sizeof(size_t), 1, f);
+    CHECK_LE(num_zones, kMaxZones);
+    CHECK_GT(rows_per_zone_, size_t(0));
+    mins_.resize(num_zones);
+    maxs_.resize(num_zones);
+    has_nulls_.resize(num_zones);
+    fread((int8_t*)mins_.data(), sizeof(T), num_zones, f);
+    fread((int8_t*)maxs_.data(), sizeof(T), num_zones, f);
+    fread((int8_t*)has_nulls_.data(), sizeof(int8_t), num_zones, f);
+  }
+
+ private:
+  void mergeZones() {
+    const size_t num_merged_zones = (mins_.size() + 1) / 2;
+    for (size_t i = 0; i < num_merged_zones; ++i) {
+      const auto first = 2 * i;
+      const auto second = std::min(first + 1, mins_.size() - 1);
+      mins_[i] = std::min(mins_[first], mins_[second]);
+      maxs_[i] = std::max(maxs_[first], maxs_[second]);
+      has_nulls_[i] = has_nulls_[first] || has_nulls_[second];
+    }
+    mins_.resize(num_merged_zones);
+    maxs_.resize(num_merged_zones);
+    has_nulls_.resize(num_merged_zones);
+    rows_per_zone_ *= 2;
+  }
+
+  bool valid_;
+  size_t rows_per_zone_;
+  // number of rows of the chunk covered by the zones
+  size_t num_rows_;
+  std::vector<T> mins_;
+  std::vector<T> maxs_;
+  std::vector<int8_t> has_nulls_;
+};
@@ -28,6 +28,7 @@
 
 #include "DataMgr/AbstractBuffer.h"
 #include "DataMgr/DataMgr.h"
+#include "DataMgr/FileMgr/FileBuffer.h"
 #include "DataMgr/FileMgr/GlobalFileMgr.h"
 #include "LockMgr/LockMgr.h"
 #include "Logger/Logger.h"
@@ -737,6 +738,17 @@ FragmentInfo* InsertOrderFragmenter::createNewFragment(
         newFragmentInfo->deviceIds[static_cast<int>(memoryLevel)],
         pageSize_);
     colMapIt->second.initEncoder();
+    if (bloomFilterColumnIds_.count(colMapIt->first)) {
+      colMapIt->second.getBuffer()->getEncoder()->enableBloomFilter();
+    }
+    if (pageCompression_ != File_Namespace::PageCompression::kNone) {
+      // only disk level chunks are compressed
+      for (auto buffer : {colMapIt->second.getBuffer(), colMapIt->second.getIndexBuf()}) {
+        if (auto file_buffer = dynamic_cast<File_Namespace::FileBuffer*>(buffer)) {
+          file_buffer->setPageCompression(pageCompression_);
+        }
+      }
+    }
   }
 
   mapd_lock_guard<mapd_shared_mutex> writeLock(fragmentInfoMutex_);
@@ -23,11 +23,13 @@
 
 #include <map>
 #include <mutex>
+#include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "DataMgr/Chunk/Chunk.h"
+#include "DataMgr/FileMgr/PageCompression.h"
 #include "DataMgr/MemoryLevel.h"
 #include "FragmentDefaultValues.h"
 #include "Fragmenter/AbstractFragmenter.h"
@@ -120,6 +122,20 @@ class InsertOrderFragmenter : public AbstractFragmenter {
   size_t getNumRows() override { return numTuples_; }
   void setNumRows(const size_t numTuples) override { numTuples_ = numTuples; }
 
+  /**
+   * @brief sets the columns whose new chunks maintain a Bloom filter of their values
+   */
+  void setBloomFilterColumns(const std::vector<int>& column_ids) {
+    bloomFilterColumnIds_ = std::set<int>(column_ids.begin(), column_ids.end());
+  }
+
+  /**
+   * @brief sets the codec compressing the pages of the new chunks on disk
+   */
+  void setPageCompression(const File_Namespace::PageCompression page_compression) {
+    pageCompression_ = page_compression;
+  }
+
   std::optional<ChunkUpdateStats> updateColumn(
       const Catalog_Namespace::Catalog* catalog,
       const TableDescriptor* td,
@@ -213,6 +229,9 @@ class InsertOrderFragmenter : public AbstractFragmenter {
   int rowIdColId_;
   std::unordered_map<int, size_t> varLenColInfo_;
   std::shared_ptr<std::mutex> mutex_access_inmem_states;
+  std::set<int> bloomFilterColumnIds_;
+  File_Namespace::PageCompression pageCompression_{
+      File_Namespace::PageCompression::kNone};
 
   /**
    * @brief creates new fragment, calling createChunk()
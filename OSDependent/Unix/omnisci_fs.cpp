@@ -48,6 +48,12 @@ void* checked_mmap(const int fd, const size_t sz) {
   return ptr;
 }
 
+void* checked_mmap_private(const int fd, const size_t sz) {
+  auto ptr = mmap(nullptr, sz, PROT_WRITE | PROT_READ, MAP_PRIVATE, fd, 0);
+  CHECK(ptr != reinterpret_cast<void*>(-1));
+  return ptr;
+}
+
 void checked_munmap(void* addr, size_t length) {
   CHECK_EQ(0, munmap(addr, length));
 }
@@ -49,6 +49,17 @@ void* checked_mmap(const int fd, const size_t sz) {
   return map_ptr;
 }
 
+void* checked_mmap_private(const int fd, const size_t sz) {
+  auto handle = _get_osfhandle(fd);
+  HANDLE map_handle =
+      CreateFileMapping(reinterpret_cast<HANDLE>(handle), NULL, PAGE_WRITECOPY, 0, 0, 0);
+  CHECK(map_handle);
+  auto map_ptr = MapViewOfFile(map_handle, FILE_MAP_COPY, 0, 0, sz);
+  CHECK(map_ptr);
+  CHECK(CloseHandle(map_handle) != 0);
+  return map_ptr;
+}
+
 void checked_munmap(void* addr, size_t length) {
   CHECK(UnmapViewOfFile(addr) != 0);
 }
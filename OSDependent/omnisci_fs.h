@@ -25,6 +25,10 @@ size_t file_size(const int fd);
 
 void* checked_mmap(const int fd, const size_t sz);
 
+// copy-on-write mapping, writes to the memory are never written back to the file, which
+// can be opened read only
+void* checked_mmap_private(const int fd, const size_t sz);
+
 void checked_munmap(void* addr, size_t length);
 
 int msync(void* addr, size_t length, bool async);
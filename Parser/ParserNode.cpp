@@ -47,6 +47,7 @@
 #include "Catalog/Catalog.h"
 #include "Catalog/DataframeTableDescriptor.h"
 #include "Catalog/SharedDictionaryValidator.h"
+#include "DataMgr/FileMgr/PageCompression.h"
 #include "Fragmenter/InsertOrderFragmenter.h"
 #include "Fragmenter/SortedOrderFragmenter.h"
 #include "Fragmenter/TargetValueConvertersFactories.h"
@@ -2277,6 +2278,51 @@ decltype(auto) get_sort_column_def(TableDescriptor& td,
   });
 }
 
+decltype(auto) get_bloom_filter_columns_def(TableDescriptor& td,
+                                            const NameValueAssign* p,
+                                            const std::list<ColumnDescriptor>& columns) {
+  return get_property_value<StringLiteral>(p, [&td, &columns](const auto columns_upper) {
+    std::vector<std::string> column_names;
+    boost::split(column_names, columns_upper, boost::is_any_of(","));
+    td.bloomFilterColumnIds.clear();
+    for (auto& column_name : column_names) {
+      boost::trim(column_name);
+      const auto cd_it =
+          std::find_if(columns.begin(), columns.end(), [&column_name](const auto& cd) {
+            return boost::to_upper_copy<std::string>(cd.columnName) == column_name;
+          });
+      if (cd_it == columns.end()) {
+        throw std::runtime_error("Specified Bloom filter column " + column_name +
+                                 " doesn't exist");
+      }
+      const auto& ti = cd_it->columnType;
+      if (!ti.is_integer() &&
+          !(ti.is_string() && ti.get_compression() == kENCODING_DICT)) {
+        throw std::runtime_error(
+            "Bloom filter indexes are only supported on integer and dictionary encoded "
+            "text columns");
+      }
+      const int column_id = sort_column_index(column_name, columns);
+      if (std::find(td.bloomFilterColumnIds.begin(),
+                    td.bloomFilterColumnIds.end(),
+                    column_id) == td.bloomFilterColumnIds.end()) {
+        td.bloomFilterColumnIds.push_back(column_id);
+      }
+    }
+  });
+}
+
+decltype(auto) get_page_compression_def(TableDescriptor& td,
+                                        const NameValueAssign* p,
+                                        const std::list<ColumnDescriptor>& columns) {
+  return get_property_value<StringLiteral>(p, [&td](const auto val) {
+    const auto page_compression = File_Namespace::parse_page_compression(val);
+    td.pageCompression = page_compression == File_Namespace::PageCompression::kNone
+                             ? ""
+                             : File_Namespace::to_string(page_compression);
+  });
+}
+
 decltype(auto) get_max_rollback_epochs_def(TableDescriptor& td,
                                            const NameValueAssign* p,
                                            const std::list<ColumnDescriptor>& columns) {
@@ -2299,6 +2345,8 @@ static const std::map<const std::string, const TableDefFuncPtr> tableDefFuncMap
     {"shard_count"s, get_shard_count_def},
     {"vacuum"s, get_vacuum_def},
     {"sort_column"s, get_sort_column_def},
+    {"bloom_filter_columns"s, get_bloom_filter_columns_def},
+    {"page_compression"s, get_page_compression_def},
     {"storage_type"s, get_storage_type},
     {"max_rollback_epochs", get_max_rollback_epochs_def}};
 
@@ -2311,7 +2359,8 @@ void get_table_definitions(TableDescriptor& td,
         "Invalid CREATE TABLE option " + *p->get_name() +
         ". Should be FRAGMENT_SIZE, MAX_CHUNK_SIZE, PAGE_SIZE, MAX_ROLLBACK_EPOCHS, "
         "MAX_ROWS, "
-        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, STORAGE_TYPE.");
+        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, BLOOM_FILTER_COLUMNS, "
+        "PAGE_COMPRESSION, STORAGE_TYPE.");
   }
   return it->second(td, p.get(), columns);
 }
@@ -2325,7 +2374,8 @@ void get_table_definitions_for_ctas(TableDescriptor& td,
         "Invalid CREATE TABLE AS option " + *p->get_name() +
         ". Should be FRAGMENT_SIZE, MAX_CHUNK_SIZE, PAGE_SIZE, MAX_ROLLBACK_EPOCHS, "
         "MAX_ROWS, "
-        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, STORAGE_TYPE or "
+        "PARTITIONS, SHARD_COUNT, VACUUM, SORT_COLUMN, BLOOM_FILTER_COLUMNS, "
+        "PAGE_COMPRESSION, STORAGE_TYPE or "
         "USE_SHARED_DICTIONARIES.");
   }
   return it->second(td, p.get(), columns);
@@ -19,12 +19,15 @@
 #include <memory>
 
 #include "DataMgr/ArrayNoneEncoder.h"
+#include "DataMgr/FileMgr/FileBuffer.h"
 #include "QueryEngine/ErrorHandling.h"
 #include "QueryEngine/Execute.h"
 #include "Shared/Intervals.h"
 #include "Shared/likely.h"
 #include "Shared/sqltypes.h"
 
+extern bool g_enable_chunk_prefetch;
+
 namespace {
 
 inline const ColumnarResults* columnarize_result(
@@ -288,6 +291,114 @@ const int8_t* ColumnFetcher::getOneTableColumnFragment(
   }
 }
 
+void ColumnFetcher::prefetchNextFragment(
+    const int table_id,
+    const int frag_id,
+    const std::vector<int>& col_ids,
+    const std::map<int, const TableFragments*>& all_tables_fragments) const {
+  if (!g_enable_chunk_prefetch || table_id < 0 || col_ids.empty()) {
+    return;
+  }
+  const auto fragments_it = all_tables_fragments.find(table_id);
+  CHECK(fragments_it != all_tables_fragments.end());
+  const auto fragments = fragments_it->second;
+  const size_t next_frag_id = frag_id + 1;
+  if (next_frag_id >= fragments->size()) {
+    return;
+  }
+  const auto& fragment = (*fragments)[next_frag_id];
+  if (fragment.isEmptyPhysicalFragment()) {
+    return;
+  }
+  const auto& cat = *executor_->getCatalog();
+  std::vector<ChunkKey> chunk_keys;
+  for (const auto col_id : col_ids) {
+    chunk_keys.push_back(
+        {cat.getCurrentDB().dbId, fragment.physicalTableId, col_id, fragment.fragmentId});
+  }
+  cat.getDataMgr().prefetchChunks(chunk_keys);
+}
+
+const int8_t* ColumnFetcher::getOneTableColumnFragmentRows(
+    const int table_id,
+    const int frag_id,
+    const int col_id,
+    const std::map<int, const TableFragments*>& all_tables_fragments,
+    const std::vector<int64_t>& row_positions,
+    const size_t thread_idx) const {
+  CHECK_GT(table_id, 0);
+  const auto fragments_it = all_tables_fragments.find(table_id);
+  CHECK(fragments_it != all_tables_fragments.end());
+  const auto fragments = fragments_it->second;
+  const auto& fragment = (*fragments)[frag_id];
+  if (fragment.isEmptyPhysicalFragment() || row_positions.empty()) {
+    return nullptr;
+  }
+  const auto& cat = *executor_->getCatalog();
+  const auto td = cat.getMetadataForTable(fragment.physicalTableId, false);
+  if (!td || td->isForeignTable() ||
+      td->persistenceLevel != Data_Namespace::MemoryLevel::DISK_LEVEL) {
+    return nullptr;
+  }
+  const auto cd = get_column_descriptor(col_id, table_id, cat);
+  CHECK(cd);
+  CHECK(!cd->columnType.is_varlen());
+  // the pages of run length and differential encoded chunks don't hold fixed width rows,
+  // these chunks are only decoded as a whole
+  if (cd->columnType.get_compression() == kENCODING_RL ||
+      cd->columnType.get_compression() == kENCODING_DIFF) {
+    return nullptr;
+  }
+  auto chunk_meta_it = fragment.getChunkMetadataMap().find(col_id);
+  CHECK(chunk_meta_it != fragment.getChunkMetadataMap().end());
+  ChunkKey chunk_key{
+      cat.getCurrentDB().dbId, fragment.physicalTableId, col_id, fragment.fragmentId};
+  auto& data_mgr = cat.getDataMgr();
+  if (data_mgr.isBufferOnDevice(chunk_key, Data_Namespace::CPU_LEVEL, 0)) {
+    return nullptr;
+  }
+  const auto file_buffer = dynamic_cast<File_Namespace::FileBuffer*>(
+      data_mgr.getChunkBuffer(chunk_key,
+                              Data_Namespace::DISK_LEVEL,
+                              0,
+                              chunk_meta_it->second->numBytes));
+  if (!file_buffer) {
+    return nullptr;
+  }
+  const size_t elem_size = cd->columnType.get_size();
+  const size_t page_data_size = file_buffer->pageDataSize();
+  const size_t num_bytes = file_buffer->size();
+  CHECK_GT(elem_size, size_t(0));
+  CHECK_GT(page_data_size, size_t(0));
+  // the runs of consecutive pages holding the rows, as [first, last] page ranges
+  std::vector<std::pair<size_t, size_t>> page_runs;
+  size_t run_bytes{0};
+  for (const auto row_pos : row_positions) {
+    CHECK_GE(row_pos, 0);
+    const size_t first_page = row_pos * elem_size / page_data_size;
+    const size_t last_page = ((row_pos + 1) * elem_size - 1) / page_data_size;
+    if (!page_runs.empty() && first_page <= page_runs.back().second + 1) {
+      run_bytes += std::max(last_page, page_runs.back().second) - page_runs.back().second;
+      page_runs.back().second = std::max(last_page, page_runs.back().second);
+    } else {
+      page_runs.emplace_back(first_page, last_page);
+      run_bytes += last_page - first_page + 1;
+    }
+  }
+  run_bytes *= page_data_size;
+  if (2 * run_bytes > num_bytes) {
+    return nullptr;
+  }
+  auto buffer = executor_->getRowSetMemoryOwner()->allocate(num_bytes, thread_idx);
+  for (const auto& [first_page, last_page] : page_runs) {
+    const size_t offset = first_page * page_data_size;
+    CHECK_LT(offset, num_bytes);
+    const size_t run_end = std::min((last_page + 1) * page_data_size, num_bytes);
+    file_buffer->read(buffer + offset, run_end - offset, offset);
+  }
+  return buffer;
+}
+
 const int8_t* ColumnFetcher::getAllTableColumnFragments(
     const int table_id,
     const int col_id,
@@ -42,6 +42,9 @@ struct FetchResult {
   std::vector<std::vector<const int8_t*>> col_buffers;
   std::vector<std::vector<int64_t>> num_rows;
   std::vector<std::vector<uint64_t>> frag_offsets;
+  // the lazily fetched columns left null in `col_buffers`, as (local column id, column
+  // id) pairs, to be fetched once the kernel projected its rows
+  std::vector<std::pair<int, int>> deferred_columns;
 };
 
 using MergedChunk = std::pair<AbstractBuffer*, AbstractBuffer*>;
@@ -86,6 +89,26 @@ class ColumnFetcher {
       const int device_id,
       DeviceAllocator* device_allocator) const;
 
+  // Reads from disk only the pages of the fixed length column chunk which hold the rows
+  // at `row_positions` (sorted), into a buffer of the size of the chunk. Returns null
+  // when the chunk is resident in CPU memory or the pages would cover most of it, the
+  // chunk is then better fetched whole.
+  const int8_t* getOneTableColumnFragmentRows(
+      const int table_id,
+      const int frag_id,
+      const int col_id,
+      const std::map<int, const TableFragments*>& all_tables_fragments,
+      const std::vector<int64_t>& row_positions,
+      const size_t thread_idx) const;
+
+  // Hints the disk reads of the chunks of the columns in the fragment after `frag_id`,
+  // so that they overlap with the execution of the current fragment.
+  void prefetchNextFragment(
+      const int table_id,
+      const int frag_id,
+      const std::vector<int>& col_ids,
+      const std::map<int, const TableFragments*>& all_tables_fragments) const;
+
   const int8_t* getAllTableColumnFragments(
       const int table_id,
       const int col_id,
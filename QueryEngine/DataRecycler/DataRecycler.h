@@ -40,8 +40,8 @@ enum CacheItemType {
   HT_HASHING_SCHEME,          // Hashtable layout
   BASELINE_HT_APPROX_CARD,    // Approximated cardinality for baseline hashtable
   OVERLAPS_AUTO_TUNER_PARAM,  // Hashtable auto tuner's params for overlaps join
+  QUERY_RESULTSET,            // Final resultset of a query
   // TODO (yoonmin): support the following items for recycling
-  // ROW_RS,             Row-wise resultset
   // COUNTALL_CARD_EST,  Cardinality of query result
   // NDV_CARD_EST,       # Non-distinct value
   // FILTER_SEL          Selectivity of (push-downed) filter node
@@ -115,7 +115,7 @@ using CacheMetricInfoMap =
 
 class DataRecyclerUtil {
  public:
-  // need to add more constants if necessary: ROW_RS, COUNTALL_CARD_EST, NDV_CARD_EST,
+  // need to add more constants if necessary: COUNTALL_CARD_EST, NDV_CARD_EST,
   // FILTER_SEL, ...
   static constexpr auto cache_item_type_str =
       shared::string_view_array("Perfect Join Hashtable",
@@ -123,7 +123,8 @@ class DataRecyclerUtil {
                                 "Overlaps Join Hashtable",
                                 "Hashing Scheme for Join Hashtable",
                                 "Baseline Join Hashtable's Approximated Cardinality",
-                                "Overlaps Join Hashtable's Auto Tuner's Parameters");
+                                "Overlaps Join Hashtable's Auto Tuner's Parameters",
+                                "Query Resultset");
   static std::string_view toStringCacheItemType(CacheItemType item_type) {
     static_assert(cache_item_type_str.size() == NUM_CACHE_ITEM_TYPE);
     return cache_item_type_str[item_type];
@@ -0,0 +1,395 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ResultSetRecycler.h"
+
+#include "Catalog/Catalog.h"
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/QueryPhysicalInputsCollector.h"
+#include "QueryEngine/RelAlgVisitor.h"
+#include "QueryEngine/RexVisitor.h"
+
+extern bool g_is_test_env;
+
+std::unique_ptr<ResultSetRecycler> ResultSetRecyclerHolder::query_resultset_cache_ =
+    std::make_unique<ResultSetRecycler>();
+
+namespace {
+
+// functions whose value depends on the time (or the session) the query is executed
+bool is_non_deterministic_function(const std::string& func_name) {
+  static const std::unordered_set<std::string> non_deterministic_funcs{
+      "NOW", "CURRENT_DATE", "CURRENT_TIME", "CURRENT_TIMESTAMP", "CURRENT_USER"};
+  return non_deterministic_funcs.count(func_name);
+}
+
+class RelAlgNonCacheableNodeVisitor : public RelAlgVisitor<bool> {
+ public:
+  RelAlgNonCacheableNodeVisitor(const Catalog_Namespace::Catalog& catalog)
+      : catalog_(catalog) {}
+
+  bool visitCompound(const RelCompound* compound) const override;
+  bool visitFilter(const RelFilter* filter) const override;
+  bool visitJoin(const RelJoin* join) const override;
+  bool visitLeftDeepInnerJoin(const RelLeftDeepInnerJoin*) const override;
+  bool visitProject(const RelProject* project) const override;
+  bool visitScan(const RelScan* scan) const override;
+  bool visitModify(const RelModify*) const override { return true; }
+  bool visitTableFunction(const RelTableFunction*) const override { return true; }
+
+ protected:
+  bool aggregateResult(const bool& aggregate, const bool& next_result) const override {
+    return aggregate || next_result;
+  }
+
+ private:
+  const Catalog_Namespace::Catalog& catalog_;
+};
+
+class RexNonCacheableExprVisitor : public RexVisitor<bool> {
+ public:
+  RexNonCacheableExprVisitor(const Catalog_Namespace::Catalog& catalog)
+      : catalog_(catalog) {}
+
+  bool visitSubQuery(const RexSubQuery* subquery) const override {
+    const auto ra = subquery->getRelAlg();
+    CHECK(ra);
+    RelAlgNonCacheableNodeVisitor visitor(catalog_);
+    return visitor.visit(ra);
+  }
+
+  bool visitOperator(const RexOperator* oper) const override {
+    const auto func_oper = dynamic_cast<const RexFunctionOperator*>(oper);
+    if (func_oper && is_non_deterministic_function(func_oper->getName())) {
+      return true;
+    }
+    // DATETIME('NOW') is translated to the current timestamp
+    if (func_oper && func_oper->getName() == "DATETIME" && func_oper->size() == 1) {
+      auto arg = func_oper->getOperand(0);
+      const auto cast_oper = dynamic_cast<const RexOperator*>(arg);
+      if (cast_oper && cast_oper->getOperator() == kCAST && cast_oper->size() == 1) {
+        arg = cast_oper->getOperand(0);
+      }
+      const auto literal = dynamic_cast<const RexLiteral*>(arg);
+      if (literal && literal->getType() == kTEXT &&
+          literal->getVal<std::string>() == "NOW") {
+        return true;
+      }
+    }
+    return RexVisitor<bool>::visitOperator(oper);
+  }
+
+ protected:
+  bool aggregateResult(const bool& aggregate, const bool& next_result) const override {
+    return aggregate || next_result;
+  }
+
+ private:
+  const Catalog_Namespace::Catalog& catalog_;
+};
+
+bool RelAlgNonCacheableNodeVisitor::visitCompound(const RelCompound* compound) const {
+  RexNonCacheableExprVisitor visitor(catalog_);
+  for (size_t i = 0; i < compound->getScalarSourcesSize(); ++i) {
+    const auto rex = compound->getScalarSource(i);
+    CHECK(rex);
+    if (visitor.visit(rex)) {
+      return true;
+    }
+  }
+  const auto filter = compound->getFilterExpr();
+  return filter && visitor.visit(filter);
+}
+
+bool RelAlgNonCacheableNodeVisitor::visitFilter(const RelFilter* filter) const {
+  const auto condition = filter->getCondition();
+  CHECK(condition);
+  RexNonCacheableExprVisitor visitor(catalog_);
+  return visitor.visit(condition);
+}
+
+bool RelAlgNonCacheableNodeVisitor::visitJoin(const RelJoin* join) const {
+  const auto condition = join->getCondition();
+  if (!condition) {
+    return false;
+  }
+  RexNonCacheableExprVisitor visitor(catalog_);
+  return visitor.visit(condition);
+}
+
+bool RelAlgNonCacheableNodeVisitor::visitLeftDeepInnerJoin(
+    const RelLeftDeepInnerJoin* left_deep_inner_join) const {
+  RexNonCacheableExprVisitor visitor(catalog_);
+  const auto condition = left_deep_inner_join->getInnerCondition();
+  if (condition && visitor.visit(condition)) {
+    return true;
+  }
+  CHECK_GE(left_deep_inner_join->inputCount(), size_t(2));
+  for (size_t nesting_level = 1; nesting_level <= left_deep_inner_join->inputCount() - 1;
+       ++nesting_level) {
+    const auto outer_condition = left_deep_inner_join->getOuterCondition(nesting_level);
+    if (outer_condition && visitor.visit(outer_condition)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RelAlgNonCacheableNodeVisitor::visitProject(const RelProject* project) const {
+  RexNonCacheableExprVisitor visitor(catalog_);
+  for (size_t i = 0; i < project->size(); ++i) {
+    const auto rex = project->getProjectAt(i);
+    CHECK(rex);
+    if (visitor.visit(rex)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool RelAlgNonCacheableNodeVisitor::visitScan(const RelScan* scan) const {
+  const auto td = scan->getTableDescriptor();
+  CHECK(td);
+  // system tables depend on point in time data snapshots
+  return td->is_system_table;
+}
+
+}  // namespace
+
+bool ResultSetRecycler::hasItemInCache(QueryPlanHash key,
+                                       CacheItemType item_type,
+                                       DeviceIdentifier device_identifier,
+                                       std::lock_guard<std::mutex>& lock,
+                                       std::optional<ResultSetMetaInfo> meta_info) const {
+  if (!g_enable_data_recycler || !g_use_query_resultset_cache ||
+      key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return false;
+  }
+  auto resultset_cache = getCachedItemContainer(item_type, device_identifier);
+  CHECK(resultset_cache);
+  return getCachedItem(key, *resultset_cache).has_value();
+}
+
+ResultSetPtr ResultSetRecycler::getItemFromCache(
+    QueryPlanHash key,
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    std::optional<ResultSetMetaInfo> meta_info) const {
+  if (!g_enable_data_recycler || !g_use_query_resultset_cache ||
+      key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto resultset_cache = getCachedItemContainer(item_type, device_identifier);
+  CHECK(resultset_cache);
+  auto candidate_rs = getCachedItem(key, *resultset_cache);
+  if (candidate_rs) {
+    candidate_rs->item_metric->incRefCount();
+    VLOG(1) << "[" << DataRecyclerUtil::toStringCacheItemType(item_type) << ", "
+            << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+            << "] Recycle item in a cache";
+    return candidate_rs->cached_item->copy();
+  }
+  return nullptr;
+}
+
+std::optional<ResultSetMetaInfo> ResultSetRecycler::getResultSetMetaInfo(
+    QueryPlanHash key) const {
+  if (!g_enable_data_recycler || !g_use_query_resultset_cache ||
+      key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return std::nullopt;
+  }
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  auto resultset_cache = getCachedItemContainer(CacheItemType::QUERY_RESULTSET,
+                                                DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+  CHECK(resultset_cache);
+  auto candidate_rs = getCachedItem(key, *resultset_cache);
+  return candidate_rs ? candidate_rs->meta_info : std::nullopt;
+}
+
+void ResultSetRecycler::putItemToCache(QueryPlanHash key,
+                                       ResultSetPtr item_ptr,
+                                       CacheItemType item_type,
+                                       DeviceIdentifier device_identifier,
+                                       size_t item_size,
+                                       size_t compute_time,
+                                       std::optional<ResultSetMetaInfo> meta_info) {
+  if (!g_enable_data_recycler || !g_use_query_resultset_cache ||
+      key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return;
+  }
+  CHECK(meta_info);
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  if (!hasItemInCache(key, item_type, device_identifier, lock, meta_info)) {
+    auto& metric_tracker = getMetricTracker(item_type);
+    auto cache_status = metric_tracker.canAddItem(device_identifier, item_size);
+    if (cache_status == CacheAvailability::UNAVAILABLE) {
+      // resultset is too large
+      return;
+    } else if (cache_status == CacheAvailability::AVAILABLE_AFTER_CLEANUP) {
+      auto required_size = metric_tracker.calculateRequiredSpaceForItemAddition(
+          device_identifier, item_size);
+      cleanupCacheForInsertion(item_type, device_identifier, required_size, lock);
+    }
+    auto new_cache_metric_ptr = metric_tracker.putNewCacheItemMetric(
+        key, device_identifier, item_size, compute_time);
+    CHECK_EQ(item_size, new_cache_metric_ptr->getMemSize());
+    metric_tracker.updateCurrentCacheSize(
+        device_identifier, CacheUpdateAction::ADD, item_size);
+    VLOG(1) << "[" << DataRecyclerUtil::toStringCacheItemType(item_type) << ", "
+            << DataRecyclerUtil::getDeviceIdentifierString(device_identifier)
+            << "] Put item to cache";
+    auto resultset_cache = getCachedItemContainer(item_type, device_identifier);
+    // the caller keeps consuming the given resultset, so we cache our own copy
+    resultset_cache->emplace_back(
+        key, item_ptr->copy(), new_cache_metric_ptr, meta_info);
+  }
+  // this resultset is already cached
+  return;
+}
+
+void ResultSetRecycler::removeItemFromCache(QueryPlanHash key,
+                                            CacheItemType item_type,
+                                            DeviceIdentifier device_identifier,
+                                            std::lock_guard<std::mutex>& lock,
+                                            std::optional<ResultSetMetaInfo> meta_info) {
+  if (!g_enable_data_recycler || !g_use_query_resultset_cache ||
+      key == EMPTY_HASHED_PLAN_DAG_KEY) {
+    return;
+  }
+  auto& metric_tracker = getMetricTracker(item_type);
+  auto cache_metric = metric_tracker.getCacheItemMetric(key, device_identifier);
+  CHECK(cache_metric);
+  auto resultset_size = cache_metric->getMemSize();
+  auto resultset_container = getCachedItemContainer(item_type, device_identifier);
+  auto filter = [key](auto const& item) { return item.key == key; };
+  auto itr =
+      std::find_if(resultset_container->cbegin(), resultset_container->cend(), filter);
+  if (itr == resultset_container->cend()) {
+    return;
+  }
+  resultset_container->erase(itr);
+  metric_tracker.removeCacheItemMetric(key, device_identifier);
+  metric_tracker.updateCurrentCacheSize(
+      device_identifier, CacheUpdateAction::REMOVE, resultset_size);
+}
+
+void ResultSetRecycler::cleanupCacheForInsertion(
+    CacheItemType item_type,
+    DeviceIdentifier device_identifier,
+    size_t required_size,
+    std::lock_guard<std::mutex>& lock,
+    std::optional<ResultSetMetaInfo> meta_info) {
+  // evict the least important cached resultsets first (by # referenced, size and
+  // compute time) until we have enough space to put the new one
+  auto& metric_tracker = getMetricTracker(item_type);
+  auto actual_space_to_free = metric_tracker.getTotalCacheSize() / 2;
+  if (!g_is_test_env && required_size < actual_space_to_free) {
+    // remove enough items to avoid too frequent cache cleanup
+    required_size = actual_space_to_free;
+  }
+  sortCacheContainerByQueryMetric(item_type, device_identifier);
+  auto resultset_container = getCachedItemContainer(item_type, device_identifier);
+  std::vector<QueryPlanHash> elimination_targets;
+  size_t removed_size = 0;
+  for (auto& cached_item : *resultset_container) {
+    elimination_targets.push_back(cached_item.key);
+    removed_size += cached_item.item_metric->getMemSize();
+    if (removed_size > required_size) {
+      break;
+    }
+  }
+  for (auto key : elimination_targets) {
+    removeItemFromCache(key, item_type, device_identifier, lock);
+  }
+}
+
+void ResultSetRecycler::clearCache() {
+  std::lock_guard<std::mutex> lock(getCacheLock());
+  for (auto& item_type : getCacheItemType()) {
+    getMetricTracker(item_type).clearCacheMetricTracker();
+    auto item_cache = getItemCache().find(item_type)->second;
+    for (auto& kv : *item_cache) {
+      kv.second->clear();
+    }
+  }
+}
+
+std::string ResultSetRecycler::toString() const {
+  std::ostringstream oss;
+  oss << "A current status of the Query Resultset Recycler:\n";
+  for (auto& item_type : getCacheItemType()) {
+    oss << "\t" << DataRecyclerUtil::toStringCacheItemType(item_type);
+    auto& metric_tracker = getMetricTracker(item_type);
+    oss << "\n\t# cached resultsets:\n";
+    auto item_cache = getItemCache().find(item_type)->second;
+    for (auto& cache_container : *item_cache) {
+      oss << "\t\tDevice"
+          << DataRecyclerUtil::getDeviceIdentifierString(cache_container.first)
+          << ", # resultsets: " << cache_container.second->size() << "\n";
+      for (auto& rs : *cache_container.second) {
+        oss << "\t\t\tRS] " << rs.item_metric->toString() << "\n";
+      }
+    }
+    oss << "\t" << metric_tracker.toString() << "\n";
+  }
+  return oss.str();
+}
+
+QueryPlanHash ResultSetRecycler::getResultSetCacheKey(
+    const RelAlgNode* root_node,
+    const Catalog_Namespace::Catalog& catalog,
+    const Executor* executor) {
+  if (!g_enable_data_recycler || !g_use_query_resultset_cache) {
+    return EMPTY_HASHED_PLAN_DAG_KEY;
+  }
+  CHECK(root_node);
+  CHECK(executor);
+  RelAlgNonCacheableNodeVisitor non_cacheable_node_visitor(catalog);
+  if (non_cacheable_node_visitor.visit(root_node)) {
+    return EMPTY_HASHED_PLAN_DAG_KEY;
+  }
+  // tables read by subqueries are not visible to the scan node visitor, so we also
+  // collect the tables of the physical input columns
+  auto input_table_ids = get_physical_table_inputs(root_node);
+  for (const auto& phys_input : get_physical_inputs(root_node)) {
+    input_table_ids.insert(phys_input.table_id);
+  }
+  std::set<int> sorted_input_table_ids(input_table_ids.begin(), input_table_ids.end());
+  auto cache_key = root_node->toHash();
+  boost::hash_combine(cache_key, catalog.getDatabaseId());
+  for (const auto table_id : sorted_input_table_ids) {
+    const auto table_info = executor->getTableInfo(table_id);
+    boost::hash_combine(cache_key, table_id);
+    boost::hash_combine(cache_key, table_info.getPhysicalNumTuples());
+  }
+  return cache_key == EMPTY_HASHED_PLAN_DAG_KEY ? EMPTY_HASHED_PLAN_DAG_KEY + 1
+                                                : cache_key;
+}
+
+bool ResultSetRecycler::isCacheableResultSet(const ResultSetPtr& rs) {
+  if (!rs || rs->isExplain() || rs->isValidationOnlyRes() || !rs->getStorage()) {
+    return false;
+  }
+  // lazily fetched columns point to the chunks of the buffer pool, so keeping them
+  // alive in the cache would pin those chunks
+  const auto& lazy_fetch_info = rs->getLazyFetchInfo();
+  return std::none_of(lazy_fetch_info.begin(),
+                      lazy_fetch_info.end(),
+                      [](const ColumnLazyFetchInfo& col_lazy_fetch_info) {
+                        return col_lazy_fetch_info.is_lazily_fetched;
+                      });
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include "DataRecycler.h"
+
+extern bool g_use_query_resultset_cache;
+extern size_t g_query_resultset_cache_total_bytes;
+extern size_t g_max_cacheable_query_resultset_size_bytes;
+
+namespace Catalog_Namespace {
+class Catalog;
+}
+
+class Executor;
+
+struct ResultSetMetaInfo {
+  // output metainfo of the root rel node, required to rebuild the execution result
+  std::vector<TargetMetaInfo> targets_meta;
+};
+
+// Recycles the final resultset of a query
+// A cache key consists of the hashed query plan (the same node hash the query plan DAG
+// cache uses to identify each rel node) of the root node, the database id and the
+// table generation (# tuples) of every physical input table, so appending rows to one
+// of input tables naturally makes the cached resultset unreachable. Other modifications
+// (update, delete, truncate, drop, foreign table refresh, ...) clear the cache via
+// the external cache invalidators.
+// A cached resultset is never handed out as is since consumers iterate, sort and
+// truncate it in-place; we keep our own copy at insertion and return a fresh copy
+// per cache hit instead
+class ResultSetRecycler : public DataRecycler<ResultSetPtr, ResultSetMetaInfo> {
+ public:
+  ResultSetRecycler()
+      : DataRecycler({CacheItemType::QUERY_RESULTSET},
+                     g_query_resultset_cache_total_bytes,
+                     g_max_cacheable_query_resultset_size_bytes,
+                     0) {}
+
+  ResultSetPtr getItemFromCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::optional<ResultSetMetaInfo> meta_info = std::nullopt) const override;
+
+  void putItemToCache(QueryPlanHash key,
+                      ResultSetPtr item_ptr,
+                      CacheItemType item_type,
+                      DeviceIdentifier device_identifier,
+                      size_t item_size,
+                      size_t compute_time,
+                      std::optional<ResultSetMetaInfo> meta_info = std::nullopt) override;
+
+  // nothing to do with resultset recycler
+  void initCache() override {}
+
+  void clearCache() override;
+
+  std::string toString() const override;
+
+  std::optional<ResultSetMetaInfo> getResultSetMetaInfo(QueryPlanHash key) const;
+
+  // returns EMPTY_HASHED_PLAN_DAG_KEY if the query plan rooted at the given node
+  // is not safe to recycle its resultset, i.e., it contains non-deterministic functions
+  // or it reads system tables which are point in time data snapshots
+  static QueryPlanHash getResultSetCacheKey(const RelAlgNode* root_node,
+                                            const Catalog_Namespace::Catalog& catalog,
+                                            const Executor* executor);
+
+  static bool isCacheableResultSet(const ResultSetPtr& rs);
+
+ private:
+  bool hasItemInCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<ResultSetMetaInfo> meta_info = std::nullopt) const override;
+
+  void removeItemFromCache(
+      QueryPlanHash key,
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<ResultSetMetaInfo> meta_info = std::nullopt) override;
+
+  void cleanupCacheForInsertion(
+      CacheItemType item_type,
+      DeviceIdentifier device_identifier,
+      size_t required_size,
+      std::lock_guard<std::mutex>& lock,
+      std::optional<ResultSetMetaInfo> meta_info = std::nullopt) override;
+};
+
+// cache holding type of the resultset recycler for the external cache invalidators
+class ResultSetRecyclerHolder {
+ public:
+  static ResultSetRecycler* getResultSetRecycler() {
+    CHECK(query_resultset_cache_);
+    return query_resultset_cache_.get();
+  }
+
+  static auto getCacheInvalidator() -> std::function<void()> {
+    CHECK(query_resultset_cache_);
+    return []() -> void {
+      auto main_cache_invalidator = query_resultset_cache_->getCacheInvalidator();
+      main_cache_invalidator();
+    };
+  }
+
+ private:
+  static std::unique_ptr<ResultSetRecycler> query_resultset_cache_;
+};
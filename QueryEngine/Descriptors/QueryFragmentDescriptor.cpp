@@ -154,7 +154,8 @@ void QueryFragmentDescriptor::buildFragmentPerKernelForTable(
     const auto& fragment = (*fragments)[i];
     const auto skip_frag = executor->skipFragment(
         table_desc, fragment, ra_exe_unit.simple_quals, frag_offsets, i);
-    if (skip_frag.first) {
+    if (skip_frag.first ||
+        executor->skipFragmentByStringBloomFilters(fragment, ra_exe_unit.quals)) {
       continue;
     }
     rowid_lookup_key_ = std::max(rowid_lookup_key_, skip_frag.second);
@@ -387,7 +388,8 @@ void QueryFragmentDescriptor::buildMultifragKernelMap(
       skip_frag = executor->skipFragmentInnerJoins(
           outer_table_desc, ra_exe_unit, fragment, frag_offsets, outer_frag_id);
     }
-    if (skip_frag.first) {
+    if (skip_frag.first ||
+        executor->skipFragmentByStringBloomFilters(fragment, ra_exe_unit.quals)) {
       continue;
     }
     const int device_id =
@@ -614,6 +614,9 @@ bool QueryMemoryDescriptor::operator==(const QueryMemoryDescriptor& other) const
   if (interleaved_bins_on_gpu_ != other.interleaved_bins_on_gpu_) {
     return false;
   }
+  if (adaptive_entry_count_ != other.adaptive_entry_count_) {
+    return false;
+  }
   if (idx_target_as_key_ != other.idx_target_as_key_) {
     return false;
   }
@@ -1194,6 +1197,7 @@ std::string QueryMemoryDescriptor::toString() const {
       "\tLazy Init Groups (GPU): " + ::toString(lazyInitGroups(ExecutorDeviceType::GPU)) +
       "\n";
   str += "\tEntry Count: " + std::to_string(entry_count_) + "\n";
+  str += "\tAdaptive Entry Count: " + ::toString(adaptive_entry_count_) + "\n";
   str += "\tMin Val (perfect hash only): " + std::to_string(min_val_) + "\n";
   str += "\tMax Val (perfect hash only): " + std::to_string(max_val_) + "\n";
   str += "\tBucket Val (perfect hash only): " + std::to_string(bucket_) + "\n";
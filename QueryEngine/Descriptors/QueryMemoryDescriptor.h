@@ -179,6 +179,11 @@ class QueryMemoryDescriptor {
   bool hasInterleavedBinsOnGpu() const { return interleaved_bins_on_gpu_; }
   void setHasInterleavedBinsOnGpu(const bool val) { interleaved_bins_on_gpu_ = val; }
 
+  // the entry count of a baseline hash buffer is read at runtime, so that the buffer can
+  // grow when it runs out of slots
+  bool hasAdaptiveEntryCount() const { return adaptive_entry_count_; }
+  void setHasAdaptiveEntryCount(const bool val) { adaptive_entry_count_ = val; }
+
   int32_t getTargetIdxForKey() const { return idx_target_as_key_; }
   void setTargetIdxForKey(const int32_t val) { idx_target_as_key_ = val; }
 
@@ -376,6 +381,7 @@ class QueryMemoryDescriptor {
   bool use_streaming_top_n_;
 
   bool force_4byte_float_;
+  bool adaptive_entry_count_{false};
 
   ColSlotContext col_slot_context_;
 
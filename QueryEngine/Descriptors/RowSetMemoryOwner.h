@@ -41,44 +41,75 @@ class ResultSet;
 
 /**
  * Handles allocations and outputs for all stages in a query, either explicitly or via a
- * managed allocator object
+ * managed allocator object.
+ *
+ * Allocations are served from one arena per kernel thread. The arena at index 0 is shared
+ * by all the callers which are not kernel threads and is guarded by the state mutex, the
+ * other ones belong to a single kernel thread at a time (see getKernelThreadIdx()) and
+ * allocate without taking any lock.
  */
 class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
  public:
   RowSetMemoryOwner(const size_t arena_block_size, const size_t num_kernel_threads = 0)
       : arena_block_size_(arena_block_size) {
     for (size_t i = 0; i < num_kernel_threads + 1; i++) {
-      allocators_.emplace_back(std::make_unique<Arena>(arena_block_size));
+      allocators_.emplace_back(std::make_unique<ThreadAllocator>(arena_block_size));
     }
     CHECK(!allocators_.empty());
   }
 
+  /**
+   * Returns the arena index to use for the allocations of the kernel running on the
+   * calling thread: the index of the calling worker in its TBB arena plus one, or the
+   * shared index 0 if the calling thread is not a TBB worker or there are not enough
+   * arenas.
+   */
+  size_t getKernelThreadIdx() const;
+
   int8_t* allocate(const size_t num_bytes, const size_t thread_idx = 0) override {
     CHECK_LT(thread_idx, allocators_.size());
-    auto allocator = allocators_[thread_idx].get();
+    auto& allocator = allocators_[thread_idx]->arena;
+    if (thread_idx) {
+      return reinterpret_cast<int8_t*>(allocator.allocate(num_bytes));
+    }
     std::lock_guard<std::mutex> lock(state_mutex_);
-    return reinterpret_cast<int8_t*>(allocator->allocate(num_bytes));
+    return reinterpret_cast<int8_t*>(allocator.allocate(num_bytes));
   }
 
   int8_t* allocateCountDistinctBuffer(const size_t num_bytes,
                                       const size_t thread_idx = 0) {
     int8_t* buffer = allocate(num_bytes, thread_idx);
     std::memset(buffer, 0, num_bytes);
-    addCountDistinctBuffer(buffer, num_bytes, /*physical_buffer=*/true);
+    addCountDistinctBuffer(buffer, num_bytes, /*physical_buffer=*/true, thread_idx);
     return buffer;
   }
 
   void addCountDistinctBuffer(int8_t* count_distinct_buffer,
                               const size_t bytes,
-                              const bool physical_buffer) {
+                              const bool physical_buffer,
+                              const size_t thread_idx = 0) {
+    CHECK_LT(thread_idx, allocators_.size());
+    auto& count_distinct_bitmaps = allocators_[thread_idx]->count_distinct_bitmaps;
+    if (thread_idx) {
+      count_distinct_bitmaps.emplace_back(
+          CountDistinctBitmapBuffer{count_distinct_buffer, bytes, physical_buffer});
+      return;
+    }
     std::lock_guard<std::mutex> lock(state_mutex_);
-    count_distinct_bitmaps_.emplace_back(
+    count_distinct_bitmaps.emplace_back(
         CountDistinctBitmapBuffer{count_distinct_buffer, bytes, physical_buffer});
   }
 
-  void addCountDistinctSet(robin_hood::unordered_set<int64_t>* count_distinct_set) {
+  void addCountDistinctSet(robin_hood::unordered_set<int64_t>* count_distinct_set,
+                           const size_t thread_idx = 0) {
+    CHECK_LT(thread_idx, allocators_.size());
+    auto& count_distinct_sets = allocators_[thread_idx]->count_distinct_sets;
+    if (thread_idx) {
+      count_distinct_sets.push_back(count_distinct_set);
+      return;
+    }
     std::lock_guard<std::mutex> lock(state_mutex_);
-    count_distinct_sets_.push_back(count_distinct_set);
+    count_distinct_sets.push_back(count_distinct_set);
   }
 
   void addGroupByBuffer(int64_t* group_by_buffer) {
@@ -161,8 +192,10 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   }
 
   ~RowSetMemoryOwner() {
-    for (auto count_distinct_set : count_distinct_sets_) {
-      delete count_distinct_set;
+    for (auto& allocator : allocators_) {
+      for (auto count_distinct_set : allocator->count_distinct_sets) {
+        delete count_distinct_set;
+      }
     }
     for (auto group_by_buffer : group_by_buffers_) {
       free(group_by_buffer);
@@ -203,8 +236,6 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
     const bool physical_buffer;
   };
 
-  std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps_;
-  std::vector<robin_hood::unordered_set<int64_t>*> count_distinct_sets_;
   std::vector<int64_t*> group_by_buffers_;
   std::vector<void*> varlen_buffers_;
   std::list<std::string> strings_;
@@ -216,8 +247,18 @@ class RowSetMemoryOwner final : public SimpleAllocator, boost::noncopyable {
   std::vector<Data_Namespace::AbstractBuffer*> varlen_input_buffers_;
   std::vector<std::unique_ptr<quantile::TDigest>> t_digests_;
 
+  // the arena and the count distinct buffers of a kernel thread, only the kernel thread
+  // owning the index touches them unless the index is 0
+  struct ThreadAllocator {
+    explicit ThreadAllocator(const size_t arena_block_size) : arena(arena_block_size) {}
+
+    Arena arena;
+    std::vector<CountDistinctBitmapBuffer> count_distinct_bitmaps;
+    std::vector<robin_hood::unordered_set<int64_t>*> count_distinct_sets;
+  };
+
   size_t arena_block_size_;  // for cloning
-  std::vector<std::unique_ptr<Arena>> allocators_;
+  std::vector<std::unique_ptr<ThreadAllocator>> allocators_;
 
   mutable std::mutex state_mutex_;
 
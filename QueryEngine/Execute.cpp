@@ -32,9 +32,15 @@
 #include <numeric>
 #include <thread>
 
+#ifdef HAVE_TBB
+#include <tbb/task_arena.h>
+#endif  // HAVE_TBB
+
 #include "Catalog/Catalog.h"
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/BufferMgr/BufferMgr.h"
+#include "DataMgr/BloomFilter.h"
+#include "DataMgr/ZoneMap.h"
 #include "Parser/ParserNode.h"
 #include "QueryEngine/AggregateUtils.h"
 #include "QueryEngine/AggregatedColRange.h"
@@ -87,6 +93,7 @@ unsigned g_trivial_loop_join_threshold{1000};
 bool g_from_table_reordering{true};
 bool g_inner_join_fragment_skipping{true};
 extern bool g_enable_smem_group_by;
+extern size_t g_watchdog_baseline_max_groups;
 extern std::unique_ptr<llvm::Module> udf_gpu_module;
 extern std::unique_ptr<llvm::Module> udf_cpu_module;
 bool g_enable_filter_push_down{false};
@@ -101,10 +108,15 @@ bool g_enable_distance_rangejoin{true};
 bool g_enable_hashjoin_many_to_many{false};
 size_t g_overlaps_max_table_size_bytes{1024 * 1024 * 1024};
 double g_overlaps_target_entries_per_bin{1.3};
+bool g_enable_sort_merge_join{true};
+size_t g_sort_merge_join_max_hash_table_bytes{1024 * 1024 * 1024};
 bool g_strip_join_covered_quals{false};
 size_t g_constrained_by_in_threshold{10};
 size_t g_default_max_groups_buffer_entry_guess{16384};
 size_t g_big_group_threshold{g_default_max_groups_buffer_entry_guess};
+bool g_enable_adaptive_group_by{false};
+bool g_enable_partitioned_reduction{true};
+size_t g_partitioned_reduction_min_entries{1000000};
 bool g_enable_window_functions{true};
 bool g_enable_table_functions{false};
 size_t g_max_memory_allocation_size{2000000000};  // set to max slab size
@@ -113,6 +125,14 @@ size_t g_min_memory_allocation_size{
            // without pre-flight count
 bool g_enable_bump_allocator{false};
 double g_bump_allocator_step_reduction{0.75};
+bool g_enable_vectorized_interpreter{false};
+size_t g_vectorized_interpreter_max_rows{100000};  // max # input rows to run a query
+                                                  // on the vectorized interpreter
+bool g_enable_async_reduction_jit{false};  // run the reduction on the interpreter while
+                                          // its native code compiles in the background
+bool g_enable_persistent_code_cache{false};
+std::string g_persistent_code_cache_path{""};  // defaults to <base path>/omnisci_code_cache
+size_t g_persistent_code_cache_max_size_bytes{1UL << 30};  // 1GB
 bool g_enable_direct_columnarization{true};
 extern bool g_enable_experimental_string_functions;
 bool g_enable_lazy_fetch{true};
@@ -141,6 +161,9 @@ bool g_enable_data_recycler{true};
 bool g_use_hashtable_cache{true};
 size_t g_hashtable_cache_total_bytes{size_t(1) << 32};
 size_t g_max_cacheable_hashtable_size_bytes{size_t(1) << 31};
+bool g_use_query_resultset_cache{false};
+size_t g_query_resultset_cache_total_bytes{size_t(1) << 32};
+size_t g_max_cacheable_query_resultset_size_bytes{size_t(1) << 31};
 
 size_t g_approx_quantile_buffer{1000};
 size_t g_approx_quantile_centroids{300};
@@ -149,6 +172,10 @@ bool g_enable_automatic_ir_metadata{true};
 
 extern bool g_cache_string_hash;
 bool g_enable_multifrag_rs{false};
+bool g_enable_chunk_prefetch{true};
+bool g_enable_late_materialization{true};
+bool g_enable_radix_partitioned_join_build{true};
+size_t g_radix_partitioned_join_build_threshold{10000000};
 
 int const Executor::max_gpu_count;
 
@@ -272,6 +299,18 @@ quantile::TDigest* RowSetMemoryOwner::nullTDigest(double const q) {
       .get();
 }
 
+size_t RowSetMemoryOwner::getKernelThreadIdx() const {
+#ifdef HAVE_TBB
+  // a TBB worker runs a single kernel at a time, kernels it picks up while waiting on
+  // another one only interleave with it
+  const auto worker_idx = tbb::this_task_arena::current_thread_index();
+  if (worker_idx >= 0 && static_cast<size_t>(worker_idx) + 1 < allocators_.size()) {
+    return worker_idx + 1;
+  }
+#endif  // HAVE_TBB
+  return 0;
+}
+
 bool Executor::isCPUOnly() const {
   CHECK(data_mgr_);
   return !data_mgr_->getCudaMgr();
@@ -994,6 +1033,20 @@ ReductionCode get_reduction_code(
   return reduction_jit.codegen();
 };
 
+bool use_partitioned_reduction(
+    const std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device,
+    const size_t total_entry_count) {
+  if (!g_enable_partitioned_reduction || g_cluster || cpu_threads() < 2 ||
+      total_entry_count < g_partitioned_reduction_min_entries) {
+    return false;
+  }
+  return std::all_of(results_per_device.begin(),
+                     results_per_device.end(),
+                     [](const std::pair<ResultSetPtr, std::vector<size_t>>& rs) {
+                       return rs.first->getStorage() != nullptr;
+                     });
+}
+
 }  // namespace
 
 bool couldUseParallelReduce(const QueryMemoryDescriptor& desc) {
@@ -1030,6 +1083,9 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
           return init + r->getQueryMemDesc().getEntryCount();
         });
     CHECK(total_entry_count);
+    if (use_partitioned_reduction(results_per_device, total_entry_count)) {
+      return reducePartitionedResultSets(results_per_device, row_set_mem_owner);
+    }
     auto query_mem_desc = first->getQueryMemDesc();
     query_mem_desc.setEntryCount(total_entry_count);
     reduced_results = std::make_shared<ResultSet>(first->getTargetInfos(),
@@ -1099,6 +1155,89 @@ ResultSetPtr Executor::reduceMultiDeviceResultSets(
   return reduced_results;
 }
 
+// Reduces the baseline hash results of the kernels by partitions of their groups: every
+// kernel result is split by the hash of the group keys, then the partitions are reduced
+// in parallel. The groups of different partitions are disjoint, so the reduced
+// partitions are appended as the storages of the result rather than concatenated.
+ResultSetPtr Executor::reducePartitionedResultSets(
+    std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device,
+    std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner) const {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto& first = results_per_device.front().first;
+  const size_t partition_count = cpu_threads();
+  const size_t device_count = results_per_device.size();
+  VLOG(1) << "Reducing " << device_count << " results by " << partition_count
+          << " partitions of their groups";
+
+  std::vector<std::vector<std::unique_ptr<ResultSet>>> partitions_per_device(
+      device_count);
+  threading::parallel_for(threading::blocked_range<size_t>(0, device_count),
+                          [&](auto r) {
+                            for (size_t i = r.begin(); i != r.end(); ++i) {
+                              partitions_per_device[i] =
+                                  results_per_device[i].first->partitionBaselineEntries(
+                                      partition_count);
+                            }
+                          });
+
+  int64_t compilation_queue_time = 0;
+  const auto reduction_code =
+      get_reduction_code(results_per_device, &compilation_queue_time);
+
+  std::vector<std::shared_ptr<ResultSet>> reduced_partitions(partition_count);
+  threading::parallel_for(
+      threading::blocked_range<size_t>(0, partition_count), [&](auto r) {
+        for (size_t partition = r.begin(); partition != r.end(); ++partition) {
+          size_t entry_count{0};
+          for (const auto& device_partitions : partitions_per_device) {
+            if (const auto& device_partition = device_partitions[partition]) {
+              entry_count += device_partition->getQueryMemDesc().getEntryCount();
+            }
+          }
+          if (!entry_count) {
+            continue;
+          }
+          auto query_mem_desc = first->getQueryMemDesc();
+          query_mem_desc.setEntryCount(entry_count);
+          auto reduced_partition = std::make_shared<ResultSet>(first->getTargetInfos(),
+                                                               ExecutorDeviceType::CPU,
+                                                               query_mem_desc,
+                                                               row_set_mem_owner,
+                                                               catalog_,
+                                                               blockSize(),
+                                                               gridSize());
+          auto result_storage =
+              reduced_partition->allocateStorage(plan_state_->init_agg_vals_);
+          reduced_partition->initializeStorage();
+          for (const auto& device_partitions : partitions_per_device) {
+            if (device_partitions[partition]) {
+              result_storage->reduce(
+                  *device_partitions[partition]->getStorage(), {}, reduction_code);
+            }
+          }
+          reduced_partitions[partition] = reduced_partition;
+        }
+      });
+
+  std::shared_ptr<ResultSet> reduced_results;
+  for (const auto& reduced_partition : reduced_partitions) {
+    if (!reduced_partition) {
+      continue;
+    }
+    if (reduced_results) {
+      reduced_results->append(*reduced_partition);
+    } else {
+      reduced_results = reduced_partition;
+    }
+  }
+  if (!reduced_results) {
+    // none of the kernels found a group
+    return first;
+  }
+  reduced_results->addCompilationQueueTime(compilation_queue_time);
+  return reduced_results;
+}
+
 ResultSetPtr Executor::reduceSpeculativeTopN(
     const RelAlgExecutionUnit& ra_exe_unit,
     std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& results_per_device,
@@ -1823,6 +1962,7 @@ void Executor::addTransientStringLiterals(
           CHECK(sdp);
           TransientStringLiteralsVisitor visitor(sdp);
           visitor.visit(expr);
+          visitor.addTransientStrings();
         }
       };
 
@@ -2334,17 +2474,11 @@ void Executor::launchKernels(SharedKernelContext& shared_context,
 
   VLOG(1) << "Launching " << kernels.size() << " kernels for query on "
           << (device_type == ExecutorDeviceType::CPU ? "CPU"s : "GPU"s) << ".";
-  size_t kernel_idx = 1;
   for (auto& kernel : kernels) {
     CHECK(kernel.get());
-    tg.run([this,
-            &kernel,
-            &shared_context,
-            parent_thread_id = logger::thread_id(),
-            crt_kernel_idx = kernel_idx++] {
+    tg.run([this, &kernel, &shared_context, parent_thread_id = logger::thread_id()] {
       DEBUG_TIMER_NEW_THREAD(parent_thread_id);
-      const size_t thread_i = crt_kernel_idx % cpu_threads();
-      kernel->run(this, thread_i, shared_context);
+      kernel->run(this, row_set_mem_owner_->getKernelThreadIdx(), shared_context);
     });
   }
   tg.wait();
@@ -2600,7 +2734,8 @@ FetchResult Executor::fetchChunks(
     std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunks,
     DeviceAllocator* device_allocator,
     const size_t thread_idx,
-    const bool allow_runtime_interrupt) {
+    const bool allow_runtime_interrupt,
+    const bool defer_lazy_fetch_columns) {
   auto timer = DEBUG_TIMER(__func__);
   INJECT_TIMER(fetchChunks);
   const auto& col_global_ids = ra_exe_unit.input_col_descs;
@@ -2617,6 +2752,9 @@ FetchResult Executor::fetchChunks(
   std::vector<std::vector<const int8_t*>> all_frag_col_buffers;
   std::vector<std::vector<int64_t>> all_num_rows;
   std::vector<std::vector<uint64_t>> all_frag_offsets;
+  // the columns fetched per (table, fragment), to prefetch the next fragment
+  std::map<std::pair<int, size_t>, std::vector<int>> fetched_frag_col_ids;
+  std::vector<std::pair<int, int>> deferred_columns;
   for (const auto& selected_frag_ids : frag_ids_crossjoin) {
     std::vector<const int8_t*> frag_col_buffers(
         plan_state_->global_to_local_col_ids_.size());
@@ -2700,6 +2838,11 @@ FetchResult Executor::fetchChunks(
                                                         device_allocator,
                                                         thread_idx);
         }
+      } else if (defer_lazy_fetch_columns && cd && !cd->columnType.is_varlen() &&
+                 !plan_state_->columns_to_fetch_.count(tbl_col_ids) &&
+                 plan_state_->columns_to_not_fetch_.count(tbl_col_ids)) {
+        // only read by the result set, fetched once the filters selected the rows
+        deferred_columns.emplace_back(it->second, col_id->getColId());
       } else {
         frag_col_buffers[it->second] =
             column_fetcher.getOneTableColumnFragment(table_id,
@@ -2711,15 +2854,75 @@ FetchResult Executor::fetchChunks(
                                                      memory_level_for_column,
                                                      device_id,
                                                      device_allocator);
+        fetched_frag_col_ids[{table_id, frag_id}].push_back(col_id->getColId());
       }
       ///}
       //}
     }
     all_frag_col_buffers.push_back(frag_col_buffers);
   }
+  for (const auto& [table_frag_ids, col_ids] : fetched_frag_col_ids) {
+    column_fetcher.prefetchNextFragment(
+        table_frag_ids.first, table_frag_ids.second, col_ids, all_tables_fragments);
+  }
   std::tie(all_num_rows, all_frag_offsets) = getRowCountAndOffsetForAllFrags(
       ra_exe_unit, frag_ids_crossjoin, ra_exe_unit.input_descs, all_tables_fragments);
-  return {all_frag_col_buffers, all_num_rows, all_frag_offsets};
+  return {all_frag_col_buffers, all_num_rows, all_frag_offsets, deferred_columns};
+}
+
+void Executor::fetchDeferredColumns(
+    const ColumnFetcher& column_fetcher,
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::map<int, const TableFragments*>& all_tables_fragments,
+    const FragmentsList& selected_fragments,
+    FetchResult& fetch_result,
+    ResultSet* results,
+    std::list<ChunkIter>& chunk_iterators,
+    std::list<std::shared_ptr<Chunk_NS::Chunk>>& chunks,
+    const size_t thread_idx) {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK(results);
+  CHECK_EQ(size_t(1), ra_exe_unit.input_descs.size());
+  CHECK_EQ(size_t(1), selected_fragments.size());
+  CHECK_EQ(size_t(1), selected_fragments.front().fragment_ids.size());
+  CHECK_EQ(size_t(1), fetch_result.col_buffers.size());
+  const int table_id = ra_exe_unit.input_descs.front().getTableId();
+  const int frag_id = selected_fragments.front().fragment_ids.front();
+  const auto& lazy_fetch_info = results->getLazyFetchInfo();
+  const auto lazy_target_it = std::find_if(
+      lazy_fetch_info.begin(),
+      lazy_fetch_info.end(),
+      [](const ColumnLazyFetchInfo& col_info) { return col_info.is_lazily_fetched; });
+  if (lazy_target_it == lazy_fetch_info.end()) {
+    return;
+  }
+  // all the lazily fetched targets of a row hold the position of the same input row
+  const auto row_positions = results->getLazyFetchRowPositions(
+      std::distance(lazy_fetch_info.begin(), lazy_target_it));
+  if (row_positions.empty()) {
+    // the result set never reads the columns of a fragment without rows
+    VLOG(2) << "Skipped fetching " << fetch_result.deferred_columns.size()
+            << " columns of fragment " << frag_id << " without projected rows";
+    return;
+  }
+  for (const auto& [local_col_id, col_id] : fetch_result.deferred_columns) {
+    auto col_buffer = column_fetcher.getOneTableColumnFragmentRows(
+        table_id, frag_id, col_id, all_tables_fragments, row_positions, thread_idx);
+    if (!col_buffer) {
+      col_buffer = column_fetcher.getOneTableColumnFragment(table_id,
+                                                            frag_id,
+                                                            col_id,
+                                                            all_tables_fragments,
+                                                            chunks,
+                                                            chunk_iterators,
+                                                            Data_Namespace::CPU_LEVEL,
+                                                            0,
+                                                            nullptr);
+    }
+    fetch_result.col_buffers.front()[local_col_id] = col_buffer;
+    results->setLazyFetchColumnBuffer(0, local_col_id, col_buffer);
+    ++num_deferred_column_fetches_;
+  }
 }
 
 // fetchChunks() is written under the assumption that multiple inputs implies a JOIN.
@@ -3013,7 +3216,8 @@ int32_t Executor::executePlanWithoutGroupBy(
     const uint32_t num_tables,
     const bool allow_runtime_interrupt,
     RenderInfo* render_info,
-    const int64_t rows_to_process) {
+    const int64_t rows_to_process,
+    const int64_t first_row_to_process) {
   INJECT_TIMER(executePlanWithoutGroupBy);
   auto timer = DEBUG_TIMER(__func__);
   CHECK(!results || !(*results));
@@ -3065,7 +3269,8 @@ int32_t Executor::executePlanWithoutGroupBy(
                                                &error_code,
                                                num_tables,
                                                join_hash_table_ptrs,
-                                               rows_to_process);
+                                               rows_to_process,
+                                               first_row_to_process);
     output_memory_scope.reset(new OutVecOwner(out_vec));
   } else {
     auto gpu_generated_code = std::dynamic_pointer_cast<GpuCompilationContext>(
@@ -3235,7 +3440,8 @@ int32_t Executor::executePlanWithGroupBy(
     const uint32_t num_tables,
     const bool allow_runtime_interrupt,
     RenderInfo* render_info,
-    const int64_t rows_to_process) {
+    const int64_t rows_to_process,
+    const int64_t first_row_to_process) {
   auto timer = DEBUG_TIMER(__func__);
   INJECT_TIMER(executePlanWithGroupBy);
   // TODO: get results via a separate method, but need to do something with literals.
@@ -3246,7 +3452,7 @@ int32_t Executor::executePlanWithGroupBy(
   CHECK_NE(ra_exe_unit.groupby_exprs.size(), size_t(0));
   // TODO(alex):
   // 1. Optimize size (make keys more compact).
-  // 2. Resize on overflow.
+  // 2. Resize on overflow (only done for adaptive baseline hash buffers on CPU).
   // 3. Optimize runtime.
   auto hoist_buf = serializeLiterals(compilation_result.literal_values, device_id);
   int32_t error_code = device_type == ExecutorDeviceType::GPU ? 0 : start_rowid;
@@ -3313,25 +3519,51 @@ int32_t Executor::executePlanWithGroupBy(
   if (device_type == ExecutorDeviceType::CPU) {
     const int32_t scan_limit_for_query =
         ra_exe_unit_copy.union_all ? ra_exe_unit_copy.scan_limit : scan_limit;
-    const int32_t max_matched = scan_limit_for_query == 0
-                                    ? query_exe_context->query_mem_desc_.getEntryCount()
-                                    : scan_limit_for_query;
-
     auto cpu_generated_code = std::dynamic_pointer_cast<CpuCompilationContext>(
         compilation_result.generated_code);
     CHECK(cpu_generated_code);
-    query_exe_context->launchCpuCode(ra_exe_unit_copy,
-                                     cpu_generated_code.get(),
-                                     hoist_literals,
-                                     hoist_buf,
-                                     col_buffers,
-                                     num_rows,
-                                     frag_offsets,
-                                     max_matched,
-                                     &error_code,
-                                     num_tables,
-                                     join_hash_table_ptrs,
-                                     rows_to_process);
+    auto& query_mem_desc = query_exe_context->query_mem_desc_;
+    // the rows left to scan, the range starts later when the kernel resumes
+    auto scan_start = first_row_to_process;
+    auto scan_end = rows_to_process >= 0 ? first_row_to_process + rows_to_process : -1;
+    while (true) {
+      const int32_t max_matched = scan_limit_for_query == 0
+                                      ? query_mem_desc.getEntryCount()
+                                      : scan_limit_for_query;
+      query_exe_context->launchCpuCode(ra_exe_unit_copy,
+                                       cpu_generated_code.get(),
+                                       hoist_literals,
+                                       hoist_buf,
+                                       col_buffers,
+                                       num_rows,
+                                       frag_offsets,
+                                       max_matched,
+                                       &error_code,
+                                       num_tables,
+                                       join_hash_table_ptrs,
+                                       scan_end >= 0 ? scan_end - scan_start : -1,
+                                       scan_start);
+      // an adaptive buffer which ran out of slots doubles and the kernel resumes from
+      // the row which did not fit, instead of failing the whole query
+      const auto new_entry_count = 2 * query_mem_desc.getEntryCount();
+      if (error_code >= 0 || !query_mem_desc.hasAdaptiveEntryCount() ||
+          col_buffers.size() != 1 || num_tables != 1 ||
+          new_entry_count > static_cast<size_t>(std::numeric_limits<int32_t>::max()) ||
+          (g_enable_watchdog && new_entry_count > g_watchdog_baseline_max_groups)) {
+        break;
+      }
+      VLOG(1) << "Growing the group by buffer from " << query_mem_desc.getEntryCount()
+              << " to " << new_entry_count << " entries";
+      query_mem_desc.setEntryCount(new_entry_count);
+      query_exe_context->query_buffers_->growGroupByBuffer(
+          ra_exe_unit_copy, query_mem_desc, this);
+      if (scan_end < 0) {
+        CHECK(!num_rows.empty() && !num_rows.front().empty());
+        scan_end = start_rowid ? start_rowid + 1 : num_rows.front().front();
+      }
+      scan_start = -error_code - 1;
+      error_code = 0;
+    }
   } else {
     try {
       auto gpu_generated_code = std::dynamic_pointer_cast<GpuCompilationContext>(
@@ -3684,6 +3916,61 @@ std::tuple<bool, int64_t, int64_t> get_hpt_overflow_underflow_safe_scaled_values
   return std::make_tuple(false, chunk_min, chunk_max);
 }
 
+// Returns false if no value in the [min, max] range can satisfy the comparison with the
+// given constant.
+bool range_may_satisfy_qual(const SQLOps optype,
+                            const int64_t min,
+                            const int64_t max,
+                            const int64_t rhs_val) {
+  switch (optype) {
+    case kGE:
+      return max >= rhs_val;
+    case kGT:
+      return max > rhs_val;
+    case kLE:
+      return min <= rhs_val;
+    case kLT:
+      return min < rhs_val;
+    case kEQ:
+      return min <= rhs_val && max >= rhs_val;
+    default:
+      return true;
+  }
+}
+
+// The zone maps of a chunk can only be used if they cover all the rows of the fragment
+// visible to the query.
+bool zone_maps_cover_fragment(const ChunkMetadata& chunk_metadata,
+                              const Fragmenter_Namespace::FragmentInfo& fragment) {
+  return chunk_metadata.rowsPerZone > 0 &&
+         chunk_metadata.numElements >= fragment.getNumTuples();
+}
+
+// Returns the half-open range between the first and the last zone of the chunk which
+// may hold rows satisfying the comparison, an empty range if no zone does.
+std::pair<size_t, size_t> get_qualifying_zones(const ChunkMetadata& chunk_metadata,
+                                               const SQLTypeInfo& chunk_type,
+                                               const SQLOps optype,
+                                               const int64_t rhs_val) {
+  size_t first_zone = chunk_metadata.zoneStats.size();
+  size_t last_zone = 0;
+  for (size_t i = 0; i < chunk_metadata.zoneStats.size(); ++i) {
+    const auto& zone_stats = chunk_metadata.zoneStats[i];
+    const auto zone_min = extract_min_stat(zone_stats, chunk_type);
+    const auto zone_max = extract_max_stat(zone_stats, chunk_type);
+    // zones holding only nulls have an empty range and never qualify
+    if (zone_min <= zone_max &&
+        range_may_satisfy_qual(optype, zone_min, zone_max, rhs_val)) {
+      first_zone = std::min(first_zone, i);
+      last_zone = i;
+    }
+  }
+  if (first_zone > last_zone) {
+    return {0, 0};
+  }
+  return {first_zone, last_zone + 1};
+}
+
 }  // namespace
 
 bool Executor::isFragmentFullyDeleted(
@@ -3791,6 +4078,9 @@ std::pair<bool, int64_t> Executor::skipFragment(
       // invalid metadata range, do not skip fragment
       return {false, -1};
     }
+    bool use_zone_maps = !is_rowid && lhs_col == lhs &&
+                         chunk_meta_it != fragment.getChunkMetadataMap().end() &&
+                         zone_maps_cover_fragment(*chunk_meta_it->second, fragment);
     if (lhs->get_type_info().is_timestamp() &&
         (lhs_col->get_type_info().get_dimension() !=
          rhs_const->get_type_info().get_dimension()) &&
@@ -3803,6 +4093,7 @@ std::pair<bool, int64_t> Executor::skipFragment(
       // Note(Wamsi): We adjust rhs const value instead of lhs value to not
       // artificially limit the lhs column range. RHS overflow/underflow is already
       // been validated in `TimeGM::get_overflow_underflow_safe_epoch`.
+      use_zone_maps = false;
       bool is_valid;
       std::tie(is_valid, chunk_min, chunk_max) =
           get_hpt_overflow_underflow_safe_scaled_values(
@@ -3826,41 +4117,140 @@ std::pair<bool, int64_t> Executor::skipFragment(
     const auto rhs_val =
         CodeGenerator::codegenIntConst(rhs_const, &local_cgen_state)->getSExtValue();
 
-    switch (comp_expr->get_optype()) {
-      case kGE:
-        if (chunk_max < rhs_val) {
-          return {true, -1};
-        }
-        break;
-      case kGT:
-        if (chunk_max <= rhs_val) {
-          return {true, -1};
-        }
-        break;
-      case kLE:
-        if (chunk_min > rhs_val) {
-          return {true, -1};
-        }
-        break;
-      case kLT:
-        if (chunk_min >= rhs_val) {
-          return {true, -1};
-        }
-        break;
-      case kEQ:
-        if (chunk_min > rhs_val || chunk_max < rhs_val) {
-          return {true, -1};
-        } else if (is_rowid) {
-          return {false, rhs_val - start_rowid};
-        }
-        break;
-      default:
-        break;
+    const auto optype = comp_expr->get_optype();
+    if (!range_may_satisfy_qual(optype, chunk_min, chunk_max, rhs_val)) {
+      return {true, -1};
+    }
+    if (optype == kEQ && is_rowid) {
+      return {false, rhs_val - start_rowid};
+    }
+    if (optype == kEQ && lhs_col == lhs &&
+        chunk_meta_it != fragment.getChunkMetadataMap().end() &&
+        chunk_meta_it->second->bloomFilter &&
+        !chunk_meta_it->second->bloomFilter->mayContain(rhs_val)) {
+      VLOG(2) << "Skipping fragment " << frag_idx << " of table " << table_id
+              << " using the Bloom filter of column " << col_id;
+      return {true, -1};
+    }
+    if (use_zone_maps) {
+      // the value range of the whole chunk overlaps the qual, but no zone might
+      const auto qualifying_zones = get_qualifying_zones(
+          *chunk_meta_it->second, lhs_col->get_type_info(), optype, rhs_val);
+      if (qualifying_zones.first == qualifying_zones.second) {
+        VLOG(2) << "Skipping fragment " << frag_idx << " of table " << table_id
+                << " using the zone maps of column " << col_id;
+        return {true, -1};
+      }
     }
   }
   return {false, -1};
 }
 
+bool Executor::skipFragmentByStringBloomFilters(
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const std::list<std::shared_ptr<Analyzer::Expr>>& quals) {
+  for (const auto& qual : quals) {
+    const auto comp_expr = std::dynamic_pointer_cast<const Analyzer::BinOper>(qual);
+    if (!comp_expr || comp_expr->get_optype() != kEQ ||
+        comp_expr->get_qualifier() != kONE) {
+      continue;
+    }
+    auto lhs = comp_expr->get_left_operand();
+    auto rhs = comp_expr->get_right_operand();
+    if (!dynamic_cast<const Analyzer::ColumnVar*>(lhs)) {
+      std::swap(lhs, rhs);
+    }
+    const auto lhs_col = dynamic_cast<const Analyzer::ColumnVar*>(lhs);
+    if (!lhs_col || !lhs_col->get_table_id() || lhs_col->get_rte_idx()) {
+      continue;
+    }
+    const auto& lhs_ti = lhs_col->get_type_info();
+    if (!lhs_ti.is_string() || lhs_ti.get_compression() != kENCODING_DICT) {
+      continue;
+    }
+    // the string literal is cast to the dictionary encoded type of the column
+    const auto rhs_cast = dynamic_cast<const Analyzer::UOper*>(rhs);
+    if (rhs_cast && rhs_cast->get_optype() == kCAST) {
+      rhs = rhs_cast->get_operand();
+    }
+    const auto rhs_const = dynamic_cast<const Analyzer::Constant*>(rhs);
+    if (!rhs_const || rhs_const->get_is_null() ||
+        !rhs_const->get_type_info().is_string()) {
+      continue;
+    }
+    const auto chunk_meta_it =
+        fragment.getChunkMetadataMap().find(lhs_col->get_column_id());
+    if (chunk_meta_it == fragment.getChunkMetadataMap().end() ||
+        !chunk_meta_it->second->bloomFilter) {
+      continue;
+    }
+    const auto sdp =
+        getStringDictionaryProxy(lhs_ti.get_comp_param(), row_set_mem_owner_, true);
+    CHECK(sdp);
+    const auto str_id = sdp->getIdOfString(*rhs_const->get_constval().stringval);
+    // strings missing from the dictionary, or only known to the query, can't be stored
+    if (str_id < 0 || !chunk_meta_it->second->bloomFilter->mayContain(str_id)) {
+      VLOG(2) << "Skipping fragment " << fragment.fragmentId << " of table "
+              << lhs_col->get_table_id() << " using the Bloom filter of column "
+              << lhs_col->get_column_id();
+      return true;
+    }
+  }
+  return false;
+}
+
+std::pair<size_t, size_t> Executor::getQualifyingRowRange(
+    const Fragmenter_Namespace::FragmentInfo& fragment,
+    const std::list<std::shared_ptr<Analyzer::Expr>>& simple_quals) {
+  std::pair<size_t, size_t> row_range{0, fragment.getNumTuples()};
+  if (!g_enable_zone_maps) {
+    return row_range;
+  }
+  for (const auto& simple_qual : simple_quals) {
+    const auto comp_expr =
+        std::dynamic_pointer_cast<const Analyzer::BinOper>(simple_qual);
+    if (!comp_expr) {
+      continue;
+    }
+    const auto lhs_col =
+        dynamic_cast<const Analyzer::ColumnVar*>(comp_expr->get_left_operand());
+    const auto rhs_const =
+        dynamic_cast<const Analyzer::Constant*>(comp_expr->get_right_operand());
+    if (!lhs_col || !lhs_col->get_table_id() || lhs_col->get_rte_idx() || !rhs_const) {
+      continue;
+    }
+    const auto& col_type = lhs_col->get_type_info();
+    if (!col_type.is_integer() && !col_type.is_time()) {
+      continue;
+    }
+    if (col_type.is_timestamp() &&
+        col_type.get_dimension() != rhs_const->get_type_info().get_dimension()) {
+      // the zone maps hold values in the precision of the column
+      continue;
+    }
+    const auto chunk_meta_it =
+        fragment.getChunkMetadataMap().find(lhs_col->get_column_id());
+    if (chunk_meta_it == fragment.getChunkMetadataMap().end() ||
+        !zone_maps_cover_fragment(*chunk_meta_it->second, fragment)) {
+      continue;
+    }
+    llvm::LLVMContext local_context;
+    CgenState local_cgen_state(local_context);
+    const auto rhs_val =
+        CodeGenerator::codegenIntConst(rhs_const, &local_cgen_state)->getSExtValue();
+    const auto qualifying_zones = get_qualifying_zones(
+        *chunk_meta_it->second, col_type, comp_expr->get_optype(), rhs_val);
+    const auto rows_per_zone = chunk_meta_it->second->rowsPerZone;
+    row_range.first = std::max(row_range.first, qualifying_zones.first * rows_per_zone);
+    row_range.second =
+        std::min(row_range.second, qualifying_zones.second * rows_per_zone);
+  }
+  if (row_range.first >= row_range.second) {
+    return {0, 0};
+  }
+  return row_range;
+}
+
 /*
  *   The skipFragmentInnerJoins process all quals stored in the execution unit's
  * join_quals and gather all the ones that meet the "simple_qual" characteristics
@@ -3936,7 +4326,10 @@ AggregatedColRange Executor::computeColRangesCache(
     CHECK(cd);
     if (ExpressionRange::typeSupportsRange(cd->columnType)) {
       const auto col_var = boost::make_unique<Analyzer::ColumnVar>(
-          cd->columnType, phys_input.table_id, phys_input.col_id, 0);
+          get_in_memory_type_info(cd->columnType),
+          phys_input.table_id,
+          phys_input.col_id,
+          0);
       const auto col_range = getLeafColumnRange(col_var.get(), query_infos, this, false);
       agg_col_range_cache.setColRange(phys_input, col_range);
     }
@@ -4391,3 +4784,5 @@ std::mutex Executor::kernel_mutex_;
 QueryPlanDagCache Executor::query_plan_dag_cache_;
 mapd_shared_mutex Executor::recycler_mutex_;
 std::unordered_map<std::string, size_t> Executor::cardinality_cache_;
+
+std::atomic<size_t> Executor::num_deferred_column_fetches_{0};
@@ -408,6 +408,9 @@ class Executor {
 
   static size_t getArenaBlockSize();
 
+  // number of columns fetched after kernel execution by late materialization
+  static size_t getNumDeferredColumnFetches() { return num_deferred_column_fetches_; }
+
   static void addUdfIrToModule(const std::string& udf_ir_filename, const bool is_cuda_ir);
 
   /**
@@ -520,6 +523,10 @@ class Executor {
   // Generate code for an aggregate window function target.
   llvm::Value* codegenWindowFunctionAggregate(const CompilationOptions& co);
 
+  // Generate code which reads the precomputed value of an aggregate window function
+  // with an explicit frame.
+  llvm::Value* codegenWindowFrameAggregate();
+
   // The aggregate state requires a state reset when starting a new partition. Generate
   // the new partition check and return the continuation basic block.
   llvm::BasicBlock* codegenWindowResetStateControlFlow();
@@ -668,7 +675,18 @@ class Executor {
                           std::list<std::shared_ptr<Chunk_NS::Chunk>>&,
                           DeviceAllocator* device_allocator,
                           const size_t thread_idx,
-                          const bool allow_runtime_interrupt);
+                          const bool allow_runtime_interrupt,
+                          const bool defer_lazy_fetch_columns = false);
+
+  void fetchDeferredColumns(const ColumnFetcher&,
+                            const RelAlgExecutionUnit& ra_exe_unit,
+                            const std::map<int, const TableFragments*>&,
+                            const FragmentsList& selected_fragments,
+                            FetchResult& fetch_result,
+                            ResultSet* results,
+                            std::list<ChunkIter>&,
+                            std::list<std::shared_ptr<Chunk_NS::Chunk>>&,
+                            const size_t thread_idx);
 
   FetchResult fetchUnionChunks(const ColumnFetcher&,
                                const RelAlgExecutionUnit& ra_exe_unit,
@@ -727,7 +745,8 @@ class Executor {
                                  const uint32_t num_tables,
                                  const bool allow_runtime_interrupt,
                                  RenderInfo* render_info,
-                                 const int64_t rows_to_process = -1);
+                                 const int64_t rows_to_process = -1,
+                                 const int64_t first_row_to_process = 0);
   // pass nullptr to results if it shouldn't be extracted from the execution context
   int32_t executePlanWithoutGroupBy(
       const RelAlgExecutionUnit& ra_exe_unit,
@@ -746,7 +765,8 @@ class Executor {
       const uint32_t num_tables,
       const bool allow_runtime_interrupt,
       RenderInfo* render_info,
-      const int64_t rows_to_process = -1);
+      const int64_t rows_to_process = -1,
+      const int64_t first_row_to_process = 0);
 
  public:  // Temporary, ask saman about this
   static std::pair<int64_t, int32_t> reduceResults(const SQLAgg agg,
@@ -781,6 +801,9 @@ class Executor {
       std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& all_fragment_results,
       std::shared_ptr<RowSetMemoryOwner>,
       const QueryMemoryDescriptor&) const;
+  ResultSetPtr reducePartitionedResultSets(
+      std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& all_fragment_results,
+      std::shared_ptr<RowSetMemoryOwner>) const;
   ResultSetPtr reduceSpeculativeTopN(
       const RelAlgExecutionUnit&,
       std::vector<std::pair<ResultSetPtr, std::vector<size_t>>>& all_fragment_results,
@@ -949,6 +972,19 @@ class Executor {
       const std::vector<uint64_t>& frag_offsets,
       const size_t frag_idx);
 
+  // Returns true if a dictionary encoded string equality qual can't be satisfied by the
+  // fragment according to the Bloom filters of its chunks.
+  bool skipFragmentByStringBloomFilters(
+      const Fragmenter_Namespace::FragmentInfo& fragment,
+      const std::list<std::shared_ptr<Analyzer::Expr>>& quals);
+
+  // Returns the half-open range of the rows of the fragment which may satisfy all the
+  // simple quals according to the zone maps of the fragment, all the rows if there's no
+  // zone map for any of the quals.
+  std::pair<size_t, size_t> getQualifyingRowRange(
+      const Fragmenter_Namespace::FragmentInfo& fragment,
+      const std::list<std::shared_ptr<Analyzer::Expr>>& simple_quals);
+
   std::pair<bool, int64_t> skipFragmentInnerJoins(
       const InputDescriptor& table_desc,
       const RelAlgExecutionUnit& ra_exe_unit,
@@ -1153,6 +1189,8 @@ class Executor {
   static mapd_shared_mutex recycler_mutex_;
   static std::unordered_map<std::string, size_t> cardinality_cache_;
 
+  static std::atomic<size_t> num_deferred_column_fetches_;
+
  public:
   static const int32_t ERR_DIV_BY_ZERO{1};
   static const int32_t ERR_OUT_OF_GPU_MEM{2};
@@ -1193,6 +1231,7 @@ class Executor {
   friend class InValuesBitmap;
   friend class LeafAggregator;
   friend class PerfectJoinHashTable;
+  friend class SortMergeJoinHashTable;
   friend class QueryRewriter;
   friend class PendingExecutionClosure;
   friend class RelAlgExecutor;
@@ -19,6 +19,7 @@
 #include <mutex>
 #include <vector>
 
+#include "DataMgr/ZoneMap.h"
 #include "QueryEngine/Descriptors/RowSetMemoryOwner.h"
 #include "QueryEngine/DynamicWatchdog.h"
 #include "QueryEngine/ErrorHandling.h"
@@ -26,6 +27,8 @@
 #include "QueryEngine/ExternalExecutor.h"
 #include "QueryEngine/SerializeToSql.h"
 
+extern bool g_enable_late_materialization;
+
 namespace {
 
 bool needs_skip_result(const ResultSetPtr& res) {
@@ -190,8 +193,17 @@ void ExecutionKernel::runImpl(Executor* executor,
     device_allocator = std::make_unique<CudaAllocator>(data_mgr, chosen_device_id);
   }
   std::shared_ptr<FetchResult> fetch_result(new FetchResult);
+  // the lazily fetched columns of a CPU projection over one fragment are fetched once the
+  // kernel ran, only for the rows which passed the filters
+  const bool defer_lazy_fetch_columns =
+      g_enable_late_materialization && chosen_device_type == ExecutorDeviceType::CPU &&
+      eo.executor_type == ExecutorType::Native &&
+      !(render_info_ && render_info_->isPotentialInSituRender()) &&
+      !ra_exe_unit_.union_all && ra_exe_unit_.input_descs.size() == 1 &&
+      frag_list.size() == 1 && outer_tab_frag_ids.size() == 1 &&
+      query_mem_desc.getQueryDescriptionType() == QueryDescriptionType::Projection;
+  std::map<int, const TableFragments*> all_tables_fragments;
   try {
-    std::map<int, const TableFragments*> all_tables_fragments;
     QueryFragmentDescriptor::computeAllTablesFragments(
         all_tables_fragments, ra_exe_unit_, shared_context.getQueryInfos());
 
@@ -219,7 +231,8 @@ void ExecutionKernel::runImpl(Executor* executor,
                                                 chunks,
                                                 device_allocator.get(),
                                                 thread_idx,
-                                                eo.allow_runtime_query_interrupt);
+                                                eo.allow_runtime_query_interrupt,
+                                                defer_lazy_fetch_columns);
     if (fetch_result->num_rows.empty()) {
       return;
     }
@@ -302,6 +315,26 @@ void ExecutionKernel::runImpl(Executor* executor,
                     all_frag_row_offsets[frag_list.begin()->fragment_ids.front()];
     }
   }
+  // the rows of the outer fragment a CPU kernel scans, all of them by default
+  int64_t first_row_to_process{0};
+  int64_t rows_to_process{-1};
+  if (chosen_device_type == ExecutorDeviceType::CPU && g_enable_zone_maps &&
+      rowid_lookup_key < 0 && !ra_exe_unit_.union_all &&
+      ra_exe_unit_.input_descs.size() == 1 && outer_tab_frag_ids.size() == 1 &&
+      fetch_result->num_rows.size() == 1 && fetch_result->num_rows[0].size() == 1) {
+    // only scan the rows between the first and the last zone of the fragment which may
+    // hold rows satisfying the filters
+    const auto& query_infos = shared_context.getQueryInfos();
+    CHECK_EQ(query_infos.size(), size_t(1));
+    const auto& fragments = query_infos.front().info.fragments;
+    CHECK_LT(outer_tab_frag_ids.front(), fragments.size());
+    const auto row_range = executor->getQualifyingRowRange(
+        fragments[outer_tab_frag_ids.front()], ra_exe_unit_.simple_quals);
+    auto& num_rows = fetch_result->num_rows[0][0];
+    num_rows = std::min(num_rows, static_cast<int64_t>(row_range.second));
+    first_row_to_process = std::min(num_rows, static_cast<int64_t>(row_range.first));
+    rows_to_process = num_rows - first_row_to_process;
+  }
 
 #ifdef HAVE_TBB
   bool can_run_subkernels = shared_context.getThreadPool() != nullptr;
@@ -331,7 +364,8 @@ void ExecutionKernel::runImpl(Executor* executor,
     size_t total_rows = fetch_result->num_rows[0][0];
     size_t sub_size = g_cpu_sub_task_size;
 
-    for (size_t sub_start = start_rowid; sub_start < total_rows; sub_start += sub_size) {
+    for (size_t sub_start = start_rowid + first_row_to_process; sub_start < total_rows;
+         sub_start += sub_size) {
       sub_size = (sub_start + sub_size > total_rows) ? total_rows - sub_start : sub_size;
       auto subtask = std::make_shared<KernelSubtask>(*this,
                                                      shared_context,
@@ -339,8 +373,7 @@ void ExecutionKernel::runImpl(Executor* executor,
                                                      chunk_iterators_ptr,
                                                      total_num_input_rows,
                                                      sub_start,
-                                                     sub_size,
-                                                     thread_idx);
+                                                     sub_size);
       shared_context.getThreadPool()->run(
           [subtask, executor] { subtask->run(executor); });
     }
@@ -389,7 +422,9 @@ void ExecutionKernel::runImpl(Executor* executor,
                                               start_rowid,
                                               ra_exe_unit_.input_descs.size(),
                                               eo.allow_runtime_query_interrupt,
-                                              do_render ? render_info_ : nullptr);
+                                              do_render ? render_info_ : nullptr,
+                                              rows_to_process,
+                                              first_row_to_process);
   } else {
     if (ra_exe_unit_.union_all) {
       VLOG(1) << "outer_table_id=" << outer_table_id
@@ -412,7 +447,20 @@ void ExecutionKernel::runImpl(Executor* executor,
                                            start_rowid,
                                            ra_exe_unit_.input_descs.size(),
                                            eo.allow_runtime_query_interrupt,
-                                           do_render ? render_info_ : nullptr);
+                                           do_render ? render_info_ : nullptr,
+                                           rows_to_process,
+                                           first_row_to_process);
+  }
+  if (device_results_ && !err && !fetch_result->deferred_columns.empty()) {
+    executor->fetchDeferredColumns(column_fetcher,
+                                   ra_exe_unit_,
+                                   all_tables_fragments,
+                                   frag_list,
+                                   *fetch_result,
+                                   device_results_.get(),
+                                   *chunk_iterators_ptr,
+                                   chunks,
+                                   thread_idx);
   }
   if (device_results_) {
     std::list<std::shared_ptr<Chunk_NS::Chunk>> chunks_to_hold;
@@ -494,8 +542,8 @@ void KernelSubtask::runImpl(Executor* executor) {
           executor->getRowSetMemoryOwner(),
           compilation_result.output_columnar,
           kernel_.query_mem_desc.sortOnGpu(),
-          // TODO: use TBB thread id to choose allocator
-          thread_idx_,
+          // the subtask may run on another worker than its kernel
+          executor->getRowSetMemoryOwner()->getKernelThreadIdx(),
           do_render ? kernel_.render_info_ : nullptr);
     } catch (const OutOfHostMemory& e) {
       throw QueryExecutionError(Executor::ERR_OUT_OF_CPU_MEM);
@@ -525,11 +573,12 @@ void KernelSubtask::runImpl(Executor* executor) {
                                               fetch_result_->frag_offsets,
                                               &catalog->getDataMgr(),
                                               kernel_.chosen_device_id,
-                                              start_rowid_,
+                                              0,
                                               kernel_.ra_exe_unit_.input_descs.size(),
                                               kernel_.eo.allow_runtime_query_interrupt,
                                               do_render ? kernel_.render_info_ : nullptr,
-                                              start_rowid_ + num_rows_to_process_);
+                                              num_rows_to_process_,
+                                              start_rowid_);
   } else {
     err = executor->executePlanWithGroupBy(kernel_.ra_exe_unit_,
                                            compilation_result,
@@ -545,11 +594,12 @@ void KernelSubtask::runImpl(Executor* executor) {
                                            kernel_.chosen_device_id,
                                            outer_table_id,
                                            kernel_.ra_exe_unit_.scan_limit,
-                                           start_rowid_,
+                                           0,
                                            kernel_.ra_exe_unit_.input_descs.size(),
                                            kernel_.eo.allow_runtime_query_interrupt,
                                            do_render ? kernel_.render_info_ : nullptr,
-                                           start_rowid_ + num_rows_to_process_);
+                                           num_rows_to_process_,
+                                           start_rowid_);
   }
 
   if (err) {
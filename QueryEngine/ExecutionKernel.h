@@ -131,16 +131,14 @@ class KernelSubtask {
                 std::shared_ptr<std::list<ChunkIter>> chunk_iterators,
                 int64_t total_num_input_rows,
                 size_t start_rowid,
-                size_t num_rows_to_process,
-                size_t thread_idx)
+                size_t num_rows_to_process)
       : kernel_(k)
       , shared_context_(shared_context)
       , fetch_result_(fetch_result)
       , chunk_iterators_(chunk_iterators)
       , total_num_input_rows_(total_num_input_rows)
       , start_rowid_(start_rowid)
-      , num_rows_to_process_(num_rows_to_process)
-      , thread_idx_(thread_idx) {}
+      , num_rows_to_process_(num_rows_to_process) {}
 
   void run(Executor* executor);
 
@@ -154,6 +152,5 @@ class KernelSubtask {
   int64_t total_num_input_rows_;
   size_t start_rowid_;
   size_t num_rows_to_process_;
-  size_t thread_idx_;
 };
 #endif  // HAVE_TBB
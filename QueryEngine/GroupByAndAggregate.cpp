@@ -106,6 +106,26 @@ bool has_count_distinct(const RelAlgExecutionUnit& ra_exe_unit) {
   return false;
 }
 
+bool has_unnest_group_by(const RelAlgExecutionUnit& ra_exe_unit) {
+  for (const auto& group_expr : ra_exe_unit.groupby_exprs) {
+    const auto uoper = dynamic_cast<const Analyzer::UOper*>(group_expr.get());
+    if (uoper && uoper->get_optype() == kUNNEST) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool has_approx_quantile(const RelAlgExecutionUnit& ra_exe_unit) {
+  for (const auto& target_expr : ra_exe_unit.target_exprs) {
+    const auto agg_info = get_target_info(target_expr, g_bigint_count);
+    if (agg_info.is_agg && agg_info.agg_kind == kAPPROX_QUANTILE) {
+      return true;
+    }
+  }
+  return false;
+}
+
 bool is_column_range_too_big_for_perfect_hash(const ColRangeInfo& col_range_info,
                                               const int64_t max_entry_count) {
   try {
@@ -705,9 +725,34 @@ std::unique_ptr<QueryMemoryDescriptor> GroupByAndAggregate::initQueryMemoryDescr
       break;
     }
   }
+  query_mem_desc->setHasAdaptiveEntryCount(
+      supportsAdaptiveEntryCount(*query_mem_desc, render_info));
   return query_mem_desc;
 }
 
+// A baseline hash buffer can only grow in place when a kernel scans the rows of a single
+// table, since it resumes from the row which ran out of slots, and when moving its
+// entries to a bigger buffer does not involve the memory owned by the slots.
+bool GroupByAndAggregate::supportsAdaptiveEntryCount(
+    const QueryMemoryDescriptor& query_mem_desc,
+    const RenderInfo* render_info) const {
+  if (!g_enable_adaptive_group_by || device_type_ != ExecutorDeviceType::CPU ||
+      render_info) {
+    return false;
+  }
+  if (query_mem_desc.getQueryDescriptionType() !=
+          QueryDescriptionType::GroupByBaselineHash ||
+      query_mem_desc.didOutputColumnar() || query_mem_desc.hasVarlenOutput()) {
+    return false;
+  }
+  if (ra_exe_unit_.input_descs.size() != 1 || !ra_exe_unit_.join_quals.empty() ||
+      ra_exe_unit_.union_all || ra_exe_unit_.estimator || ra_exe_unit_.scan_limit) {
+    return false;
+  }
+  return !has_count_distinct(ra_exe_unit_) && !has_approx_quantile(ra_exe_unit_) &&
+         !has_unnest_group_by(ra_exe_unit_);
+}
+
 std::unique_ptr<QueryMemoryDescriptor> GroupByAndAggregate::initQueryMemoryDescriptorImpl(
     const bool allow_multifrag,
     const size_t max_groups_buffer_entry_count,
@@ -937,10 +982,14 @@ bool GroupByAndAggregate::codegen(llvm::Value* filter_result,
           LL_BUILDER.CreateRet(LL_INT(int32_t(0)));
         } else {
           CodeGenerator code_generator(executor_);
-          LL_BUILDER.CreateRet(LL_BUILDER.CreateNeg(LL_BUILDER.CreateTrunc(
-              // TODO(alex): remove the trunc once pos is converted to 32 bits
-              code_generator.posArg(nullptr),
-              get_int_type(32, LL_CONTEXT))));
+          // TODO(alex): remove the trunc once pos is converted to 32 bits
+          const auto pos = LL_BUILDER.CreateTrunc(code_generator.posArg(nullptr),
+                                                  get_int_type(32, LL_CONTEXT));
+          // adaptive buffers return -(pos + 1), so that running out of slots on the
+          // first row is an error too and the kernel knows which row to resume from
+          LL_BUILDER.CreateRet(query_mem_desc.hasAdaptiveEntryCount()
+                                   ? LL_BUILDER.CreateNot(pos)
+                                   : LL_BUILDER.CreateNeg(pos));
         }
       }
     } else {
@@ -1301,9 +1350,13 @@ GroupByAndAggregate::codegenMultiColumnBaselineHash(
     group_key =
         LL_BUILDER.CreatePointerCast(group_key, llvm::Type::getInt64PtrTy(LL_CONTEXT));
   }
+  // the max_matched argument of the row function carries the current entry count
+  // of an adaptive buffer
   std::vector<llvm::Value*> func_args{
       groups_buffer,
-      LL_INT(static_cast<int32_t>(query_mem_desc.getEntryCount())),
+      query_mem_desc.hasAdaptiveEntryCount()
+          ? get_arg_by_name(ROW_FUNC, "max_matched")
+          : LL_INT(static_cast<int32_t>(query_mem_desc.getEntryCount())),
       &*group_key,
       &*key_size_lv,
       LL_INT(static_cast<int32_t>(key_width))};
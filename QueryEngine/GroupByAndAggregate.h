@@ -43,6 +43,7 @@
 
 extern bool g_enable_smem_group_by;
 extern bool g_bigint_count;
+extern bool g_enable_adaptive_group_by;
 
 struct ColRangeInfo {
   QueryDescriptionType hash_type_;
@@ -100,6 +101,9 @@ class GroupByAndAggregate {
   int64_t getShardedTopBucket(const ColRangeInfo& col_range_info,
                               const size_t shard_count) const;
 
+  bool supportsAdaptiveEntryCount(const QueryMemoryDescriptor& query_mem_desc,
+                                  const RenderInfo* render_info) const;
+
   llvm::Value* codegenOutputSlot(llvm::Value* groups_buffer,
                                  const QueryMemoryDescriptor& query_mem_desc,
                                  const CompilationOptions& co,
@@ -17,6 +17,7 @@
 #include "JoinFilterPushDown.h"
 #include "DeepCopyVisitor.h"
 #include "RelAlgExecutor.h"
+#include "RelAlgTranslator.h"
 
 namespace {
 
@@ -59,13 +60,20 @@ FilterSelectivity RelAlgExecutor::getFilterSelectivity(
     const CompilationOptions& co,
     const ExecutionOptions& eo) {
   CollectInputColumnsVisitor input_columns_visitor;
+  std::list<std::shared_ptr<Analyzer::Expr>> simple_quals;
   std::list<std::shared_ptr<Analyzer::Expr>> quals;
   std::unordered_set<InputColDescriptor> input_column_descriptors;
   BindFilterToOutermostVisitor bind_filter_to_outermost;
   for (const auto& filter_expr : filter_expressions) {
     input_column_descriptors = input_columns_visitor.aggregateResult(
         input_column_descriptors, input_columns_visitor.visit(filter_expr.get()));
-    quals.push_back(bind_filter_to_outermost.visit(filter_expr.get()));
+    // separate the simple quals, so that the count can skip fragments based on their
+    // metadata (min / max stats, zone maps and Bloom filters)
+    const auto quals_cf =
+        qual_to_conjunctive_form(bind_filter_to_outermost.visit(filter_expr.get()));
+    simple_quals.insert(
+        simple_quals.end(), quals_cf.simple_quals.begin(), quals_cf.simple_quals.end());
+    quals.insert(quals.end(), quals_cf.quals.begin(), quals_cf.quals.end());
   }
   std::vector<InputDescriptor> input_descs;
   std::list<std::shared_ptr<const InputColDescriptor>> input_col_descs;
@@ -85,7 +93,7 @@ FilterSelectivity RelAlgExecutor::getFilterSelectivity(
                                   nullptr);
   RelAlgExecutionUnit ra_exe_unit{input_descs,
                                   input_col_descs,
-                                  {},
+                                  simple_quals,
                                   quals,
                                   {},
                                   {},
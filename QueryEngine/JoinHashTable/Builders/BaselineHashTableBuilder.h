@@ -23,6 +23,9 @@
 #include "QueryEngine/JoinHashTable/Runtime/JoinHashTableGpuUtils.h"
 #include "Shared/thread_count.h"
 
+extern bool g_enable_radix_partitioned_join_build;
+extern size_t g_radix_partitioned_join_build_threshold;
+
 template <typename SIZE,
           class KEY_HANDLER,
           typename std::enable_if<sizeof(SIZE) == 4, SIZE>::type* = nullptr>
@@ -344,58 +347,96 @@ class BaselineJoinHashTableBuilder {
     for (auto& child : init_cpu_buff_threads) {
       child.get();
     }
-    std::vector<std::future<int>> fill_cpu_buff_threads;
-    for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
-      fill_cpu_buff_threads.emplace_back(std::async(
-          std::launch::async,
-          [key_handler,
-           keyspace_entry_count,
-           &join_columns,
-           key_component_count,
-           key_component_width,
-           layout,
-           thread_idx,
-           cpu_hash_table_ptr,
-           thread_count,
-           for_semi_join] {
-            switch (key_component_width) {
-              case 4: {
-                return fill_baseline_hash_join_buff<int32_t>(cpu_hash_table_ptr,
-                                                             keyspace_entry_count,
-                                                             -1,
-                                                             for_semi_join,
-                                                             key_component_count,
-                                                             layout == HashType::OneToOne,
-                                                             key_handler,
-                                                             join_columns[0].num_elems,
-                                                             thread_idx,
-                                                             thread_count);
-                break;
-              }
-              case 8: {
-                return fill_baseline_hash_join_buff<int64_t>(cpu_hash_table_ptr,
-                                                             keyspace_entry_count,
-                                                             -1,
-                                                             for_semi_join,
-                                                             key_component_count,
-                                                             layout == HashType::OneToOne,
-                                                             key_handler,
-                                                             join_columns[0].num_elems,
-                                                             thread_idx,
-                                                             thread_count);
-                break;
-              }
-              default:
-                CHECK(false);
-            }
-            return -1;
-          }));
-    }
     int err = 0;
-    for (auto& child : fill_cpu_buff_threads) {
-      int partial_err = child.get();
-      if (partial_err) {
-        err = partial_err;
+    bool partitioned_build = false;
+    if constexpr (std::is_same<KEY_HANDLER, GenericKeyHandler>::value) {
+      partitioned_build = g_enable_radix_partitioned_join_build &&
+                          join_columns[0].num_elems >=
+                              g_radix_partitioned_join_build_threshold;
+    }
+    if (partitioned_build) {
+      VLOG(1) << "Building the CPU Join Hash Table by partitions of its slots";
+      switch (key_component_width) {
+        case 4:
+          err = fill_baseline_hash_join_buff_partitioned_32(cpu_hash_table_ptr,
+                                                            keyspace_entry_count,
+                                                            -1,
+                                                            for_semi_join,
+                                                            key_component_count,
+                                                            layout == HashType::OneToOne,
+                                                            key_handler,
+                                                            join_columns[0].num_elems,
+                                                            thread_count);
+          break;
+        case 8:
+          err = fill_baseline_hash_join_buff_partitioned_64(cpu_hash_table_ptr,
+                                                            keyspace_entry_count,
+                                                            -1,
+                                                            for_semi_join,
+                                                            key_component_count,
+                                                            layout == HashType::OneToOne,
+                                                            key_handler,
+                                                            join_columns[0].num_elems,
+                                                            thread_count);
+          break;
+        default:
+          CHECK(false);
+      }
+    } else {
+      std::vector<std::future<int>> fill_cpu_buff_threads;
+      for (int thread_idx = 0; thread_idx < thread_count; ++thread_idx) {
+        fill_cpu_buff_threads.emplace_back(std::async(
+            std::launch::async,
+            [key_handler,
+             keyspace_entry_count,
+             &join_columns,
+             key_component_count,
+             key_component_width,
+             layout,
+             thread_idx,
+             cpu_hash_table_ptr,
+             thread_count,
+             for_semi_join] {
+              switch (key_component_width) {
+                case 4: {
+                  return fill_baseline_hash_join_buff<int32_t>(
+                      cpu_hash_table_ptr,
+                      keyspace_entry_count,
+                      -1,
+                      for_semi_join,
+                      key_component_count,
+                      layout == HashType::OneToOne,
+                      key_handler,
+                      join_columns[0].num_elems,
+                      thread_idx,
+                      thread_count);
+                  break;
+                }
+                case 8: {
+                  return fill_baseline_hash_join_buff<int64_t>(
+                      cpu_hash_table_ptr,
+                      keyspace_entry_count,
+                      -1,
+                      for_semi_join,
+                      key_component_count,
+                      layout == HashType::OneToOne,
+                      key_handler,
+                      join_columns[0].num_elems,
+                      thread_idx,
+                      thread_count);
+                  break;
+                }
+                default:
+                  CHECK(false);
+              }
+              return -1;
+            }));
+      }
+      for (auto& child : fill_cpu_buff_threads) {
+        int partial_err = child.get();
+        if (partial_err) {
+          err = partial_err;
+        }
       }
     }
     if (err) {
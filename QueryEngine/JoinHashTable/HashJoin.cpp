@@ -22,6 +22,7 @@
 #include "QueryEngine/JoinHashTable/BaselineJoinHashTable.h"
 #include "QueryEngine/JoinHashTable/OverlapsJoinHashTable.h"
 #include "QueryEngine/JoinHashTable/PerfectJoinHashTable.h"
+#include "QueryEngine/JoinHashTable/SortMergeJoinHashTable.h"
 #include "QueryEngine/RangeTableIndexVisitor.h"
 #include "QueryEngine/RuntimeFunctions.h"
 #include "QueryEngine/ScalarExprVisitor.h"
@@ -297,17 +298,24 @@ std::shared_ptr<HashJoin> HashJoin::getInstance(
       CHECK_EQ(join_quals.size(), size_t(1));
       const auto join_qual =
           std::dynamic_pointer_cast<Analyzer::BinOper>(join_quals.front());
-      VLOG(1) << "Trying to build keyed hash table after perfect hash table:";
-      join_hash_table = BaselineJoinHashTable::getInstance(join_qual,
-                                                           query_infos,
-                                                           memory_level,
-                                                           join_type,
-                                                           preferred_hash_type,
-                                                           device_count,
-                                                           column_cache,
-                                                           executor,
-                                                           hashtable_build_dag_map,
-                                                           table_id_to_node_map);
+      if (SortMergeJoinHashTable::preferredOverKeyedHashTable(
+              qual_bin_oper, query_infos, memory_level, join_type, executor)) {
+        VLOG(1) << "Trying to build sort-merge join table after perfect hash table:";
+        join_hash_table = SortMergeJoinHashTable::getInstance(
+            qual_bin_oper, query_infos, memory_level, join_type, column_cache, executor);
+      } else {
+        VLOG(1) << "Trying to build keyed hash table after perfect hash table:";
+        join_hash_table = BaselineJoinHashTable::getInstance(join_qual,
+                                                             query_infos,
+                                                             memory_level,
+                                                             join_type,
+                                                             preferred_hash_type,
+                                                             device_count,
+                                                             column_cache,
+                                                             executor,
+                                                             hashtable_build_dag_map,
+                                                             table_id_to_node_map);
+      }
     }
   }
   CHECK(join_hash_table);
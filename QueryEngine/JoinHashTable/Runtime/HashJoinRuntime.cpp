@@ -31,10 +31,12 @@
 
 #include "QueryEngine/RuntimeFunctions.h"
 #include "Shared/likely.h"
+#include "Shared/threading.h"
 #include "StringDictionary/StringDictionary.h"
 #include "StringDictionary/StringDictionaryProxy.h"
 
 #include <x86intrin.h>
+#include <atomic>
 #include <future>
 #endif
 
@@ -1932,6 +1934,185 @@ int range_fill_baseline_hash_join_buff_64(int8_t* hash_buff,
                                                cpu_thread_count);
 }
 
+namespace {
+
+// Target size of the slot range of a partition, so that the inserts of a partition stay
+// within the L2 cache of the core building it.
+constexpr size_t kJoinBuildPartitionBytes{256 * 1024};
+constexpr size_t kMaxJoinBuildPartitions{16384};
+
+/**
+ * The build side keys of a thread, grouped by the partition of their home slot. Each
+ * entry is the row id followed by the key components.
+ */
+template <typename T>
+struct PartitionedJoinKeys {
+  std::vector<T> entries;
+  std::vector<size_t> partition_offsets;  // in entries, one more than the partitions
+};
+
+}  // namespace
+
+template <typename T>
+int fill_baseline_hash_join_buff_partitioned(int8_t* hash_buff,
+                                             const int64_t entry_count,
+                                             const int32_t invalid_slot_val,
+                                             const bool for_semi_join,
+                                             const size_t key_component_count,
+                                             const bool with_val_slot,
+                                             const GenericKeyHandler* key_handler,
+                                             const int64_t num_elems,
+                                             const int32_t cpu_thread_count) {
+  const size_t key_size_in_bytes = key_component_count * sizeof(T);
+  const size_t hash_entry_size =
+      (key_component_count + (with_val_slot ? 1 : 0)) * sizeof(T);
+  const size_t num_partitions = std::max(
+      std::min((entry_count * hash_entry_size + kJoinBuildPartitionBytes - 1) /
+                   kJoinBuildPartitionBytes,
+               kMaxJoinBuildPartitions),
+      size_t(1));
+  const size_t slots_per_partition = (entry_count + num_partitions - 1) / num_partitions;
+  const size_t stride = key_component_count + 1;
+
+  // Partition the keys of a slice of the rows per thread. The keys are materialized once,
+  // then scattered by partition into a thread local buffer.
+  std::vector<PartitionedJoinKeys<T>> partitioned_keys(cpu_thread_count);
+  std::vector<std::future<void>> partition_threads;
+  for (int32_t thread_idx = 0; thread_idx < cpu_thread_count; ++thread_idx) {
+    partition_threads.push_back(std::async(std::launch::async, [&, thread_idx] {
+      const size_t slice_size = num_elems / cpu_thread_count + 1;
+      std::vector<T> keys;
+      keys.reserve(slice_size * stride);
+      std::vector<uint32_t> partitions;
+      partitions.reserve(slice_size);
+      auto key_buff_handler = [&](const int64_t entry_idx,
+                                  const T* key_scratch_buffer,
+                                  const size_t key_component_count) {
+        const uint32_t h =
+            MurmurHash1Impl(key_scratch_buffer, key_size_in_bytes, 0) % entry_count;
+        partitions.push_back(h / slots_per_partition);
+        keys.push_back(entry_idx);
+        keys.insert(
+            keys.end(), key_scratch_buffer, key_scratch_buffer + key_component_count);
+        return 0;
+      };
+      T key_scratch_buff[g_maximum_conditions_to_coalesce];
+      JoinColumnTuple cols(key_handler->get_number_of_columns(),
+                           key_handler->get_join_columns(),
+                           key_handler->get_join_column_type_infos());
+      for (auto& it : cols.slice(thread_idx, cpu_thread_count)) {
+        (*key_handler)(it.join_column_iterators, key_scratch_buff, key_buff_handler);
+      }
+
+      auto& thread_keys = partitioned_keys[thread_idx];
+      auto& offsets = thread_keys.partition_offsets;
+      offsets.assign(num_partitions + 1, 0);
+      for (const auto partition : partitions) {
+        offsets[partition + 1] += stride;
+      }
+      std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+      std::vector<size_t> write_pos(offsets.begin(), offsets.end() - 1);
+      thread_keys.entries.resize(keys.size());
+      for (size_t i = 0; i < partitions.size(); ++i) {
+        std::copy_n(keys.begin() + i * stride,
+                    stride,
+                    thread_keys.entries.begin() + write_pos[partitions[i]]);
+        write_pos[partitions[i]] += stride;
+      }
+    }));
+  }
+  for (auto& child : partition_threads) {
+    child.get();
+  }
+
+  // Insert the partitions, stolen by the idle workers of the pool as they go. Linear
+  // probing can still overflow into the slots of the next partition, which the atomic
+  // slot claim of the regular build handles.
+  std::atomic<int> err{0};
+  threading::parallel_for(
+      threading::blocked_range<size_t>(0, num_partitions),
+      [&](const threading::blocked_range<size_t>& r) {
+        for (size_t partition = r.begin(); partition != r.end(); ++partition) {
+          for (const auto& thread_keys : partitioned_keys) {
+            const auto begin = thread_keys.partition_offsets[partition];
+            const auto end = thread_keys.partition_offsets[partition + 1];
+            for (size_t i = begin; i < end; i += stride) {
+              const auto key = &thread_keys.entries[i + 1];
+              const auto partial_err =
+                  for_semi_join
+                      ? write_baseline_hash_slot_for_semi_join<T>(
+                            thread_keys.entries[i],
+                            hash_buff,
+                            entry_count,
+                            key,
+                            key_component_count,
+                            with_val_slot,
+                            invalid_slot_val,
+                            key_size_in_bytes,
+                            hash_entry_size)
+                      : write_baseline_hash_slot<T>(thread_keys.entries[i],
+                                                    hash_buff,
+                                                    entry_count,
+                                                    key,
+                                                    key_component_count,
+                                                    with_val_slot,
+                                                    invalid_slot_val,
+                                                    key_size_in_bytes,
+                                                    hash_entry_size);
+              if (partial_err) {
+                err = partial_err;
+                return;
+              }
+            }
+          }
+          if (err) {
+            return;
+          }
+        }
+      });
+  return err;
+}
+
+int fill_baseline_hash_join_buff_partitioned_32(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                const int64_t num_elems,
+                                                const int32_t cpu_thread_count) {
+  return fill_baseline_hash_join_buff_partitioned<int32_t>(hash_buff,
+                                                           entry_count,
+                                                           invalid_slot_val,
+                                                           for_semi_join,
+                                                           key_component_count,
+                                                           with_val_slot,
+                                                           key_handler,
+                                                           num_elems,
+                                                           cpu_thread_count);
+}
+
+int fill_baseline_hash_join_buff_partitioned_64(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                const int64_t num_elems,
+                                                const int32_t cpu_thread_count) {
+  return fill_baseline_hash_join_buff_partitioned<int64_t>(hash_buff,
+                                                           entry_count,
+                                                           invalid_slot_val,
+                                                           for_semi_join,
+                                                           key_component_count,
+                                                           with_val_slot,
+                                                           key_handler,
+                                                           num_elems,
+                                                           cpu_thread_count);
+}
+
 template <typename T>
 void fill_one_to_many_baseline_hash_table(
     int32_t* buff,
@@ -308,6 +308,29 @@ int range_fill_baseline_hash_join_buff_64(int8_t* hash_buff,
                                           const int32_t cpu_thread_idx,
                                           const int32_t cpu_thread_count);
 
+// Builds the same table as fill_baseline_hash_join_buff_{32,64} with all the threads at
+// once. The keys are first partitioned by the slot range of their home slot, then the
+// partitions are inserted in parallel so that the writes of each one stay in cache.
+int fill_baseline_hash_join_buff_partitioned_32(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                const int64_t num_elems,
+                                                const int32_t cpu_thread_count);
+
+int fill_baseline_hash_join_buff_partitioned_64(int8_t* hash_buff,
+                                                const int64_t entry_count,
+                                                const int32_t invalid_slot_val,
+                                                const bool for_semi_join,
+                                                const size_t key_component_count,
+                                                const bool with_val_slot,
+                                                const GenericKeyHandler* key_handler,
+                                                const int64_t num_elems,
+                                                const int32_t cpu_thread_count);
+
 void fill_baseline_hash_join_buff_on_device_32(int8_t* hash_buff,
                                                const int64_t entry_count,
                                                const int32_t invalid_slot_val,
@@ -354,3 +354,46 @@ get_num_buckets_for_bounds(const int8_t* range_bytes,
 
   return num_buckets;
 }
+
+// The sorted keys buffer of a sort-merge join starts with the number of keys, followed
+// by the keys in ascending order and the row ids they come from.
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+sorted_join_lower_bound(int64_t sorted_buff, const int64_t key) {
+  const auto entry_count = *reinterpret_cast<const int64_t*>(sorted_buff);
+  const auto keys = reinterpret_cast<const int64_t*>(sorted_buff) + 1;
+  int64_t lo = 0;
+  int64_t hi = entry_count;
+  while (lo < hi) {
+    const auto mid = lo + (hi - lo) / 2;
+    if (keys[mid] < key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+sorted_join_upper_bound(int64_t sorted_buff, const int64_t key) {
+  const auto entry_count = *reinterpret_cast<const int64_t*>(sorted_buff);
+  const auto keys = reinterpret_cast<const int64_t*>(sorted_buff) + 1;
+  int64_t lo = 0;
+  int64_t hi = entry_count;
+  while (lo < hi) {
+    const auto mid = lo + (hi - lo) / 2;
+    if (keys[mid] <= key) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+extern "C" RUNTIME_EXPORT ALWAYS_INLINE DEVICE int64_t
+sorted_join_row_ids(int64_t sorted_buff) {
+  const auto entry_count = *reinterpret_cast<const int64_t*>(sorted_buff);
+  return reinterpret_cast<int64_t>(reinterpret_cast<const int64_t*>(sorted_buff) + 1 +
+                                   entry_count);
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include "QueryEngine/CompilationOptions.h"
+#include "QueryEngine/JoinHashTable/HashTable.h"
+
+/**
+ * The inner side of a sort-merge join: the number of entries, the non-null keys of the
+ * inner join column in ascending order and the row ids the keys come from, in this order
+ * and in a single CPU buffer. Equal keys are adjacent, so the rows matching an outer key
+ * are a contiguous range of the row ids, found with two binary searches of the keys.
+ */
+class SortMergeHashTable : public HashTable {
+ public:
+  SortMergeHashTable(const size_t entry_count)
+      : entry_count_(entry_count)
+      , cpu_hash_table_buff_size_(sizeof(int64_t) * (entry_count + 1) +
+                                  sizeof(int32_t) * entry_count)
+      , cpu_hash_table_buff_(new int8_t[cpu_hash_table_buff_size_]) {
+    *reinterpret_cast<int64_t*>(cpu_hash_table_buff_.get()) = entry_count_;
+  }
+
+  int64_t* getKeys() {
+    return reinterpret_cast<int64_t*>(cpu_hash_table_buff_.get()) + 1;
+  }
+
+  int32_t* getRowIds() { return reinterpret_cast<int32_t*>(getKeys() + entry_count_); }
+
+  size_t getHashTableBufferSize(const ExecutorDeviceType device_type) const override {
+    return device_type == ExecutorDeviceType::CPU ? cpu_hash_table_buff_size_ : 0;
+  }
+
+  int8_t* getCpuBuffer() override { return cpu_hash_table_buff_.get(); }
+
+  int8_t* getGpuBuffer() const override { return nullptr; }
+
+  HashType getLayout() const override { return HashType::OneToMany; }
+
+  size_t getEntryCount() const override { return entry_count_; }
+
+  size_t getEmittedKeysCount() const override { return entry_count_; }
+
+ private:
+  size_t entry_count_;
+  size_t cpu_hash_table_buff_size_;
+  std::unique_ptr<int8_t[]> cpu_hash_table_buff_;
+};
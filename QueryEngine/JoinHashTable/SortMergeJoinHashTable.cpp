@@ -0,0 +1,377 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/JoinHashTable/SortMergeJoinHashTable.h"
+
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <sstream>
+
+#include "Logger/Logger.h"
+#include "QueryEngine/CodeGenerator.h"
+#include "QueryEngine/ColumnFetcher.h"
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/ExpressionRewrite.h"
+#include "QueryEngine/JoinHashTable/PerfectJoinHashTable.h"
+#include "QueryEngine/JoinHashTable/Runtime/HashJoinRuntime.h"
+#include "QueryEngine/JoinHashTable/Runtime/JoinColumnIterator.h"
+#include "QueryEngine/RuntimeFunctions.h"
+#include "Shared/threading.h"
+
+extern bool g_enable_sort_merge_join;
+extern size_t g_sort_merge_join_max_hash_table_bytes;
+
+namespace {
+
+using KeyAndRowId = std::pair<int64_t, int32_t>;
+
+bool key_less(const KeyAndRowId& lhs, const KeyAndRowId& rhs) {
+  return lhs.first < rhs.first;
+}
+
+// The non-null keys of a chunk of the inner join column with their row ids, in key order.
+// Chunks of tables sorted on the join column are already in order and only checked.
+std::vector<KeyAndRowId> make_sorted_run(const JoinChunk& chunk,
+                                         const size_t first_row_id,
+                                         const JoinColumn& join_column,
+                                         const JoinColumnTypeInfo& type_info) {
+  std::vector<KeyAndRowId> run;
+  if (!chunk.num_elems) {
+    return run;
+  }
+  run.reserve(chunk.num_elems);
+  const JoinColumn chunk_column{reinterpret_cast<const int8_t*>(&chunk),
+                                sizeof(JoinChunk),
+                                1,
+                                chunk.num_elems,
+                                join_column.elem_sz};
+  JoinColumnTyped col{&chunk_column, &type_info};
+  for (auto item : col.slice(0, 1)) {
+    if (item.element == type_info.null_val) {
+      continue;
+    }
+    run.emplace_back(item.element, static_cast<int32_t>(first_row_id + item.index));
+  }
+  if (!std::is_sorted(run.begin(), run.end(), key_less)) {
+    std::stable_sort(run.begin(), run.end(), key_less);
+  }
+  return run;
+}
+
+// Merges the sorted runs pairwise, the merges of a round running in parallel.
+std::vector<KeyAndRowId> merge_runs(std::vector<std::vector<KeyAndRowId>> runs) {
+  if (runs.empty()) {
+    return {};
+  }
+  while (runs.size() > 1) {
+    std::vector<std::vector<KeyAndRowId>> merged_runs((runs.size() + 1) / 2);
+    threading::parallel_for(size_t(0), merged_runs.size(), [&](const size_t i) {
+      auto& lhs = runs[2 * i];
+      if (2 * i + 1 == runs.size()) {
+        merged_runs[i] = std::move(lhs);
+        return;
+      }
+      auto& rhs = runs[2 * i + 1];
+      auto& merged = merged_runs[i];
+      merged.resize(lhs.size() + rhs.size());
+      std::merge(
+          lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), merged.begin(), key_less);
+      std::vector<KeyAndRowId>().swap(lhs);
+      std::vector<KeyAndRowId>().swap(rhs);
+    });
+    runs.swap(merged_runs);
+  }
+  return std::move(runs.front());
+}
+
+}  // namespace
+
+//! Make the sorted keys table from an in-flight SQL query's parse tree etc.
+std::shared_ptr<SortMergeJoinHashTable> SortMergeJoinHashTable::getInstance(
+    const std::shared_ptr<Analyzer::BinOper> qual_bin_oper,
+    const std::vector<InputTableInfo>& query_infos,
+    const Data_Namespace::MemoryLevel memory_level,
+    const JoinType join_type,
+    ColumnCacheMap& column_cache,
+    Executor* executor) {
+  CHECK_EQ(qual_bin_oper->get_optype(), kEQ);
+  CHECK_EQ(memory_level, Data_Namespace::CPU_LEVEL);
+  const auto cols = normalizeColumnPair(qual_bin_oper->get_left_operand(),
+                                        qual_bin_oper->get_right_operand(),
+                                        *executor->getCatalog(),
+                                        executor->getTemporaryTables());
+  decltype(std::chrono::steady_clock::now()) ts1, ts2;
+  if (VLOGGING(1)) {
+    ts1 = std::chrono::steady_clock::now();
+  }
+  auto join_hash_table = std::shared_ptr<SortMergeJoinHashTable>(
+      new SortMergeJoinHashTable(
+          qual_bin_oper, cols.first, query_infos, join_type, column_cache, executor));
+  try {
+    join_hash_table->reify();
+  } catch (const TableMustBeReplicated& e) {
+    // Throw a runtime error to abort the query
+    join_hash_table->freeHashBufferMemory();
+    throw std::runtime_error(e.what());
+  } catch (const HashJoinFail& e) {
+    join_hash_table->freeHashBufferMemory();
+    throw HashJoinFail(std::string("Could not build the sorted keys for the sort-merge "
+                                   "join | ") +
+                       e.what());
+  } catch (const ColumnarConversionNotSupported& e) {
+    throw HashJoinFail(std::string("Could not build the sorted keys for the sort-merge "
+                                   "join | ") +
+                       e.what());
+  } catch (const OutOfMemory& e) {
+    throw HashJoinFail(
+        std::string("Ran out of memory while sorting the keys for the sort-merge "
+                    "join | ") +
+        e.what());
+  } catch (const std::exception& e) {
+    throw std::runtime_error(
+        std::string("Fatal error while attempting to build a sort-merge join: ") +
+        e.what());
+  }
+  if (VLOGGING(1)) {
+    ts2 = std::chrono::steady_clock::now();
+    VLOG(1) << "Built sort-merge join table of "
+            << join_hash_table->getHashTableForDevice(0)->getEntryCount() << " keys in "
+            << std::chrono::duration_cast<std::chrono::milliseconds>(ts2 - ts1).count()
+            << " ms";
+  }
+  return join_hash_table;
+}
+
+bool SortMergeJoinHashTable::preferredOverKeyedHashTable(
+    const std::shared_ptr<Analyzer::BinOper> qual_bin_oper,
+    const std::vector<InputTableInfo>& query_infos,
+    const Data_Namespace::MemoryLevel memory_level,
+    const JoinType join_type,
+    const Executor* executor) {
+  // the window functions partition with the layout of a one-to-many hash table
+  if (!g_enable_sort_merge_join || memory_level != Data_Namespace::CPU_LEVEL ||
+      join_type == JoinType::INVALID || qual_bin_oper->get_optype() != kEQ ||
+      dynamic_cast<const Analyzer::ExpressionTuple*>(qual_bin_oper->get_left_operand())) {
+    return false;
+  }
+  InnerOuter cols;
+  try {
+    cols = normalizeColumnPair(qual_bin_oper->get_left_operand(),
+                               qual_bin_oper->get_right_operand(),
+                               *executor->getCatalog(),
+                               executor->getTemporaryTables());
+  } catch (const HashJoinFail&) {
+    return false;
+  }
+  const auto inner_col = cols.first;
+  const auto& ti = inner_col->get_type_info();
+  if (!ti.is_integer() && !ti.is_decimal() && !ti.is_time() && !ti.is_boolean() &&
+      !(ti.is_string() && ti.get_compression() == kENCODING_DICT)) {
+    return false;
+  }
+  if (ti.is_string() && needs_dictionary_translation(inner_col, cols.second, executor)) {
+    return false;
+  }
+  if (inner_col->get_table_id() > 0) {
+    const auto inner_td =
+        executor->getCatalog()->getMetadataForTable(inner_col->get_table_id());
+    if (inner_td && inner_td->sortedColumnId == inner_col->get_column_id()) {
+      return true;
+    }
+  }
+  // A keyed hash table has twice as many entries as the inner table has rows, each with
+  // a key, an offset and a count, followed by the row ids.
+  const auto& query_info = get_inner_query_info(inner_col->get_table_id(), query_infos);
+  const size_t num_tuples = query_info.info.getNumTuplesUpperBound();
+  const size_t keyed_hash_table_bytes =
+      2 * num_tuples * (sizeof(int64_t) + 2 * sizeof(int32_t)) +
+      num_tuples * sizeof(int32_t);
+  return keyed_hash_table_bytes > g_sort_merge_join_max_hash_table_bytes;
+}
+
+InnerOuter SortMergeJoinHashTable::getInnerOuterPair() const {
+  return normalizeColumnPair(qual_bin_oper_->get_left_operand(),
+                             qual_bin_oper_->get_right_operand(),
+                             *executor_->getCatalog(),
+                             executor_->getTemporaryTables());
+}
+
+void SortMergeJoinHashTable::reify() {
+  auto timer = DEBUG_TIMER(__func__);
+  HashJoin::checkHashJoinReplicationConstraint(getInnerTableId(), 0, executor_);
+  const auto& query_info = get_inner_query_info(getInnerTableId(), query_infos_).info;
+  if (query_info.getNumTuplesUpperBound() >
+      static_cast<size_t>(std::numeric_limits<int32_t>::max())) {
+    throw TooManyHashEntries();
+  }
+  if (query_info.fragments.empty()) {
+    hash_tables_for_device_[0] = std::make_shared<SortMergeHashTable>(0);
+    return;
+  }
+  const auto catalog = executor_->getCatalog();
+  const auto inner_cd = get_column_descriptor_maybe(
+      inner_col_->get_column_id(), inner_col_->get_table_id(), *catalog);
+  if (inner_cd && inner_cd->isVirtualCol) {
+    throw FailedToJoinOnVirtualColumn();
+  }
+  std::vector<std::shared_ptr<Chunk_NS::Chunk>> chunks_owner;
+  std::vector<std::shared_ptr<void>> malloc_owner;
+  const auto join_column = fetchJoinColumn(inner_col_.get(),
+                                           query_info.fragments,
+                                           Data_Namespace::CPU_LEVEL,
+                                           0,
+                                           chunks_owner,
+                                           nullptr,
+                                           malloc_owner,
+                                           executor_,
+                                           &column_cache_);
+  const auto& ti = inner_col_->get_type_info();
+  const JoinColumnTypeInfo type_info{static_cast<size_t>(ti.get_size()),
+                                     0,
+                                     0,
+                                     inline_fixed_encoding_null_val(ti),
+                                     false,
+                                     0,
+                                     get_join_column_type_kind(ti)};
+  const auto chunks = reinterpret_cast<const JoinChunk*>(join_column.col_chunks_buff);
+  std::vector<size_t> first_row_ids(join_column.num_chunks);
+  for (size_t i = 1; i < join_column.num_chunks; ++i) {
+    first_row_ids[i] = first_row_ids[i - 1] + chunks[i - 1].num_elems;
+  }
+  std::vector<std::vector<KeyAndRowId>> runs(join_column.num_chunks);
+  threading::parallel_for(size_t(0), join_column.num_chunks, [&](const size_t i) {
+    runs[i] = make_sorted_run(chunks[i], first_row_ids[i], join_column, type_info);
+  });
+  const auto sorted_keys = merge_runs(std::move(runs));
+
+  auto hash_table = std::make_shared<SortMergeHashTable>(sorted_keys.size());
+  auto keys = hash_table->getKeys();
+  auto row_ids = hash_table->getRowIds();
+  threading::parallel_for(size_t(0), sorted_keys.size(), [&](const size_t i) {
+    keys[i] = sorted_keys[i].first;
+    row_ids[i] = sorted_keys[i].second;
+  });
+  hash_tables_for_device_[0] = hash_table;
+}
+
+HashJoinMatchingSet SortMergeJoinHashTable::codegenMatchingSet(
+    const CompilationOptions& co,
+    const size_t index) {
+  AUTOMATIC_IR_METADATA(executor_->cgen_state_.get());
+  const auto cols = getInnerOuterPair();
+  const auto key_col = cols.second;
+  CHECK(key_col);
+  const auto val_col = cols.first;
+  CHECK(val_col);
+  const auto key_col_var = dynamic_cast<const Analyzer::ColumnVar*>(key_col);
+  if (key_col_var &&
+      self_join_not_covered_by_left_deep_tree(
+          key_col_var,
+          val_col,
+          get_max_rte_scan_table(executor_->cgen_state_->scan_idx_to_hash_pos_))) {
+    throw std::runtime_error(
+        "Query execution fails because the query contains not supported self-join "
+        "pattern. We suspect the query requires multiple left-deep join tree due to "
+        "the join condition of the self-join and is not supported for now. Please "
+        "consider rewriting table order in FROM clause.");
+  }
+  auto cgen_state = executor_->cgen_state_.get();
+  auto& ir_builder = cgen_state->ir_builder_;
+  auto sorted_buff_lv = HashJoin::codegenHashTableLoad(index, executor_);
+  if (!sorted_buff_lv->getType()->isIntegerTy(64)) {
+    CHECK(sorted_buff_lv->getType()->isPointerTy());
+    sorted_buff_lv = ir_builder.CreatePtrToInt(
+        get_arg_by_name(cgen_state->row_func_, "join_hash_tables"),
+        llvm::Type::getInt64Ty(cgen_state->context_));
+  }
+  CodeGenerator code_generator(executor_);
+  const auto key_lvs = code_generator.codegen(key_col, true, co);
+  CHECK_EQ(size_t(1), key_lvs.size());
+  const auto key_lv = cgen_state->castToTypeIn(key_lvs.front(), 64);
+
+  const auto lower_bound_lv =
+      cgen_state->emitCall("sorted_join_lower_bound", {sorted_buff_lv, key_lv});
+  const auto upper_bound_lv =
+      cgen_state->emitCall("sorted_join_upper_bound", {sorted_buff_lv, key_lv});
+  llvm::Value* row_count_lv = ir_builder.CreateSub(upper_bound_lv, lower_bound_lv);
+  const auto key_col_logical_ti = get_logical_type_info(key_col->get_type_info());
+  if (!key_col_logical_ti.get_notnull()) {
+    const auto is_null_lv = ir_builder.CreateICmpEQ(
+        key_lv, cgen_state->llInt(inline_fixed_encoding_null_val(key_col_logical_ti)));
+    row_count_lv =
+        ir_builder.CreateSelect(is_null_lv, cgen_state->llInt(int64_t(0)), row_count_lv);
+  }
+  const auto row_ids_lv = ir_builder.CreateIntToPtr(
+      cgen_state->emitCall("sorted_join_row_ids", {sorted_buff_lv}),
+      llvm::Type::getInt32PtrTy(cgen_state->context_));
+  const auto rowid_ptr_lv = ir_builder.CreateGEP(row_ids_lv, lower_bound_lv);
+  return {rowid_ptr_lv, row_count_lv, lower_bound_lv};
+}
+
+llvm::Value* SortMergeJoinHashTable::codegenSlot(const CompilationOptions&,
+                                                 const size_t) {
+  UNREACHABLE();  // the sorted keys are always used as one-to-many
+  return nullptr;
+}
+
+size_t SortMergeJoinHashTable::offsetBufferOff() const noexcept {
+  return sizeof(int64_t);
+}
+
+size_t SortMergeJoinHashTable::countBufferOff() const noexcept {
+  return offsetBufferOff();
+}
+
+size_t SortMergeJoinHashTable::payloadBufferOff() const noexcept {
+  return offsetBufferOff() + getComponentBufferSize();
+}
+
+size_t SortMergeJoinHashTable::getComponentBufferSize() const noexcept {
+  const auto hash_table = hash_tables_for_device_.front();
+  return hash_table ? hash_table->getEntryCount() * sizeof(int64_t) : 0;
+}
+
+std::set<DecodedJoinHashBufferEntry> SortMergeJoinHashTable::toSet(
+    const ExecutorDeviceType device_type,
+    const int device_id) const {
+  CHECK(device_type == ExecutorDeviceType::CPU);
+  std::set<DecodedJoinHashBufferEntry> entries;
+  auto hash_table = dynamic_cast<SortMergeHashTable*>(getHashTableForDevice(device_id));
+  if (!hash_table) {
+    return entries;
+  }
+  const auto keys = hash_table->getKeys();
+  const auto row_ids = hash_table->getRowIds();
+  const auto entry_count = hash_table->getEntryCount();
+  for (size_t i = 0; i < entry_count;) {
+    DecodedJoinHashBufferEntry entry{{keys[i]}, {}};
+    for (; i < entry_count && keys[i] == entry.key.front(); ++i) {
+      entry.payload.insert(row_ids[i]);
+    }
+    entries.insert(std::move(entry));
+  }
+  return entries;
+}
+
+std::string SortMergeJoinHashTable::toString(const ExecutorDeviceType device_type,
+                                             const int device_id,
+                                             bool raw) const {
+  std::ostringstream oss;
+  oss << "| sort-merge " << getHashTypeString(HashType::OneToMany) << " |\n";
+  oss << toSet(device_type, device_id);
+  return oss.str();
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * @file    SortMergeJoinHashTable.h
+ * @brief   Equijoin on a single column through the sorted keys of the inner table.
+ *
+ * The inner join column is turned into runs of (key, row id) pairs, one per fragment,
+ * which are sorted unless the fragment already is (tables created with a sort_column)
+ * and then merged. The outer rows find their matches with a binary search of the merged
+ * keys, which the join loops iterate like the rows of a one-to-many hash table entry, so
+ * inner, left, semi and anti joins work unchanged. The table takes 12 bytes per inner
+ * row, a fraction of a keyed hash table with its empty entries, which is why it replaces
+ * the latter for inner tables too large to hash or already sorted on the join column.
+ */
+
+#pragma once
+
+#include "QueryEngine/JoinHashTable/HashJoin.h"
+#include "QueryEngine/JoinHashTable/SortMergeHashTable.h"
+
+class SortMergeJoinHashTable : public HashJoin {
+ public:
+  //! Make the sorted keys table from an in-flight SQL query's parse tree etc.
+  static std::shared_ptr<SortMergeJoinHashTable> getInstance(
+      const std::shared_ptr<Analyzer::BinOper> qual_bin_oper,
+      const std::vector<InputTableInfo>& query_infos,
+      const Data_Namespace::MemoryLevel memory_level,
+      const JoinType join_type,
+      ColumnCacheMap& column_cache,
+      Executor* executor);
+
+  //! Whether the equijoin should use a sort-merge join instead of a keyed hash table,
+  //! asked once the perfect hash table turned out to be too large or too sparse.
+  static bool preferredOverKeyedHashTable(
+      const std::shared_ptr<Analyzer::BinOper> qual_bin_oper,
+      const std::vector<InputTableInfo>& query_infos,
+      const Data_Namespace::MemoryLevel memory_level,
+      const JoinType join_type,
+      const Executor* executor);
+
+  std::string toString(const ExecutorDeviceType device_type,
+                       const int device_id = 0,
+                       bool raw = false) const override;
+
+  std::set<DecodedJoinHashBufferEntry> toSet(const ExecutorDeviceType device_type,
+                                             const int device_id) const override;
+
+  llvm::Value* codegenSlot(const CompilationOptions&, const size_t) override;
+
+  HashJoinMatchingSet codegenMatchingSet(const CompilationOptions&,
+                                         const size_t) override;
+
+  int getInnerTableId() const noexcept override { return inner_col_->get_table_id(); }
+
+  int getInnerTableRteIdx() const noexcept override { return inner_col_->get_rte_idx(); }
+
+  HashType getHashType() const noexcept override { return HashType::OneToMany; }
+
+  Data_Namespace::MemoryLevel getMemoryLevel() const noexcept override {
+    return Data_Namespace::CPU_LEVEL;
+  }
+
+  int getDeviceCount() const noexcept override { return 1; }
+
+  size_t offsetBufferOff() const noexcept override;
+
+  size_t countBufferOff() const noexcept override;
+
+  size_t payloadBufferOff() const noexcept override;
+
+  std::string getHashJoinType() const final { return "SortMerge"; }
+
+  virtual ~SortMergeJoinHashTable() {}
+
+ private:
+  SortMergeJoinHashTable(const std::shared_ptr<Analyzer::BinOper> qual_bin_oper,
+                         const Analyzer::ColumnVar* inner_col,
+                         const std::vector<InputTableInfo>& query_infos,
+                         const JoinType join_type,
+                         ColumnCacheMap& column_cache,
+                         Executor* executor)
+      : qual_bin_oper_(qual_bin_oper)
+      , inner_col_(
+            std::dynamic_pointer_cast<Analyzer::ColumnVar>(inner_col->deep_copy()))
+      , query_infos_(query_infos)
+      , join_type_(join_type)
+      , executor_(executor)
+      , column_cache_(column_cache) {
+    hash_tables_for_device_.resize(1);
+  }
+
+  void reify();
+
+  InnerOuter getInnerOuterPair() const;
+
+  size_t getComponentBufferSize() const noexcept override;
+
+  std::shared_ptr<Analyzer::BinOper> qual_bin_oper_;
+  std::shared_ptr<Analyzer::ColumnVar> inner_col_;
+  const std::vector<InputTableInfo>& query_infos_;
+  const JoinType join_type_;
+  Executor* executor_;
+  ColumnCacheMap& column_cache_;
+};
@@ -68,6 +68,7 @@ static_assert(false, "LLVM Version >= 9 is required.");
 #include "QueryEngine/LLVMFunctionAttributesUtil.h"
 #include "QueryEngine/Optimization/AnnotateInternalFunctionsPass.h"
 #include "QueryEngine/OutputBufferInitialization.h"
+#include "QueryEngine/PersistentCodeCache.h"
 #include "QueryEngine/QueryTemplateGenerator.h"
 #include "Shared/InlineNullValues.h"
 #include "Shared/MathUtils.h"
@@ -80,6 +81,11 @@ std::unique_ptr<llvm::Module> udf_cpu_module;
 std::unique_ptr<llvm::Module> rt_udf_gpu_module;
 std::unique_ptr<llvm::Module> rt_udf_cpu_module;
 
+// digests of the CPU UDF modules for the persistent code cache keys, set when the
+// modules are read
+std::string udf_cpu_module_digest;
+std::string rt_udf_cpu_module_digest;
+
 extern std::unique_ptr<llvm::Module> g_rt_module;
 
 #ifdef HAVE_CUDA
@@ -443,12 +449,19 @@ std::string assemblyForCPU(ExecutionEngineWrapper& execution_engine,
 ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
     llvm::Function* func,
     const std::unordered_set<llvm::Function*>& live_funcs,
-    const CompilationOptions& co) {
+    const CompilationOptions& co,
+    PersistentCodeCache* persistent_code_cache) {
   auto module = func->getParent();
+  // the object is read here rather than checked for, it could be evicted before the
+  // execution engine asks for it and the unoptimized module would be compiled instead
+  const bool has_cached_object =
+      persistent_code_cache && persistent_code_cache->loadObject(module);
   // run optimizations
 #ifndef WITH_JIT_DEBUG
-  llvm::legacy::PassManager pass_manager;
-  optimize_ir(func, module, pass_manager, live_funcs, co);
+  if (!has_cached_object) {
+    llvm::legacy::PassManager pass_manager;
+    optimize_ir(func, module, pass_manager, live_funcs, co);
+  }
 #endif  // WITH_JIT_DEBUG
 
   auto init_err = llvm::InitializeNativeTarget();
@@ -479,7 +492,14 @@ ExecutionEngineWrapper CodeGenerator::generateNativeCPUCode(
 
   ExecutionEngineWrapper execution_engine(eb.create(), co);
   CHECK(execution_engine.get());
-  LOG(ASM) << assemblyForCPU(execution_engine, module);
+  if (persistent_code_cache) {
+    // MCJIT looks the module up before compiling it, and hands over the object code of
+    // the modules it had to compile
+    execution_engine->setObjectCache(persistent_code_cache);
+  }
+  if (!has_cached_object) {
+    LOG(ASM) << assemblyForCPU(execution_engine, module);
+  }
 
   execution_engine->finalizeObject();
   return execution_engine;
@@ -529,8 +549,27 @@ std::shared_ptr<CompilationContext> Executor::optimizeAndCodegenCPU(
 #endif
   }
 
-  auto execution_engine =
-      CodeGenerator::generateNativeCPUCode(query_func, live_funcs, co);
+#ifdef WITH_JIT_DEBUG
+  // the IR is not optimized in JIT debug builds, don't persist the object code
+  PersistentCodeCache* persistent_code_cache{nullptr};
+#else
+  auto persistent_code_cache = PersistentCodeCache::get();
+#endif  // WITH_JIT_DEBUG
+  if (persistent_code_cache) {
+    static const std::string rt_module_digest =
+        PersistentCodeCache::getModuleDigest(*g_rt_module);
+    std::vector<std::string> module_digests{rt_module_digest};
+    if (udf_cpu_module) {
+      module_digests.push_back(udf_cpu_module_digest);
+    }
+    if (rt_udf_cpu_module) {
+      module_digests.push_back(rt_udf_cpu_module_digest);
+    }
+    module->setModuleIdentifier(
+        PersistentCodeCache::getObjectKey(key, co, module_digests));
+  }
+  auto execution_engine = CodeGenerator::generateNativeCPUCode(
+      query_func, live_funcs, co, persistent_code_cache);
   auto cpu_compilation_context =
       std::make_shared<CpuCompilationContext>(std::move(execution_engine));
   cpu_compilation_context->setFunctionPointer(multifrag_query_func);
@@ -1800,6 +1839,7 @@ void read_udf_cpu_module(const std::string& udf_ir_filename) {
   if (!udf_cpu_module) {
     throw_parseIR_error(parse_error, udf_ir_filename);
   }
+  udf_cpu_module_digest = PersistentCodeCache::getModuleDigest(*udf_cpu_module);
 }
 
 }  // namespace
@@ -1847,6 +1887,7 @@ void read_rt_udf_cpu_module(const std::string& udf_ir_string) {
     LOG(IR) << "read_rt_udf_cpu_module:LLVM IR:\n" << udf_ir_string << "\nEnd of LLVM IR";
     throw_parseIR_error(parse_error);
   }
+  rt_udf_cpu_module_digest = PersistentCodeCache::getModuleDigest(*rt_udf_cpu_module);
 }
 
 std::unordered_set<llvm::Function*> CodeGenerator::markDeadRuntimeFuncs(
@@ -2609,9 +2650,10 @@ Executor::compileWorkUnit(const std::vector<InputTableInfo>& query_infos,
                                                        render_info,
                                                        eo.output_columnar_hint);
 
+  // adaptive buffers grow when they run out of slots, they don't need an estimate
   if (query_mem_desc->getQueryDescriptionType() ==
           QueryDescriptionType::GroupByBaselineHash &&
-      !has_cardinality_estimation &&
+      !has_cardinality_estimation && !query_mem_desc->hasAdaptiveEntryCount() &&
       (!render_info || !render_info->isPotentialInSituRender()) && !eo.just_explain) {
     const auto col_range_info = group_by_and_aggregate.getColRangeInfo();
     throw CardinalityEstimationRequired(col_range_info.max - col_range_info.min);
@@ -0,0 +1,228 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/PersistentCodeCache.h"
+
+#include "Logger/Logger.h"
+#include "MapDRelease.h"
+#include "QueryEngine/CompilationOptions.h"
+
+#include <boost/filesystem.hpp>
+#include <llvm/ADT/StringExtras.h>
+#include <llvm/Bitcode/BitcodeWriter.h>
+#include <llvm/Support/Host.h>
+#include <llvm/Support/MemoryBuffer.h>
+#include <llvm/Support/SHA1.h>
+#include <llvm/Support/raw_ostream.h>
+
+#include <algorithm>
+#include <fstream>
+#include <unistd.h>
+
+namespace {
+
+// Prefix of the module identifiers set by getObjectKey, the object cache is only
+// consulted for the modules tagged with it.
+const std::string kObjectKeyPrefix{"omnisci_cached_kernel_"};
+const std::string kObjectFileExtension{".o"};
+
+// Everything besides the IR and the linked modules which changes the generated object
+// code: the code is lowered for the host CPU by the current LLVM version.
+std::string get_code_generation_environment() {
+  std::string environment = MAPD_RELEASE + "\n" + std::to_string(LLVM_VERSION_MAJOR) +
+                            "." + std::to_string(LLVM_VERSION_MINOR) + "." +
+                            std::to_string(LLVM_VERSION_PATCH) + "\n" +
+                            llvm::sys::getProcessTriple() + "\n" +
+                            llvm::sys::getHostCPUName().str() + "\n";
+  llvm::StringMap<bool> cpu_features;
+  if (llvm::sys::getHostCPUFeatures(cpu_features)) {
+    // StringMap iteration order is unspecified, sort the features for a stable key
+    std::vector<std::string> features;
+    for (auto it = cpu_features.begin(); it != cpu_features.end(); ++it) {
+      features.push_back((it->getValue() ? "+" : "-") + it->getKey().str());
+    }
+    std::sort(features.begin(), features.end());
+    for (const auto& feature : features) {
+      environment += feature + " ";
+    }
+  }
+  return environment;
+}
+
+}  // namespace
+
+PersistentCodeCache::PersistentCodeCache(const std::string& path,
+                                         const size_t max_size_bytes)
+    : path_(path), max_size_bytes_(max_size_bytes) {
+  boost::system::error_code ec;
+  boost::filesystem::create_directories(path_, ec);
+  if (ec) {
+    LOG(WARNING) << "Failed to create the persistent code cache directory " << path_
+                 << ": " << ec.message();
+  }
+}
+
+PersistentCodeCache* PersistentCodeCache::get() {
+  if (!g_enable_persistent_code_cache || g_persistent_code_cache_path.empty()) {
+    return nullptr;
+  }
+  static PersistentCodeCache persistent_code_cache(
+      g_persistent_code_cache_path, g_persistent_code_cache_max_size_bytes);
+  return &persistent_code_cache;
+}
+
+std::string PersistentCodeCache::getObjectKey(
+    const CodeCacheKey& key,
+    const CompilationOptions& co,
+    const std::vector<std::string>& module_digests) {
+  static const std::string environment = get_code_generation_environment();
+  std::string key_str = environment + std::to_string(static_cast<int>(co.opt_level));
+  for (const auto& digest : module_digests) {
+    key_str += "\n" + digest;
+  }
+  for (const auto& str : key) {
+    key_str += "\n" + std::to_string(str.size()) + "\n" + str;
+  }
+  return kObjectKeyPrefix + llvm::toHex(llvm::SHA1::hash(llvm::arrayRefFromStringRef(
+                                key_str)),
+                            /*LowerCase=*/true);
+}
+
+std::string PersistentCodeCache::getModuleDigest(const llvm::Module& module) {
+  std::string bitcode;
+  llvm::raw_string_ostream os(bitcode);
+  llvm::WriteBitcodeToFile(module, os);
+  os.flush();
+  return llvm::toHex(llvm::SHA1::hash(llvm::arrayRefFromStringRef(bitcode)),
+                     /*LowerCase=*/true);
+}
+
+std::string PersistentCodeCache::getObjectPath(const llvm::Module* module) const {
+  const auto& module_id = module->getModuleIdentifier();
+  if (module_id.compare(0, kObjectKeyPrefix.size(), kObjectKeyPrefix) != 0) {
+    return "";
+  }
+  return (boost::filesystem::path(path_) / (module_id + kObjectFileExtension)).string();
+}
+
+bool PersistentCodeCache::loadObject(const llvm::Module* module) {
+  const auto object_path = getObjectPath(module);
+  if (object_path.empty()) {
+    return false;
+  }
+  // a single read, the object can be evicted at any time
+  auto object = llvm::MemoryBuffer::getFile(object_path);
+  if (!object) {
+    ++num_misses_;
+    return false;
+  }
+  ++num_hits_;
+  // refresh the timestamp, the eviction drops the least recently used objects first
+  boost::system::error_code ec;
+  boost::filesystem::last_write_time(object_path, std::time(nullptr), ec);
+  std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+  loaded_objects_[module] =
+      std::make_pair(module->getModuleIdentifier(), std::move(*object));
+  return true;
+}
+
+void PersistentCodeCache::notifyObjectCompiled(const llvm::Module* module,
+                                               llvm::MemoryBufferRef object) {
+  const auto object_path = getObjectPath(module);
+  if (object_path.empty() || object.getBufferSize() > max_size_bytes_) {
+    return;
+  }
+  std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+  evictObjects(max_size_bytes_ - object.getBufferSize());
+  // write to a temporary file first, so that concurrent readers (possibly other server
+  // processes sharing the directory) never see a partially written object
+  const auto tmp_path = object_path + "." + std::to_string(getpid()) + ".tmp";
+  {
+    std::ofstream object_file(tmp_path, std::ios::binary | std::ios::trunc);
+    object_file.write(object.getBufferStart(), object.getBufferSize());
+    if (!object_file) {
+      LOG(WARNING) << "Failed to write the cached object file " << tmp_path;
+      boost::system::error_code ec;
+      boost::filesystem::remove(tmp_path, ec);
+      return;
+    }
+  }
+  boost::system::error_code ec;
+  boost::filesystem::rename(tmp_path, object_path, ec);
+  if (ec) {
+    LOG(WARNING) << "Failed to add the object file " << object_path
+                 << " to the persistent code cache: " << ec.message();
+    boost::filesystem::remove(tmp_path, ec);
+  }
+}
+
+std::unique_ptr<llvm::MemoryBuffer> PersistentCodeCache::getObject(
+    const llvm::Module* module) {
+  std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+  auto it = loaded_objects_.find(module);
+  if (it == loaded_objects_.end()) {
+    return nullptr;
+  }
+  auto object = std::move(it->second);
+  loaded_objects_.erase(it);
+  // the address can belong to another module if the compilation of the one the object
+  // was loaded for failed before reaching this point
+  if (object.first != module->getModuleIdentifier()) {
+    return nullptr;
+  }
+  return std::move(object.second);
+}
+
+void PersistentCodeCache::clear() {
+  std::lock_guard<std::mutex> cache_lock(cache_mutex_);
+  evictObjects(0);
+}
+
+void PersistentCodeCache::evictObjects(const size_t target_size_bytes) {
+  std::vector<std::pair<std::time_t, boost::filesystem::path>> objects;
+  size_t total_size_bytes{0};
+  boost::system::error_code ec;
+  for (boost::filesystem::directory_iterator it(path_, ec), end; !ec && it != end;
+       it.increment(ec)) {
+    const auto& object_path = it->path();
+    if (object_path.extension() != kObjectFileExtension ||
+        object_path.filename().string().compare(
+            0, kObjectKeyPrefix.size(), kObjectKeyPrefix) != 0) {
+      continue;
+    }
+    boost::system::error_code file_ec;
+    const auto file_size = boost::filesystem::file_size(object_path, file_ec);
+    const auto last_write_time = boost::filesystem::last_write_time(object_path, file_ec);
+    if (!file_ec) {
+      total_size_bytes += file_size;
+      objects.emplace_back(last_write_time, object_path);
+    }
+  }
+  if (total_size_bytes <= target_size_bytes) {
+    return;
+  }
+  std::sort(objects.begin(), objects.end());
+  for (const auto& object : objects) {
+    if (total_size_bytes <= target_size_bytes) {
+      break;
+    }
+    boost::system::error_code file_ec;
+    const auto file_size = boost::filesystem::file_size(object.second, file_ec);
+    if (!file_ec && boost::filesystem::remove(object.second, file_ec)) {
+      total_size_bytes -= std::min(total_size_bytes, static_cast<size_t>(file_size));
+    }
+  }
+}
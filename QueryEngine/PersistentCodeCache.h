@@ -0,0 +1,101 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    PersistentCodeCache.h
+ * @brief   On-disk tier of the CPU code cache, which keeps the object code of compiled
+ *          query kernels across server restarts.
+ *
+ * The in-memory CodeCache is empty after every restart, so the first execution of each
+ * query pays the full LLVM compilation cost again. This cache hooks into the MCJIT
+ * object cache interface: the object code of every compiled kernel is written to a file
+ * named after a digest of the code cache key, the runtime and UDF modules linked into
+ * the kernel, the build, the LLVM version and the host CPU, and later compilations of
+ * the same kernel load the object file instead of optimizing and lowering the IR.
+ * Nothing is read at startup, object files are loaded lazily on the first lookup of
+ * their key.
+ */
+
+#pragma once
+
+#include "QueryEngine/CodeCache.h"
+
+#include <llvm/ExecutionEngine/ObjectCache.h>
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern bool g_enable_persistent_code_cache;
+extern std::string g_persistent_code_cache_path;
+extern size_t g_persistent_code_cache_max_size_bytes;
+
+struct CompilationOptions;
+
+class PersistentCodeCache : public llvm::ObjectCache {
+ public:
+  PersistentCodeCache(const std::string& path, const size_t max_size_bytes);
+
+  // returns nullptr if the persistent code cache is disabled, the cache directory is
+  // created on the first call
+  static PersistentCodeCache* get();
+
+  // digest which identifies the object code of the given kernel on disk, to be set as
+  // the identifier of the module holding the kernel before compiling it; module_digests
+  // are the getModuleDigest digests of the modules linked into the kernel
+  static std::string getObjectKey(const CodeCacheKey& key,
+                                  const CompilationOptions& co,
+                                  const std::vector<std::string>& module_digests);
+
+  static std::string getModuleDigest(const llvm::Module& module);
+
+  // reads the object file of the given module, returns false if there is none; a loaded
+  // object is handed to the execution engine by the next getObject call for the module,
+  // which only has to be optimized and compiled if the lookup failed
+  bool loadObject(const llvm::Module* module);
+
+  void notifyObjectCompiled(const llvm::Module* module,
+                            llvm::MemoryBufferRef object) override;
+
+  std::unique_ptr<llvm::MemoryBuffer> getObject(const llvm::Module* module) override;
+
+  // removes all the cached object files
+  void clear();
+
+  size_t getNumHits() const { return num_hits_; }
+  size_t getNumMisses() const { return num_misses_; }
+
+ private:
+  // returns an empty string for modules whose identifier was not set by getObjectKey
+  std::string getObjectPath(const llvm::Module* module) const;
+
+  // evicts the least recently used object files until the cache fits into the given
+  // number of bytes, must be called with the mutex held
+  void evictObjects(const size_t target_size_bytes);
+
+  const std::string path_;
+  const size_t max_size_bytes_;
+  std::mutex cache_mutex_;
+  // objects read by loadObject and not yet returned by getObject, with the identifier
+  // of the module they were loaded for
+  std::unordered_map<const llvm::Module*,
+                     std::pair<std::string, std::unique_ptr<llvm::MemoryBuffer>>>
+      loaded_objects_;
+  std::atomic<size_t> num_hits_{0};
+  std::atomic<size_t> num_misses_{0};
+};
@@ -609,7 +609,8 @@ std::vector<int64_t*> QueryExecutionContext::launchCpuCode(
     int32_t* error_code,
     const uint32_t num_tables,
     const std::vector<int64_t>& join_hash_tables,
-    const int64_t num_rows_to_process) {
+    const int64_t num_rows_to_process,
+    const int64_t first_row_to_process) {
   auto timer = DEBUG_TIMER(__func__);
   INJECT_TIMER(lauchCpuCode);
 
@@ -656,14 +657,19 @@ std::vector<int64_t*> QueryExecutionContext::launchCpuCode(
     flatened_frag_offsets.insert(
         flatened_frag_offsets.end(), offsets.begin(), offsets.end());
   }
-  int64_t rowid_lookup_num_rows{*error_code ? *error_code + 1 : 0};
-  int64_t* num_rows_ptr;
-  if (num_rows_to_process > 0) {
-    flatened_num_rows[0] = num_rows_to_process;
-    num_rows_ptr = flatened_num_rows.data();
-  } else {
-    num_rows_ptr =
-        rowid_lookup_num_rows ? &rowid_lookup_num_rows : flatened_num_rows.data();
+  int64_t rowid_lookup_num_rows{0};
+  int64_t* num_rows_ptr = flatened_num_rows.data();
+  if (num_rows_to_process >= 0) {
+    // an explicit range of rows of the outer fragment, the kernel starts scanning from
+    // the position it finds in the error code
+    CHECK_EQ(*error_code, 0);
+    CHECK_GE(first_row_to_process, 0);
+    CHECK_LE(first_row_to_process + num_rows_to_process, flatened_num_rows[0]);
+    flatened_num_rows[0] = first_row_to_process + num_rows_to_process;
+    *error_code = first_row_to_process;
+  } else if (*error_code) {
+    rowid_lookup_num_rows = *error_code + 1;
+    num_rows_ptr = &rowid_lookup_num_rows;
   }
   int32_t total_matched_init{0};
 
@@ -765,7 +771,9 @@ std::vector<int64_t*> QueryExecutionContext::launchCpuCode(
     return {};
   }
 
-  if (rowid_lookup_num_rows && *error_code < 0) {
+  // an adaptive buffer which ran out of slots has to grow, even for a rowid lookup
+  if (rowid_lookup_num_rows && *error_code < 0 &&
+      !query_mem_desc_.hasAdaptiveEntryCount()) {
     *error_code = 0;
   }
 
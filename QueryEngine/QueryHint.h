@@ -34,6 +34,7 @@ enum QueryHint {
   kOverlapsAllowGpuBuild,
   kOverlapsNoCache,
   kOverlapsKeysPerBin,
+  kVectorizedInterpreter,
   kHintCount,   // should be at the last elem before INVALID enum value to count #
                 // supported hints correctly
   kInvalidHint  // this should be the last elem of this enum
@@ -47,7 +48,8 @@ static const std::unordered_map<std::string, QueryHint> SupportedQueryHints = {
     {"overlaps_max_size", QueryHint::kOverlapsMaxSize},
     {"overlaps_allow_gpu_build", QueryHint::kOverlapsAllowGpuBuild},
     {"overlaps_no_cache", QueryHint::kOverlapsNoCache},
-    {"overlaps_keys_per_bin", QueryHint::kOverlapsKeysPerBin}};
+    {"overlaps_keys_per_bin", QueryHint::kOverlapsKeysPerBin},
+    {"vectorized_interpreter", QueryHint::kVectorizedInterpreter}};
 
 class ExplainedQueryHint {
   // this class represents parsed query hint's specification
@@ -143,6 +145,7 @@ struct RegisteredQueryHint {
       , overlaps_allow_gpu_build(true)
       , overlaps_no_cache(false)
       , overlaps_keys_per_bin(g_overlaps_target_entries_per_bin)
+      , vectorized_interpreter(false)
       , registered_hint(QueryHint::kHintCount, false) {}
 
   RegisteredQueryHint& operator=(const RegisteredQueryHint& other) {
@@ -154,6 +157,7 @@ struct RegisteredQueryHint {
     overlaps_allow_gpu_build = other.overlaps_allow_gpu_build;
     overlaps_no_cache = other.overlaps_no_cache;
     overlaps_keys_per_bin = other.overlaps_keys_per_bin;
+    vectorized_interpreter = other.vectorized_interpreter;
     registered_hint = other.registered_hint;
     return *this;
   }
@@ -167,6 +171,7 @@ struct RegisteredQueryHint {
     overlaps_allow_gpu_build = other.overlaps_allow_gpu_build;
     overlaps_no_cache = other.overlaps_no_cache;
     overlaps_keys_per_bin = other.overlaps_keys_per_bin;
+    vectorized_interpreter = other.vectorized_interpreter;
     registered_hint = other.registered_hint;
   }
 
@@ -182,6 +187,9 @@ struct RegisteredQueryHint {
   bool overlaps_no_cache;
   double overlaps_keys_per_bin;
 
+  // run the query on the vectorized CPU interpreter instead of JIT compiling it
+  bool vectorized_interpreter;
+
   std::vector<bool> registered_hint;
 
   static RegisteredQueryHint defaults() { return RegisteredQueryHint(); }
@@ -337,7 +337,8 @@ QueryMemoryInitializer::QueryMemoryInitializer(
     const auto varlen_buffer_elem_size_opt = query_mem_desc.varlenOutputBufferElemSize();
     CHECK(varlen_buffer_elem_size_opt);  // TODO(adb): relax
     auto varlen_output_buffer = reinterpret_cast<int64_t*>(row_set_mem_owner_->allocate(
-        query_mem_desc.getEntryCount() * varlen_buffer_elem_size_opt.value()));
+        query_mem_desc.getEntryCount() * varlen_buffer_elem_size_opt.value(),
+        thread_idx_));
     num_buffers_ += 1;
     group_by_buffers_.push_back(varlen_output_buffer);
   }
@@ -391,6 +392,27 @@ QueryMemoryInitializer::QueryMemoryInitializer(
   }
 }
 
+void QueryMemoryInitializer::growGroupByBuffer(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const QueryMemoryDescriptor& query_mem_desc,
+    const Executor* executor) {
+  CHECK(query_mem_desc.hasAdaptiveEntryCount());
+  CHECK_EQ(size_t(1), group_by_buffers_.size());
+  CHECK_EQ(size_t(1), result_sets_.size());
+  CHECK(result_sets_.front());
+  auto group_by_buffer = reinterpret_cast<int64_t*>(row_set_mem_owner_->allocate(
+      query_mem_desc.getBufferSizeBytes(ExecutorDeviceType::CPU), thread_idx_));
+  initGroupByBuffer(group_by_buffer,
+                    ra_exe_unit,
+                    query_mem_desc,
+                    ExecutorDeviceType::CPU,
+                    /*output_columnar=*/false,
+                    executor);
+  result_sets_.front()->growBaselineStorage(reinterpret_cast<int8_t*>(group_by_buffer),
+                                            query_mem_desc.getEntryCount());
+  group_by_buffers_.front() = group_by_buffer;
+}
+
 // Table functions execution constructor
 QueryMemoryInitializer::QueryMemoryInitializer(
     const TableFunctionExecutionUnit& exe_unit,
@@ -820,7 +842,7 @@ int64_t QueryMemoryInitializer::allocateCountDistinctBitmap(const size_t bitmap_
     auto ptr = count_distinct_bitmap_crt_ptr_;
     count_distinct_bitmap_crt_ptr_ += bitmap_byte_sz;
     row_set_mem_owner_->addCountDistinctBuffer(
-        ptr, bitmap_byte_sz, /*physial_buffer=*/false);
+        ptr, bitmap_byte_sz, /*physial_buffer=*/false, thread_idx_);
     return reinterpret_cast<int64_t>(ptr);
   }
   return reinterpret_cast<int64_t>(
@@ -829,7 +851,7 @@ int64_t QueryMemoryInitializer::allocateCountDistinctBitmap(const size_t bitmap_
 
 int64_t QueryMemoryInitializer::allocateCountDistinctSet() {
   auto count_distinct_set = new robin_hood::unordered_set<int64_t>();
-  row_set_mem_owner_->addCountDistinctSet(count_distinct_set);
+  row_set_mem_owner_->addCountDistinctSet(count_distinct_set, thread_idx_);
   return reinterpret_cast<int64_t>(count_distinct_set);
 }
 
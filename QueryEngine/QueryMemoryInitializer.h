@@ -108,6 +108,13 @@ class QueryMemoryInitializer {
     return num_buffers_;
   }
 
+  // Replaces the baseline hash buffer of a CPU kernel, which ran out of slots, with a
+  // bigger one sized for the entry count of `query_mem_desc`. The old buffer is released
+  // with the row set memory owner.
+  void growGroupByBuffer(const RelAlgExecutionUnit& ra_exe_unit,
+                         const QueryMemoryDescriptor& query_mem_desc,
+                         const Executor* executor);
+
 #ifdef HAVE_CUDA
   GpuGroupByBuffers setupTableFunctionGpuBuffers(
       const QueryMemoryDescriptor& query_mem_desc,
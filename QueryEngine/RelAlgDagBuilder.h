@@ -2243,6 +2243,11 @@ class RelAlgDagBuilder : public boost::noncopyable {
           }
           break;
         }
+        case QueryHint::kVectorizedInterpreter: {
+          query_hint.registerHint(QueryHint::kVectorizedInterpreter);
+          query_hint.vectorized_interpreter = true;
+          break;
+        }
         default:
           break;
       }
@@ -21,6 +21,7 @@
 #include "QueryEngine/CalciteDeserializerUtils.h"
 #include "QueryEngine/CardinalityEstimator.h"
 #include "QueryEngine/ColumnFetcher.h"
+#include "QueryEngine/DataRecycler/ResultSetRecycler.h"
 #include "QueryEngine/EquiJoinCondition.h"
 #include "QueryEngine/ErrorHandling.h"
 #include "QueryEngine/ExpressionRewrite.h"
@@ -36,6 +37,7 @@
 #include "QueryEngine/ResultSetBuilder.h"
 #include "QueryEngine/RexVisitor.h"
 #include "QueryEngine/TableOptimizer.h"
+#include "QueryEngine/VectorizedInterpreter.h"
 #include "QueryEngine/WindowContext.h"
 #include "Shared/TypedDataAccessors.h"
 #include "Shared/measure.h"
@@ -53,6 +55,8 @@ bool g_skip_intermediate_count{true};
 bool g_enable_interop{false};
 bool g_enable_union{false};
 size_t g_estimator_failure_max_groupby_size{256000000};
+bool g_enable_group_by_partitioning{true};
+size_t g_max_group_by_partitions{64};
 
 extern bool g_enable_bump_allocator;
 extern size_t g_default_max_groups_buffer_entry_guess;
@@ -470,6 +474,29 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
   }
   timer_setup.stop();
 
+  auto resultset_cache_key = EMPTY_HASHED_PLAN_DAG_KEY;
+  if (!render_info && !g_cluster && !eo.just_validate && !eo.just_explain &&
+      !eo.just_calcite_explain) {
+    resultset_cache_key = ResultSetRecycler::getResultSetCacheKey(&ra, cat_, executor_);
+  }
+  auto resultset_cache = ResultSetRecyclerHolder::getResultSetRecycler();
+  if (resultset_cache_key != EMPTY_HASHED_PLAN_DAG_KEY) {
+    auto cached_meta_info = resultset_cache->getResultSetMetaInfo(resultset_cache_key);
+    auto cached_rs = cached_meta_info
+                         ? resultset_cache->getItemFromCache(
+                               resultset_cache_key,
+                               CacheItemType::QUERY_RESULTSET,
+                               DataRecyclerUtil::CPU_DEVICE_IDENTIFIER)
+                         : nullptr;
+    if (cached_rs) {
+      ra.setOutputMetainfo(cached_meta_info->targets_meta);
+      ExecutionResult cached_result(cached_rs, cached_meta_info->targets_meta);
+      cached_result.setQueueTime(queue_time_ms);
+      return cached_result;
+    }
+  }
+
+  auto clock_begin_execution = timer_start();
   // Dispatch the subqueries first
   for (auto subquery : getSubqueries()) {
     const auto subquery_ra = subquery->getRelAlg();
@@ -483,7 +510,20 @@ ExecutionResult RelAlgExecutor::executeRelAlgQueryNoRetry(const CompilationOptio
     auto result = ra_executor.executeRelAlgSeq(subquery_seq, co, eo, nullptr, 0);
     subquery->setExecutionResult(std::make_shared<ExecutionResult>(result));
   }
-  return executeRelAlgSeq(ed_seq, co, eo, render_info, queue_time_ms);
+  auto result = executeRelAlgSeq(ed_seq, co, eo, render_info, queue_time_ms);
+  if (resultset_cache_key != EMPTY_HASHED_PLAN_DAG_KEY && !result.empty() &&
+      result.getTable().getFragCount() == 1 &&
+      ResultSetRecycler::isCacheableResultSet(result.getDataPtr())) {
+    const auto& rs = result.getDataPtr();
+    resultset_cache->putItemToCache(resultset_cache_key,
+                                    rs,
+                                    CacheItemType::QUERY_RESULTSET,
+                                    DataRecyclerUtil::CPU_DEVICE_IDENTIFIER,
+                                    rs->getTotalHostBufferSizeBytes(),
+                                    timer_stop(clock_begin_execution),
+                                    ResultSetMetaInfo{result.getTargetsMeta()});
+  }
+  return result;
 }
 
 AggregatedColRange RelAlgExecutor::computeColRangesCache() {
@@ -2118,6 +2158,35 @@ std::unique_ptr<WindowFunctionContext> RelAlgExecutor::createWindowFunctionConte
     CHECK_EQ(join_col_elem_count, elem_count);
     context->addOrderColumn(column, order_col.get(), chunks_owner);
   }
+  const auto& args = window_func->getArgs();
+  if (window_func->getFrame() && !args.empty()) {
+    const auto arg_col =
+        std::dynamic_pointer_cast<const Analyzer::ColumnVar>(args.front());
+    if (!arg_col) {
+      throw std::runtime_error(
+          "Only column arguments supported for window frames for now");
+    }
+    const auto& arg_ti = arg_col->get_type_info();
+    if (!arg_ti.is_integer() && !arg_ti.is_decimal() && !arg_ti.is_fp() &&
+        !arg_ti.is_time() && !arg_ti.is_boolean()) {
+      throw std::runtime_error("Type not supported yet for window frames: " +
+                               arg_ti.get_type_name());
+    }
+    const int8_t* column;
+    size_t join_col_elem_count;
+    std::tie(column, join_col_elem_count) =
+        ColumnFetcher::getOneColumnFragment(executor_,
+                                            *arg_col,
+                                            query_infos.front().info.fragments.front(),
+                                            memory_level,
+                                            0,
+                                            nullptr,
+                                            /*thread_idx=*/0,
+                                            chunks_owner,
+                                            column_cache_map);
+    CHECK_EQ(join_col_elem_count, elem_count);
+    context->addFrameArgColumn(column, arg_col.get(), chunks_owner);
+  }
   return context;
 }
 
@@ -3002,6 +3071,73 @@ inline bool can_use_bump_allocator(const RelAlgExecutionUnit& ra_exe_unit,
          !eo.output_columnar_hint && ra_exe_unit.sort_info.order_entries.empty();
 }
 
+// The group by key the input rows are partitioned on when the group by buffers of a query
+// do not fit in CPU memory, or null if the groups cannot be computed by partitions. The
+// groups of different partitions are disjoint, so their results are concatenated as is,
+// which excludes the top n sorts applied while computing the groups.
+std::shared_ptr<Analyzer::Expr> get_group_by_partition_key(
+    const RelAlgExecutionUnit& ra_exe_unit) {
+  if (ra_exe_unit.groupby_exprs.empty() || !ra_exe_unit.groupby_exprs.front() ||
+      ra_exe_unit.estimator || ra_exe_unit.union_all ||
+      ra_exe_unit.sort_info.algorithm != SortAlgorithm::Default) {
+    return nullptr;
+  }
+  for (const auto& groupby_expr : ra_exe_unit.groupby_exprs) {
+    const auto& groupby_ti = groupby_expr->get_type_info();
+    if (groupby_ti.is_integer()) {
+      return groupby_expr;
+    }
+    if (groupby_ti.is_dict_encoded_string()) {
+      return makeExpr<Analyzer::KeyForStringExpr>(groupby_expr);
+    }
+  }
+  return nullptr;
+}
+
+bool can_partition_group_by(const RelAlgExecutionUnit& ra_exe_unit) {
+  return g_enable_group_by_partitioning && g_max_group_by_partitions > 1 &&
+         get_group_by_partition_key(ra_exe_unit);
+}
+
+// The filter of the rows whose partition key is `remainder` modulo `modulus`. The null
+// keys are assigned to the partitions of remainder 0.
+std::shared_ptr<Analyzer::Expr> make_group_by_partition_qual(
+    const std::shared_ptr<Analyzer::Expr>& partition_key,
+    const int64_t modulus,
+    const int64_t remainder) {
+  const auto key = partition_key->add_cast(SQLTypeInfo(kBIGINT, false));
+  Datum modulus_datum;
+  modulus_datum.bigintval = modulus;
+  const auto modulus_expr = makeExpr<Analyzer::Constant>(kBIGINT, false, modulus_datum);
+  Datum remainder_datum;
+  remainder_datum.bigintval = remainder;
+  const auto remainder_expr =
+      makeExpr<Analyzer::Constant>(kBIGINT, false, remainder_datum);
+  // ((key % modulus) + modulus) % modulus, as the remainder of negative keys is negative
+  const auto key_mod = makeExpr<Analyzer::BinOper>(
+      kBIGINT,
+      kMODULO,
+      kONE,
+      makeExpr<Analyzer::BinOper>(
+          kBIGINT,
+          kPLUS,
+          kONE,
+          makeExpr<Analyzer::BinOper>(kBIGINT, kMODULO, kONE, key, modulus_expr),
+          modulus_expr),
+      modulus_expr);
+  const auto partition_qual =
+      makeExpr<Analyzer::BinOper>(kBOOLEAN, kEQ, kONE, key_mod, remainder_expr);
+  if (remainder) {
+    return partition_qual;
+  }
+  return makeExpr<Analyzer::BinOper>(
+      kBOOLEAN,
+      kOR,
+      kONE,
+      partition_qual,
+      makeExpr<Analyzer::UOper>(kBOOLEAN, kISNULL, partition_key));
+}
+
 }  // namespace
 
 ExecutionResult RelAlgExecutor::executeWorkUnit(
@@ -3066,6 +3202,19 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
       ra_exe_unit.query_hint = *candidate;
     }
   }
+  if (!render_info && !eo.just_explain && !eo.just_validate && !g_cluster &&
+      VectorizedInterpreter::shouldInterpret(ra_exe_unit, table_infos, co, eo)) {
+    // skip the preflight count and code generation altogether if the interpreter can
+    // handle the query, otherwise continue with the regular path
+    if (auto interpreter =
+            VectorizedInterpreter::create(ra_exe_unit, table_infos, executor_)) {
+      if (auto interpreted_rows = interpreter->execute()) {
+        ExecutionResult interpreted_result(interpreted_rows, targets_meta);
+        interpreted_result.setQueueTime(queue_time_ms);
+        return interpreted_result;
+      }
+    }
+  }
   auto max_groups_buffer_entry_guess = work_unit.max_groups_buffer_entry_guess;
   if (is_window_execution_unit(ra_exe_unit)) {
     CHECK_EQ(table_infos.size(), size_t(1));
@@ -3123,6 +3272,19 @@ ExecutionResult RelAlgExecutor::executeWorkUnit(
       if (!has_ndv_estimation && e.getErrorCode() < 0) {
         throw CardinalityEstimationRequired(/*range=*/0);
       }
+      if (e.getErrorCode() == Executor::ERR_OUT_OF_CPU_MEM && !render_info &&
+          can_partition_group_by(ra_exe_unit)) {
+        LOG(WARNING) << "Query ran out of CPU memory, retrying by partitions of its "
+                        "groups.";
+        auto result = executeWorkUnitByPartitions(
+            {ra_exe_unit, work_unit.body, local_groups_buffer_entry_guess},
+            targets_meta,
+            is_agg,
+            co,
+            eo);
+        result.setQueueTime(queue_time_ms);
+        return result;
+      }
       handlePersistentError(e.getErrorCode());
       return handleOutOfMemoryRetry(
           {ra_exe_unit, work_unit.body, local_groups_buffer_entry_guess},
@@ -3392,6 +3554,18 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
                         "groups buffer entry "
                         "guess equal to "
                      << max_groups_buffer_entry_guess;
+      } else if (e.getErrorCode() == Executor::ERR_OUT_OF_CPU_MEM &&
+                 can_partition_group_by(ra_exe_unit)) {
+        LOG(WARNING) << "Query ran out of CPU memory, retrying by partitions of its "
+                        "groups.";
+        result = executeWorkUnitByPartitions(
+            {ra_exe_unit, work_unit.body, max_groups_buffer_entry_guess},
+            targets_meta,
+            is_agg,
+            co_cpu,
+            eo_no_multifrag);
+        result.setQueueTime(queue_time_ms);
+        return result;
       } else {
         handlePersistentError(e.getErrorCode());
       }
@@ -3403,6 +3577,79 @@ ExecutionResult RelAlgExecutor::handleOutOfMemoryRetry(
   return result;
 }
 
+ExecutionResult RelAlgExecutor::executeWorkUnitByPartitions(
+    const RelAlgExecutor::WorkUnit& work_unit,
+    const std::vector<TargetMetaInfo>& targets_meta,
+    const bool is_agg,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo) {
+  const auto& ra_exe_unit_in = work_unit.exe_unit;
+  const auto partition_key = get_group_by_partition_key(ra_exe_unit_in);
+  CHECK(partition_key);
+  const auto co_cpu = CompilationOptions::makeCpuOnly(co);
+  const auto table_infos = get_table_infos(ra_exe_unit_in, executor_);
+
+  // Each partition is the input rows whose key has a given remainder modulo the number of
+  // partitions. A partition which still runs out of memory is split in the two partitions
+  // of twice its modulus, which only hold its rows.
+  std::vector<std::pair<int64_t, int64_t>> partitions{{2, 1}, {2, 0}};
+  std::vector<ResultSetPtr> partition_results;
+  while (!partitions.empty()) {
+    const auto [modulus, remainder] = partitions.back();
+    partitions.pop_back();
+    auto ra_exe_unit = ra_exe_unit_in;
+    ra_exe_unit.use_bump_allocator = false;
+    ra_exe_unit.quals.push_back(
+        make_group_by_partition_qual(partition_key, modulus, remainder));
+    // the groups buffers are sized for the groups of the partition only
+    const auto ndv_groups_estimation =
+        getNDVEstimation({ra_exe_unit, work_unit.body, 0}, 0, is_agg, co_cpu, eo);
+    size_t max_groups_buffer_entry_guess = 2 * ndv_groups_estimation;
+    VLOG(1) << "Executing partition " << remainder << " of " << modulus
+            << " with max groups buffer entry guess equal to "
+            << max_groups_buffer_entry_guess;
+    ColumnCacheMap column_cache;
+    try {
+      const auto partition_result =
+          executor_->executeWorkUnit(max_groups_buffer_entry_guess,
+                                     is_agg,
+                                     table_infos,
+                                     ra_exe_unit,
+                                     co_cpu,
+                                     eo,
+                                     cat_,
+                                     nullptr,
+                                     true,
+                                     column_cache);
+      CHECK_EQ(partition_result.getFragCount(), 1);
+      partition_results.push_back(partition_result[0]);
+    } catch (const QueryExecutionError& e) {
+      // an underestimated number of groups also runs out of slots
+      if ((e.getErrorCode() != Executor::ERR_OUT_OF_CPU_MEM && e.getErrorCode() >= 0) ||
+          static_cast<size_t>(2 * modulus) > g_max_group_by_partitions) {
+        throw std::runtime_error(getErrorMessageFromCode(e.getErrorCode()));
+      }
+      LOG(WARNING) << "Partition " << remainder << " of " << modulus
+                   << " ran out of memory, splitting it in two.";
+      partitions.emplace_back(2 * modulus, remainder + modulus);
+      partitions.emplace_back(2 * modulus, remainder);
+    }
+  }
+
+  ResultSetPtr result;
+  for (const auto& partition_result : partition_results) {
+    if (partition_result->definitelyHasNoRows()) {
+      continue;
+    }
+    if (result) {
+      result->append(*partition_result);
+    } else {
+      result = partition_result;
+    }
+  }
+  return {result ? result : partition_results.front(), targets_meta};
+}
+
 void RelAlgExecutor::handlePersistentError(const int32_t error_code) {
   LOG(ERROR) << "Query execution failed with error "
              << getErrorMessageFromCode(error_code);
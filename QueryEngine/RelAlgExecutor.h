@@ -315,6 +315,16 @@ class RelAlgExecutor : private StorageIOFacility {
                                          const bool was_multifrag_kernel_launch,
                                          const int64_t queue_time_ms);
 
+  // Computes the groups of the work unit on CPU by partitions of its input rows, each
+  // partition holding the rows of a disjoint subset of the groups, when the buffers of
+  // all the groups do not fit in memory at once.
+  ExecutionResult executeWorkUnitByPartitions(
+      const RelAlgExecutor::WorkUnit& work_unit,
+      const std::vector<TargetMetaInfo>& targets_meta,
+      const bool is_agg,
+      const CompilationOptions& co,
+      const ExecutionOptions& eo);
+
   // Allows an out of memory error through if CPU retry is enabled. Otherwise, throws an
   // appropriate exception corresponding to the query error code.
   static void handlePersistentError(const int32_t error_code);
@@ -400,7 +400,7 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateInput(
     const auto cd =
         cat_.getMetadataForColumnBySpi(table_desc->tableId, rex_input->getIndex() + 1);
     CHECK(cd);
-    auto col_ti = cd->columnType;
+    auto col_ti = get_in_memory_type_info(cd->columnType);
     if (col_ti.is_string()) {
       col_ti.set_type(kTEXT);
     }
@@ -1783,16 +1783,96 @@ bool supported_upper_bound(const RexWindowFunctionOperator* rex_window_function)
   }
 }
 
+// Returns the offset of a bound of an explicit frame from the current row, none if it's
+// unbounded.
+std::optional<int64_t> translate_window_bound(
+    const RexWindowFunctionOperator::RexWindowBound& window_bound,
+    const std::shared_ptr<Analyzer::Expr>& offset,
+    const bool is_lower) {
+  if (window_bound.unbounded) {
+    if (window_bound.preceding != is_lower) {
+      throw std::runtime_error("Frame specification not supported");
+    }
+    return std::nullopt;
+  }
+  if (window_bound.is_current_row) {
+    return 0;
+  }
+  CHECK(offset);
+  const auto offset_constant = dynamic_cast<const Analyzer::Constant*>(offset.get());
+  if (!offset_constant || offset_constant->get_is_null()) {
+    throw std::runtime_error("Only constant frame offsets supported");
+  }
+  int64_t offset_val{0};
+  switch (offset_constant->get_type_info().get_type()) {
+    case kTINYINT: {
+      offset_val = offset_constant->get_constval().tinyintval;
+      break;
+    }
+    case kSMALLINT: {
+      offset_val = offset_constant->get_constval().smallintval;
+      break;
+    }
+    case kINT: {
+      offset_val = offset_constant->get_constval().intval;
+      break;
+    }
+    case kBIGINT: {
+      offset_val = offset_constant->get_constval().bigintval;
+      break;
+    }
+    default: {
+      throw std::runtime_error("Only integer frame offsets supported");
+    }
+  }
+  if (offset_val < 0) {
+    throw std::runtime_error("Frame offsets cannot be negative");
+  }
+  return window_bound.preceding ? -offset_val : offset_val;
+}
+
 }  // namespace
 
-std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateWindowFunction(
-    const RexWindowFunctionOperator* rex_window_function) const {
-  if (!supported_lower_bound(rex_window_function->getLowerBound()) ||
-      !supported_upper_bound(rex_window_function) ||
-      ((rex_window_function->getKind() == SqlWindowFunctionKind::ROW_NUMBER) !=
+std::optional<Analyzer::WindowFrame> RelAlgTranslator::translateWindowFrame(
+    const RexWindowFunctionOperator* rex_window_function,
+    const std::vector<std::shared_ptr<Analyzer::Expr>>& order_keys) const {
+  if (supported_lower_bound(rex_window_function->getLowerBound()) &&
+      supported_upper_bound(rex_window_function) &&
+      ((rex_window_function->getKind() == SqlWindowFunctionKind::ROW_NUMBER) ==
        rex_window_function->isRows())) {
+    return std::nullopt;
+  }
+  if (!window_function_is_aggregate(rex_window_function->getKind())) {
     throw std::runtime_error("Frame specification not supported");
   }
+  const auto translate_offset = [this](const RexWindowFunctionOperator::RexWindowBound&
+                                           window_bound) {
+    return window_bound.offset ? translateScalarRex(window_bound.offset.get()) : nullptr;
+  };
+  const auto& lower_bound = rex_window_function->getLowerBound();
+  const auto& upper_bound = rex_window_function->getUpperBound();
+  Analyzer::WindowFrame frame{
+      rex_window_function->isRows(),
+      translate_window_bound(lower_bound, translate_offset(lower_bound), true),
+      translate_window_bound(upper_bound, translate_offset(upper_bound), false)};
+  const auto has_offset = [](const std::optional<int64_t>& bound) {
+    return bound && *bound != 0;
+  };
+  if (!frame.is_rows && (has_offset(frame.lower) || has_offset(frame.upper))) {
+    if (order_keys.size() != 1) {
+      throw std::runtime_error("RANGE frame offsets require exactly one order key");
+    }
+    const auto& order_key_ti = order_keys.front()->get_type_info();
+    if (!order_key_ti.is_integer() && !order_key_ti.is_decimal() &&
+        !order_key_ti.is_fp()) {
+      throw std::runtime_error("RANGE frame offsets require a numeric order key");
+    }
+  }
+  return frame;
+}
+
+std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateWindowFunction(
+    const RexWindowFunctionOperator* rex_window_function) const {
   std::vector<std::shared_ptr<Analyzer::Expr>> args;
   for (size_t i = 0; i < rex_window_function->size(); ++i) {
     args.push_back(translateScalarRex(rex_window_function->getOperand(i)));
@@ -1810,13 +1890,15 @@ std::shared_ptr<Analyzer::Expr> RelAlgTranslator::translateWindowFunction(
     CHECK_GE(args.size(), 1u);
     ti = args.front()->get_type_info();
   }
+  const auto frame = translateWindowFrame(rex_window_function, order_keys);
   return makeExpr<Analyzer::WindowFunction>(
       ti,
       rex_window_function->getKind(),
       args,
       partition_keys,
       order_keys,
-      translate_collation(rex_window_function->getCollation()));
+      translate_collation(rex_window_function->getCollation()),
+      frame);
 }
 
 Analyzer::ExpressionPtrVector RelAlgTranslator::translateFunctionArgs(
@@ -148,6 +148,10 @@ class RelAlgTranslator {
   std::shared_ptr<Analyzer::Expr> translateWindowFunction(
       const RexWindowFunctionOperator*) const;
 
+  std::optional<Analyzer::WindowFrame> translateWindowFrame(
+      const RexWindowFunctionOperator*,
+      const std::vector<std::shared_ptr<Analyzer::Expr>>& order_keys) const;
+
   Analyzer::ExpressionPtrVector translateFunctionArgs(const RexFunctionOperator*) const;
 
   std::shared_ptr<Analyzer::Expr> translateUnaryGeoFunction(
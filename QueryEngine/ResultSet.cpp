@@ -236,6 +236,27 @@ const ResultSetStorage* ResultSet::allocateStorage(
   return storage_.get();
 }
 
+void ResultSet::growBaselineStorage(int8_t* new_buff, const size_t new_entry_count) {
+  CHECK(new_buff);
+  CHECK(storage_);
+  CHECK(appended_storage_.empty());
+  switch (query_mem_desc_.getEffectiveKeyWidth()) {
+    case 4:
+      storage_->moveEntriesToBuffer<int32_t>(new_buff, new_entry_count);
+      break;
+    case 8:
+      storage_->moveEntriesToBuffer<int64_t>(new_buff, new_entry_count);
+      break;
+    default:
+      CHECK(false);
+  }
+  const auto target_init_vals = storage_->target_init_vals_;
+  const auto varlen_output_info = storage_->varlen_output_info_;
+  storage_.reset();
+  query_mem_desc_.setEntryCount(new_entry_count);
+  allocateStorage(new_buff, target_init_vals, varlen_output_info);
+}
+
 size_t ResultSet::getCurrentRowBufferIndex() const {
   if (crt_row_buff_idx_ == 0) {
     throw std::runtime_error("current row buffer iteration index is undefined");
@@ -243,16 +264,22 @@ size_t ResultSet::getCurrentRowBufferIndex() const {
   return crt_row_buff_idx_ - 1;
 }
 
-// Note: that.appended_storage_ does not get appended to this.
 void ResultSet::append(ResultSet& that) {
   CHECK_EQ(-1, cached_row_count_);
   if (!that.storage_) {
     return;
   }
-  appended_storage_.push_back(std::move(that.storage_));
-  query_mem_desc_.setEntryCount(
-      query_mem_desc_.getEntryCount() +
-      appended_storage_.back()->query_mem_desc_.getEntryCount());
+  // the partitioned reduction keeps part of the groups in the appended storages
+  auto append_storage = [this](std::unique_ptr<ResultSetStorage> storage) {
+    query_mem_desc_.setEntryCount(query_mem_desc_.getEntryCount() +
+                                  storage->query_mem_desc_.getEntryCount());
+    appended_storage_.push_back(std::move(storage));
+  };
+  append_storage(std::move(that.storage_));
+  for (auto& storage : that.appended_storage_) {
+    append_storage(std::move(storage));
+  }
+  that.appended_storage_.clear();
   chunks_.insert(chunks_.end(), that.chunks_.begin(), that.chunks_.end());
   col_buffers_.insert(
       col_buffers_.end(), that.col_buffers_.begin(), that.col_buffers_.end());
@@ -274,6 +301,70 @@ void ResultSet::append(ResultSet& that) {
   }
 }
 
+std::shared_ptr<ResultSet> ResultSet::copy() const {
+  auto timer = DEBUG_TIMER(__func__);
+  CHECK(!just_explain_);
+  CHECK(!estimator_);
+  CHECK(row_set_mem_owner_);
+  auto copied_rs = std::make_shared<ResultSet>(targets_,
+                                               device_type_,
+                                               query_mem_desc_,
+                                               row_set_mem_owner_,
+                                               catalog_,
+                                               block_size_,
+                                               grid_size_);
+  auto copy_storage =
+      [this](const ResultSetStorage* src_storage) -> std::unique_ptr<ResultSetStorage> {
+    CHECK(src_storage);
+    const auto& src_query_mem_desc = src_storage->query_mem_desc_;
+    const auto buffer_size = src_query_mem_desc.getBufferSizeBytes(device_type_);
+    // the copied buffer is owned (and freed) by the copied result set itself rather
+    // than the shared row set memory owner, which would otherwise grow per copy
+    auto buff = static_cast<int8_t*>(checked_malloc(buffer_size));
+    std::memcpy(buff, src_storage->getUnderlyingBuffer(), buffer_size);
+    std::unique_ptr<ResultSetStorage> new_storage(new ResultSetStorage(
+        src_storage->targets_, src_query_mem_desc, buff, /*buff_is_provided=*/false));
+    new_storage->target_init_vals_ = src_storage->target_init_vals_;
+    new_storage->count_distinct_sets_mapping_ = src_storage->count_distinct_sets_mapping_;
+    new_storage->varlen_output_info_ = src_storage->varlen_output_info_;
+    return new_storage;
+  };
+  if (storage_) {
+    copied_rs->storage_ = copy_storage(storage_.get());
+  }
+  for (const auto& storage : appended_storage_) {
+    copied_rs->appended_storage_.push_back(copy_storage(storage.get()));
+  }
+  copied_rs->drop_first_ = drop_first_;
+  copied_rs->keep_first_ = keep_first_;
+  copied_rs->permutation_ = permutation_;
+  copied_rs->timings_ = timings_;
+  copied_rs->outer_table_id_ = outer_table_id_;
+  copied_rs->chunks_ = chunks_;
+  copied_rs->chunk_iters_ = chunk_iters_;
+  copied_rs->literal_buffers_ = literal_buffers_;
+  copied_rs->col_buffers_ = col_buffers_;
+  copied_rs->frag_offsets_ = frag_offsets_;
+  copied_rs->consistent_frag_sizes_ = consistent_frag_sizes_;
+  copied_rs->serialized_varlen_buffer_ = serialized_varlen_buffer_;
+  copied_rs->separate_varlen_storage_valid_ = separate_varlen_storage_valid_;
+  copied_rs->for_validation_only_ = for_validation_only_;
+  copied_rs->cached_row_count_ = cached_row_count_.load();
+  copied_rs->geo_return_type_ = geo_return_type_;
+  return copied_rs;
+}
+
+size_t ResultSet::getTotalHostBufferSizeBytes() const {
+  size_t total_size{0};
+  if (storage_) {
+    total_size += storage_->query_mem_desc_.getBufferSizeBytes(device_type_);
+  }
+  for (const auto& storage : appended_storage_) {
+    total_size += storage->query_mem_desc_.getBufferSizeBytes(device_type_);
+  }
+  return total_size;
+}
+
 const ResultSetStorage* ResultSet::getStorage() const {
   return storage_.get();
 }
@@ -596,6 +687,96 @@ void sort_onecol_cpu(int8_t* val_buff,
   }
 }
 
+namespace {
+
+// Returns the number of elements taken from the run [a, a + a_size) among the first `k`
+// elements of its stable merge with the run [b, b + b_size).
+size_t merge_co_rank(const PermutationIdx* a,
+                     const size_t a_size,
+                     const PermutationIdx* b,
+                     const size_t b_size,
+                     const size_t k,
+                     const Comparator& compare) {
+  size_t lo = k > b_size ? k - b_size : 0;
+  size_t hi = std::min(k, a_size);
+  while (lo < hi) {
+    const size_t i = lo + (hi - lo) / 2;
+    const size_t j = k - i;
+    if (j == 0 || i == a_size || compare(b[j - 1], a[i])) {
+      hi = i;
+    } else {
+      lo = i + 1;
+    }
+  }
+  return lo;
+}
+
+// Sorts the permutation with a merge sort: every thread sorts one run, then the runs are
+// merged pairwise. The merges of a level are split in slices of their output, found by
+// the co-ranks of the slice bounds, so that the last levels still use all the threads.
+void parallel_merge_sort(PermutationView permutation,
+                         const Comparator& compare,
+                         const size_t thread_count) {
+  auto timer = DEBUG_TIMER(__func__);
+  const size_t size = permutation.size();
+  std::vector<size_t> run_bounds;
+  {
+    threading::task_group sort_threads;
+    for (auto interval : makeIntervals<size_t>(0, size, thread_count)) {
+      run_bounds.push_back(interval.begin);
+      sort_threads.run([permutation, &compare, interval] {
+        std::sort(permutation.begin() + interval.begin,
+                  permutation.begin() + interval.end,
+                  compare);
+      });
+    }
+    sort_threads.wait();
+  }
+  run_bounds.push_back(size);
+  Permutation scratch(size);
+  PermutationIdx* src = permutation.begin();
+  PermutationIdx* dst = scratch.data();
+  while (run_bounds.size() > 2) {
+    const size_t run_count = run_bounds.size() - 1;
+    const size_t slices_per_merge = std::max(thread_count / (run_count / 2), size_t(1));
+    std::vector<size_t> merged_run_bounds;
+    threading::task_group merge_threads;
+    for (size_t run = 0; run < run_count; run += 2) {
+      merged_run_bounds.push_back(run_bounds[run]);
+      const auto a = src + run_bounds[run];
+      const size_t a_size = run_bounds[run + 1] - run_bounds[run];
+      if (run + 1 == run_count) {
+        std::copy(a, a + a_size, dst + run_bounds[run]);
+        continue;
+      }
+      const auto b = src + run_bounds[run + 1];
+      const size_t b_size = run_bounds[run + 2] - run_bounds[run + 1];
+      const auto out = dst + run_bounds[run];
+      for (auto slice : makeIntervals<size_t>(0, a_size + b_size, slices_per_merge)) {
+        merge_threads.run([a, a_size, b, b_size, out, &compare, slice] {
+          const auto a_begin = merge_co_rank(a, a_size, b, b_size, slice.begin, compare);
+          const auto a_end = merge_co_rank(a, a_size, b, b_size, slice.end, compare);
+          std::merge(a + a_begin,
+                     a + a_end,
+                     b + (slice.begin - a_begin),
+                     b + (slice.end - a_end),
+                     out + slice.begin,
+                     compare);
+        });
+      }
+    }
+    merge_threads.wait();
+    merged_run_bounds.push_back(size);
+    run_bounds = std::move(merged_run_bounds);
+    std::swap(src, dst);
+  }
+  if (src != permutation.begin()) {
+    std::copy(src, src + size, permutation.begin());
+  }
+}
+
+}  // namespace
+
 void ResultSet::sort(const std::list<Analyzer::OrderEntry>& order_entries,
                      size_t top_n,
                      const Executor* executor) {
@@ -671,6 +852,10 @@ void ResultSet::sort(const std::list<Analyzer::OrderEntry>& order_entries,
         return;
       }
     }
+    if (top_n == 0 && g_parallel_top_min < entryCount()) {
+      parallelSort(order_entries, executor);
+      return;
+    }
     permutation_.resize(query_mem_desc_.getEntryCount());
     // PermutationView is used to share common API with parallelTop().
     PermutationView pv(permutation_.data(), 0, permutation_.size());
@@ -758,22 +943,82 @@ void ResultSet::parallelTop(const std::list<Analyzer::OrderEntry>& order_entries
   // columns as necessary to perform a comparison. This cost is why reduction is chosen to
   // be serial instead; only one more Comparator is needed below.
 
-  // Left-copy disjoint top-sorted subranges into one contiguous range.
-  // ++++....+++.....+++++...  ->  ++++++++++++............
-  auto end = permutation_.begin() + permutation_views.front().size();
-  for (size_t i = 1; i < nthreads; ++i) {
-    std::copy(permutation_views[i].begin(), permutation_views[i].end(), end);
-    end += permutation_views[i].size();
+  const auto run_bounds = compactPermutationViews(permutation_views);
+  PermutationView pv(permutation_.data(), run_bounds.back());
+  const auto compare = createComparator(order_entries, pv, executor, false);
+
+  // Every subrange is sorted, merge their heads with a heap until top_n are taken, which
+  // takes O(top_n * log(nthreads)) comparisons.
+  using RunHead = std::pair<size_t, size_t>;  // the next and end positions of a run
+  const auto heap_compare = [this, &compare](const RunHead& lhs, const RunHead& rhs) {
+    return compare(permutation_[rhs.first], permutation_[lhs.first]);
+  };
+  std::vector<RunHead> run_heads;
+  for (size_t i = 0; i + 1 < run_bounds.size(); ++i) {
+    if (run_bounds[i] < run_bounds[i + 1]) {
+      run_heads.emplace_back(run_bounds[i], run_bounds[i + 1]);
+    }
+  }
+  std::make_heap(run_heads.begin(), run_heads.end(), heap_compare);
+  Permutation top_permutation;
+  top_permutation.reserve(std::min(top_n, pv.size()));
+  while (top_permutation.size() < top_n && !run_heads.empty()) {
+    std::pop_heap(run_heads.begin(), run_heads.end(), heap_compare);
+    auto& run_head = run_heads.back();
+    top_permutation.push_back(permutation_[run_head.first]);
+    if (++run_head.first < run_head.second) {
+      std::push_heap(run_heads.begin(), run_heads.end(), heap_compare);
+    } else {
+      run_heads.pop_back();
+    }
+  }
+  permutation_ = std::move(top_permutation);
+}
+
+void ResultSet::parallelSort(const std::list<Analyzer::OrderEntry>& order_entries,
+                             const Executor* executor) {
+  auto timer = DEBUG_TIMER(__func__);
+  const size_t nthreads = cpu_threads();
+
+  permutation_.resize(query_mem_desc_.getEntryCount());
+  std::vector<PermutationView> permutation_views(nthreads);
+  threading::task_group init_threads;
+  for (auto interval : makeIntervals<PermutationIdx>(0, permutation_.size(), nthreads)) {
+    init_threads.run(
+        [this, &permutation_views, query_id = logger::query_id(), interval] {
+          auto qid_scope_guard = logger::set_thread_local_query_id(query_id);
+          PermutationView pv(permutation_.data() + interval.begin, 0, interval.size());
+          permutation_views[interval.index] =
+              initPermutationBuffer(pv, interval.begin, interval.end);
+        });
   }
+  init_threads.wait();
 
-  // Top sort final range.
-  PermutationView pv(permutation_.data(), end - permutation_.begin());
+  const auto run_bounds = compactPermutationViews(permutation_views);
+  PermutationView pv(permutation_.data(), run_bounds.back());
   const auto compare = createComparator(order_entries, pv, executor, false);
-  pv = topPermutation(pv, top_n, compare, false);
+  parallel_merge_sort(pv, compare, nthreads);
   permutation_.resize(pv.size());
   permutation_.shrink_to_fit();
 }
 
+// Left-copy disjoint subranges of permutation_ into one contiguous range and returns the
+// bounds of the subranges in it.
+// ++++....+++.....+++++...  ->  ++++++++++++............
+std::vector<size_t> ResultSet::compactPermutationViews(
+    const std::vector<PermutationView>& permutation_views) {
+  std::vector<size_t> run_bounds{0};
+  size_t end{0};
+  for (const auto& pv : permutation_views) {
+    if (pv.begin() != permutation_.data() + end) {
+      std::copy(pv.begin(), pv.end(), permutation_.data() + end);
+    }
+    end += pv.size();
+    run_bounds.push_back(end);
+  }
+  return run_bounds;
+}
+
 std::pair<size_t, size_t> ResultSet::getStorageIndex(const size_t entry_idx) const {
   size_t fixedup_entry_idx = entry_idx;
   auto entry_count = storage_->query_mem_desc_.getEntryCount();
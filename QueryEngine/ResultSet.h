@@ -237,6 +237,16 @@ class ResultSet {
     storage_->updateEntryCount(new_entry_count);
   }
 
+  // Moves the groups of a baseline hash result set to `partition_count` result sets by
+  // the hash of their keys, null for the empty partitions. The partitions of several
+  // result sets are then reduced independently of each other.
+  std::vector<std::unique_ptr<ResultSet>> partitionBaselineEntries(
+      const size_t partition_count) const;
+
+  // Moves the entries of a baseline hash storage to the bigger, initialized, buffer and
+  // makes it the storage of this result set.
+  void growBaselineStorage(int8_t* new_buff, const size_t new_entry_count);
+
   std::vector<TargetValue> getNextRow(const bool translate_strings,
                                       const bool decimal_to_double) const;
 
@@ -270,6 +280,12 @@ class ResultSet {
 
   void append(ResultSet& that);
 
+  // Deep copies the (main and appended) storage buffers so that the returned result set
+  // can be iterated, sorted and truncated independently of this one. The row set memory
+  // owner is shared, so count distinct sets, varlen outputs and string dictionary proxies
+  // referenced from the copied buffers stay valid as long as either result set is alive.
+  std::shared_ptr<ResultSet> copy() const;
+
   const ResultSetStorage* getStorage() const;
 
   size_t colCount() const;
@@ -294,6 +310,9 @@ class ResultSet {
 
   size_t getBufferSizeBytes(const ExecutorDeviceType device_type) const;
 
+  // total size of the main and all appended storage buffers on the host
+  size_t getTotalHostBufferSizeBytes() const;
+
   bool definitelyHasNoRows() const;
 
   const QueryMemoryDescriptor& getQueryMemDesc() const;
@@ -440,6 +459,16 @@ class ResultSet {
     return lazy_fetch_info_;
   }
 
+  // Returns the sorted and unique fragment row positions held by the lazily fetched
+  // target `target_idx` of a projection with a single storage.
+  std::vector<int64_t> getLazyFetchRowPositions(const size_t target_idx) const;
+
+  // Sets the buffer of the lazily fetched column `local_col_id` of the fragment
+  // `frag_idx`, for the columns fetched once the kernel ran.
+  void setLazyFetchColumnBuffer(const size_t frag_idx,
+                                const int local_col_id,
+                                const int8_t* col_buffer);
+
   void setSeparateVarlenStorageValid(const bool val) {
     separate_varlen_storage_valid_ = val;
   }
@@ -716,6 +745,12 @@ class ResultSet {
                    const size_t top_n,
                    const Executor* executor);
 
+  void parallelSort(const std::list<Analyzer::OrderEntry>& order_entries,
+                    const Executor* executor);
+
+  std::vector<size_t> compactPermutationViews(
+      const std::vector<PermutationView>& permutation_views);
+
   void baselineSort(const std::list<Analyzer::OrderEntry>& order_entries,
                     const size_t top_n,
                     const Executor* executor);
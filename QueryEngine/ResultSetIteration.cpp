@@ -37,6 +37,7 @@
 
 #include <boost/math/special_functions/fpclassify.hpp>
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
@@ -1105,6 +1106,46 @@ const std::vector<const int8_t*>& ResultSet::getColumnFrag(const size_t storage_
   }
 }
 
+std::vector<int64_t> ResultSet::getLazyFetchRowPositions(const size_t target_idx) const {
+  CHECK(storage_);
+  CHECK(appended_storage_.empty());
+  CHECK(query_mem_desc_.getQueryDescriptionType() == QueryDescriptionType::Projection);
+  CHECK_LT(target_idx, lazy_fetch_info_.size());
+  CHECK(lazy_fetch_info_[target_idx].is_lazily_fetched);
+  const auto& storage_query_mem_desc = storage_->query_mem_desc_;
+  const auto slot_idx = getSlotIndicesForTargetIndices()[target_idx];
+  const auto slot_width = storage_query_mem_desc.getPaddedSlotWidthBytes(slot_idx);
+  const auto column_offset = storage_query_mem_desc.getColOffInBytes(slot_idx);
+  const auto buff = storage_->getUnderlyingBuffer();
+  std::vector<int64_t> row_positions;
+  for (size_t entry_idx = 0; entry_idx < storage_query_mem_desc.getEntryCount();
+       ++entry_idx) {
+    if (storage_->isEmptyEntry(entry_idx)) {
+      continue;
+    }
+    const auto slot_ptr =
+        storage_query_mem_desc.didOutputColumnar()
+            ? buff + column_offset + entry_idx * slot_width
+            : buff + storage_query_mem_desc.getRowSize() * entry_idx + column_offset;
+    row_positions.push_back(read_int_from_buff(slot_ptr, slot_width));
+  }
+  std::sort(row_positions.begin(), row_positions.end());
+  row_positions.erase(std::unique(row_positions.begin(), row_positions.end()),
+                      row_positions.end());
+  return row_positions;
+}
+
+void ResultSet::setLazyFetchColumnBuffer(const size_t frag_idx,
+                                         const int local_col_id,
+                                         const int8_t* col_buffer) {
+  CHECK_EQ(size_t(1), col_buffers_.size());
+  CHECK_LT(frag_idx, col_buffers_.front().size());
+  auto& frag_col_buffers = col_buffers_.front()[frag_idx];
+  CHECK_GE(local_col_id, 0);
+  CHECK_LT(static_cast<size_t>(local_col_id), frag_col_buffers.size());
+  frag_col_buffers[local_col_id] = col_buffer;
+}
+
 const VarlenOutputInfo* ResultSet::getVarlenOutputInfo(const size_t entry_idx) const {
   auto storage_lookup_result = findStorage(entry_idx);
   CHECK(storage_lookup_result.storage_ptr);
@@ -1236,9 +1277,12 @@ template <typename ENTRY_TYPE>
 ENTRY_TYPE ResultSet::getColumnarPerfectHashEntryAt(const size_t row_idx,
                                                     const size_t target_idx,
                                                     const size_t slot_idx) const {
-  const size_t column_offset = storage_->query_mem_desc_.getColOffInBytes(slot_idx);
-  const int8_t* storage_buffer = storage_->getUnderlyingBuffer() + column_offset;
-  return reinterpret_cast<const ENTRY_TYPE*>(storage_buffer)[row_idx];
+  const auto storage_lookup_result = findStorage(row_idx);
+  const auto storage = storage_lookup_result.storage_ptr;
+  const size_t column_offset = storage->query_mem_desc_.getColOffInBytes(slot_idx);
+  const int8_t* storage_buffer = storage->getUnderlyingBuffer() + column_offset;
+  return reinterpret_cast<const ENTRY_TYPE*>(
+      storage_buffer)[storage_lookup_result.fixedup_entry_idx];
 }
 
 /**
@@ -1251,10 +1295,13 @@ template <typename ENTRY_TYPE>
 ENTRY_TYPE ResultSet::getRowWisePerfectHashEntryAt(const size_t row_idx,
                                                    const size_t target_idx,
                                                    const size_t slot_idx) const {
-  const size_t row_offset = storage_->query_mem_desc_.getRowSize() * row_idx;
-  const size_t column_offset = storage_->query_mem_desc_.getColOffInBytes(slot_idx);
+  const auto storage_lookup_result = findStorage(row_idx);
+  const auto storage = storage_lookup_result.storage_ptr;
+  const size_t row_offset =
+      storage->query_mem_desc_.getRowSize() * storage_lookup_result.fixedup_entry_idx;
+  const size_t column_offset = storage->query_mem_desc_.getColOffInBytes(slot_idx);
   const int8_t* storage_buffer =
-      storage_->getUnderlyingBuffer() + row_offset + column_offset;
+      storage->getUnderlyingBuffer() + row_offset + column_offset;
   return *reinterpret_cast<const ENTRY_TYPE*>(storage_buffer);
 }
 
@@ -1268,14 +1315,17 @@ template <typename ENTRY_TYPE>
 ENTRY_TYPE ResultSet::getRowWiseBaselineEntryAt(const size_t row_idx,
                                                 const size_t target_idx,
                                                 const size_t slot_idx) const {
-  CHECK_NE(storage_->query_mem_desc_.targetGroupbyIndicesSize(), size_t(0));
-  const auto key_width = storage_->query_mem_desc_.getEffectiveKeyWidth();
-  auto keys_ptr = row_ptr_rowwise(
-      storage_->getUnderlyingBuffer(), storage_->query_mem_desc_, row_idx);
+  const auto storage_lookup_result = findStorage(row_idx);
+  const auto storage = storage_lookup_result.storage_ptr;
+  CHECK_NE(storage->query_mem_desc_.targetGroupbyIndicesSize(), size_t(0));
+  const auto key_width = storage->query_mem_desc_.getEffectiveKeyWidth();
+  auto keys_ptr = row_ptr_rowwise(storage->getUnderlyingBuffer(),
+                                  storage->query_mem_desc_,
+                                  storage_lookup_result.fixedup_entry_idx);
   const auto column_offset =
-      (storage_->query_mem_desc_.getTargetGroupbyIndex(target_idx) < 0)
-          ? storage_->query_mem_desc_.getColOffInBytes(slot_idx)
-          : storage_->query_mem_desc_.getTargetGroupbyIndex(target_idx) * key_width;
+      (storage->query_mem_desc_.getTargetGroupbyIndex(target_idx) < 0)
+          ? storage->query_mem_desc_.getColOffInBytes(slot_idx)
+          : storage->query_mem_desc_.getTargetGroupbyIndex(target_idx) * key_width;
   const auto storage_buffer = keys_ptr + column_offset;
   return *reinterpret_cast<const ENTRY_TYPE*>(storage_buffer);
 }
@@ -1290,15 +1340,18 @@ template <typename ENTRY_TYPE>
 ENTRY_TYPE ResultSet::getColumnarBaselineEntryAt(const size_t row_idx,
                                                  const size_t target_idx,
                                                  const size_t slot_idx) const {
-  CHECK_NE(storage_->query_mem_desc_.targetGroupbyIndicesSize(), size_t(0));
-  const auto key_width = storage_->query_mem_desc_.getEffectiveKeyWidth();
+  const auto storage_lookup_result = findStorage(row_idx);
+  const auto storage = storage_lookup_result.storage_ptr;
+  CHECK_NE(storage->query_mem_desc_.targetGroupbyIndicesSize(), size_t(0));
+  const auto key_width = storage->query_mem_desc_.getEffectiveKeyWidth();
   const auto column_offset =
-      (storage_->query_mem_desc_.getTargetGroupbyIndex(target_idx) < 0)
-          ? storage_->query_mem_desc_.getColOffInBytes(slot_idx)
-          : storage_->query_mem_desc_.getTargetGroupbyIndex(target_idx) * key_width *
-                storage_->query_mem_desc_.getEntryCount();
-  const auto column_buffer = storage_->getUnderlyingBuffer() + column_offset;
-  return reinterpret_cast<const ENTRY_TYPE*>(column_buffer)[row_idx];
+      (storage->query_mem_desc_.getTargetGroupbyIndex(target_idx) < 0)
+          ? storage->query_mem_desc_.getColOffInBytes(slot_idx)
+          : storage->query_mem_desc_.getTargetGroupbyIndex(target_idx) * key_width *
+                storage->query_mem_desc_.getEntryCount();
+  const auto column_buffer = storage->getUnderlyingBuffer() + column_offset;
+  return reinterpret_cast<const ENTRY_TYPE*>(
+      column_buffer)[storage_lookup_result.fixedup_entry_idx];
 }
 
 // Interprets ptr1, ptr2 as the ptr and len pair used for variable length data.
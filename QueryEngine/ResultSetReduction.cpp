@@ -29,6 +29,7 @@
 #include "ResultSetReductionJIT.h"
 #include "RuntimeFunctions.h"
 #include "Shared/SqlTypesLayout.h"
+#include "Shared/checked_alloc.h"
 #include "Shared/likely.h"
 #include "Shared/thread_count.h"
 #include "Shared/threading.h"
@@ -142,19 +143,26 @@ void run_reduction_code(const ReductionCode& reduction_code,
                         const void* that_qmd,
                         const void* serialized_varlen_buffer) {
   int err = 0;
-  if (reduction_code.func_ptr) {
-    err = reduction_code.func_ptr(this_buff,
-                                  that_buff,
-                                  start_entry_index,
-                                  end_entry_index,
-                                  that_entry_count,
-                                  this_qmd,
-                                  that_qmd,
-                                  serialized_varlen_buffer);
+  // Switches to the native code as soon as its background compilation is done.
+  const auto func_ptr = reduction_code.getFuncPtr();
+  if (func_ptr) {
+    err = func_ptr(this_buff,
+                   that_buff,
+                   start_entry_index,
+                   end_entry_index,
+                   that_entry_count,
+                   this_qmd,
+                   that_qmd,
+                   serialized_varlen_buffer);
   } else {
     // Calls LLVM methods that are not thread safe, ensure nothing else compiles while we
-    // run this reduction
-    std::lock_guard<std::mutex> compilation_lock(Executor::compilation_mutex_);
+    // run this reduction. Not needed if the stubs have been bound upfront for a
+    // background compilation, which holds the lock itself.
+    std::unique_lock<std::mutex> compilation_lock(Executor::compilation_mutex_,
+                                                  std::defer_lock);
+    if (!reduction_code.async_compilation.valid()) {
+      compilation_lock.lock();
+    }
     auto ret = ReductionInterpreter::run(
         reduction_code.ir_reduce_loop.get(),
         {ReductionInterpreter::MakeEvalValue(this_buff),
@@ -181,6 +189,17 @@ void run_reduction_code(const ReductionCode& reduction_code,
   }
 }
 
+// The partition of a group for a partitioned reduction. It comes from the high bits of
+// the hash of the key, since the slot of the group in the buffer of its partition comes
+// from the low ones.
+uint32_t get_key_partition(const int64_t* key,
+                           const size_t key_count,
+                           const size_t key_byte_width,
+                           const size_t partition_count) {
+  const auto h = key_hash(key, key_count, key_byte_width);
+  return (static_cast<uint64_t>(h) * partition_count) >> 32;
+}
+
 }  // namespace
 
 void result_set::fill_empty_key(void* key_ptr,
@@ -1004,6 +1023,118 @@ void ResultSetStorage::moveOneEntryToBuffer(const size_t entry_index,
              query_mem_desc_);
 }
 
+std::vector<uint32_t> ResultSetStorage::getEntryPartitions(
+    const size_t partition_count) const {
+  CHECK(QueryDescriptionType::GroupByBaselineHash ==
+        query_mem_desc_.getQueryDescriptionType());
+  CHECK_GT(partition_count, size_t(0));
+  const auto entry_count = query_mem_desc_.getEntryCount();
+  const auto key_count = query_mem_desc_.getGroupbyColCount();
+  const auto row_qw_count = get_row_qw_count(query_mem_desc_);
+  const auto key_byte_width = query_mem_desc_.getEffectiveKeyWidth();
+  const auto buff_i64 = reinterpret_cast<const int64_t*>(buff_);
+  std::vector<uint32_t> entry_partitions(entry_count, partition_count);
+  for (size_t entry_idx = 0; entry_idx < entry_count; ++entry_idx) {
+    if (isEmptyEntry(entry_idx)) {
+      continue;
+    }
+    if (query_mem_desc_.didOutputColumnar()) {
+      const auto key = make_key(&buff_i64[key_offset_colwise(entry_idx, 0, entry_count)],
+                                entry_count,
+                                key_count);
+      entry_partitions[entry_idx] =
+          get_key_partition(&key[0], key_count, sizeof(int64_t), partition_count);
+    } else {
+      entry_partitions[entry_idx] = get_key_partition(&buff_i64[row_qw_count * entry_idx],
+                                                      key_count,
+                                                      key_byte_width,
+                                                      partition_count);
+    }
+  }
+  return entry_partitions;
+}
+
+template <class KeyType>
+void ResultSetStorage::moveEntriesToPartitions(
+    const std::vector<uint32_t>& entry_partitions,
+    const std::vector<int8_t*>& partition_buffs,
+    const std::vector<size_t>& partition_entry_counts) const {
+  CHECK_EQ(entry_partitions.size(), query_mem_desc_.getEntryCount());
+  CHECK_EQ(partition_buffs.size(), partition_entry_counts.size());
+  const auto src_buff = reinterpret_cast<const int64_t*>(buff_);
+  const auto key_count = query_mem_desc_.getGroupbyColCount();
+  const auto row_qw_count = get_row_qw_count(query_mem_desc_);
+  const auto key_byte_width = query_mem_desc_.getEffectiveKeyWidth();
+  for (size_t entry_idx = 0; entry_idx < entry_partitions.size(); ++entry_idx) {
+    const auto partition = entry_partitions[entry_idx];
+    if (partition == partition_buffs.size()) {
+      continue;
+    }
+    CHECK_LT(partition, partition_buffs.size());
+    moveOneEntryToBuffer<KeyType>(entry_idx,
+                                  reinterpret_cast<int64_t*>(partition_buffs[partition]),
+                                  partition_entry_counts[partition],
+                                  key_count,
+                                  row_qw_count,
+                                  src_buff,
+                                  key_byte_width);
+  }
+}
+
+std::vector<std::unique_ptr<ResultSet>> ResultSet::partitionBaselineEntries(
+    const size_t partition_count) const {
+  CHECK(storage_);
+  CHECK(appended_storage_.empty());
+  const auto entry_partitions = storage_->getEntryPartitions(partition_count);
+  std::vector<size_t> partition_group_counts(partition_count, 0);
+  for (const auto partition : entry_partitions) {
+    if (partition < partition_count) {
+      ++partition_group_counts[partition];
+    }
+  }
+  std::vector<std::unique_ptr<ResultSet>> partitions(partition_count);
+  std::vector<int8_t*> partition_buffs(partition_count, nullptr);
+  std::vector<size_t> partition_entry_counts(partition_count, 0);
+  for (size_t i = 0; i < partition_count; ++i) {
+    if (!partition_group_counts[i]) {
+      continue;
+    }
+    auto query_mem_desc = query_mem_desc_;
+    // same 50% fill rate as the group by buffers
+    query_mem_desc.setEntryCount(2 * partition_group_counts[i]);
+    partitions[i] = std::make_unique<ResultSet>(targets_,
+                                                ExecutorDeviceType::CPU,
+                                                query_mem_desc,
+                                                row_set_mem_owner_,
+                                                catalog_,
+                                                block_size_,
+                                                grid_size_);
+    // the partitions only live during the reduction, their buffers are owned (and
+    // freed) by them rather than the row set memory owner
+    auto buff = static_cast<int8_t*>(
+        checked_malloc(query_mem_desc.getBufferSizeBytes(ExecutorDeviceType::CPU)));
+    partitions[i]->storage_.reset(
+        new ResultSetStorage(targets_, query_mem_desc, buff, /*buff_is_provided=*/false));
+    partitions[i]->storage_->target_init_vals_ = storage_->target_init_vals_;
+    partitions[i]->initializeStorage();
+    partition_buffs[i] = buff;
+    partition_entry_counts[i] = query_mem_desc.getEntryCount();
+  }
+  switch (query_mem_desc_.getEffectiveKeyWidth()) {
+    case 4:
+      storage_->moveEntriesToPartitions<int32_t>(
+          entry_partitions, partition_buffs, partition_entry_counts);
+      break;
+    case 8:
+      storage_->moveEntriesToPartitions<int64_t>(
+          entry_partitions, partition_buffs, partition_entry_counts);
+      break;
+    default:
+      CHECK(false);
+  }
+  return partitions;
+}
+
 void ResultSet::initializeStorage() const {
   if (query_mem_desc_.didOutputColumnar()) {
     storage_->initializeColWise();
@@ -1081,7 +1212,10 @@ ResultSet* ResultSetManager::reduce(std::vector<ResultSet*>& result_sets) {
   ResultSetReductionJIT reduction_jit(result_rs->getQueryMemDesc(),
                                       result_rs->getTargetInfos(),
                                       result_rs->getTargetInitVals());
-  auto reduction_code = reduction_jit.codegen();
+  auto reduction_code = [&reduction_jit] {
+    std::lock_guard<std::mutex> compilation_lock(Executor::compilation_mutex_);
+    return reduction_jit.codegen();
+  }();
   size_t ctr = 1;
   for (auto result_it = result_sets.begin() + 1; result_it != result_sets.end();
        ++result_it) {
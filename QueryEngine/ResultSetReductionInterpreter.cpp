@@ -309,6 +309,23 @@ class ReductionInterpreterImpl {
     interpreter->alloca_buffers_.resize(saved_alloca_count);
   }
 
+  static void bindStubs(const std::vector<std::unique_ptr<Instruction>>& body) {
+    for (const auto& instr : body) {
+      if (const auto call = dynamic_cast<const Call*>(instr.get())) {
+        if (call->callee()) {
+          bindStubs(call->callee()->body());
+        } else {
+          bindStub(call);
+        }
+      } else if (const auto external_call =
+                     dynamic_cast<const ExternalCall*>(instr.get())) {
+        bindStub(external_call);
+      } else if (const auto for_loop = dynamic_cast<const For*>(instr.get())) {
+        bindStubs(for_loop->body());
+      }
+    }
+  }
+
  private:
   // Set the variable based on its id.
   void setVar(const Value* var, ReductionInterpreter::EvalValue value) {
@@ -331,13 +348,13 @@ class ReductionInterpreterImpl {
   // Bind and cache a stub call.
   template <class Call>
   static StubGenerator::Stub bindStub(const Call* call) {
-    const auto func_ptr =
-        call->cached_callee()
-            ? reinterpret_cast<StubGenerator::Stub>(call->cached_callee())
-            : StubGenerator::generateStub(call->callee_name(),
-                                          get_value_types(call->arguments()),
-                                          call->type(),
-                                          call->external());
+    if (const auto cached_callee = call->cached_callee()) {
+      return reinterpret_cast<StubGenerator::Stub>(cached_callee);
+    }
+    const auto func_ptr = StubGenerator::generateStub(call->callee_name(),
+                                                      get_value_types(call->arguments()),
+                                                      call->type(),
+                                                      call->external());
     CHECK(func_ptr);
     call->set_cached_callee(reinterpret_cast<void*>(func_ptr));
     return func_ptr;
@@ -447,6 +464,10 @@ ReductionInterpreter::EvalValue ReductionInterpreter::run(
   return *maybe_ret;
 }
 
+void ReductionInterpreter::bindStubs(const Function* function) {
+  ReductionInterpreterImpl::bindStubs(function->body());
+}
+
 std::optional<ReductionInterpreter::EvalValue> ReductionInterpreter::run(
     const std::vector<std::unique_ptr<Instruction>>& body,
     const std::vector<ReductionInterpreter::EvalValue>& vars) {
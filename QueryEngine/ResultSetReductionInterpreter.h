@@ -51,4 +51,9 @@ class ReductionInterpreter {
   static std::optional<EvalValue> run(
       const std::vector<std::unique_ptr<Instruction>>& body,
       const std::vector<EvalValue>& vars);
+
+  // Bind the stubs for all the runtime functions called by the given function, including
+  // its loops and callees. Generating stubs isn't thread safe, so binding them upfront
+  // allows running the function without the compilation lock.
+  static void bindStubs(const Function* function);
 };
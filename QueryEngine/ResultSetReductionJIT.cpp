@@ -16,6 +16,7 @@
 
 #include "ResultSetReductionJIT.h"
 #include "ResultSetReductionCodegen.h"
+#include "ResultSetReductionInterpreter.h"
 #include "ResultSetReductionInterpreterStubs.h"
 
 #include "CodeGenerator.h"
@@ -26,6 +27,7 @@
 #include "Shared/likely.h"
 #include "Shared/quantile.h"
 
+#include <boost/algorithm/string/join.hpp>
 #include <llvm/Bitcode/BitcodeReader.h>
 #include <llvm/IR/Function.h>
 #include <llvm/IR/IRBuilder.h>
@@ -39,6 +41,21 @@ CodeCache ResultSetReductionJIT::s_code_cache(10000);
 
 std::mutex ReductionCode::s_reduction_mutex;
 
+ReductionCode::FuncPtr ReductionCode::getFuncPtr() const {
+  if (func_ptr) {
+    return func_ptr;
+  }
+  // the reduction threads call this concurrently, each of them has to wait on its own
+  // copy of the shared future
+  const auto compilation = async_compilation;
+  if (!compilation.valid() ||
+      compilation.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+    return nullptr;
+  }
+  auto cpu_context = std::dynamic_pointer_cast<CpuCompilationContext>(compilation.get());
+  return cpu_context ? reinterpret_cast<FuncPtr>(cpu_context->func()) : nullptr;
+}
+
 namespace {
 
 // Error code to be returned when the watchdog timer triggers during the reduction.
@@ -47,6 +64,45 @@ const int32_t WATCHDOG_ERROR{-1};
 const int32_t INTERRUPT_ERROR{10};
 // Use the interpreter, not the JIT, for a number of entries lower than the threshold.
 const size_t INTERP_THRESHOLD{25};
+// Compile synchronously if that many background compilations are already pending.
+const size_t MAX_PENDING_ASYNC_COMPILATIONS{16};
+
+// Tracks the reduction code compilations running in the background.
+class AsyncReductionCompilations {
+ public:
+  static AsyncReductionCompilations& get() {
+    static AsyncReductionCompilations async_compilations;
+    return async_compilations;
+  }
+
+  // Must be called with the mutex held.
+  void pruneFinishedJobs() {
+    jobs.erase(std::remove_if(jobs.begin(),
+                              jobs.end(),
+                              [](const std::future<void>& job) {
+                                return job.wait_for(std::chrono::seconds(0)) ==
+                                       std::future_status::ready;
+                              }),
+               jobs.end());
+  }
+
+  void waitForJobs() {
+    std::vector<std::future<void>> pending_jobs;
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      pending_jobs.swap(jobs);
+    }
+    for (auto& job : pending_jobs) {
+      job.wait();
+    }
+  }
+
+  std::mutex mutex;
+  // Compilations in flight by cache key, used to avoid compiling the same code twice.
+  std::unordered_map<std::string, std::shared_future<std::shared_ptr<CompilationContext>>>
+      in_flight;
+  std::vector<std::future<void>> jobs;
+};
 
 // Load the value stored at 'ptr' interpreted as 'ptr_type'.
 Value* emit_load(Value* ptr, Type ptr_type, Function* function) {
@@ -554,6 +610,53 @@ ResultSetReductionJIT::ResultSetReductionJIT(const QueryMemoryDescriptor& query_
 //     reduce_func_idx(this_buff, that_buff, that_entry_index)
 
 ReductionCode ResultSetReductionJIT::codegen() const {
+  auto reduction_code = generateReductionIR();
+  if (!reduction_code.ir_reduce_loop) {
+    return reduction_code;
+  }
+  // For small result sets, avoid native code generation and use the interpreter instead.
+  // Always compile for count distinct aggregation
+  if (query_mem_desc_.getCountDistinctDescriptorsSize() == 0 &&
+      query_mem_desc_.getEntryCount() < INTERP_THRESHOLD &&
+      (!query_mem_desc_.getExecutor() || query_mem_desc_.blocksShareMemory())) {
+    return reduction_code;
+  }
+  CodeCacheKey key{cacheKey()};
+  {
+    std::lock_guard<std::mutex> reduction_guard(ReductionCode::s_reduction_mutex);
+    const auto compilation_context = s_code_cache.get(key);
+    if (compilation_context) {
+      auto cpu_context =
+          std::dynamic_pointer_cast<CpuCompilationContext>(compilation_context->first);
+      CHECK(cpu_context);
+      return {reinterpret_cast<ReductionCode::FuncPtr>(cpu_context->func()),
+              nullptr,
+              nullptr,
+              nullptr,
+              std::move(reduction_code.ir_is_empty),
+              std::move(reduction_code.ir_reduce_one_entry),
+              std::move(reduction_code.ir_reduce_one_entry_idx),
+              std::move(reduction_code.ir_reduce_loop)};
+    }
+  }
+  // Start the reduction on the interpreter right away and switch to the native code once
+  // the background compilation is done. Count distinct always needs the native code.
+  if (g_enable_async_reduction_jit &&
+      query_mem_desc_.getCountDistinctDescriptorsSize() == 0) {
+    auto async_compilation = compileAsync(key);
+    if (async_compilation.valid()) {
+      // The compilation lock is held by the caller, bind the stubs now so that the
+      // interpreter can run concurrently with the compilation.
+      ReductionInterpreter::bindStubs(reduction_code.ir_reduce_loop.get());
+      reduction_code.async_compilation = std::move(async_compilation);
+      return reduction_code;
+    }
+  }
+  std::lock_guard<std::mutex> reduction_guard(ReductionCode::s_reduction_mutex);
+  return compileReductionCode(std::move(reduction_code), key);
+}
+
+ReductionCode ResultSetReductionJIT::generateReductionIR() const {
   const auto hash_type = query_mem_desc_.getQueryDescriptionType();
   if (query_mem_desc_.didOutputColumnar() || !is_aggregate_query(hash_type)) {
     return {};
@@ -577,29 +680,11 @@ ReductionCode ResultSetReductionJIT::codegen() const {
     }
   }
   reduceLoop(reduction_code);
-  // For small result sets, avoid native code generation and use the interpreter instead.
-  // Always compile for count distinct aggregation
-  if (query_mem_desc_.getCountDistinctDescriptorsSize() == 0 &&
-      query_mem_desc_.getEntryCount() < INTERP_THRESHOLD &&
-      (!query_mem_desc_.getExecutor() || query_mem_desc_.blocksShareMemory())) {
-    return reduction_code;
-  }
-  std::lock_guard<std::mutex> reduction_guard(ReductionCode::s_reduction_mutex);
-  CodeCacheKey key{cacheKey()};
-  const auto compilation_context = s_code_cache.get(key);
-  if (compilation_context) {
-    auto cpu_context =
-        std::dynamic_pointer_cast<CpuCompilationContext>(compilation_context->first);
-    CHECK(cpu_context);
-    return {reinterpret_cast<ReductionCode::FuncPtr>(cpu_context->func()),
-            nullptr,
-            nullptr,
-            nullptr,
-            std::move(reduction_code.ir_is_empty),
-            std::move(reduction_code.ir_reduce_one_entry),
-            std::move(reduction_code.ir_reduce_one_entry_idx),
-            std::move(reduction_code.ir_reduce_loop)};
-  }
+  return reduction_code;
+}
+
+ReductionCode ResultSetReductionJIT::compileReductionCode(ReductionCode reduction_code,
+                                                          const CodeCacheKey& key) const {
   reduction_code.cgen_state.reset(new CgenState({}, false));
   auto cgen_state = reduction_code.cgen_state.get();
   std::unique_ptr<llvm::Module> module = runtime_module_shallow_copy(cgen_state);
@@ -636,7 +721,56 @@ ReductionCode ResultSetReductionJIT::codegen() const {
                                key);
 }
 
+std::shared_future<std::shared_ptr<CompilationContext>>
+ResultSetReductionJIT::compileAsync(const CodeCacheKey& key) const {
+  auto& async_compilations = AsyncReductionCompilations::get();
+  std::lock_guard<std::mutex> async_compilations_lock(async_compilations.mutex);
+  const auto key_str = boost::algorithm::join(key, "\n");
+  const auto in_flight_it = async_compilations.in_flight.find(key_str);
+  if (in_flight_it != async_compilations.in_flight.end()) {
+    return in_flight_it->second;
+  }
+  async_compilations.pruneFinishedJobs();
+  if (async_compilations.jobs.size() >= MAX_PENDING_ASYNC_COMPILATIONS) {
+    // Too many compilations queued up, let the caller compile synchronously.
+    return {};
+  }
+  auto promise = std::make_shared<std::promise<std::shared_ptr<CompilationContext>>>();
+  auto compilation = promise->get_future().share();
+  async_compilations.in_flight.emplace(key_str, compilation);
+  // The copy of the generator owns everything needed to regenerate the IR.
+  auto reduction_jit = std::make_shared<ResultSetReductionJIT>(
+      query_mem_desc_, targets_, target_init_vals_);
+  async_compilations.jobs.push_back(
+      std::async(std::launch::async, [reduction_jit, key, key_str, promise] {
+        std::shared_ptr<CompilationContext> compilation_context;
+        try {
+          std::lock_guard<std::mutex> compilation_lock(Executor::compilation_mutex_);
+          auto reduction_code = reduction_jit->generateReductionIR();
+          std::lock_guard<std::mutex> reduction_guard(ReductionCode::s_reduction_mutex);
+          const auto cached_context = s_code_cache.get(key);
+          if (cached_context) {
+            compilation_context = cached_context->first;
+          } else {
+            compilation_context =
+                reduction_jit->compileReductionCode(std::move(reduction_code), key)
+                    .compilation_context;
+          }
+        } catch (const std::exception& e) {
+          // The interpreter keeps running the reduction.
+          LOG(WARNING) << "Background compilation of the reduction code failed: "
+                       << e.what();
+        }
+        promise->set_value(compilation_context);
+        auto& async_compilations = AsyncReductionCompilations::get();
+        std::lock_guard<std::mutex> async_compilations_lock(async_compilations.mutex);
+        async_compilations.in_flight.erase(key_str);
+      }));
+  return compilation;
+}
+
 void ResultSetReductionJIT::clearCache() {
+  AsyncReductionCompilations::get().waitForJobs();
   // Clear stub cache to avoid crash caused by non-deterministic static destructor order
   // of LLVM context and the cache.
   StubGenerator::clearCache();
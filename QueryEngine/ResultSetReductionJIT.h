@@ -27,6 +27,10 @@
 #include <llvm/IR/Module.h>
 #include <llvm/IR/Value.h>
 
+#include <future>
+
+extern bool g_enable_async_reduction_jit;
+
 struct ReductionCode {
   // Function which reduces 'that_buff' into 'this_buff', for rows between
   // [start_entry_index, end_entry_index).
@@ -48,6 +52,15 @@ struct ReductionCode {
   std::unique_ptr<Function> ir_reduce_one_entry_idx;
   std::unique_ptr<Function> ir_reduce_loop;
   std::shared_ptr<CompilationContext> compilation_context;
+  // Set when the native code is being compiled in the background while the reduction
+  // runs on the interpreter. The stubs used by the interpreter are bound upfront in this
+  // case, so the interpreter doesn't need the compilation lock.
+  std::shared_future<std::shared_ptr<CompilationContext>> async_compilation;
+
+  // Returns the native reduction function, if any. Picks up the result of the background
+  // compilation once it's done, so callers switch from the interpreter to the compiled
+  // code between two calls.
+  FuncPtr getFuncPtr() const;
 
   static std::mutex s_reduction_mutex;
 };
@@ -59,8 +72,10 @@ class ResultSetReductionJIT {
                         const std::vector<int64_t>& target_init_vals);
   virtual ~ResultSetReductionJIT() = default;
 
-  // Generate the code for the result set reduction loop.
+  // Generate the code for the result set reduction loop. The caller is expected to hold
+  // the executor compilation lock.
   virtual ReductionCode codegen() const;
+  // Waits for the pending background compilations and clears the code cache.
   static void clearCache();
 
  protected:
@@ -125,6 +140,18 @@ class ResultSetReductionJIT {
                                    const size_t target_logical_idx,
                                    Function* ir_reduce_one_entry) const;
 
+  // Generate the interpreter IR for the reduction functions.
+  ReductionCode generateReductionIR() const;
+
+  // Translate the interpreter IR to LLVM IR and compile it to native code.
+  ReductionCode compileReductionCode(ReductionCode reduction_code,
+                                     const CodeCacheKey& key) const;
+
+  // Start compiling the native code on a background thread, unless a compilation for
+  // the same key is already in flight.
+  std::shared_future<std::shared_ptr<CompilationContext>> compileAsync(
+      const CodeCacheKey& key) const;
+
   ReductionCode finalizeReductionCode(ReductionCode reduction_code,
                                       const llvm::Function* ir_is_empty,
                                       const llvm::Function* ir_reduce_one_entry,
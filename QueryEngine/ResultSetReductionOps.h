@@ -18,6 +18,7 @@
 
 #include <Logger/Logger.h>
 
+#include <atomic>
 #include <memory>
 #include <string>
 #include <vector>
@@ -374,16 +375,19 @@ class Call : public Instruction {
 
   void run(ReductionInterpreterImpl* interpreter) override;
 
-  void* cached_callee() const { return cached_callee_; }
+  void* cached_callee() const { return cached_callee_.load(std::memory_order_acquire); }
 
-  void set_cached_callee(void* cached_callee) const { cached_callee_ = cached_callee; }
+  void set_cached_callee(void* cached_callee) const {
+    cached_callee_.store(cached_callee, std::memory_order_release);
+  }
 
  private:
   const std::string callee_name_;
   const Function* callee_;
   const std::vector<const Value*> arguments_;
   // For performance reasons, the pointer of the native function is stored in this field.
-  mutable void* cached_callee_;
+  // Atomic, since the interpreters running the same reduction in parallel share it.
+  mutable std::atomic<void*> cached_callee_;
 };
 
 // An external runtime function, with C binding.
@@ -406,14 +410,16 @@ class ExternalCall : public Instruction {
 
   void run(ReductionInterpreterImpl* interpreter) override;
 
-  void* cached_callee() const { return cached_callee_; }
+  void* cached_callee() const { return cached_callee_.load(std::memory_order_acquire); }
 
-  void set_cached_callee(void* cached_callee) const { cached_callee_ = cached_callee; }
+  void set_cached_callee(void* cached_callee) const {
+    cached_callee_.store(cached_callee, std::memory_order_release);
+  }
 
  private:
   const std::string callee_name_;
   const std::vector<const Value*> arguments_;
-  mutable void* cached_callee_;
+  mutable std::atomic<void*> cached_callee_;
 };
 
 class Alloca : public Instruction {
@@ -159,7 +159,8 @@ bool ResultSet::canUseFastBaselineSort(
     const std::list<Analyzer::OrderEntry>& order_entries,
     const size_t top_n) {
   if (order_entries.size() != 1 || query_mem_desc_.hasKeylessHash() ||
-      query_mem_desc_.sortOnGpu() || query_mem_desc_.didOutputColumnar()) {
+      query_mem_desc_.sortOnGpu() || query_mem_desc_.didOutputColumnar() ||
+      !appended_storage_.empty()) {
     return false;
   }
   const auto& order_entry = order_entries.front();
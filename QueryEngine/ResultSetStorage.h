@@ -128,6 +128,15 @@ class ResultSetStorage {
                             const int64_t* src_buff,
                             const size_t key_byte_width) const;
 
+  // The partition of every entry of a baseline hash buffer for a partitioned reduction,
+  // `partition_count` for the empty entries.
+  std::vector<uint32_t> getEntryPartitions(const size_t partition_count) const;
+
+  template <class KeyType>
+  void moveEntriesToPartitions(const std::vector<uint32_t>& entry_partitions,
+                               const std::vector<int8_t*>& partition_buffs,
+                               const std::vector<size_t>& partition_entry_counts) const;
+
   void updateEntryCount(const size_t new_entry_count) {
     query_mem_desc_.setEntryCount(new_entry_count);
   }
@@ -23,6 +23,8 @@
 
 #include <boost/locale/conversion.hpp>
 
+#include <algorithm>
+
 extern "C" RUNTIME_EXPORT uint64_t string_decode(int8_t* chunk_iter_, int64_t pos) {
   auto chunk_iter = reinterpret_cast<ChunkIter*>(chunk_iter_);
   VarlenDatum vd;
@@ -64,6 +66,26 @@ extern "C" RUNTIME_EXPORT int32_t lower_encoded(int32_t string_id,
   return string_dict_proxy->getOrAddTransient(boost::locale::to_lower(str));
 }
 
+extern "C" RUNTIME_EXPORT int32_t lower_encoded_translated(
+    int32_t string_id,
+    int64_t translation_table_address,
+    int32_t translation_table_size,
+    int64_t string_dict_proxy_address) {
+  if (string_id >= 0 && string_id < translation_table_size) {
+    return reinterpret_cast<const int32_t*>(translation_table_address)[string_id];
+  }
+  // transient strings and the strings added to the dictionary after code generation
+  return lower_encoded(string_id, string_dict_proxy_address);
+}
+
+namespace {
+
+// LOWER of dictionaries up to this size is computed for all of their strings at once
+// during code generation, the generated code then looks the results up by string id
+constexpr size_t kMaxLowerTranslationEntries{1 << 16};
+
+}  // namespace
+
 llvm::Value* CodeGenerator::codegen(const Analyzer::CharLengthExpr* expr,
                                     const CompilationOptions& co) {
   AUTOMATIC_IR_METADATA(cgen_state_);
@@ -114,16 +136,43 @@ llvm::Value* CodeGenerator::codegen(const Analyzer::LowerExpr* expr,
   auto str_id_lv = codegen(expr->get_arg(), true, co);
   CHECK_EQ(size_t(1), str_id_lv.size());
 
+  auto row_set_mem_owner = executor()->getRowSetMemoryOwner();
   const auto string_dictionary_proxy = executor()->getStringDictionaryProxy(
-      expr->get_type_info().get_comp_param(), executor()->getRowSetMemoryOwner(), true);
+      expr->get_type_info().get_comp_param(), row_set_mem_owner, true);
   CHECK(string_dictionary_proxy);
 
+  size_t num_dict_strings = string_dictionary_proxy->storageEntryCount();
+  const auto generation = string_dictionary_proxy->getGeneration();
+  if (generation >= 0) {
+    num_dict_strings = std::min(num_dict_strings, static_cast<size_t>(generation));
+  }
+  if (num_dict_strings == 0 || num_dict_strings > kMaxLowerTranslationEntries) {
+    std::vector<llvm::Value*> args{
+        str_id_lv[0],
+        cgen_state_->llInt(reinterpret_cast<int64_t>(string_dictionary_proxy))};
+    return cgen_state_->emitExternalCall(
+        "lower_encoded", get_int_type(32, cgen_state_->context_), args);
+  }
+
+  // add the lowered strings to the proxy in one batch instead of one row at a time
+  std::vector<std::string> lowered_strings(num_dict_strings);
+  for (size_t string_id = 0; string_id < num_dict_strings; ++string_id) {
+    lowered_strings[string_id] = boost::locale::to_lower(
+        string_dictionary_proxy->getString(static_cast<int32_t>(string_id)));
+  }
+  const auto lowered_ids =
+      string_dictionary_proxy->getOrAddTransientBulk(lowered_strings);
+  auto translation_table = reinterpret_cast<int32_t*>(
+      row_set_mem_owner->allocate(lowered_ids.size() * sizeof(int32_t)));
+  std::copy(lowered_ids.begin(), lowered_ids.end(), translation_table);
+
   std::vector<llvm::Value*> args{
       str_id_lv[0],
+      cgen_state_->llInt(reinterpret_cast<int64_t>(translation_table)),
+      cgen_state_->llInt(static_cast<int32_t>(lowered_ids.size())),
       cgen_state_->llInt(reinterpret_cast<int64_t>(string_dictionary_proxy))};
-
   return cgen_state_->emitExternalCall(
-      "lower_encoded", get_int_type(32, cgen_state_->context_), args);
+      "lower_encoded_translated", get_int_type(32, cgen_state_->context_), args);
 }
 
 llvm::Value* CodeGenerator::codegen(const Analyzer::LikeExpr* expr,
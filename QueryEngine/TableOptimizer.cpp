@@ -312,7 +312,7 @@ void TableOptimizer::recomputeColumnMetadata(
     const std::unordered_map</*fragment_id*/ int, size_t>& tuple_count_map,
     std::optional<Data_Namespace::MemoryLevel> memory_level,
     const std::set<size_t>& fragment_indexes) const {
-  const auto ti = cd->columnType;
+  const auto ti = get_in_memory_type_info(cd->columnType);
   if (ti.is_varlen()) {
     LOG(INFO) << "Skipping varlen column " << cd->columnName;
     return;
@@ -322,13 +322,13 @@ void TableOptimizer::recomputeColumnMetadata(
   const auto input_col_desc =
       std::make_shared<const InputColDescriptor>(column_id, td->tableId, 0);
   const auto col_expr =
-      makeExpr<Analyzer::ColumnVar>(cd->columnType, td->tableId, column_id, 0);
+      makeExpr<Analyzer::ColumnVar>(ti, td->tableId, column_id, 0);
   auto max_expr =
-      makeExpr<Analyzer::AggExpr>(cd->columnType, kMAX, col_expr, false, nullptr);
+      makeExpr<Analyzer::AggExpr>(ti, kMAX, col_expr, false, nullptr);
   auto min_expr =
-      makeExpr<Analyzer::AggExpr>(cd->columnType, kMIN, col_expr, false, nullptr);
+      makeExpr<Analyzer::AggExpr>(ti, kMIN, col_expr, false, nullptr);
   auto count_expr =
-      makeExpr<Analyzer::AggExpr>(cd->columnType, kCOUNT, col_expr, false, nullptr);
+      makeExpr<Analyzer::AggExpr>(ti, kCOUNT, col_expr, false, nullptr);
 
   if (ti.is_string()) {
     const SQLTypeInfo fun_ti(kINT);
@@ -0,0 +1,758 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "QueryEngine/VectorizedInterpreter.h"
+
+#include "QueryEngine/ColumnFetcher.h"
+#include "QueryEngine/Execute.h"
+
+#include <functional>
+
+namespace {
+
+bool is_interpretable_column_type(const SQLTypeInfo& ti) {
+  if (ti.get_compression() != kENCODING_NONE) {
+    return false;
+  }
+  switch (ti.get_type()) {
+    case kBOOLEAN:
+    case kTINYINT:
+    case kSMALLINT:
+    case kINT:
+    case kBIGINT:
+    case kFLOAT:
+    case kDOUBLE:
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+      return true;
+    default:
+      return false;
+  }
+}
+
+const ColumnDescriptor* get_interpretable_column(const Analyzer::Expr* expr,
+                                                 const int table_id,
+                                                 const Catalog_Namespace::Catalog& cat) {
+  const auto col_var = dynamic_cast<const Analyzer::ColumnVar*>(expr);
+  if (!col_var || dynamic_cast<const Analyzer::Var*>(expr) ||
+      col_var->get_table_id() != table_id || col_var->get_rte_idx() != 0) {
+    return nullptr;
+  }
+  const auto cd = cat.getMetadataForColumn(table_id, col_var->get_column_id());
+  if (!cd || cd->isVirtualCol || !is_interpretable_column_type(cd->columnType) ||
+      !is_interpretable_column_type(col_var->get_type_info())) {
+    return nullptr;
+  }
+  return cd;
+}
+
+std::optional<int64_t> get_int_literal(const Analyzer::Constant* constant) {
+  const auto& ti = constant->get_type_info();
+  const auto datum = constant->get_constval();
+  switch (ti.get_type()) {
+    case kBOOLEAN:
+      return static_cast<int64_t>(datum.boolval);
+    case kTINYINT:
+      return static_cast<int64_t>(datum.tinyintval);
+    case kSMALLINT:
+      return static_cast<int64_t>(datum.smallintval);
+    case kINT:
+      return static_cast<int64_t>(datum.intval);
+    case kBIGINT:
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+      return datum.bigintval;
+    default:
+      return std::nullopt;
+  }
+}
+
+// translates a single conjunct of the filter, i.e., `col <op> literal`
+std::optional<VectorizedInterpreter::ColumnPredicate> translate_predicate(
+    const Analyzer::Expr* qual,
+    const int table_id,
+    const Catalog_Namespace::Catalog& cat) {
+  if (const auto uoper = dynamic_cast<const Analyzer::UOper*>(qual)) {
+    auto op = uoper->get_optype();
+    auto operand = uoper->get_operand();
+    if (op == kNOT) {
+      const auto inner_uoper = dynamic_cast<const Analyzer::UOper*>(operand);
+      if (!inner_uoper || inner_uoper->get_optype() != kISNULL) {
+        return std::nullopt;
+      }
+      op = kISNOTNULL;
+      operand = inner_uoper->get_operand();
+    }
+    if (op != kISNULL && op != kISNOTNULL) {
+      return std::nullopt;
+    }
+    const auto cd = get_interpretable_column(operand, table_id, cat);
+    if (!cd) {
+      return std::nullopt;
+    }
+    return VectorizedInterpreter::ColumnPredicate{cd, op, false, 0, 0.0};
+  }
+  const auto bin_oper = dynamic_cast<const Analyzer::BinOper*>(qual);
+  if (!bin_oper || bin_oper->get_qualifier() != kONE) {
+    return std::nullopt;
+  }
+  auto op = bin_oper->get_optype();
+  if (!IS_COMPARISON(op) || op == kBW_EQ || op == kOVERLAPS) {
+    return std::nullopt;
+  }
+  auto col_expr = bin_oper->get_left_operand();
+  auto const_expr = bin_oper->get_right_operand();
+  if (dynamic_cast<const Analyzer::Constant*>(col_expr)) {
+    std::swap(col_expr, const_expr);
+    op = COMMUTE_COMPARISON(op);
+  }
+  const auto cd = get_interpretable_column(col_expr, table_id, cat);
+  const auto constant = dynamic_cast<const Analyzer::Constant*>(const_expr);
+  if (!cd || !constant || constant->get_is_null()) {
+    return std::nullopt;
+  }
+  const auto& col_ti = cd->columnType;
+  const auto& const_ti = constant->get_type_info();
+  if (col_ti.is_time() || const_ti.is_time()) {
+    // datetime literals are only comparable as is if they have the same unit
+    if (col_ti.get_type() != const_ti.get_type() ||
+        col_ti.get_dimension() != const_ti.get_dimension()) {
+      return std::nullopt;
+    }
+  }
+  if (const_ti.is_fp()) {
+    if (!col_ti.is_fp() && !col_ti.is_integer()) {
+      return std::nullopt;
+    }
+    const auto fp_rhs = const_ti.get_type() == kFLOAT
+                            ? static_cast<double>(constant->get_constval().floatval)
+                            : constant->get_constval().doubleval;
+    return VectorizedInterpreter::ColumnPredicate{cd, op, true, 0, fp_rhs};
+  }
+  const auto int_rhs = get_int_literal(constant);
+  if (!int_rhs) {
+    return std::nullopt;
+  }
+  return VectorizedInterpreter::ColumnPredicate{
+      cd, op, col_ti.is_fp(), *int_rhs, static_cast<double>(*int_rhs)};
+}
+
+std::optional<VectorizedInterpreter::InterpretedTarget> translate_target(
+    const Analyzer::Expr* target_expr,
+    const int table_id,
+    const Catalog_Namespace::Catalog& cat) {
+  const auto agg_expr = dynamic_cast<const Analyzer::AggExpr*>(target_expr);
+  if (!agg_expr) {
+    const auto cd = get_interpretable_column(target_expr, table_id, cat);
+    if (!cd) {
+      return std::nullopt;
+    }
+    return VectorizedInterpreter::InterpretedTarget{
+        cd, std::nullopt, target_expr->get_type_info()};
+  }
+  if (agg_expr->get_is_distinct()) {
+    return std::nullopt;
+  }
+  const auto agg_kind = agg_expr->get_aggtype();
+  const auto& result_type = agg_expr->get_type_info();
+  switch (agg_kind) {
+    case kCOUNT: {
+      if (!agg_expr->get_arg()) {
+        return VectorizedInterpreter::InterpretedTarget{nullptr, agg_kind, result_type};
+      }
+      break;
+    }
+    case kSUM:
+    case kAVG:
+    case kMIN:
+    case kMAX:
+      break;
+    default:
+      return std::nullopt;
+  }
+  const auto cd = get_interpretable_column(agg_expr->get_arg(), table_id, cat);
+  if (!cd || cd->columnType.get_type() == kBOOLEAN ||
+      (agg_kind != kCOUNT && !is_interpretable_column_type(result_type)) ||
+      ((agg_kind == kSUM || agg_kind == kAVG) && cd->columnType.is_time())) {
+    return std::nullopt;
+  }
+  return VectorizedInterpreter::InterpretedTarget{cd, agg_kind, result_type};
+}
+
+// kernels: each of them is a tight loop over a fixed-width column buffer specialized by
+// the physical column type, the filter result is kept as a byte mask so the loops stay
+// branch-free and can be auto-vectorized by the compiler
+
+template <typename T, typename V, typename CMP>
+void filter_column(const T* col,
+                   const size_t row_count,
+                   const T null_val,
+                   const V rhs,
+                   uint8_t* mask) {
+  CMP cmp;
+  for (size_t i = 0; i < row_count; ++i) {
+    const T val = col[i];
+    mask[i] &= static_cast<uint8_t>((val != null_val) & cmp(static_cast<V>(val), rhs));
+  }
+}
+
+template <typename T>
+void filter_column_nulls(const T* col,
+                         const size_t row_count,
+                         const T null_val,
+                         const bool is_null,
+                         uint8_t* mask) {
+  for (size_t i = 0; i < row_count; ++i) {
+    mask[i] &= static_cast<uint8_t>((col[i] == null_val) == is_null);
+  }
+}
+
+template <typename T, typename V>
+void filter_column(const T* col,
+                   const size_t row_count,
+                   const T null_val,
+                   const SQLOps op,
+                   const V rhs,
+                   uint8_t* mask) {
+  switch (op) {
+    case kEQ:
+      filter_column<T, V, std::equal_to<V>>(col, row_count, null_val, rhs, mask);
+      break;
+    case kNE:
+      filter_column<T, V, std::not_equal_to<V>>(col, row_count, null_val, rhs, mask);
+      break;
+    case kLT:
+      filter_column<T, V, std::less<V>>(col, row_count, null_val, rhs, mask);
+      break;
+    case kLE:
+      filter_column<T, V, std::less_equal<V>>(col, row_count, null_val, rhs, mask);
+      break;
+    case kGT:
+      filter_column<T, V, std::greater<V>>(col, row_count, null_val, rhs, mask);
+      break;
+    case kGE:
+      filter_column<T, V, std::greater_equal<V>>(col, row_count, null_val, rhs, mask);
+      break;
+    default:
+      UNREACHABLE();
+  }
+}
+
+template <typename T>
+void apply_predicate(const VectorizedInterpreter::ColumnPredicate& predicate,
+                     const int8_t* col_buf,
+                     const size_t row_count,
+                     uint8_t* mask) {
+  const auto col = reinterpret_cast<const T*>(col_buf);
+  const auto& ti = predicate.cd->columnType;
+  T null_val;
+  if constexpr (std::is_floating_point<T>::value) {
+    null_val = static_cast<T>(inline_fp_null_val(ti));
+  } else {
+    null_val = static_cast<T>(inline_int_null_val(ti));
+  }
+  if (predicate.op == kISNULL || predicate.op == kISNOTNULL) {
+    filter_column_nulls<T>(col, row_count, null_val, predicate.op == kISNULL, mask);
+  } else if (predicate.compare_as_fp) {
+    filter_column<T, double>(
+        col, row_count, null_val, predicate.op, predicate.fp_rhs, mask);
+  } else {
+    filter_column<T, int64_t>(
+        col, row_count, null_val, predicate.op, predicate.int_rhs, mask);
+  }
+}
+
+// running state of a non-grouped aggregate
+struct AggState {
+  int64_t count{0};
+  int64_t int_val{0};
+  double fp_val{0.0};
+  bool overflow{false};
+};
+
+template <typename T>
+void aggregate_column(const VectorizedInterpreter::InterpretedTarget& target,
+                      const int8_t* col_buf,
+                      const size_t row_count,
+                      const uint8_t* mask,
+                      AggState& state) {
+  const auto col = reinterpret_cast<const T*>(col_buf);
+  const auto& ti = target.cd->columnType;
+  T null_val;
+  if constexpr (std::is_floating_point<T>::value) {
+    null_val = static_cast<T>(inline_fp_null_val(ti));
+  } else {
+    null_val = static_cast<T>(inline_int_null_val(ti));
+  }
+  int64_t count{0};
+  for (size_t i = 0; i < row_count; ++i) {
+    count += mask[i] & (col[i] != null_val);
+  }
+  const bool init = state.count == 0;
+  state.count += count;
+  if (*target.agg_kind == kCOUNT || count == 0) {
+    return;
+  }
+  if constexpr (std::is_floating_point<T>::value) {
+    switch (*target.agg_kind) {
+      case kSUM:
+      case kAVG: {
+        double sum{0.0};
+        for (size_t i = 0; i < row_count; ++i) {
+          sum += (mask[i] && col[i] != null_val) ? static_cast<double>(col[i]) : 0.0;
+        }
+        state.fp_val += sum;
+        break;
+      }
+      case kMIN: {
+        double min_val = init ? std::numeric_limits<double>::max() : state.fp_val;
+        for (size_t i = 0; i < row_count; ++i) {
+          const double val = col[i];
+          min_val = (mask[i] && col[i] != null_val && val < min_val) ? val : min_val;
+        }
+        state.fp_val = min_val;
+        break;
+      }
+      case kMAX: {
+        double max_val = init ? std::numeric_limits<double>::lowest() : state.fp_val;
+        for (size_t i = 0; i < row_count; ++i) {
+          const double val = col[i];
+          max_val = (mask[i] && col[i] != null_val && val > max_val) ? val : max_val;
+        }
+        state.fp_val = max_val;
+        break;
+      }
+      default:
+        UNREACHABLE();
+    }
+  } else {
+    switch (*target.agg_kind) {
+      case kSUM:
+      case kAVG: {
+        int64_t sum{0};
+        if constexpr (sizeof(T) < sizeof(int64_t)) {
+          // a fragment never has 2^32 rows, so narrow integers cannot overflow here
+          for (size_t i = 0; i < row_count; ++i) {
+            sum += (mask[i] && col[i] != null_val) ? static_cast<int64_t>(col[i]) : 0;
+          }
+        } else {
+          for (size_t i = 0; i < row_count; ++i) {
+            const int64_t val = (mask[i] && col[i] != null_val) ? col[i] : 0;
+            if (__builtin_add_overflow(sum, val, &sum)) {
+              state.overflow = true;
+              return;
+            }
+          }
+        }
+        if (__builtin_add_overflow(state.int_val, sum, &state.int_val)) {
+          state.overflow = true;
+        }
+        break;
+      }
+      case kMIN: {
+        int64_t min_val = init ? std::numeric_limits<int64_t>::max() : state.int_val;
+        for (size_t i = 0; i < row_count; ++i) {
+          const int64_t val = col[i];
+          min_val = (mask[i] && col[i] != null_val && val < min_val) ? val : min_val;
+        }
+        state.int_val = min_val;
+        break;
+      }
+      case kMAX: {
+        int64_t max_val = init ? std::numeric_limits<int64_t>::min() : state.int_val;
+        for (size_t i = 0; i < row_count; ++i) {
+          const int64_t val = col[i];
+          max_val = (mask[i] && col[i] != null_val && val > max_val) ? val : max_val;
+        }
+        state.int_val = max_val;
+        break;
+      }
+      default:
+        UNREACHABLE();
+    }
+  }
+}
+
+template <typename T>
+void gather_column(const int8_t* col_buf,
+                   const std::vector<uint32_t>& row_ids,
+                   int8_t* out,
+                   const size_t row_size) {
+  const auto col = reinterpret_cast<const T*>(col_buf);
+  for (const auto row_id : row_ids) {
+    *reinterpret_cast<T*>(out) = col[row_id];
+    out += row_size;
+  }
+}
+
+// dispatches the kernel by the physical type of the given column
+template <template <typename> class KERNEL, typename... ARGS>
+void dispatch_by_column_type(const SQLTypeInfo& ti, ARGS&&... args) {
+  switch (ti.get_type()) {
+    case kBOOLEAN:
+    case kTINYINT:
+      KERNEL<int8_t>()(std::forward<ARGS>(args)...);
+      break;
+    case kSMALLINT:
+      KERNEL<int16_t>()(std::forward<ARGS>(args)...);
+      break;
+    case kINT:
+      KERNEL<int32_t>()(std::forward<ARGS>(args)...);
+      break;
+    case kBIGINT:
+    case kTIME:
+    case kTIMESTAMP:
+    case kDATE:
+      KERNEL<int64_t>()(std::forward<ARGS>(args)...);
+      break;
+    case kFLOAT:
+      KERNEL<float>()(std::forward<ARGS>(args)...);
+      break;
+    case kDOUBLE:
+      KERNEL<double>()(std::forward<ARGS>(args)...);
+      break;
+    default:
+      UNREACHABLE() << ti.get_type_name();
+  }
+}
+
+template <typename T>
+struct ApplyPredicate {
+  template <typename... ARGS>
+  void operator()(ARGS&&... args) const {
+    apply_predicate<T>(std::forward<ARGS>(args)...);
+  }
+};
+
+template <typename T>
+struct AggregateColumn {
+  template <typename... ARGS>
+  void operator()(ARGS&&... args) const {
+    aggregate_column<T>(std::forward<ARGS>(args)...);
+  }
+};
+
+template <typename T>
+struct GatherColumn {
+  template <typename... ARGS>
+  void operator()(ARGS&&... args) const {
+    gather_column<T>(std::forward<ARGS>(args)...);
+  }
+};
+
+void write_int_slot(int8_t* ptr, const SQLTypeInfo& ti, const int64_t val) {
+  switch (ti.get_size()) {
+    case 1:
+      *reinterpret_cast<int8_t*>(ptr) = static_cast<int8_t>(val);
+      break;
+    case 2:
+      *reinterpret_cast<int16_t*>(ptr) = static_cast<int16_t>(val);
+      break;
+    case 4:
+      *reinterpret_cast<int32_t*>(ptr) = static_cast<int32_t>(val);
+      break;
+    case 8:
+      *reinterpret_cast<int64_t*>(ptr) = val;
+      break;
+    default:
+      UNREACHABLE() << ti.get_size();
+  }
+}
+
+void write_fp_slot(int8_t* ptr, const SQLTypeInfo& ti, const double val) {
+  if (ti.get_type() == kFLOAT) {
+    *reinterpret_cast<float*>(ptr) = static_cast<float>(val);
+  } else {
+    CHECK_EQ(ti.get_type(), kDOUBLE);
+    *reinterpret_cast<double*>(ptr) = val;
+  }
+}
+
+void write_null_slot(int8_t* ptr, const SQLTypeInfo& ti) {
+  if (ti.is_fp()) {
+    write_fp_slot(ptr, ti, inline_fp_null_val(ti));
+  } else {
+    write_int_slot(ptr, ti, inline_int_null_val(ti));
+  }
+}
+
+void write_agg_result(int8_t* ptr,
+                      const VectorizedInterpreter::InterpretedTarget& target,
+                      const AggState& state) {
+  const auto& result_type = target.result_type;
+  if (*target.agg_kind == kCOUNT) {
+    write_int_slot(ptr, result_type, state.count);
+    return;
+  }
+  if (state.count == 0) {
+    write_null_slot(ptr, result_type);
+    return;
+  }
+  const bool arg_is_fp = target.cd->columnType.is_fp();
+  if (*target.agg_kind == kAVG) {
+    const auto sum = arg_is_fp ? state.fp_val : static_cast<double>(state.int_val);
+    write_fp_slot(ptr, result_type, sum / state.count);
+    return;
+  }
+  if (result_type.is_fp()) {
+    write_fp_slot(ptr,
+                  result_type,
+                  arg_is_fp ? state.fp_val : static_cast<double>(state.int_val));
+  } else {
+    CHECK(!arg_is_fp);
+    write_int_slot(ptr, result_type, state.int_val);
+  }
+}
+
+}  // namespace
+
+std::atomic<size_t> VectorizedInterpreter::num_executed_units_{0};
+
+std::unique_ptr<VectorizedInterpreter> VectorizedInterpreter::create(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& query_infos,
+    Executor* executor) {
+  CHECK(executor);
+  if (ra_exe_unit.input_descs.size() != 1 || query_infos.size() != 1 ||
+      !ra_exe_unit.join_quals.empty() || ra_exe_unit.estimator ||
+      ra_exe_unit.union_all || ra_exe_unit.target_exprs.empty()) {
+    return nullptr;
+  }
+  if (ra_exe_unit.groupby_exprs.size() != 1 || ra_exe_unit.groupby_exprs.front()) {
+    return nullptr;
+  }
+  const auto& input_desc = ra_exe_unit.input_descs.front();
+  const auto table_id = input_desc.getTableId();
+  if (input_desc.getSourceType() != InputSourceType::TABLE || table_id <= 0) {
+    return nullptr;
+  }
+  const auto cat = executor->getCatalog();
+  CHECK(cat);
+  const auto td = cat->getMetadataForTable(table_id, false);
+  if (!td || td->isView || td->storageType == StorageType::FOREIGN_TABLE) {
+    return nullptr;
+  }
+
+  std::vector<ColumnPredicate> predicates;
+  for (const auto& quals : {ra_exe_unit.simple_quals, ra_exe_unit.quals}) {
+    for (const auto& qual : quals) {
+      auto predicate = translate_predicate(qual.get(), table_id, *cat);
+      if (!predicate) {
+        VLOG(1) << "Cannot interpret the filter: " << qual->toString();
+        return nullptr;
+      }
+      predicates.push_back(*predicate);
+    }
+  }
+  std::vector<InterpretedTarget> targets;
+  for (const auto target_expr : ra_exe_unit.target_exprs) {
+    auto target = translate_target(target_expr, table_id, *cat);
+    if (!target) {
+      VLOG(1) << "Cannot interpret the target: " << target_expr->toString();
+      return nullptr;
+    }
+    targets.push_back(*target);
+  }
+  // a non-grouped query either aggregates or projects all of its targets
+  const bool is_agg = targets.front().agg_kind.has_value();
+  for (const auto& target : targets) {
+    if (target.agg_kind.has_value() != is_agg) {
+      return nullptr;
+    }
+  }
+  return std::unique_ptr<VectorizedInterpreter>(new VectorizedInterpreter(
+      ra_exe_unit, query_infos.front(), td, predicates, targets, executor));
+}
+
+bool VectorizedInterpreter::shouldInterpret(
+    const RelAlgExecutionUnit& ra_exe_unit,
+    const std::vector<InputTableInfo>& query_infos,
+    const CompilationOptions& co,
+    const ExecutionOptions& eo) {
+  if (eo.executor_type != ExecutorType::Native || !eo.outer_fragment_indices.empty()) {
+    return false;
+  }
+  if (ra_exe_unit.query_hint.isHintRegistered(QueryHint::kVectorizedInterpreter)) {
+    VLOG(1) << "A user forces the query to run on the vectorized interpreter";
+    return true;
+  }
+  if (!g_enable_vectorized_interpreter || co.device_type != ExecutorDeviceType::CPU ||
+      query_infos.size() != 1) {
+    return false;
+  }
+  return query_infos.front().info.getNumTuples() <= g_vectorized_interpreter_max_rows;
+}
+
+ResultSetPtr VectorizedInterpreter::makeResultSet(const size_t entry_count) const {
+  QueryMemoryDescriptor query_mem_desc(
+      executor_, entry_count, QueryDescriptionType::Projection, false);
+  std::vector<TargetInfo> target_infos;
+  for (const auto& target : targets_) {
+    query_mem_desc.addColSlotInfo({std::make_tuple(target.result_type.get_size(), 8)});
+    target_infos.emplace_back(TargetInfo{false,
+                                         kCOUNT,
+                                         target.result_type,
+                                         SQLTypeInfo(kNULLT, false),
+                                         false,
+                                         false,
+                                         /*is_varlen_projection=*/false});
+  }
+  return std::make_shared<ResultSet>(target_infos,
+                                     ExecutorDeviceType::CPU,
+                                     query_mem_desc,
+                                     executor_->getRowSetMemoryOwner(),
+                                     executor_->getCatalog(),
+                                     executor_->blockSize(),
+                                     executor_->gridSize());
+}
+
+ResultSetPtr VectorizedInterpreter::execute() {
+  auto timer = DEBUG_TIMER(__func__);
+  const auto& cat = *executor_->getCatalog();
+  const auto table_id = td_->tableId;
+  const auto& fragments = query_info_.info.fragments;
+  const std::map<int, const TableFragments*> all_tables_fragments{
+      {table_id, &fragments}};
+  ColumnCacheMap column_cache;
+  ColumnFetcher column_fetcher(executor_, column_cache);
+  std::list<std::shared_ptr<Chunk_NS::Chunk>> chunk_holder;
+  std::list<ChunkIter> chunk_iter_holder;
+  const auto fetch_column = [&](const ColumnDescriptor* cd, const size_t frag_idx) {
+    const auto col_buf =
+        column_fetcher.getOneTableColumnFragment(table_id,
+                                                 frag_idx,
+                                                 cd->columnId,
+                                                 all_tables_fragments,
+                                                 chunk_holder,
+                                                 chunk_iter_holder,
+                                                 Data_Namespace::CPU_LEVEL,
+                                                 0,
+                                                 nullptr);
+    CHECK(col_buf);
+    return col_buf;
+  };
+  const auto deleted_cd = cat.getDeletedColumnIfRowsDeleted(td_);
+  const bool is_agg = isAggregate();
+  const size_t scan_limit = is_agg ? 0 : ra_exe_unit_.scan_limit;
+
+  std::vector<AggState> agg_states(is_agg ? targets_.size() : 0);
+  // selected rows per fragment and the column buffers to gather the projection from
+  std::vector<std::pair<std::vector<uint32_t>, std::vector<const int8_t*>>>
+      projected_fragments;
+  size_t projected_row_count{0};
+  std::vector<uint8_t> mask;
+  for (size_t frag_idx = 0; frag_idx < fragments.size(); ++frag_idx) {
+    const auto& fragment = fragments[frag_idx];
+    const auto row_count = fragment.getNumTuples();
+    if (row_count == 0 || fragment.isEmptyPhysicalFragment()) {
+      continue;
+    }
+    if (scan_limit && projected_row_count >= scan_limit) {
+      break;
+    }
+    mask.assign(row_count, 1);
+    if (deleted_cd) {
+      const auto deleted = fetch_column(deleted_cd, frag_idx);
+      for (size_t i = 0; i < row_count; ++i) {
+        mask[i] &= static_cast<uint8_t>(deleted[i] == 0);
+      }
+    }
+    for (const auto& predicate : predicates_) {
+      dispatch_by_column_type<ApplyPredicate>(predicate.cd->columnType,
+                                              predicate,
+                                              fetch_column(predicate.cd, frag_idx),
+                                              row_count,
+                                              mask.data());
+    }
+    if (is_agg) {
+      for (size_t target_idx = 0; target_idx < targets_.size(); ++target_idx) {
+        const auto& target = targets_[target_idx];
+        auto& state = agg_states[target_idx];
+        if (!target.cd) {
+          // COUNT(*)
+          for (size_t i = 0; i < row_count; ++i) {
+            state.count += mask[i];
+          }
+          continue;
+        }
+        dispatch_by_column_type<AggregateColumn>(target.cd->columnType,
+                                                 target,
+                                                 fetch_column(target.cd, frag_idx),
+                                                 row_count,
+                                                 mask.data(),
+                                                 state);
+        if (state.overflow) {
+          VLOG(1) << "Overflow detected in the vectorized interpreter, fall back to JIT";
+          return nullptr;
+        }
+      }
+      continue;
+    }
+    std::vector<uint32_t> row_ids;
+    for (size_t i = 0; i < row_count; ++i) {
+      if (mask[i]) {
+        row_ids.push_back(i);
+      }
+    }
+    if (scan_limit && projected_row_count + row_ids.size() > scan_limit) {
+      row_ids.resize(scan_limit - projected_row_count);
+    }
+    if (row_ids.empty()) {
+      continue;
+    }
+    std::vector<const int8_t*> col_bufs;
+    for (const auto& target : targets_) {
+      col_bufs.push_back(fetch_column(target.cd, frag_idx));
+    }
+    projected_row_count += row_ids.size();
+    projected_fragments.emplace_back(std::move(row_ids), std::move(col_bufs));
+  }
+
+  ++num_executed_units_;
+  auto rs = makeResultSet(is_agg ? 1 : projected_row_count);
+  if (!is_agg && projected_row_count == 0) {
+    return rs;
+  }
+  auto storage = rs->allocateStorage();
+  auto buff = storage->getUnderlyingBuffer();
+  const auto& query_mem_desc = rs->getQueryMemDesc();
+  const auto row_size = query_mem_desc.getRowSize();
+  std::memset(buff, 0, row_size * query_mem_desc.getEntryCount());
+  if (is_agg) {
+    for (size_t target_idx = 0; target_idx < targets_.size(); ++target_idx) {
+      write_agg_result(buff + query_mem_desc.getColOffInBytes(target_idx),
+                       targets_[target_idx],
+                       agg_states[target_idx]);
+    }
+    return rs;
+  }
+  size_t row_offset{0};
+  for (const auto& [row_ids, col_bufs] : projected_fragments) {
+    for (size_t target_idx = 0; target_idx < targets_.size(); ++target_idx) {
+      dispatch_by_column_type<GatherColumn>(
+          targets_[target_idx].cd->columnType,
+          col_bufs[target_idx],
+          row_ids,
+          buff + row_offset * row_size + query_mem_desc.getColOffInBytes(target_idx),
+          row_size);
+    }
+    row_offset += row_ids.size();
+  }
+  CHECK_EQ(row_offset, projected_row_count);
+  return rs;
+}
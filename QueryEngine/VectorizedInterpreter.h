@@ -0,0 +1,114 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file    VectorizedInterpreter.h
+ * @brief   CPU execution path which evaluates simple execution units with precompiled,
+ *          type-specialized kernels instead of generating and JIT compiling LLVM IR.
+ *
+ * For point lookups and small filters over a single table, the time spent on code
+ * generation and compilation easily exceeds the execution time itself, and every new
+ * literal shape misses the code cache. The interpreter handles the following
+ * execution units and gives up (so the caller falls back to the JIT path) otherwise:
+ *   - a single physical input table without joins, group-by or estimator
+ *   - filters consisting of conjunctions of comparisons between a column and a literal,
+ *     and IS [NOT] NULL checks on a column
+ *   - either projections of columns, or non-grouped COUNT / SUM / MIN / MAX / AVG
+ *     aggregates over columns (no DISTINCT)
+ *   - fixed-width, none-encoded boolean, integer, floating point and datetime columns
+ */
+
+#pragma once
+
+#include "QueryEngine/InputMetadata.h"
+#include "QueryEngine/RelAlgExecutionUnit.h"
+#include "QueryEngine/ResultSet.h"
+
+#include <atomic>
+
+extern bool g_enable_vectorized_interpreter;
+extern size_t g_vectorized_interpreter_max_rows;
+
+class Executor;
+struct CompilationOptions;
+struct ExecutionOptions;
+
+class VectorizedInterpreter {
+ public:
+  // a conjunct of the filter the interpreter can evaluate against a single column
+  struct ColumnPredicate {
+    const ColumnDescriptor* cd;
+    SQLOps op;  // one of comparison operators, kISNULL or kISNOTNULL
+    bool compare_as_fp;
+    int64_t int_rhs;
+    double fp_rhs;
+  };
+
+  // a target the interpreter can compute, the column is null for COUNT(*)
+  struct InterpretedTarget {
+    const ColumnDescriptor* cd;
+    std::optional<SQLAgg> agg_kind;  // std::nullopt for projected column
+    SQLTypeInfo result_type;
+  };
+
+  // returns nullptr if the execution unit has an expression which is not supported by
+  // the interpreter
+  static std::unique_ptr<VectorizedInterpreter> create(
+      const RelAlgExecutionUnit& ra_exe_unit,
+      const std::vector<InputTableInfo>& query_infos,
+      Executor* executor);
+
+  // decides whether we try the interpreter: a user can force it via the query hint,
+  // otherwise we use it for queries reading a small number of rows on CPU if enabled
+  static bool shouldInterpret(const RelAlgExecutionUnit& ra_exe_unit,
+                              const std::vector<InputTableInfo>& query_infos,
+                              const CompilationOptions& co,
+                              const ExecutionOptions& eo);
+
+  // returns nullptr if the interpreter gives up during the execution, i.e., integer
+  // overflow, so the caller can rerun the query via the JIT path to get a proper error
+  ResultSetPtr execute();
+
+  // number of execution units the interpreter has produced results for
+  static size_t getNumExecutedUnits() { return num_executed_units_; }
+
+ private:
+  VectorizedInterpreter(const RelAlgExecutionUnit& ra_exe_unit,
+                        const InputTableInfo& query_info,
+                        const TableDescriptor* td,
+                        std::vector<ColumnPredicate> predicates,
+                        std::vector<InterpretedTarget> targets,
+                        Executor* executor)
+      : ra_exe_unit_(ra_exe_unit)
+      , query_info_(query_info)
+      , td_(td)
+      , predicates_(std::move(predicates))
+      , targets_(std::move(targets))
+      , executor_(executor) {}
+
+  bool isAggregate() const { return targets_.front().agg_kind.has_value(); }
+
+  ResultSetPtr makeResultSet(const size_t entry_count) const;
+
+  const RelAlgExecutionUnit& ra_exe_unit_;
+  const InputTableInfo& query_info_;
+  const TableDescriptor* td_;
+  const std::vector<ColumnPredicate> predicates_;
+  const std::vector<InterpretedTarget> targets_;
+  Executor* executor_;
+
+  static std::atomic<size_t> num_executed_units_;
+};
@@ -26,16 +26,24 @@ class TransientStringLiteralsVisitor : public ScalarExprVisitor<void*> {
   void* visitConstant(const Analyzer::Constant* constant) const override {
     if (constant->get_type_info().is_string() && !constant->get_is_null()) {
       CHECK(constant->get_constval().stringval);
-      sdp_->getOrAddTransient(*constant->get_constval().stringval);
+      literals_.push_back(*constant->get_constval().stringval);
     }
     return nullptr;
   }
 
+  // Adds the string literals of the visited expressions to the proxy in a single batch,
+  // in the order they were visited.
+  void addTransientStrings() const {
+    sdp_->getOrAddTransientBulk(literals_);
+    literals_.clear();
+  }
+
  protected:
   void* defaultResult() const override { return nullptr; }
 
  private:
   mutable StringDictionaryProxy* sdp_;
+  mutable std::vector<std::string> literals_;
 };
 
 class TransientDictIdVisitor : public ScalarExprVisitor<int> {
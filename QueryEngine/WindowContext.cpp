@@ -16,7 +16,12 @@
 
 #include "QueryEngine/WindowContext.h"
 
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
 #include <numeric>
+#include <optional>
 
 #include "QueryEngine/Descriptors/CountDistinctDescriptor.h"
 #include "QueryEngine/Execute.h"
@@ -24,8 +29,18 @@
 #include "QueryEngine/ResultSetBufferAccessors.h"
 #include "QueryEngine/RuntimeFunctions.h"
 #include "QueryEngine/TypePunning.h"
+#include "Shared/DateConverters.h"
 #include "Shared/checked_alloc.h"
 #include "Shared/funcannotations.h"
+#include "Shared/thread_count.h"
+#include "Shared/threading.h"
+
+#ifdef HAVE_TBB
+#include <tbb/parallel_sort.h>
+#endif
+
+// Partitions smaller than this are sorted by a single thread.
+size_t g_parallel_window_partition_sort_min = 1 << 16;
 
 // Non-partitioned version (no join table provided)
 WindowFunctionContext::WindowFunctionContext(
@@ -34,9 +49,11 @@ WindowFunctionContext::WindowFunctionContext(
     const ExecutorDeviceType device_type,
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner)
     : window_func_(window_func)
+    , frame_arg_column_(nullptr)
     , partitions_(nullptr)
     , elem_count_(elem_count)
     , output_(nullptr)
+    , frame_output_(nullptr)
     , partition_start_(nullptr)
     , partition_end_(nullptr)
     , device_type_(device_type)
@@ -60,9 +77,11 @@ WindowFunctionContext::WindowFunctionContext(
     const ExecutorDeviceType device_type,
     std::shared_ptr<RowSetMemoryOwner> row_set_mem_owner)
     : window_func_(window_func)
+    , frame_arg_column_(nullptr)
     , partitions_(partitions)
     , elem_count_(elem_count)
     , output_(nullptr)
+    , frame_output_(nullptr)
     , partition_start_(nullptr)
     , partition_end_(nullptr)
     , device_type_(device_type)
@@ -89,6 +108,15 @@ void WindowFunctionContext::addOrderColumn(
   order_columns_.push_back(column);
 }
 
+void WindowFunctionContext::addFrameArgColumn(
+    const int8_t* column,
+    const Analyzer::ColumnVar* col_var,
+    const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner) {
+  CHECK(window_func_->getFrame());
+  frame_arg_column_owner_ = chunks_owner;
+  frame_arg_column_ = column;
+}
+
 namespace {
 
 // Converts the sorted indices to a mapping from row position to row number.
@@ -302,20 +330,291 @@ void apply_last_value_to_partition(const int32_t* original_indices,
       original_indices, original_indices + partition_size, output_for_partition_buff);
 }
 
+// Decodes the value of a fixed width numeric column at the given row, none for nulls.
+template <class T>
+std::optional<T> decode_frame_value(const int8_t* column,
+                                    const SQLTypeInfo& ti,
+                                    const int64_t row) {
+  if constexpr (std::is_floating_point_v<T>) {
+    const double val = ti.get_type() == kFLOAT
+                           ? reinterpret_cast<const float*>(column)[row]
+                           : reinterpret_cast<const double*>(column)[row];
+    return val == inline_fp_null_val(ti) ? std::nullopt : std::optional<T>(val);
+  } else {
+    int64_t val{0};
+    switch (ti.get_size()) {
+      case 8: {
+        val = reinterpret_cast<const int64_t*>(column)[row];
+        break;
+      }
+      case 4: {
+        val = reinterpret_cast<const int32_t*>(column)[row];
+        break;
+      }
+      case 2: {
+        val = reinterpret_cast<const int16_t*>(column)[row];
+        break;
+      }
+      case 1: {
+        val = column[row];
+        break;
+      }
+      default: {
+        LOG(FATAL) << "Invalid type size: " << ti.get_size();
+      }
+    }
+    if (val == inline_fixed_encoding_null_val(ti)) {
+      return std::nullopt;
+    }
+    return ti.is_date_in_days() ? DateConverters::get_epoch_seconds_from_days(val) : val;
+  }
+}
+
+// Returns the first position in [begin, end) for which the monotone predicate holds.
+template <class Predicate>
+int64_t first_position(int64_t begin, int64_t end, const Predicate& predicate) {
+  while (begin < end) {
+    const auto mid = begin + (end - begin) / 2;
+    if (predicate(mid)) {
+      end = mid;
+    } else {
+      begin = mid + 1;
+    }
+  }
+  return begin;
+}
+
+// Returns true iff key >= base - offset for PRECEDING, key >= base + offset otherwise.
+// Integer keys compare unsigned distances, which don't overflow.
+bool key_reaches(const int64_t key,
+                 const int64_t base,
+                 const uint64_t offset,
+                 const bool preceding) {
+  if (preceding) {
+    return key >= base ||
+           static_cast<uint64_t>(base) - static_cast<uint64_t>(key) <= offset;
+  }
+  return key >= base &&
+         static_cast<uint64_t>(key) - static_cast<uint64_t>(base) >= offset;
+}
+
+bool key_reaches(const double key,
+                 const double base,
+                 const double offset,
+                 const bool preceding) {
+  return preceding ? key >= base - offset : key >= base + offset;
+}
+
+// Returns true iff key > base - offset for PRECEDING, key > base + offset otherwise.
+bool key_exceeds(const int64_t key,
+                 const int64_t base,
+                 const uint64_t offset,
+                 const bool preceding) {
+  if (preceding) {
+    return key >= base ||
+           static_cast<uint64_t>(base) - static_cast<uint64_t>(key) < offset;
+  }
+  return key > base && static_cast<uint64_t>(key) - static_cast<uint64_t>(base) > offset;
+}
+
+bool key_exceeds(const double key,
+                 const double base,
+                 const double offset,
+                 const bool preceding) {
+  return preceding ? key > base - offset : key > base + offset;
+}
+
+// Narrows the RANGE frames of the rows with a non-null order key to the rows whose key
+// is within the offsets of theirs. The keys are in sorted order, negated for descending
+// order so that the non-null ones ascend.
+template <class T, class Offset>
+void apply_range_offsets(const std::vector<std::optional<T>>& keys,
+                         const std::optional<int64_t>& lower,
+                         const std::optional<int64_t>& upper,
+                         const Offset offset_scale,
+                         std::vector<int64_t>& frame_begin,
+                         std::vector<int64_t>& frame_end) {
+  const int64_t key_count = keys.size();
+  int64_t non_null_begin = 0;
+  while (non_null_begin < key_count && !keys[non_null_begin]) {
+    ++non_null_begin;
+  }
+  int64_t non_null_end = key_count;
+  while (non_null_end > non_null_begin && !keys[non_null_end - 1]) {
+    --non_null_end;
+  }
+  const auto offset_of = [offset_scale](const int64_t bound) {
+    const auto magnitude = static_cast<Offset>(bound);
+    return (bound < 0 ? -magnitude : magnitude) * offset_scale;
+  };
+  for (int64_t i = non_null_begin; i < non_null_end; ++i) {
+    const T base = *keys[i];
+    if (lower && *lower) {
+      const auto offset = offset_of(*lower);
+      const bool preceding = *lower < 0;
+      frame_begin[i] = first_position(non_null_begin, non_null_end, [&](const int64_t j) {
+        return key_reaches(*keys[j], base, offset, preceding);
+      });
+    }
+    if (upper && *upper) {
+      const auto offset = offset_of(*upper);
+      const bool preceding = *upper < 0;
+      frame_end[i] = first_position(non_null_begin, non_null_end, [&](const int64_t j) {
+        return key_exceeds(*keys[j], base, offset, preceding);
+      });
+    }
+  }
+}
+
+// Aggregate of the non-null values of a range of rows.
+template <class T>
+struct FrameAggregate {
+  T val;
+  int64_t count;
+};
+
+// Segment tree over the values of a partition in sorted order, which aggregates any
+// frame in logarithmic time after a linear time build.
+template <class T>
+class FrameSegmentTree {
+ public:
+  FrameSegmentTree(const SqlWindowFunctionKind kind,
+                   const std::vector<FrameAggregate<T>>& leaves)
+      : kind_(kind), leaf_count_(leaves.size()), nodes_(2 * leaves.size()) {
+    std::copy(leaves.begin(), leaves.end(), nodes_.begin() + leaf_count_);
+    for (size_t i = leaf_count_ - 1; i > 0; --i) {
+      nodes_[i] = combine(nodes_[2 * i], nodes_[2 * i + 1]);
+    }
+  }
+
+  FrameAggregate<T> identity() const {
+    switch (kind_) {
+      case SqlWindowFunctionKind::MIN: {
+        return {std::numeric_limits<T>::max(), 0};
+      }
+      case SqlWindowFunctionKind::MAX: {
+        return {std::numeric_limits<T>::lowest(), 0};
+      }
+      default: {
+        return {0, 0};
+      }
+    }
+  }
+
+  FrameAggregate<T> combine(const FrameAggregate<T>& lhs,
+                            const FrameAggregate<T>& rhs) const {
+    switch (kind_) {
+      case SqlWindowFunctionKind::MIN: {
+        return {std::min(lhs.val, rhs.val), lhs.count + rhs.count};
+      }
+      case SqlWindowFunctionKind::MAX: {
+        return {std::max(lhs.val, rhs.val), lhs.count + rhs.count};
+      }
+      default: {
+        return {lhs.val + rhs.val, lhs.count + rhs.count};
+      }
+    }
+  }
+
+  // Aggregates the leaves in [begin, end).
+  FrameAggregate<T> query(size_t begin, size_t end) const {
+    auto result = identity();
+    for (begin += leaf_count_, end += leaf_count_; begin < end; begin >>= 1, end >>= 1) {
+      if (begin & 1) {
+        result = combine(result, nodes_[begin++]);
+      }
+      if (end & 1) {
+        result = combine(result, nodes_[--end]);
+      }
+    }
+    return result;
+  }
+
+ private:
+  const SqlWindowFunctionKind kind_;
+  const size_t leaf_count_;
+  std::vector<FrameAggregate<T>> nodes_;
+};
+
+// Aggregates the argument over the frame [frame_begin[i], frame_end[i]) of the row at
+// every sorted position i and writes the results to frame_output in the same order.
+template <class T>
+void fill_frame_aggregates(int8_t* frame_output,
+                           const Analyzer::WindowFunction* window_func,
+                           const int8_t* arg_column,
+                           const std::function<int64_t(const size_t)>& row_at,
+                           const std::vector<int64_t>& frame_begin,
+                           const std::vector<int64_t>& frame_end) {
+  const size_t partition_size = frame_begin.size();
+  const auto kind = window_func->getKind();
+  const auto& args = window_func->getArgs();
+  std::vector<FrameAggregate<T>> leaves(partition_size, FrameAggregate<T>{0, 1});
+  if (!args.empty()) {
+    CHECK(arg_column);
+    const auto& arg_ti = args.front()->get_type_info();
+    for (size_t i = 0; i < partition_size; ++i) {
+      const auto val = decode_frame_value<T>(arg_column, arg_ti, row_at(i));
+      leaves[i] = val ? FrameAggregate<T>{*val, 1} : FrameAggregate<T>{0, 0};
+    }
+  }
+  const FrameSegmentTree<T> segment_tree(kind, leaves);
+  const auto& window_func_ti = window_func->get_type_info();
+  const double avg_scale =
+      !args.empty() && args.front()->get_type_info().is_decimal()
+          ? pow(10, args.front()->get_type_info().get_scale())
+          : 1;
+  auto output_i64 = reinterpret_cast<int64_t*>(frame_output);
+  auto output_double = reinterpret_cast<double*>(may_alias_ptr(frame_output));
+  for (size_t i = 0; i < partition_size; ++i) {
+    const auto aggregate = frame_begin[i] < frame_end[i]
+                               ? segment_tree.query(frame_begin[i], frame_end[i])
+                               : segment_tree.identity();
+    switch (kind) {
+      case SqlWindowFunctionKind::COUNT: {
+        output_i64[i] = aggregate.count;
+        break;
+      }
+      case SqlWindowFunctionKind::AVG: {
+        output_double[i] = aggregate.count ? static_cast<double>(aggregate.val) /
+                                                 avg_scale / aggregate.count
+                                           : inline_fp_null_value<double>();
+        break;
+      }
+      default: {
+        if constexpr (std::is_floating_point_v<T>) {
+          output_double[i] =
+              aggregate.count ? aggregate.val : inline_fp_null_val(window_func_ti);
+        } else {
+          output_i64[i] =
+              aggregate.count ? aggregate.val : inline_int_null_val(window_func_ti);
+        }
+        break;
+      }
+    }
+  }
+}
+
+// Sets a bit of a bitmap whose neighbouring bits are set concurrently, by the threads
+// computing the neighbouring partitions.
+void set_bit_atomic(int8_t* bitmap, const int64_t pos) {
+  static_assert(sizeof(std::atomic<uint8_t>) == sizeof(uint8_t));
+  reinterpret_cast<std::atomic<uint8_t>*>(bitmap + (pos >> 3))
+      ->fetch_or(static_cast<uint8_t>(1 << (pos & 7)), std::memory_order_relaxed);
+}
+
 void index_to_partition_end(
-    const int8_t* partition_end,
+    int8_t* partition_end,
     const size_t off,
     const int64_t* index,
     const size_t index_size,
     const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator) {
-  int64_t partition_end_handle = reinterpret_cast<int64_t>(partition_end);
   for (size_t i = 0; i < index_size; ++i) {
     if (advance_current_rank(comparator, index, i)) {
-      agg_count_distinct_bitmap(&partition_end_handle, off + i - 1, 0);
+      set_bit_atomic(partition_end, off + i - 1);
     }
   }
   CHECK(index_size);
-  agg_count_distinct_bitmap(&partition_end_handle, off + index_size - 1, 0);
+  set_bit_atomic(partition_end, off + index_size - 1);
 }
 
 bool pos_is_set(const int64_t bitset, const int64_t pos) {
@@ -421,7 +720,7 @@ extern "C" RUNTIME_EXPORT void add_window_pending_output(void* pending_output,
 // Returns true iff the aggregate window function requires special multiplicity handling
 // to ensure that peer rows have the same value for the window function.
 bool window_function_requires_peer_handling(const Analyzer::WindowFunction* window_func) {
-  if (!window_function_is_aggregate(window_func->getKind())) {
+  if (!window_function_is_aggregate(window_func->getKind()) || window_func->getFrame()) {
     return false;
   }
   if (window_func->getOrderKeys().empty()) {
@@ -443,81 +742,146 @@ void WindowFunctionContext::compute() {
   output_ = static_cast<int8_t*>(row_set_mem_owner_->allocate(
       elem_count_ * window_function_buffer_element_size(window_func_->getKind()),
       /*thread_idx=*/0));
-  if (window_function_is_aggregate(window_func_->getKind())) {
+  if (window_func_->getFrame()) {
+    frame_output_ = static_cast<int8_t*>(
+        row_set_mem_owner_->allocate(elem_count_ * sizeof(int64_t), /*thread_idx=*/0));
+  } else if (window_function_is_aggregate(window_func_->getKind())) {
     fillPartitionStart();
     if (window_function_requires_peer_handling(window_func_)) {
       fillPartitionEnd();
     }
   }
   std::unique_ptr<int64_t[]> scratchpad(new int64_t[elem_count_]);
-  int64_t off = 0;
+  const auto partition_counts = counts();
   const size_t partition_count{partitionCount()};
+  // Partitions larger than the share of a thread would be the long pole, they are sorted
+  // in parallel one after another. The other partitions are handed out to the threads
+  // largest first, which balances skewed partition sizes.
+  const size_t thread_count = cpu_threads();
+  const size_t parallel_sort_partition_size =
+      std::max(g_parallel_window_partition_sort_min, elem_count_ / thread_count);
+  std::vector<size_t> partitions;
+  size_t partitioned_count{0};
   for (size_t i = 0; i < partition_count; ++i) {
-    auto partition_size = counts()[i];
+    const size_t partition_size = partition_counts[i];
+    partitioned_count += partition_size;
     if (partition_size == 0) {
       continue;
     }
-    auto output_for_partition_buff = scratchpad.get() + offsets()[i];
-    std::iota(output_for_partition_buff,
-              output_for_partition_buff + partition_size,
-              int64_t(0));
-    std::vector<Comparator> comparators;
-    const auto& order_keys = window_func_->getOrderKeys();
-    const auto& collation = window_func_->getCollation();
-    CHECK_EQ(order_keys.size(), collation.size());
-    for (size_t order_column_idx = 0; order_column_idx < order_columns_.size();
-         ++order_column_idx) {
-      auto order_column_buffer = order_columns_[order_column_idx];
-      const auto order_col =
-          dynamic_cast<const Analyzer::ColumnVar*>(order_keys[order_column_idx].get());
-      CHECK(order_col);
-      const auto& order_col_collation = collation[order_column_idx];
-      const auto asc_comparator = makeComparator(order_col,
-                                                 order_column_buffer,
-                                                 payload() + offsets()[i],
-                                                 order_col_collation.nulls_first);
-      auto comparator = asc_comparator;
-      if (order_col_collation.is_desc) {
-        comparator = [asc_comparator](const int64_t lhs, const int64_t rhs) {
-          return asc_comparator(rhs, lhs);
-        };
-      }
-      comparators.push_back(comparator);
-    }
-    const auto col_tuple_comparator = [&comparators](const int64_t lhs,
-                                                     const int64_t rhs) {
-      for (const auto& comparator : comparators) {
-        if (comparator(lhs, rhs)) {
-          return true;
-        }
-      }
-      return false;
-    };
-    std::sort(output_for_partition_buff,
-              output_for_partition_buff + partition_size,
-              col_tuple_comparator);
-    computePartition(output_for_partition_buff,
-                     partition_size,
-                     off,
-                     window_func_,
-                     col_tuple_comparator);
-    if (window_function_is_value(window_func_->getKind()) ||
-        window_function_is_aggregate(window_func_->getKind())) {
-      off += partition_size;
+    if (partition_size >= parallel_sort_partition_size) {
+      sortAndComputePartition(i, scratchpad.get(), /*parallel_sort=*/true);
+    } else {
+      partitions.push_back(i);
     }
   }
   if (window_function_is_value(window_func_->getKind()) ||
       window_function_is_aggregate(window_func_->getKind())) {
-    CHECK_EQ(static_cast<size_t>(off), elem_count_);
+    CHECK_EQ(partitioned_count, elem_count_);
+  }
+  std::sort(partitions.begin(),
+            partitions.end(),
+            [partition_counts](const size_t lhs, const size_t rhs) {
+              return partition_counts[lhs] > partition_counts[rhs];
+            });
+  std::atomic<size_t> next_partition{0};
+  std::mutex error_mutex;
+  std::exception_ptr error;
+  const size_t worker_count = std::min(thread_count, partitions.size());
+  threading::parallel_for(
+      threading::blocked_range<size_t>(0, worker_count),
+      [&](const threading::blocked_range<size_t>& r) {
+        for (size_t worker = r.begin(); worker != r.end(); ++worker) {
+          for (size_t i = next_partition++; i < partitions.size(); i = next_partition++) {
+            try {
+              sortAndComputePartition(
+                  partitions[i], scratchpad.get(), /*parallel_sort=*/false);
+            } catch (...) {
+              std::lock_guard<std::mutex> error_lock(error_mutex);
+              if (!error) {
+                error = std::current_exception();
+              }
+              next_partition = partitions.size();
+            }
+          }
+        }
+      });
+  if (error) {
+    std::rethrow_exception(error);
   }
   auto output_i64 = reinterpret_cast<int64_t*>(output_);
   if (window_function_is_aggregate(window_func_->getKind())) {
     std::copy(scratchpad.get(), scratchpad.get() + elem_count_, output_i64);
   } else {
-    for (size_t i = 0; i < elem_count_; ++i) {
-      output_i64[payload()[i]] = scratchpad[i];
+    const auto partition_row_offsets = payload();
+    threading::parallel_for(threading::blocked_range<size_t>(0, elem_count_),
+                            [&](const threading::blocked_range<size_t>& r) {
+                              for (size_t i = r.begin(); i != r.end(); ++i) {
+                                output_i64[partition_row_offsets[i]] = scratchpad[i];
+                              }
+                            });
+  }
+}
+
+void WindowFunctionContext::sortAndComputePartition(const size_t partition_idx,
+                                                    int64_t* scratchpad,
+                                                    const bool parallel_sort) {
+  const size_t partition_size = counts()[partition_idx];
+  const size_t off = offsets()[partition_idx];
+  auto output_for_partition_buff = scratchpad + off;
+  std::iota(
+      output_for_partition_buff, output_for_partition_buff + partition_size, int64_t(0));
+  std::vector<Comparator> comparators;
+  const auto& order_keys = window_func_->getOrderKeys();
+  const auto& collation = window_func_->getCollation();
+  CHECK_EQ(order_keys.size(), collation.size());
+  for (size_t order_column_idx = 0; order_column_idx < order_columns_.size();
+       ++order_column_idx) {
+    auto order_column_buffer = order_columns_[order_column_idx];
+    const auto order_col =
+        dynamic_cast<const Analyzer::ColumnVar*>(order_keys[order_column_idx].get());
+    CHECK(order_col);
+    const auto& order_col_collation = collation[order_column_idx];
+    const auto asc_comparator = makeComparator(order_col,
+                                               order_column_buffer,
+                                               payload() + off,
+                                               order_col_collation.nulls_first);
+    auto comparator = asc_comparator;
+    if (order_col_collation.is_desc) {
+      comparator = [asc_comparator](const int64_t lhs, const int64_t rhs) {
+        return asc_comparator(rhs, lhs);
+      };
     }
+    comparators.push_back(comparator);
   }
+  // Lexicographic comparison, later order keys only break the ties of earlier ones.
+  const auto col_tuple_comparator = [&comparators](const int64_t lhs, const int64_t rhs) {
+    for (const auto& comparator : comparators) {
+      if (comparator(lhs, rhs)) {
+        return true;
+      }
+      if (comparator(rhs, lhs)) {
+        return false;
+      }
+    }
+    return false;
+  };
+  if (parallel_sort) {
+#ifdef HAVE_TBB
+    tbb::parallel_sort(output_for_partition_buff,
+                       output_for_partition_buff + partition_size,
+                       col_tuple_comparator);
+#else
+    std::sort(output_for_partition_buff,
+              output_for_partition_buff + partition_size,
+              col_tuple_comparator);
+#endif
+  } else {
+    std::sort(output_for_partition_buff,
+              output_for_partition_buff + partition_size,
+              col_tuple_comparator);
+  }
+  computePartition(
+      output_for_partition_buff, partition_size, off, window_func_, col_tuple_comparator);
 }
 
 const Analyzer::WindowFunction* WindowFunctionContext::getWindowFunction() const {
@@ -528,6 +892,11 @@ const int8_t* WindowFunctionContext::output() const {
   return output_;
 }
 
+const int8_t* WindowFunctionContext::frameOutput() const {
+  CHECK(window_func_->getFrame());
+  return frame_output_;
+}
+
 const int64_t* WindowFunctionContext::aggregateState() const {
   CHECK(window_function_is_aggregate(window_func_->getKind()));
   return &aggregate_state_.val;
@@ -749,9 +1118,13 @@ void WindowFunctionContext::computePartition(
     case SqlWindowFunctionKind::SUM:
     case SqlWindowFunctionKind::COUNT: {
       const auto partition_row_offsets = payload() + off;
+      if (window_func->getFrame()) {
+        computeFramePartition(
+            output_for_partition_buff, partition_size, off, comparator);
+      }
       if (window_function_requires_peer_handling(window_func)) {
         index_to_partition_end(
-            partitionEnd(), off, output_for_partition_buff, partition_size, comparator);
+            partition_end_, off, output_for_partition_buff, partition_size, comparator);
       }
       apply_permutation_to_partition(
           output_for_partition_buff, partition_row_offsets, partition_size);
@@ -764,6 +1137,89 @@ void WindowFunctionContext::computePartition(
   }
 }
 
+void WindowFunctionContext::computeFramePartition(
+    const int64_t* output_for_partition_buff,
+    const size_t partition_size,
+    const size_t off,
+    const Comparator& comparator) {
+  const auto& frame = *window_func_->getFrame();
+  const auto partition_row_offsets = payload() + off;
+  const auto row_at = [partition_row_offsets, output_for_partition_buff](const size_t i) {
+    return static_cast<int64_t>(partition_row_offsets[output_for_partition_buff[i]]);
+  };
+  const int64_t size = partition_size;
+  std::vector<int64_t> frame_begin(partition_size);
+  std::vector<int64_t> frame_end(partition_size);
+  if (frame.is_rows) {
+    for (int64_t i = 0; i < size; ++i) {
+      frame_begin[i] = frame.lower ? std::clamp(i + *frame.lower, int64_t(0), size) : 0;
+      frame_end[i] = frame.upper ? std::clamp(i + *frame.upper + 1, int64_t(0), size)
+                                 : size;
+    }
+  } else {
+    // Every bound but UNBOUNDED starts from the peers of the current row, offsets then
+    // move the bounds of the rows with a non-null order key.
+    for (int64_t i = 0; i < size; ++i) {
+      const bool starts_peers =
+          i == 0 || advance_current_rank(comparator, output_for_partition_buff, i);
+      frame_begin[i] = !frame.lower ? 0 : starts_peers ? i : frame_begin[i - 1];
+    }
+    for (int64_t i = size - 1; i >= 0; --i) {
+      const bool ends_peers =
+          i == size - 1 ||
+          advance_current_rank(comparator, output_for_partition_buff, i + 1);
+      frame_end[i] = !frame.upper ? size : ends_peers ? i + 1 : frame_end[i + 1];
+    }
+    if ((frame.lower && *frame.lower) || (frame.upper && *frame.upper)) {
+      CHECK_EQ(order_columns_.size(), size_t(1));
+      const auto order_col =
+          dynamic_cast<const Analyzer::ColumnVar*>(window_func_->getOrderKeys()[0].get());
+      CHECK(order_col);
+      const auto& order_ti = order_col->get_type_info();
+      const bool is_desc = window_func_->getCollation()[0].is_desc;
+      if (order_ti.is_fp()) {
+        std::vector<std::optional<double>> keys(partition_size);
+        for (int64_t i = 0; i < size; ++i) {
+          keys[i] = decode_frame_value<double>(order_columns_[0], order_ti, row_at(i));
+          if (keys[i] && is_desc) {
+            keys[i] = -*keys[i];
+          }
+        }
+        apply_range_offsets(keys, frame.lower, frame.upper, 1.0, frame_begin, frame_end);
+      } else {
+        std::vector<std::optional<int64_t>> keys(partition_size);
+        for (int64_t i = 0; i < size; ++i) {
+          keys[i] = decode_frame_value<int64_t>(order_columns_[0], order_ti, row_at(i));
+          if (keys[i] && is_desc) {
+            keys[i] = -*keys[i];
+          }
+        }
+        const auto offset_scale =
+            order_ti.is_decimal() ? exp_to_scale(order_ti.get_scale()) : uint64_t(1);
+        apply_range_offsets(
+            keys, frame.lower, frame.upper, offset_scale, frame_begin, frame_end);
+      }
+    }
+  }
+  const auto& args = window_func_->getArgs();
+  auto frame_output_for_partition = frame_output_ + off * sizeof(int64_t);
+  if (!args.empty() && args.front()->get_type_info().is_fp()) {
+    fill_frame_aggregates<double>(frame_output_for_partition,
+                                  window_func_,
+                                  frame_arg_column_,
+                                  row_at,
+                                  frame_begin,
+                                  frame_end);
+  } else {
+    fill_frame_aggregates<int64_t>(frame_output_for_partition,
+                                   window_func_,
+                                   frame_arg_column_,
+                                   row_at,
+                                   frame_begin,
+                                   frame_end);
+  }
+}
+
 void WindowFunctionContext::fillPartitionStart() {
   CountDistinctDescriptor partition_start_bitmap{CountDistinctImplType::Bitmap,
                                                  0,
@@ -89,6 +89,13 @@ class WindowFunctionContext {
                       const Analyzer::ColumnVar* col_var,
                       const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner);
 
+  // Adds the buffer of the column argument of an aggregate with an explicit frame and
+  // keeps ownership of it.
+  void addFrameArgColumn(
+      const int8_t* column,
+      const Analyzer::ColumnVar* col_var,
+      const std::vector<std::shared_ptr<Chunk_NS::Chunk>>& chunks_owner);
+
   // Computes the window function result to be used during the actual projection query.
   void compute();
 
@@ -98,6 +105,10 @@ class WindowFunctionContext {
   // Returns a pointer to the output buffer of the window function result.
   const int8_t* output() const;
 
+  // Returns a pointer to the values of an aggregate with an explicit frame, in iteration
+  // order. Integer aggregates and counts are 64-bit integers, the others doubles.
+  const int8_t* frameOutput() const;
+
   // Returns a pointer to the value field of the aggregation state.
   const int64_t* aggregateState() const;
 
@@ -132,6 +143,12 @@ class WindowFunctionContext {
                                    const int32_t* partition_indices,
                                    const bool nulls_first);
 
+  // Sorts the partition at the given index of the hash table into its range of the
+  // scratchpad, with a parallel sort if requested, and computes the window function.
+  void sortAndComputePartition(const size_t partition_idx,
+                               int64_t* scratchpad,
+                               const bool parallel_sort);
+
   void computePartition(
       int64_t* output_for_partition_buff,
       const size_t partition_size,
@@ -139,6 +156,13 @@ class WindowFunctionContext {
       const Analyzer::WindowFunction* window_func,
       const std::function<bool(const int64_t lhs, const int64_t rhs)>& comparator);
 
+  // Computes the aggregate over the explicit frame of every row of the partition, given
+  // its sorted indices.
+  void computeFramePartition(const int64_t* output_for_partition_buff,
+                             const size_t partition_size,
+                             const size_t off,
+                             const Comparator& comparator);
+
   void fillPartitionStart();
 
   void fillPartitionEnd();
@@ -156,12 +180,18 @@ class WindowFunctionContext {
   std::vector<std::vector<std::shared_ptr<Chunk_NS::Chunk>>> order_columns_owner_;
   // Order column buffers.
   std::vector<const int8_t*> order_columns_;
+  // Keeps ownership of the argument column of an aggregate with an explicit frame.
+  std::vector<std::shared_ptr<Chunk_NS::Chunk>> frame_arg_column_owner_;
+  // Argument column buffer of an aggregate with an explicit frame, null for COUNT(*).
+  const int8_t* frame_arg_column_;
   // Hash table which contains the partitions specified by the window.
   std::shared_ptr<HashJoin> partitions_;
   // The number of elements in the table.
   size_t elem_count_;
   // The output of the window function.
   int8_t* output_;
+  // The aggregate over the explicit frame of every row, in iteration order.
+  int8_t* frame_output_;
   // Markers for partition start used to reinitialize state for aggregate window
   // functions.
   int8_t* partition_start_;
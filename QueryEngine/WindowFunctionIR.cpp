@@ -59,6 +59,9 @@ llvm::Value* Executor::codegenWindowFunction(const size_t target_index,
     case SqlWindowFunctionKind::MAX:
     case SqlWindowFunctionKind::SUM:
     case SqlWindowFunctionKind::COUNT: {
+      if (window_func->getFrame()) {
+        return codegenWindowFrameAggregate();
+      }
       return codegenWindowFunctionAggregate(co);
     }
     default: {
@@ -164,6 +167,31 @@ llvm::Value* Executor::codegenWindowFunctionAggregate(const CompilationOptions&
   return codegenWindowFunctionAggregateCalls(aggregate_state, co);
 }
 
+llvm::Value* Executor::codegenWindowFrameAggregate() {
+  AUTOMATIC_IR_METADATA(cgen_state_.get());
+  const auto window_func_context =
+      WindowProjectNodeContext::getActiveWindowFunctionContext(this);
+  const auto window_func = window_func_context->getWindowFunction();
+  const auto window_func_ti = get_adjusted_window_type_info(window_func);
+  CodeGenerator code_generator(this);
+  const auto frame_output = cgen_state_->llInt(
+      reinterpret_cast<const int64_t>(window_func_context->frameOutput()));
+  // The values are in iteration order, the same as the positions of the rows.
+  if (window_func->getKind() == SqlWindowFunctionKind::COUNT ||
+      (window_func->getKind() != SqlWindowFunctionKind::AVG && !window_func_ti.is_fp())) {
+    return cgen_state_->emitCall("row_number_window_func",
+                                 {frame_output, code_generator.posArg(nullptr)});
+  }
+  const auto frame_val = cgen_state_->emitCall(
+      "percent_window_func", {frame_output, code_generator.posArg(nullptr)});
+  if (window_func->getKind() != SqlWindowFunctionKind::AVG &&
+      window_func_ti.get_type() == kFLOAT) {
+    return cgen_state_->ir_builder_.CreateFPTrunc(
+        frame_val, llvm::Type::getFloatTy(cgen_state_->context_));
+  }
+  return frame_val;
+}
+
 llvm::BasicBlock* Executor::codegenWindowResetStateControlFlow() {
   AUTOMATIC_IR_METADATA(cgen_state_.get());
   const auto window_func_context =
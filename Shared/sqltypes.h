@@ -908,7 +908,7 @@ class SQLTypeInfo {
             return comp_param / 8;
           case kENCODING_RL:
           case kENCODING_DIFF:
-            break;
+            return sizeof(int16_t);
           default:
             assert(false);
         }
@@ -923,7 +923,7 @@ class SQLTypeInfo {
             return comp_param / 8;
           case kENCODING_RL:
           case kENCODING_DIFF:
-            break;
+            return sizeof(int32_t);
           default:
             assert(false);
         }
@@ -939,7 +939,7 @@ class SQLTypeInfo {
             return comp_param / 8;
           case kENCODING_RL:
           case kENCODING_DIFF:
-            break;
+            return sizeof(int64_t);
           default:
             assert(false);
         }
@@ -987,6 +987,7 @@ class SQLTypeInfo {
             return comp_param / 8;
           case kENCODING_RL:
           case kENCODING_DIFF:
+            return sizeof(int64_t);
           case kENCODING_SPARSE:
             assert(false);
             break;
@@ -1048,7 +1049,8 @@ int64_t convert_decimal_value_to_scale(const int64_t decimal_value,
 
 inline SQLTypeInfo get_logical_type_info(const SQLTypeInfo& type_info) {
   EncodingType encoding = type_info.get_compression();
-  if (encoding == kENCODING_DATE_IN_DAYS ||
+  if (encoding == kENCODING_DATE_IN_DAYS || encoding == kENCODING_RL ||
+      encoding == kENCODING_DIFF ||
       (encoding == kENCODING_FIXED && type_info.get_type() != kARRAY)) {
     encoding = kENCODING_NONE;
   }
@@ -1072,6 +1074,20 @@ inline SQLTypeInfo get_nullable_logical_type_info(const SQLTypeInfo& type_info)
   return get_nullable_type_info(nullable_type_info);
 }
 
+// Run length and differential encodings only apply to the chunks on disk, the chunks are
+// decoded into the plain fixed width layout when they're loaded into memory. They save
+// disk space and disk reads, not memory or scan bandwidth.
+inline SQLTypeInfo get_in_memory_type_info(const SQLTypeInfo& type_info) {
+  if (type_info.get_compression() != kENCODING_RL &&
+      type_info.get_compression() != kENCODING_DIFF) {
+    return type_info;
+  }
+  SQLTypeInfo in_memory_type_info = type_info;
+  in_memory_type_info.set_compression(kENCODING_NONE);
+  in_memory_type_info.set_comp_param(0);
+  return in_memory_type_info;
+}
+
 using StringOffsetT = int32_t;
 using ArrayOffsetT = int32_t;
 
@@ -19,12 +19,17 @@
 #include <tbb/parallel_for.h>
 #include <boost/filesystem/operations.hpp>
 #include <boost/filesystem/path.hpp>
+#include <boost/regex.hpp>
 #include <boost/sort/spreadsort/string_sort.hpp>
 #include <future>
 #include <iostream>
 #include <string_view>
 #include <thread>
 
+#ifdef __x86_64__
+#include <immintrin.h>
+#endif
+
 // TODO(adb): fixup
 #ifdef _MSC_VER
 #include <fcntl.h>
@@ -37,7 +42,6 @@
 #include "Shared/sqltypes.h"
 #include "Shared/thread_count.h"
 #include "StringDictionaryClient.h"
-#include "Utils/Regexp.h"
 #include "Utils/StringLike.h"
 
 #include "LeafHostInfo.h"
@@ -88,6 +92,8 @@ string_dict_hash_t hash_string(const std::string_view& str) {
 }  // namespace
 
 bool g_enable_stringdict_parallel{false};
+size_t g_string_dictionary_pattern_cache_entries{256};
+bool g_enable_stringdict_trigram_index{false};
 constexpr int32_t StringDictionary::INVALID_STR_ID;
 constexpr size_t StringDictionary::MAX_STRLEN;
 constexpr size_t StringDictionary::MAX_STRCOUNT;
@@ -135,6 +141,12 @@ StringDictionary::StringDictionary(const std::string& folder,
   if (offset_file_size_ == 0) {
     addOffsetCapacity();
   }
+  if (g_enable_stringdict_trigram_index) {
+    trigram_index_ = std::make_unique<TrigramIndex>(
+        isTemp_ ? std::string()
+                : (boost::filesystem::path(folder) / "DictTrigrams").string(),
+        recover);
+  }
   if (!isTemp_) {  // we never mmap or recover temp dictionaries
     payload_map_ =
         reinterpret_cast<char*>(omnisci::checked_mmap(payload_fd_, payload_file_size_));
@@ -162,6 +174,9 @@ StringDictionary::StringDictionary(const std::string& folder,
       // Bail early if we know we don't have strings to add (i.e. a new or empty
       // dictionary)
       if (str_count == 0) {
+        if (trigram_index_) {
+          trigram_index_->clear();
+        }
         return;
       }
 
@@ -201,6 +216,7 @@ StringDictionary::StringDictionary(const std::string& folder,
       if (dictionary_futures.size() != 0) {
         processDictionaryFutures(dictionary_futures);
       }
+      updateTrigramIndex();
       VLOG(1) << "Opened string dictionary " << folder << " # Strings: " << str_count_
               << " Hash table size: " << string_id_string_dict_hash_table_.size()
               << " Fill rate: "
@@ -413,6 +429,7 @@ void StringDictionary::getOrAddBulk(const std::vector<String>& input_strings,
   }
   const size_t num_strings_added = str_count_ - initial_str_count;
   if (num_strings_added > 0) {
+    updateTrigramIndex();
     invalidateInvertedIndex();
   }
 }
@@ -497,6 +514,7 @@ void StringDictionary::getOrAddBulkParallel(const std::vector<String>& input_str
   const size_t num_strings_added = shadow_str_count - str_count_;
   str_count_ = shadow_str_count;
   if (num_strings_added > 0) {
+    updateTrigramIndex();
     invalidateInvertedIndex();
   }
 }
@@ -566,6 +584,14 @@ int32_t StringDictionary::getIdOfString(const std::string& str) const {
   return getUnlocked(str);
 }
 
+void StringDictionary::getIdsOfStrings(const std::vector<std::string>& strings,
+                                       int32_t* ids) const {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  for (size_t i = 0; i < strings.size(); ++i) {
+    ids[i] = client_ ? client_->get(strings[i]) : getUnlocked(strings[i]);
+  }
+}
+
 int32_t StringDictionary::getUnlocked(const std::string& str) const noexcept {
   const string_dict_hash_t hash = hash_string(str);
   auto str_id = string_id_string_dict_hash_table_[computeBucket(
@@ -607,28 +633,334 @@ size_t StringDictionary::storageEntryCount() const {
 
 namespace {
 
-bool is_like(const std::string& str,
+bool is_like(const std::string_view str,
              const std::string& pattern,
              const bool icase,
              const bool is_simple,
              const char escape) {
   return icase
              ? (is_simple ? string_ilike_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_ilike(str.c_str(),
+                                str.data(), str.size(), pattern.c_str(), pattern.size())
+                          : string_ilike(str.data(),
                                          str.size(),
                                          pattern.c_str(),
                                          pattern.size(),
                                          escape))
              : (is_simple ? string_like_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_like(str.c_str(),
+                                str.data(), str.size(), pattern.c_str(), pattern.size())
+                          : string_like(str.data(),
                                         str.size(),
                                         pattern.c_str(),
                                         pattern.size(),
                                         escape));
 }
 
+// Number of dictionary entries a single task of the LIKE and REGEXP scans matches.
+constexpr size_t kPatternScanBlockSize{1 << 16};
+
+// Matches the candidate ids, or all the ids below generation when there are no
+// candidates, in parallel blocks and returns the matching ids in ascending order.
+template <typename MATCHES>
+std::vector<int32_t> scan_string_ids(const size_t generation,
+                                     const std::vector<int32_t>* candidates,
+                                     MATCHES matches) {
+  const size_t id_count = candidates ? candidates->size() : generation;
+  const size_t block_count = (id_count + kPatternScanBlockSize - 1) /
+                             kPatternScanBlockSize;
+  std::vector<std::vector<int32_t>> block_results(block_count);
+  tbb::parallel_for(tbb::blocked_range<size_t>(0, block_count, 1),
+                    [&](const tbb::blocked_range<size_t>& r) {
+                      for (size_t block = r.begin(); block != r.end(); ++block) {
+                        const size_t block_end =
+                            std::min(id_count, (block + 1) * kPatternScanBlockSize);
+                        for (size_t i = block * kPatternScanBlockSize; i < block_end;
+                             ++i) {
+                          const size_t string_id = candidates ? (*candidates)[i] : i;
+                          if (matches(string_id)) {
+                            block_results[block].push_back(string_id);
+                          }
+                        }
+                      }
+                    });
+  std::vector<int32_t> result;
+  for (const auto& block_result : block_results) {
+    result.insert(result.end(), block_result.begin(), block_result.end());
+  }
+  return result;
+}
+
+// Runs of literal characters of a LIKE pattern, which every matching string contains.
+std::vector<std::string> like_pattern_literals(const std::string& pattern,
+                                               const char escape) {
+  std::vector<std::string> literals(1);
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    if (pattern[i] == escape) {
+      if (++i == pattern.size()) {
+        break;
+      }
+    } else if (pattern[i] == '%' || pattern[i] == '_') {
+      literals.emplace_back();
+      continue;
+    }
+    literals.back().push_back(pattern[i]);
+  }
+  return literals;
+}
+
+// Runs of literal characters every string matching an extended regular expression
+// contains. Patterns with alternations, groups, escapes or character classes aren't
+// analyzed and yield none.
+std::vector<std::string> regexp_pattern_literals(const std::string& pattern) {
+  if (pattern.find_first_of("|()\\") != std::string::npos) {
+    return {};
+  }
+  std::vector<std::string> literals(1);
+  for (size_t i = 0; i < pattern.size(); ++i) {
+    switch (pattern[i]) {
+      case '*':
+      case '?':
+      case '{':
+        // the character before the quantifier is optional
+        if (!literals.back().empty()) {
+          literals.back().pop_back();
+        }
+        if (pattern[i] == '{') {
+          i = pattern.find('}', i);
+          if (i == std::string::npos) {
+            return {};
+          }
+        }
+        literals.emplace_back();
+        break;
+      case '[': {
+        // skip the bracket expression, a ']' right after '[' or '[^' is a member
+        size_t end = i + 1 < pattern.size() && pattern[i + 1] == '^' ? i + 2 : i + 1;
+        end = pattern.find(']', end + 1);
+        if (end == std::string::npos || pattern.find('[', i + 1) < end) {
+          return {};
+        }
+        i = end;
+        literals.emplace_back();
+        break;
+      }
+      case '.':
+      case '+':
+      case '^':
+      case '$':
+        literals.emplace_back();
+        break;
+      default:
+        literals.back().push_back(pattern[i]);
+    }
+  }
+  return literals;
+}
+
+inline char ascii_lowercase(const char c) {
+  return 'A' <= c && c <= 'Z' ? c - 'A' + 'a' : c;
+}
+
+inline char ascii_uppercase(const char c) {
+  return 'a' <= c && c <= 'z' ? c - 'a' + 'A' : c;
+}
+
+// ILIKE compares the lowercase string to the pattern, lowercased by the parser.
+inline bool equals_literal(const char* str,
+                           const char* literal,
+                           const size_t len,
+                           const bool icase) {
+  if (!icase) {
+    return !memcmp(str, literal, len);
+  }
+  for (size_t i = 0; i < len; ++i) {
+    if (ascii_lowercase(str[i]) != literal[i]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool find_literal_scalar(const char* str,
+                         const size_t str_len,
+                         const std::string& literal,
+                         const bool icase) {
+  if (literal.size() > str_len) {
+    return false;
+  }
+  for (size_t i = 0; i <= str_len - literal.size(); ++i) {
+    if (equals_literal(str + i, literal.data(), literal.size(), icase)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+#ifdef __x86_64__
+
+// Substring search which compares the first and the last character of the literal to
+// a whole register of string positions at once and verifies the remaining characters
+// only at the positions where both matched, see http://0x80.pl/articles/simd-strfind.html
+#define FIND_LITERAL_SIMD(VEC, BYTES, SET1, LOADU, CMPEQ, OR, AND, MOVEMASK)           \
+  const size_t last = literal.size() - 1;                                             \
+  const VEC first_char = SET1(literal.front());                                       \
+  const VEC first_char_upper = SET1(icase ? ascii_uppercase(literal.front())          \
+                                          : literal.front());                          \
+  const VEC last_char = SET1(literal.back());                                         \
+  const VEC last_char_upper = SET1(icase ? ascii_uppercase(literal.back())            \
+                                         : literal.back());                            \
+  const size_t middle_len = last > 1 ? last - 1 : 0;                                  \
+  size_t i = 0;                                                                       \
+  for (; i + last + BYTES <= str_len; i += BYTES) {                                   \
+    const VEC block_first = LOADU(reinterpret_cast<const VEC*>(str + i));             \
+    const VEC block_last = LOADU(reinterpret_cast<const VEC*>(str + i + last));       \
+    uint32_t mask = MOVEMASK(AND(                                                     \
+        OR(CMPEQ(block_first, first_char), CMPEQ(block_first, first_char_upper)),     \
+        OR(CMPEQ(block_last, last_char), CMPEQ(block_last, last_char_upper))));       \
+    while (mask) {                                                                    \
+      const size_t pos = i + __builtin_ctz(mask);                                     \
+      if (equals_literal(str + pos + 1, literal.data() + 1, middle_len, icase)) {     \
+        return true;                                                                  \
+      }                                                                               \
+      mask &= mask - 1;                                                               \
+    }                                                                                 \
+  }                                                                                   \
+  return find_literal_scalar(str + i, str_len - i, literal, icase);
+
+bool find_literal_sse2(const char* str,
+                       const size_t str_len,
+                       const std::string& literal,
+                       const bool icase) {
+  FIND_LITERAL_SIMD(__m128i,
+                    16,
+                    _mm_set1_epi8,
+                    _mm_loadu_si128,
+                    _mm_cmpeq_epi8,
+                    _mm_or_si128,
+                    _mm_and_si128,
+                    _mm_movemask_epi8)
+}
+
+__attribute__((target("avx2"))) bool find_literal_avx2(const char* str,
+                                                       const size_t str_len,
+                                                       const std::string& literal,
+                                                       const bool icase) {
+  FIND_LITERAL_SIMD(__m256i,
+                    32,
+                    _mm256_set1_epi8,
+                    _mm256_loadu_si256,
+                    _mm256_cmpeq_epi8,
+                    _mm256_or_si256,
+                    _mm256_and_si256,
+                    _mm256_movemask_epi8)
+}
+
+#undef FIND_LITERAL_SIMD
+
+#endif  // __x86_64__
+
+bool find_literal(const char* str,
+                  const size_t str_len,
+                  const std::string& literal,
+                  const bool icase) {
+  if (literal.empty()) {
+    return true;
+  }
+  if (literal.size() > str_len) {
+    return false;
+  }
+#ifdef __x86_64__
+  static const bool has_avx2 = __builtin_cpu_supports("avx2");
+  return has_avx2 ? find_literal_avx2(str, str_len, literal, icase)
+                  : find_literal_sse2(str, str_len, literal, icase);
+#else
+  return find_literal_scalar(str, str_len, literal, icase);
+#endif
+}
+
+/**
+ * Evaluates the LIKE patterns made of a literal with '%' at its start, its end or both
+ * (or pre-stripped by the parser for the simple ones) with a substring search or a
+ * comparison, and the other patterns with string_like.
+ */
+class LikeMatcher {
+ public:
+  LikeMatcher(const std::string& pattern,
+              const bool icase,
+              const bool is_simple,
+              const char escape)
+      : pattern_(pattern)
+      , icase_(icase)
+      , is_simple_(is_simple)
+      , escape_(escape)
+      , kind_(Kind::Pattern) {
+    if (is_simple) {
+      kind_ = Kind::Substring;
+      literal_ = pattern;
+      return;
+    }
+    if (escape == '%' || escape == '_') {
+      return;
+    }
+    const auto literal_begin = pattern.find_first_not_of('%');
+    if (literal_begin == std::string::npos) {
+      kind_ = pattern.empty() ? Kind::Equals : Kind::Substring;
+      return;
+    }
+    const auto literal_end = pattern.find_last_not_of('%') + 1;
+    literal_ = pattern.substr(literal_begin, literal_end - literal_begin);
+    for (const char c : literal_) {
+      // A parser-lowercased ILIKE pattern never has uppercase characters, keep the
+      // semantics of string_ilike for the ones which do.
+      if (c == '%' || c == '_' || c == escape || (icase && ascii_lowercase(c) != c)) {
+        return;
+      }
+    }
+    const bool leading_wildcard = literal_begin > 0;
+    const bool trailing_wildcard = literal_end < pattern.size();
+    kind_ = leading_wildcard ? (trailing_wildcard ? Kind::Substring : Kind::Suffix)
+                             : (trailing_wildcard ? Kind::Prefix : Kind::Equals);
+  }
+
+  // Literals every matching string contains.
+  std::vector<std::string> literals() const {
+    return kind_ == Kind::Pattern ? like_pattern_literals(pattern_, escape_)
+                                  : std::vector<std::string>{literal_};
+  }
+
+  bool operator()(const std::string_view str) const {
+    switch (kind_) {
+      case Kind::Equals:
+        return str.size() == literal_.size() &&
+               equals_literal(str.data(), literal_.data(), literal_.size(), icase_);
+      case Kind::Prefix:
+        return str.size() >= literal_.size() &&
+               equals_literal(str.data(), literal_.data(), literal_.size(), icase_);
+      case Kind::Suffix:
+        return str.size() >= literal_.size() &&
+               equals_literal(str.data() + str.size() - literal_.size(),
+                              literal_.data(),
+                              literal_.size(),
+                              icase_);
+      case Kind::Substring:
+        return find_literal(str.data(), str.size(), literal_, icase_);
+      case Kind::Pattern:
+        return is_like(str, pattern_, icase_, is_simple_, escape_);
+    }
+    UNREACHABLE();
+    return false;
+  }
+
+ private:
+  enum class Kind { Equals, Prefix, Suffix, Substring, Pattern };
+
+  const std::string& pattern_;
+  const bool icase_;
+  const bool is_simple_;
+  const char escape_;
+  Kind kind_;
+  std::string literal_;
+};
+
 }  // namespace
 
 std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
@@ -636,51 +968,32 @@ std::vector<int32_t> StringDictionary::getLike(const std::string& pattern,
                                                const bool is_simple,
                                                const char escape,
                                                const size_t generation) const {
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   if (client_) {
     return client_->get_like(pattern, icase, is_simple, escape, generation);
   }
   const auto cache_key = std::make_tuple(pattern, icase, is_simple, escape);
-  const auto it = like_cache_.find(cache_key);
-  if (it != like_cache_.end()) {
-    return it->second;
+  {
+    std::lock_guard<std::mutex> cache_lock(pattern_cache_mutex_);
+    const auto cached_result = like_cache_.get(cache_key);
+    if (cached_result) {
+      return *cached_result;
+    }
   }
-  std::vector<int32_t> result;
-  std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
-  CHECK_GT(worker_count, 0);
-  std::vector<std::vector<int32_t>> worker_results(worker_count);
   CHECK_LE(generation, str_count_);
-  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back([&worker_results,
-                          &pattern,
-                          generation,
-                          icase,
-                          is_simple,
-                          escape,
-                          worker_idx,
-                          worker_count,
-                          this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_like(str, pattern, icase, is_simple, escape)) {
-          worker_results[worker_idx].push_back(string_id);
-        }
-      }
-    });
-  }
-  for (auto& worker : workers) {
-    worker.join();
-  }
-  for (const auto& worker_result : worker_results) {
-    result.insert(result.end(), worker_result.begin(), worker_result.end());
-  }
+  const LikeMatcher matcher(pattern, icase, is_simple, escape);
+  const auto candidates =
+      trigram_index_ ? trigram_index_->getCandidates(matcher.literals(), generation)
+                     : std::nullopt;
+  const auto result = scan_string_ids(generation,
+                                      candidates ? &*candidates : nullptr,
+                                      [&matcher, this](const size_t string_id) {
+                                        return matcher(
+                                            getStringFromStorageFast(string_id));
+                                      });
   // place result into cache for reuse if similar query
-  const auto it_ok = like_cache_.insert(std::make_pair(cache_key, result));
-
-  CHECK(it_ok.second);
-
+  std::lock_guard<std::mutex> cache_lock(pattern_cache_mutex_);
+  like_cache_.put(cache_key, result);
   return result;
 }
 
@@ -895,60 +1208,49 @@ std::vector<int32_t> StringDictionary::getCompare(const std::string& pattern,
   return ret;
 }
 
-namespace {
-
-bool is_regexp_like(const std::string& str,
-                    const std::string& pattern,
-                    const char escape) {
-  return regexp_like(str.c_str(), str.size(), pattern.c_str(), pattern.size(), escape);
-}
-
-}  // namespace
-
 std::vector<int32_t> StringDictionary::getRegexpLike(const std::string& pattern,
                                                      const char escape,
                                                      const size_t generation) const {
-  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   if (client_) {
     return client_->get_regexp_like(pattern, escape, generation);
   }
   const auto cache_key = std::make_pair(pattern, escape);
-  const auto it = regex_cache_.find(cache_key);
-  if (it != regex_cache_.end()) {
-    return it->second;
+  {
+    std::lock_guard<std::mutex> cache_lock(pattern_cache_mutex_);
+    const auto cached_result = regex_cache_.get(cache_key);
+    if (cached_result) {
+      return *cached_result;
+    }
   }
-  std::vector<int32_t> result;
-  std::vector<std::thread> workers;
-  int worker_count = cpu_threads();
-  CHECK_GT(worker_count, 0);
-  std::vector<std::vector<int32_t>> worker_results(worker_count);
   CHECK_LE(generation, str_count_);
-  for (int worker_idx = 0; worker_idx < worker_count; ++worker_idx) {
-    workers.emplace_back([&worker_results,
-                          &pattern,
-                          generation,
-                          escape,
-                          worker_idx,
-                          worker_count,
-                          this]() {
-      for (size_t string_id = worker_idx; string_id < generation;
-           string_id += worker_count) {
-        const auto str = getStringUnlocked(string_id);
-        if (is_regexp_like(str, pattern, escape)) {
-          worker_results[worker_idx].push_back(string_id);
-        }
-      }
-    });
-  }
-  for (auto& worker : workers) {
-    worker.join();
-  }
-  for (const auto& worker_result : worker_results) {
-    result.insert(result.end(), worker_result.begin(), worker_result.end());
-  }
-  const auto it_ok = regex_cache_.insert(std::make_pair(cache_key, result));
-  CHECK(it_ok.second);
-
+  // Unlike regexp_like, which compiles the pattern for every string it matches, compile
+  // it once for the whole scan and share it between the tasks. Errors mean no match, as
+  // they do in regexp_like.
+  std::vector<int32_t> result;
+  try {
+    const boost::regex re(pattern, boost::regex::extended);
+    const auto candidates =
+        trigram_index_ ? trigram_index_->getCandidates(regexp_pattern_literals(pattern),
+                                                       generation)
+                       : std::nullopt;
+    result = scan_string_ids(generation,
+                             candidates ? &*candidates : nullptr,
+                             [&re, this](const size_t string_id) {
+                               const auto str = getStringFromStorageFast(string_id);
+                               try {
+                                 boost::cmatch what;
+                                 return boost::regex_match(
+                                     str.data(), str.data() + str.size(), what, re);
+                               } catch (std::runtime_error&) {
+                                 return false;
+                               }
+                             });
+  } catch (std::runtime_error& error) {
+    VLOG(1) << "Invalid regular expression " << pattern << ": " << error.what();
+  }
+  std::lock_guard<std::mutex> cache_lock(pattern_cache_mutex_);
+  regex_cache_.put(cache_key, result);
   return result;
 }
 
@@ -1098,6 +1400,7 @@ int32_t StringDictionary::getOrAddImpl(const std::string_view& str) noexcept {
       hash_cache_[str_count_] = hash;
     }
     ++str_count_;
+    updateTrigramIndex();
     invalidateInvertedIndex();
   }
   return string_id_string_dict_hash_table_[bucket];
@@ -1370,13 +1673,22 @@ void* StringDictionary::addMemoryCapacity(void* addr,
   return new_addr;
 }
 
-void StringDictionary::invalidateInvertedIndex() noexcept {
-  if (!like_cache_.empty()) {
-    decltype(like_cache_)().swap(like_cache_);
+void StringDictionary::updateTrigramIndex() {
+  if (!trigram_index_) {
+    return;
   }
-  if (!regex_cache_.empty()) {
-    decltype(regex_cache_)().swap(regex_cache_);
+  if (trigram_index_->stringCount() > str_count_) {
+    // the index has strings the dictionary lost with a failed checkpoint, start over
+    trigram_index_->clear();
   }
+  trigram_index_->addStrings(
+      str_count_ - trigram_index_->stringCount(),
+      [this](const size_t string_id) { return getStringFromStorageFast(string_id); });
+}
+
+void StringDictionary::invalidateInvertedIndex() noexcept {
+  like_cache_.clear();
+  regex_cache_.clear();
   if (!equal_cache_.empty()) {
     decltype(equal_cache_)().swap(equal_cache_);
   }
@@ -1403,6 +1715,10 @@ bool StringDictionary::checkpoint() noexcept {
         (omnisci::msync((void*)payload_map_, payload_file_size_, /*async=*/false) == 0);
   ret = ret && (omnisci::fsync(offset_fd_) == 0);
   ret = ret && (omnisci::fsync(payload_fd_) == 0);
+  if (trigram_index_) {
+    mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+    ret = ret && trigram_index_->checkpoint();
+  }
   return ret;
 }
 
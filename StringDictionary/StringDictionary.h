@@ -21,14 +21,21 @@
 #include "DictRef.h"
 #include "DictionaryCache.hpp"
 #include "LeafHostInfo.h"
+#include "LruCache.hpp"
+#include "TrigramIndex.h"
+
+#include <boost/functional/hash.hpp>
 
 #include <future>
 #include <map>
+#include <mutex>
 #include <string>
 #include <tuple>
 #include <vector>
 
 extern bool g_enable_stringdict_parallel;
+extern size_t g_string_dictionary_pattern_cache_entries;
+extern bool g_enable_stringdict_trigram_index;
 
 class StringDictionaryClient;
 
@@ -60,6 +67,7 @@ class StringDictionary {
   void getOrAddBulkArray(const std::vector<std::vector<String>>& string_array_vec,
                          std::vector<std::vector<int32_t>>& ids_array_vec);
   int32_t getIdOfString(const std::string& str) const;
+  void getIdsOfStrings(const std::vector<std::string>& strings, int32_t* ids) const;
   std::string getString(int32_t string_id) const;
   std::pair<char*, size_t> getStringBytes(int32_t string_id) const noexcept;
   size_t storageEntryCount() const;
@@ -193,6 +201,7 @@ class StringDictionary {
   void* addMemoryCapacity(void* addr,
                           size_t& mem_size,
                           const size_t min_capacity_requested = 0) noexcept;
+  void updateTrigramIndex();
   void invalidateInvertedIndex() noexcept;
   std::vector<int32_t> getEquals(std::string pattern,
                                  std::string comp_operator,
@@ -220,12 +229,21 @@ class StringDictionary {
   size_t payload_file_size_;
   size_t payload_file_off_;
   mutable mapd_shared_mutex rw_mutex_;
-  mutable std::map<std::tuple<std::string, bool, bool, char>, std::vector<int32_t>>
-      like_cache_;
-  mutable std::map<std::pair<std::string, char>, std::vector<int32_t>> regex_cache_;
+  // Pattern caches are read and written under the shared lock of rw_mutex_, so they
+  // have their own mutex; invalidating them needs the exclusive lock only.
+  mutable std::mutex pattern_cache_mutex_;
+  mutable LruCache<std::tuple<std::string, bool, bool, char>,
+                   std::vector<int32_t>,
+                   boost::hash<std::tuple<std::string, bool, bool, char>>>
+      like_cache_{g_string_dictionary_pattern_cache_entries};
+  mutable LruCache<std::pair<std::string, char>,
+                   std::vector<int32_t>,
+                   boost::hash<std::pair<std::string, char>>>
+      regex_cache_{g_string_dictionary_pattern_cache_entries};
   mutable std::map<std::string, int32_t> equal_cache_;
   mutable DictionaryCache<std::string, compare_cache_value_t> compare_cache_;
   mutable std::shared_ptr<std::vector<std::string>> strings_cache_;
+  std::unique_ptr<TrigramIndex> trigram_index_;
   std::unique_ptr<StringDictionaryClient> client_;
   std::unique_ptr<StringDictionaryClient> client_no_timeout_;
 
@@ -41,49 +41,69 @@ int32_t truncate_to_generation(const int32_t id, const size_t generation) {
 int32_t StringDictionaryProxy::getOrAddTransient(const std::string& str) {
   mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
   CHECK_GE(generation_, 0);
-  auto transient_id =
-      truncate_to_generation(string_dict_->getIdOfString(str), generation_);
-  if (transient_id != StringDictionary::INVALID_STR_ID) {
-    return transient_id;
-  }
-  const auto it = transient_str_to_int_.find(str);
-  if (it != transient_str_to_int_.end()) {
-    return it->second;
-  }
-  transient_id =
-      -(transient_str_to_int_.size() + 2);  // make sure it's not INVALID_STR_ID
-  {
-    auto it_ok = transient_str_to_int_.insert(std::make_pair(str, transient_id));
-    CHECK(it_ok.second);
+  return getOrAddTransientUnlocked(str, string_dict_->getIdOfString(str));
+}
+
+std::vector<int32_t> StringDictionaryProxy::getOrAddTransientBulk(
+    const std::vector<std::string>& strings) {
+  mapd_lock_guard<mapd_shared_mutex> write_lock(rw_mutex_);
+  CHECK_GE(generation_, 0);
+  std::vector<int32_t> string_ids(strings.size());
+  string_dict_->getIdsOfStrings(strings, string_ids.data());
+  for (size_t i = 0; i < strings.size(); ++i) {
+    string_ids[i] = getOrAddTransientUnlocked(strings[i], string_ids[i]);
   }
-  {
-    auto it_ok = transient_int_to_str_.insert(std::make_pair(transient_id, str));
-    CHECK(it_ok.second);
+  return string_ids;
+}
+
+int32_t StringDictionaryProxy::getOrAddTransientUnlocked(const std::string& str,
+                                                         const int32_t dict_id) {
+  const auto string_id = truncate_to_generation(dict_id, generation_);
+  if (string_id != StringDictionary::INVALID_STR_ID) {
+    return string_id;
   }
-  return transient_id;
+  return transientIndexToId(transient_strings_.getOrAdd(str));
 }
 
 int32_t StringDictionaryProxy::getIdOfString(const std::string& str) const {
   mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   CHECK_GE(generation_, 0);
   auto str_id = truncate_to_generation(string_dict_->getIdOfString(str), generation_);
-  if (str_id != StringDictionary::INVALID_STR_ID || transient_str_to_int_.empty()) {
+  if (str_id != StringDictionary::INVALID_STR_ID || transient_strings_.empty()) {
     return str_id;
   }
-  auto it = transient_str_to_int_.find(str);
-  return it != transient_str_to_int_.end() ? it->second
-                                           : StringDictionary::INVALID_STR_ID;
+  const auto index = transient_strings_.find(str);
+  return index != TransientStringMap::NOT_FOUND ? transientIndexToId(index)
+                                                : StringDictionary::INVALID_STR_ID;
+}
+
+std::vector<int32_t> StringDictionaryProxy::getIdsOfStrings(
+    const std::vector<std::string>& strings) const {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  CHECK_GE(generation_, 0);
+  std::vector<int32_t> string_ids(strings.size());
+  string_dict_->getIdsOfStrings(strings, string_ids.data());
+  for (size_t i = 0; i < strings.size(); ++i) {
+    string_ids[i] = truncate_to_generation(string_ids[i], generation_);
+    if (string_ids[i] == StringDictionary::INVALID_STR_ID) {
+      const auto index = transient_strings_.find(strings[i]);
+      if (index != TransientStringMap::NOT_FOUND) {
+        string_ids[i] = transientIndexToId(index);
+      }
+    }
+  }
+  return string_ids;
 }
 
 int32_t StringDictionaryProxy::getIdOfStringNoGeneration(const std::string& str) const {
   mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
   auto str_id = string_dict_->getIdOfString(str);
-  if (str_id != StringDictionary::INVALID_STR_ID || transient_str_to_int_.empty()) {
+  if (str_id != StringDictionary::INVALID_STR_ID || transient_strings_.empty()) {
     return str_id;
   }
-  auto it = transient_str_to_int_.find(str);
-  return it != transient_str_to_int_.end() ? it->second
-                                           : StringDictionary::INVALID_STR_ID;
+  const auto index = transient_strings_.find(str);
+  return index != TransientStringMap::NOT_FOUND ? transientIndexToId(index)
+                                                : StringDictionary::INVALID_STR_ID;
 }
 
 std::string StringDictionaryProxy::getString(int32_t string_id) const {
@@ -95,29 +115,38 @@ std::string StringDictionaryProxy::getString(int32_t string_id) const {
     return string_dict_->getString(string_id);
   }
   CHECK_NE(StringDictionary::INVALID_STR_ID, string_id);
-  auto it = transient_int_to_str_.find(string_id);
-  CHECK(it != transient_int_to_str_.end());
-  return it->second;
+  const auto index = transientIdToIndex(string_id);
+  CHECK_LT(static_cast<size_t>(index), transient_strings_.size());
+  return std::string(transient_strings_[index]);
+}
+
+const std::map<int32_t, std::string> StringDictionaryProxy::getTransientMapping() const {
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  std::map<int32_t, std::string> transient_mapping;
+  for (size_t index = 0; index < transient_strings_.size(); ++index) {
+    transient_mapping.emplace(transientIndexToId(index), transient_strings_[index]);
+  }
+  return transient_mapping;
 }
 
 namespace {
 
-bool is_like(const std::string& str,
+bool is_like(const std::string_view str,
              const std::string& pattern,
              const bool icase,
              const bool is_simple,
              const char escape) {
   return icase
              ? (is_simple ? string_ilike_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_ilike(str.c_str(),
+                                str.data(), str.size(), pattern.c_str(), pattern.size())
+                          : string_ilike(str.data(),
                                          str.size(),
                                          pattern.c_str(),
                                          pattern.size(),
                                          escape))
              : (is_simple ? string_like_simple(
-                                str.c_str(), str.size(), pattern.c_str(), pattern.size())
-                          : string_like(str.c_str(),
+                                str.data(), str.size(), pattern.c_str(), pattern.size())
+                          : string_like(str.data(),
                                         str.size(),
                                         pattern.c_str(),
                                         pattern.size(),
@@ -132,10 +161,12 @@ std::vector<int32_t> StringDictionaryProxy::getLike(const std::string& pattern,
                                                     const char escape) const {
   CHECK_GE(generation_, 0);
   auto result = string_dict_->getLike(pattern, icase, is_simple, escape, generation_);
-  for (const auto& kv : transient_int_to_str_) {
-    const auto str = getString(kv.first);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  const auto& transient_strings = transient_strings_.strings();
+  for (size_t index = 0; index < transient_strings.size(); ++index) {
+    const auto str = transient_strings[index];
     if (is_like(str, pattern, icase, is_simple, escape)) {
-      result.push_back(kv.first);
+      result.push_back(transientIndexToId(index));
     }
   }
   return result;
@@ -143,7 +174,7 @@ std::vector<int32_t> StringDictionaryProxy::getLike(const std::string& pattern,
 
 namespace {
 
-bool do_compare(const std::string& str,
+bool do_compare(const std::string_view str,
                 const std::string& pattern,
                 const std::string& comp_operator) {
   int res = str.compare(pattern);
@@ -170,10 +201,12 @@ std::vector<int32_t> StringDictionaryProxy::getCompare(
     const std::string& comp_operator) const {
   CHECK_GE(generation_, 0);
   auto result = string_dict_->getCompare(pattern, comp_operator, generation_);
-  for (const auto& kv : transient_int_to_str_) {
-    const auto str = getString(kv.first);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  const auto& transient_strings = transient_strings_.strings();
+  for (size_t index = 0; index < transient_strings.size(); ++index) {
+    const auto str = transient_strings[index];
     if (do_compare(str, pattern, comp_operator)) {
-      result.push_back(kv.first);
+      result.push_back(transientIndexToId(index));
     }
   }
   return result;
@@ -181,10 +214,10 @@ std::vector<int32_t> StringDictionaryProxy::getCompare(
 
 namespace {
 
-bool is_regexp_like(const std::string& str,
+bool is_regexp_like(const std::string_view str,
                     const std::string& pattern,
                     const char escape) {
-  return regexp_like(str.c_str(), str.size(), pattern.c_str(), pattern.size(), escape);
+  return regexp_like(str.data(), str.size(), pattern.c_str(), pattern.size(), escape);
 }
 
 }  // namespace
@@ -193,10 +226,12 @@ std::vector<int32_t> StringDictionaryProxy::getRegexpLike(const std::string& pat
                                                           const char escape) const {
   CHECK_GE(generation_, 0);
   auto result = string_dict_->getRegexpLike(pattern, escape, generation_);
-  for (const auto& kv : transient_int_to_str_) {
-    const auto str = getString(kv.first);
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  const auto& transient_strings = transient_strings_.strings();
+  for (size_t index = 0; index < transient_strings.size(); ++index) {
+    const auto str = transient_strings[index];
     if (is_regexp_like(str, pattern, escape)) {
-      result.push_back(kv.first);
+      result.push_back(transientIndexToId(index));
     }
   }
   return result;
@@ -212,9 +247,13 @@ std::pair<const char*, size_t> StringDictionaryProxy::getStringBytes(
     return string_dict_.get()->getStringBytes(string_id);
   }
   CHECK_NE(StringDictionary::INVALID_STR_ID, string_id);
-  auto it = transient_int_to_str_.find(string_id);
-  CHECK(it != transient_int_to_str_.end());
-  return std::make_pair(it->second.c_str(), it->second.size());
+  // the views of the transient strings move when getOrAddTransient grows them, the bytes
+  // they point to don't
+  mapd_shared_lock<mapd_shared_mutex> read_lock(rw_mutex_);
+  const auto index = transientIdToIndex(string_id);
+  CHECK_LT(static_cast<size_t>(index), transient_strings_.size());
+  const auto str = transient_strings_[index];
+  return std::make_pair(str.data(), str.size());
 }
 
 size_t StringDictionaryProxy::storageEntryCount() const {
@@ -244,12 +283,7 @@ bool operator==(const StringDictionaryProxy& sdp1, const StringDictionaryProxy&
   if (sdp1.string_dict_id_ != sdp2.string_dict_id_) {
     return false;
   }
-  if (sdp1.transient_int_to_str_.size() != sdp2.transient_int_to_str_.size()) {
-    return false;
-  }
-  return std::equal(sdp1.transient_int_to_str_.begin(),
-                    sdp1.transient_int_to_str_.end(),
-                    sdp2.transient_int_to_str_.begin());
+  return sdp1.transient_strings_.strings() == sdp2.transient_strings_.strings();
 }
 
 bool operator!=(const StringDictionaryProxy& sdp1, const StringDictionaryProxy& sdp2) {
@@ -19,6 +19,7 @@
 
 #include "../Shared/mapd_shared_mutex.h"
 #include "StringDictionary.h"
+#include "TransientStringMap.h"
 
 #include <map>
 #include <string>
@@ -41,9 +42,13 @@ class StringDictionaryProxy {
   StringDictionary* getDictionary() noexcept;
   int64_t getGeneration() const noexcept;
   int32_t getOrAddTransient(const std::string& str);
+  // Same ids as getOrAddTransient of every string in order, under a single lock.
+  std::vector<int32_t> getOrAddTransientBulk(const std::vector<std::string>& strings);
   int32_t getIdOfString(const std::string& str) const;
   int32_t getIdOfStringNoGeneration(
       const std::string& str) const;  // disregard generation, only used by QueryRenderer
+  // Same ids as getIdOfString of every string in order, under a single lock.
+  std::vector<int32_t> getIdsOfStrings(const std::vector<std::string>& strings) const;
   std::string getString(int32_t string_id) const;
   std::pair<const char*, size_t> getStringBytes(int32_t string_id) const noexcept;
   size_t storageEntryCount() const;
@@ -59,15 +64,19 @@ class StringDictionaryProxy {
 
   std::vector<int32_t> getRegexpLike(const std::string& pattern, const char escape) const;
 
-  const std::map<int32_t, std::string> getTransientMapping() const {
-    return transient_int_to_str_;
-  }
+  const std::map<int32_t, std::string> getTransientMapping() const;
 
  private:
+  // Transient strings have negative ids, -2 for the first one, so that none is
+  // INVALID_STR_ID.
+  static int32_t transientIndexToId(const int32_t index) { return -(index + 2); }
+  static int32_t transientIdToIndex(const int32_t id) { return -id - 2; }
+
+  int32_t getOrAddTransientUnlocked(const std::string& str, const int32_t dict_id);
+
   std::shared_ptr<StringDictionary> string_dict_;
   const int32_t string_dict_id_;
-  std::map<int32_t, std::string> transient_int_to_str_;
-  std::map<std::string, int32_t> transient_str_to_int_;
+  TransientStringMap transient_strings_;
   int64_t generation_;
   mutable mapd_shared_mutex rw_mutex_;
 };
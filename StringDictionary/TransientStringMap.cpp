@@ -0,0 +1,94 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StringDictionary/TransientStringMap.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+namespace {
+
+constexpr size_t kArenaBlockSize{1 << 16};
+
+constexpr size_t kMinTableSize{64};
+
+}  // namespace
+
+int32_t TransientStringMap::find(const std::string_view str) const {
+  if (slots_.empty()) {
+    return NOT_FOUND;
+  }
+  return slots_[findSlot(str, std::hash<std::string_view>{}(str))];
+}
+
+int32_t TransientStringMap::getOrAdd(const std::string_view str) {
+  // keep the table at most half full
+  if (2 * (strings_.size() + 1) > slots_.size()) {
+    growTable();
+  }
+  const auto hash = std::hash<std::string_view>{}(str);
+  const auto slot = findSlot(str, hash);
+  if (slots_[slot] != NOT_FOUND) {
+    return slots_[slot];
+  }
+  const auto index = static_cast<int32_t>(strings_.size());
+  strings_.push_back(copyToArena(str));
+  hashes_.push_back(hash);
+  slots_[slot] = index;
+  return index;
+}
+
+size_t TransientStringMap::findSlot(const std::string_view str, const size_t hash) const {
+  const size_t mask = slots_.size() - 1;
+  for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+    const auto index = slots_[slot];
+    if (index == NOT_FOUND || (hashes_[index] == hash && strings_[index] == str)) {
+      return slot;
+    }
+  }
+}
+
+std::string_view TransientStringMap::copyToArena(const std::string_view str) {
+  if (str.empty()) {
+    // a valid pointer for empty strings too, callers check it
+    return std::string_view("", 0);
+  }
+  if (str.size() > arena_free_size_) {
+    const auto block_size = std::max(kArenaBlockSize, str.size());
+    arena_blocks_.emplace_back(new char[block_size]);
+    arena_free_ = arena_blocks_.back().get();
+    arena_free_size_ = block_size;
+  }
+  memcpy(arena_free_, str.data(), str.size());
+  const std::string_view copy(arena_free_, str.size());
+  arena_free_ += str.size();
+  arena_free_size_ -= str.size();
+  return copy;
+}
+
+void TransientStringMap::growTable() {
+  std::vector<int32_t> slots(std::max(kMinTableSize, 2 * slots_.size()), NOT_FOUND);
+  const size_t mask = slots.size() - 1;
+  for (size_t index = 0; index < strings_.size(); ++index) {
+    size_t slot = hashes_[index] & mask;
+    while (slots[slot] != NOT_FOUND) {
+      slot = (slot + 1) & mask;
+    }
+    slots[slot] = index;
+  }
+  slots_.swap(slots);
+}
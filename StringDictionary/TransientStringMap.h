@@ -0,0 +1,68 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STRINGDICTIONARY_TRANSIENTSTRINGMAP_H
+#define STRINGDICTIONARY_TRANSIENTSTRINGMAP_H
+
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+/**
+ * The strings a StringDictionaryProxy adds on top of its dictionary, numbered from 0 in
+ * the order they are added. Their bytes are copied into large arena blocks which never
+ * move, and an open-addressing hash table with linear probing maps them back to their
+ * numbers. Adding a string thus allocates only when a block fills up or the table
+ * grows, and the views of the strings stay valid as long as the map does.
+ */
+class TransientStringMap {
+ public:
+  static constexpr int32_t NOT_FOUND{-1};
+
+  size_t size() const { return strings_.size(); }
+
+  bool empty() const { return strings_.empty(); }
+
+  std::string_view operator[](const size_t index) const { return strings_[index]; }
+
+  // Strings in the order of their numbers.
+  const std::vector<std::string_view>& strings() const { return strings_; }
+
+  // Number of str, NOT_FOUND if it hasn't been added.
+  int32_t find(const std::string_view str) const;
+
+  // Number of str, which is added if it hasn't been yet.
+  int32_t getOrAdd(const std::string_view str);
+
+ private:
+  size_t findSlot(const std::string_view str, const size_t hash) const;
+
+  std::string_view copyToArena(const std::string_view str);
+
+  void growTable();
+
+  std::vector<std::unique_ptr<char[]>> arena_blocks_;
+  char* arena_free_{nullptr};
+  size_t arena_free_size_{0};
+  std::vector<std::string_view> strings_;
+  // hash of every string, to grow the table without hashing the strings again
+  std::vector<size_t> hashes_;
+  // numbers of the strings, or NOT_FOUND for the empty slots
+  std::vector<int32_t> slots_;
+};
+
+#endif  // STRINGDICTIONARY_TRANSIENTSTRINGMAP_H
@@ -0,0 +1,280 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "StringDictionary/TrigramIndex.h"
+
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cstring>
+
+#ifdef _MSC_VER
+#include <fcntl.h>
+#include <io.h>
+#else
+#include <sys/fcntl.h>
+#include <unistd.h>
+#endif
+
+#include "Logger/Logger.h"
+#include "OSDependent/omnisci_fs.h"
+#include "StringDictionary/StringDictionary.h"
+
+namespace {
+
+// The file is a sequence of segments, each a header followed by one record per trigram
+// of the segment's strings: the trigram, the number of ids and the ids.
+struct SegmentHeader {
+  uint64_t magic;
+  uint64_t begin_string_id;
+  uint64_t end_string_id;
+  uint64_t payload_size;
+};
+
+constexpr uint64_t kSegmentMagic{0x5452494752414d31};  // "TRIGRAM1"
+
+constexpr size_t kIndexBlockSize{1 << 16};
+
+inline uint32_t trigram_at(const char* str) {
+  const auto lowercase = [](const char c) -> uint8_t {
+    return 'A' <= c && c <= 'Z' ? c - 'A' + 'a' : c;
+  };
+  return (uint32_t(lowercase(str[0])) << 16) | (uint32_t(lowercase(str[1])) << 8) |
+         lowercase(str[2]);
+}
+
+void append_trigrams(const std::string_view str, std::vector<uint32_t>& trigrams) {
+  for (size_t i = 0; i + 3 <= str.size(); ++i) {
+    trigrams.push_back(trigram_at(str.data() + i));
+  }
+}
+
+void sort_unique(std::vector<uint32_t>& trigrams) {
+  std::sort(trigrams.begin(), trigrams.end());
+  trigrams.erase(std::unique(trigrams.begin(), trigrams.end()), trigrams.end());
+}
+
+}  // namespace
+
+TrigramIndex::TrigramIndex(const std::string& path, const bool recover)
+    : path_(path), fd_(-1), string_count_(0), persisted_string_count_(0) {
+  if (path_.empty()) {
+    return;
+  }
+  fd_ = omnisci::open(path_.c_str(), O_RDWR | O_CREAT | (recover ? 0 : O_TRUNC), 0644);
+  if (fd_ < 0) {
+    const auto err = "Trigram index path " + path_ + " does not exist.";
+    LOG(ERROR) << err;
+    throw DictPayloadUnavailable(err);
+  }
+  if (recover) {
+    load();
+  }
+}
+
+TrigramIndex::~TrigramIndex() {
+  if (fd_ >= 0) {
+    omnisci::close(fd_);
+  }
+}
+
+void TrigramIndex::load() {
+  const size_t file_size = omnisci::file_size(fd_);
+  std::vector<char> buffer(file_size);
+  size_t bytes_read = 0;
+  while (bytes_read < file_size) {
+    const auto ret =
+        pread(fd_, buffer.data() + bytes_read, file_size - bytes_read, bytes_read);
+    CHECK_GT(ret, 0) << "Failed to read the trigram index " << path_;
+    bytes_read += ret;
+  }
+  size_t offset = 0;
+  while (offset + sizeof(SegmentHeader) <= file_size) {
+    SegmentHeader header;
+    memcpy(&header, buffer.data() + offset, sizeof(header));
+    const size_t payload_offset = offset + sizeof(header);
+    if (header.magic != kSegmentMagic || header.begin_string_id != string_count_ ||
+        header.end_string_id < header.begin_string_id ||
+        header.payload_size > file_size - payload_offset) {
+      break;
+    }
+    // validate the whole segment before adding it, a crash could have cut it short
+    bool valid = true;
+    for (size_t record = payload_offset; record < payload_offset + header.payload_size;) {
+      uint32_t record_header[2];
+      if (record + sizeof(record_header) > payload_offset + header.payload_size) {
+        valid = false;
+        break;
+      }
+      memcpy(record_header, buffer.data() + record, sizeof(record_header));
+      record += sizeof(record_header) + record_header[1] * sizeof(int32_t);
+      valid = record <= payload_offset + header.payload_size;
+    }
+    if (!valid) {
+      break;
+    }
+    for (size_t record = payload_offset; record < payload_offset + header.payload_size;) {
+      uint32_t record_header[2];
+      memcpy(record_header, buffer.data() + record, sizeof(record_header));
+      record += sizeof(record_header);
+      auto& ids = postings_[record_header[0]];
+      const auto old_size = ids.size();
+      ids.resize(old_size + record_header[1]);
+      memcpy(ids.data() + old_size,
+             buffer.data() + record,
+             record_header[1] * sizeof(int32_t));
+      record += record_header[1] * sizeof(int32_t);
+    }
+    string_count_ = persisted_string_count_ = header.end_string_id;
+    offset = payload_offset + header.payload_size;
+  }
+  if (offset != file_size) {
+    LOG(WARNING) << "Trigram index " << path_ << " is truncated to " << string_count_
+                 << " strings";
+    CHECK_EQ(ftruncate(fd_, offset), 0);
+  }
+}
+
+void TrigramIndex::addStrings(
+    const size_t count,
+    const std::function<std::string_view(const size_t)>& get_string) {
+  const size_t first_string_id = string_count_;
+  const size_t block_count = (count + kIndexBlockSize - 1) / kIndexBlockSize;
+  // (trigram, string id) pairs of every block, in string id order
+  std::vector<std::vector<std::pair<uint32_t, int32_t>>> block_trigrams(block_count);
+  tbb::parallel_for(
+      tbb::blocked_range<size_t>(0, block_count, 1),
+      [&](const tbb::blocked_range<size_t>& r) {
+        std::vector<uint32_t> trigrams;
+        for (size_t block = r.begin(); block != r.end(); ++block) {
+          const size_t block_end = std::min(count, (block + 1) * kIndexBlockSize);
+          for (size_t i = block * kIndexBlockSize; i < block_end; ++i) {
+            const size_t string_id = first_string_id + i;
+            trigrams.clear();
+            append_trigrams(get_string(string_id), trigrams);
+            sort_unique(trigrams);
+            for (const auto trigram : trigrams) {
+              block_trigrams[block].emplace_back(trigram, string_id);
+            }
+          }
+        }
+      });
+  for (const auto& trigrams : block_trigrams) {
+    for (const auto& [trigram, string_id] : trigrams) {
+      postings_[trigram].push_back(string_id);
+    }
+  }
+  string_count_ += count;
+}
+
+std::optional<std::vector<int32_t>> TrigramIndex::getCandidates(
+    const std::vector<std::string>& literals,
+    const size_t generation) const {
+  std::vector<uint32_t> trigrams;
+  for (const auto& literal : literals) {
+    append_trigrams(literal, trigrams);
+  }
+  if (trigrams.empty()) {
+    return std::nullopt;
+  }
+  sort_unique(trigrams);
+  std::vector<const std::vector<int32_t>*> id_lists;
+  for (const auto trigram : trigrams) {
+    const auto it = postings_.find(trigram);
+    if (it == postings_.end()) {
+      return std::vector<int32_t>{};
+    }
+    id_lists.push_back(&it->second);
+  }
+  std::sort(id_lists.begin(), id_lists.end(), [](const auto lhs, const auto rhs) {
+    return lhs->size() < rhs->size();
+  });
+  const auto below_generation = [generation](const std::vector<int32_t>& ids) {
+    return std::lower_bound(ids.begin(), ids.end(), static_cast<int32_t>(generation));
+  };
+  std::vector<int32_t> candidates(id_lists.front()->begin(),
+                                  below_generation(*id_lists.front()));
+  std::vector<int32_t> intersection;
+  for (size_t i = 1; i < id_lists.size() && !candidates.empty(); ++i) {
+    intersection.clear();
+    std::set_intersection(candidates.begin(),
+                          candidates.end(),
+                          id_lists[i]->begin(),
+                          below_generation(*id_lists[i]),
+                          std::back_inserter(intersection));
+    candidates.swap(intersection);
+  }
+  return candidates;
+}
+
+void TrigramIndex::clear() {
+  std::lock_guard<std::mutex> checkpoint_lock(checkpoint_mutex_);
+  decltype(postings_)().swap(postings_);
+  string_count_ = persisted_string_count_ = 0;
+  if (fd_ >= 0) {
+    CHECK_EQ(ftruncate(fd_, 0), 0);
+  }
+}
+
+bool TrigramIndex::checkpoint() noexcept {
+  std::lock_guard<std::mutex> checkpoint_lock(checkpoint_mutex_);
+  if (fd_ < 0 || persisted_string_count_ == string_count_) {
+    return true;
+  }
+  std::vector<char> segment(sizeof(SegmentHeader));
+  for (const auto& [trigram, ids] : postings_) {
+    const auto ids_begin = std::lower_bound(
+        ids.begin(), ids.end(), static_cast<int32_t>(persisted_string_count_));
+    const uint32_t record_header[2] = {trigram,
+                                       static_cast<uint32_t>(ids.end() - ids_begin)};
+    if (!record_header[1]) {
+      continue;
+    }
+    const auto record_offset = segment.size();
+    segment.resize(record_offset + sizeof(record_header) +
+                   record_header[1] * sizeof(int32_t));
+    memcpy(segment.data() + record_offset, record_header, sizeof(record_header));
+    memcpy(segment.data() + record_offset + sizeof(record_header),
+           &*ids_begin,
+           record_header[1] * sizeof(int32_t));
+  }
+  const SegmentHeader header{kSegmentMagic,
+                             persisted_string_count_,
+                             string_count_,
+                             segment.size() - sizeof(SegmentHeader)};
+  memcpy(segment.data(), &header, sizeof(header));
+  const off_t file_end = lseek(fd_, 0, SEEK_END);
+  if (file_end == -1) {
+    return false;
+  }
+  for (size_t bytes_written = 0; bytes_written < segment.size();) {
+    const auto ret = pwrite(fd_,
+                            segment.data() + bytes_written,
+                            segment.size() - bytes_written,
+                            file_end + bytes_written);
+    if (ret <= 0) {
+      // drop the partial segment, later segments would be unreachable after it
+      CHECK_EQ(ftruncate(fd_, file_end), 0);
+      return false;
+    }
+    bytes_written += ret;
+  }
+  if (omnisci::fsync(fd_)) {
+    return false;
+  }
+  persisted_string_count_ = string_count_;
+  return true;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef STRINGDICTIONARY_TRIGRAMINDEX_H
+#define STRINGDICTIONARY_TRIGRAMINDEX_H
+
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Inverted index from the trigrams (three consecutive bytes) of the ASCII-lowercased
+ * strings of a dictionary to the ascending ids of the strings containing them. A string
+ * which contains a literal contains all of its trigrams, so intersecting their id lists
+ * gives a superset of the strings matching LIKE and REGEXP patterns which require the
+ * literal, in either letter case.
+ *
+ * Strings are added in id order. The ids added since the previous checkpoint are appended
+ * to the index file as one segment, so checkpoints don't rewrite the whole index. A
+ * segment cut short by a crash is dropped when the index is opened again, and the string
+ * dictionary indexes its strings which are missing from the file.
+ */
+class TrigramIndex {
+ public:
+  // Indexes in memory only when path is empty, otherwise opens the index file at path,
+  // truncating it unless recovering.
+  TrigramIndex(const std::string& path, const bool recover);
+
+  ~TrigramIndex();
+
+  // Number of strings indexed, the id the next string added gets.
+  size_t stringCount() const { return string_count_; }
+
+  // Indexes the strings with ids [stringCount(), stringCount() + count), which
+  // get_string returns.
+  void addStrings(const size_t count,
+                  const std::function<std::string_view(const size_t)>& get_string);
+
+  // Ascending ids below generation of the strings containing all the trigrams of the
+  // literals, none if the literals are too short to have any.
+  std::optional<std::vector<int32_t>> getCandidates(
+      const std::vector<std::string>& literals,
+      const size_t generation) const;
+
+  // Drops the whole index, in memory and on disk.
+  void clear();
+
+  // Persists the strings indexed since the last checkpoint.
+  bool checkpoint() noexcept;
+
+ private:
+  void load();
+
+  const std::string path_;
+  int fd_;
+  size_t string_count_;
+  size_t persisted_string_count_;
+  std::unordered_map<uint32_t, std::vector<int32_t>> postings_;
+  std::mutex checkpoint_mutex_;
+};
+
+#endif  // STRINGDICTIONARY_TRIGRAMINDEX_H
@@ -0,0 +1,225 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+#include "Catalog/Catalog.h"
+#include "DataMgr/BloomFilter.h"
+#include "QueryEngine/ResultSet.h"
+#include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using QR = QueryRunner::QueryRunner;
+using namespace TestHelpers;
+
+namespace {
+
+inline void run_ddl_statement(const std::string& stmt) {
+  QR::get()->runDDLStatement(stmt);
+}
+
+std::shared_ptr<ResultSet> run_query(const std::string& query_str) {
+  return QR::get()->runSQL(query_str, ExecutorDeviceType::CPU, true, true);
+}
+
+int64_t run_count_query(const std::string& query_str) {
+  const auto rows = run_query(query_str);
+  const auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size());
+  return v<int64_t>(crt_row[0]);
+}
+
+// returns the chunk metadata of the given column for every fragment of the table
+std::vector<std::shared_ptr<ChunkMetadata>> get_chunk_metadata(
+    const std::string& table_name,
+    const std::string& column_name) {
+  const auto catalog = QR::get()->getCatalog();
+  const auto td = catalog->getMetadataForTable(table_name);
+  CHECK(td);
+  const auto cd = catalog->getMetadataForColumn(td->tableId, column_name);
+  CHECK(cd);
+  std::vector<std::shared_ptr<ChunkMetadata>> chunk_metadata;
+  const auto table_info = td->fragmenter->getFragmentsForQuery();
+  for (const auto& fragment : table_info.fragments) {
+    const auto& metadata_map = fragment.getChunkMetadataMapPhysical();
+    const auto it = metadata_map.find(cd->columnId);
+    CHECK(it != metadata_map.end());
+    chunk_metadata.push_back(it->second);
+  }
+  return chunk_metadata;
+}
+
+}  // namespace
+
+TEST(BloomFilter, NoFalseNegatives) {
+  BloomFilter bloom_filter;
+  const size_t initial_size_bytes = bloom_filter.getSizeBytes();
+  // enough values to add a few stages
+  constexpr int64_t num_values{10000};
+  for (int64_t i = 0; i < num_values; ++i) {
+    bloom_filter.add(i * 7919);
+  }
+  EXPECT_EQ(size_t(num_values), bloom_filter.getNumValues());
+  EXPECT_GT(bloom_filter.getSizeBytes(), initial_size_bytes);
+  for (int64_t i = 0; i < num_values; ++i) {
+    ASSERT_TRUE(bloom_filter.mayContain(i * 7919));
+  }
+  size_t num_false_positives{0};
+  for (int64_t i = 0; i < num_values; ++i) {
+    num_false_positives += bloom_filter.mayContain(i * 7919 + 1) ? 1 : 0;
+  }
+  // a few percent at most with the default number of bits per value
+  EXPECT_LT(num_false_positives, size_t(num_values / 10));
+}
+
+TEST(BloomFilter, ReadWrite) {
+  BloomFilter bloom_filter;
+  for (int64_t i = 0; i < 3000; ++i) {
+    bloom_filter.add(-i);
+  }
+  std::stringstream ss;
+  bloom_filter.write(ss);
+  const auto read_bloom_filter = BloomFilter::read(ss);
+  ASSERT_TRUE(read_bloom_filter);
+  EXPECT_EQ(bloom_filter.getNumValues(), read_bloom_filter->getNumValues());
+  EXPECT_EQ(bloom_filter.getChecksum(), read_bloom_filter->getChecksum());
+  for (int64_t i = 0; i < 3000; ++i) {
+    ASSERT_TRUE(read_bloom_filter->mayContain(-i));
+  }
+
+  // truncated
+  const auto serialized = ss.str();
+  std::stringstream truncated_ss(serialized.substr(0, serialized.size() / 2));
+  EXPECT_FALSE(BloomFilter::read(truncated_ss));
+}
+
+class BloomFilterQueryTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    run_ddl_statement("DROP TABLE IF EXISTS bf_test;");
+    run_ddl_statement(
+        "CREATE TABLE bf_test (id BIGINT, s TEXT ENCODING DICT(32), x INT) WITH "
+        "(fragment_size=10, bloom_filter_columns='id, s');");
+    // the ids are spread across the fragments, the min / max stats can't skip any
+    for (int i = 0; i < 40; ++i) {
+      const auto id = (i % 4) * 1000 + i;
+      run_query("INSERT INTO bf_test VALUES (" + std::to_string(id) + ", 'str" +
+                std::to_string(id) + "', " + std::to_string(i) + ");");
+    }
+  }
+
+  static void TearDownTestSuite() { run_ddl_statement("DROP TABLE IF EXISTS bf_test;"); }
+};
+
+TEST_F(BloomFilterQueryTest, Metadata) {
+  const auto catalog = QR::get()->getCatalog();
+  const auto td = catalog->getMetadataForTable("bf_test");
+  ASSERT_TRUE(td);
+  EXPECT_EQ("id,s", catalog->getBloomFilterColumnNames(td));
+
+  const auto id_chunk_metadata = get_chunk_metadata("bf_test", "id");
+  ASSERT_EQ(size_t(4), id_chunk_metadata.size());
+  for (const auto& chunk_metadata : id_chunk_metadata) {
+    ASSERT_TRUE(chunk_metadata->bloomFilter);
+    EXPECT_EQ(size_t(10), chunk_metadata->bloomFilter->getNumValues());
+  }
+  EXPECT_TRUE(id_chunk_metadata.front()->bloomFilter->mayContain(1005));
+  for (const auto& chunk_metadata : get_chunk_metadata("bf_test", "s")) {
+    EXPECT_TRUE(chunk_metadata->bloomFilter);
+  }
+  for (const auto& chunk_metadata : get_chunk_metadata("bf_test", "x")) {
+    EXPECT_FALSE(chunk_metadata->bloomFilter);
+  }
+}
+
+TEST_F(BloomFilterQueryTest, Filters) {
+  EXPECT_EQ(int64_t(1), run_count_query("SELECT COUNT(*) FROM bf_test WHERE id = 1005;"));
+  EXPECT_EQ(int64_t(0), run_count_query("SELECT COUNT(*) FROM bf_test WHERE id = 1004;"));
+  EXPECT_EQ(int64_t(1),
+            run_count_query("SELECT COUNT(*) FROM bf_test WHERE s = 'str3039';"));
+  EXPECT_EQ(int64_t(0),
+            run_count_query("SELECT COUNT(*) FROM bf_test WHERE s = 'missing';"));
+  EXPECT_EQ(int64_t(1),
+            run_count_query("SELECT COUNT(*) FROM bf_test WHERE 'str2010' = s;"));
+  EXPECT_EQ(int64_t(1),
+            run_count_query(
+                "SELECT COUNT(*) FROM bf_test WHERE id = 2022 AND s = 'str2022';"));
+  EXPECT_EQ(int64_t(0),
+            run_count_query(
+                "SELECT COUNT(*) FROM bf_test WHERE id = 2022 AND s = 'str2026';"));
+  EXPECT_EQ(int64_t(20),
+            run_count_query("SELECT COUNT(*) FROM bf_test WHERE id > 2000;"));
+}
+
+TEST_F(BloomFilterQueryTest, InvalidColumns) {
+  ScopeGuard drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS bf_invalid_test;");
+  };
+  EXPECT_ANY_THROW(
+      run_ddl_statement("CREATE TABLE bf_invalid_test (f FLOAT) WITH "
+                        "(bloom_filter_columns='f');"));
+  EXPECT_ANY_THROW(
+      run_ddl_statement("CREATE TABLE bf_invalid_test (x INT) WITH "
+                        "(bloom_filter_columns='y');"));
+  EXPECT_ANY_THROW(
+      run_ddl_statement("CREATE TABLE bf_invalid_test (s TEXT ENCODING NONE) WITH "
+                        "(bloom_filter_columns='s');"));
+}
+
+TEST_F(BloomFilterQueryTest, Update) {
+  run_ddl_statement("DROP TABLE IF EXISTS bf_update_test;");
+  ScopeGuard drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS bf_update_test;");
+  };
+  run_ddl_statement(
+      "CREATE TABLE bf_update_test (x INT) WITH (fragment_size=20, "
+      "bloom_filter_columns='x');");
+  for (int i = 0; i < 12; ++i) {
+    run_query("INSERT INTO bf_update_test VALUES (" + std::to_string(i * 2) + ");");
+  }
+  EXPECT_TRUE(get_chunk_metadata("bf_update_test", "x").front()->bloomFilter);
+
+  // the updated values are not in the filter, it is dropped
+  run_query("UPDATE bf_update_test SET x = 7 WHERE x = 4;");
+  EXPECT_FALSE(get_chunk_metadata("bf_update_test", "x").front()->bloomFilter);
+  EXPECT_EQ(int64_t(1),
+            run_count_query("SELECT COUNT(*) FROM bf_update_test WHERE x = 7;"));
+  EXPECT_EQ(int64_t(0),
+            run_count_query("SELECT COUNT(*) FROM bf_update_test WHERE x = 4;"));
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  QR::init(BASE_PATH);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  QR::reset();
+  return err;
+}
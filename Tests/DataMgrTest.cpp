@@ -21,15 +21,22 @@
 
 #include <gtest/gtest.h>
 #include <boost/filesystem.hpp>
+#include <future>
+#include <numeric>
 
 #include "CudaMgr/CudaMgr.h"
 #include "DataMgr/Allocators/ArenaAllocator.h"
+#include "DataMgr/BufferMgr/CpuBufferMgr/CpuBuffer.h"
 #include "DataMgr/BufferMgr/CpuBufferMgr/TieredCpuBufferMgr.h"
 #include "DataMgr/Chunk/Chunk.h"
 #include "DataMgr/DataMgr.h"
+#include "DataMgr/ForeignStorage/CacheEvictionAlgorithms/LRUKEvictionAlgorithm.h"
+#include "Shared/scope.h"
 #include "TestHelpers.h"
 
 extern bool g_enable_tiered_cpu_mem;
+extern bool g_read_only;
+extern bool g_enable_mmap_reads;
 extern size_t g_pmem_size;
 
 // A Mock that wraps the Arena allocators.  Forwards calls to the allocator, but also has
@@ -73,6 +80,12 @@ class DataMgrTest : public testing::Test {
 
   virtual void resetDataMgr(size_t num_slabs = 1) {
     boost::filesystem::remove_all(data_mgr_path_);
+    openDataMgr(num_slabs);
+  }
+
+  // Opens a new DataMgr on the current data directory.
+  void openDataMgr(size_t num_slabs = 1) {
+    data_mgr_.reset();
     system_params_.max_cpu_slab_size = slab_size_;
     system_params_.min_cpu_slab_size = slab_size_;
     system_params_.cpu_buffer_mem_bytes = slab_size_ * num_slabs;
@@ -160,6 +173,161 @@ TEST_F(DataMgrTest, ReuseWithPinnedGaps) {
   writeChunkForKey({1, 1, 1, 3});                // unpinned
 }
 
+TEST_F(DataMgrTest, MmapReadOnly) {
+  // a chunk held by a single page and one spanning several pages
+  const ChunkKey small_key{1, 1, 1, 1};
+  const ChunkKey large_key{1, 1, 2, 1};
+  constexpr size_t disk_page_size{64};
+  const std::vector<int8_t> small_data{1, 2, 3, 4};
+  std::vector<int8_t> large_data(160);
+  std::iota(large_data.begin(), large_data.end(), 0);
+  for (const auto& [key, data] : {std::make_pair(small_key, small_data),
+                                  std::make_pair(large_key, large_data)}) {
+    auto disk_buf = data_mgr_->createChunkBuffer(
+        key, MemoryLevel::DISK_LEVEL, 0, disk_page_size);
+    disk_buf->append(const_cast<int8_t*>(data.data()), data.size());
+  }
+  data_mgr_->checkpoint(1, 1);
+
+  ScopeGuard reset_flags = [] {
+    g_read_only = false;
+    g_enable_mmap_reads = false;
+  };
+  g_read_only = true;
+  g_enable_mmap_reads = true;
+  openDataMgr();
+  ColumnDescriptor cd(1, 1, "temp", SQLTypeInfo{kTINYINT});
+  {
+    auto small_chunk = Chunk_NS::Chunk::getChunk(
+        &cd, data_mgr_.get(), small_key, MemoryLevel::CPU_LEVEL, 0, 4, 4);
+    auto small_buf = dynamic_cast<Buffer_Namespace::CpuBuffer*>(small_chunk->getBuffer());
+    ASSERT_TRUE(small_buf);
+    EXPECT_TRUE(small_buf->isMapped());
+    EXPECT_EQ(size_t(0), data_mgr_->getCpuBufferMgr()->getInUseSize());
+    std::vector<int8_t> read_data(small_data.size());
+    small_buf->read(read_data.data(), read_data.size());
+    EXPECT_EQ(small_data, read_data);
+
+    auto large_chunk = Chunk_NS::Chunk::getChunk(&cd,
+                                                 data_mgr_.get(),
+                                                 large_key,
+                                                 MemoryLevel::CPU_LEVEL,
+                                                 0,
+                                                 large_data.size(),
+                                                 large_data.size());
+    auto large_buf = dynamic_cast<Buffer_Namespace::CpuBuffer*>(large_chunk->getBuffer());
+    ASSERT_TRUE(large_buf);
+    EXPECT_FALSE(large_buf->isMapped());
+    read_data.resize(large_data.size());
+    large_buf->read(read_data.data(), read_data.size());
+    EXPECT_EQ(large_data, read_data);
+  }
+  data_mgr_->clearMemory(MemoryLevel::CPU_LEVEL);
+  EXPECT_FALSE(data_mgr_->isBufferOnDevice(small_key, MemoryLevel::CPU_LEVEL, 0));
+  data_mgr_.reset();
+}
+
+TEST_F(DataMgrTest, ConcurrentGetBuffer) {
+  // more chunks than slabs, so the lookups of resident chunks race with evictions, but
+  // more slabs than threads, as each thread pins one chunk at a time
+  resetDataMgr(5);
+  std::vector<ChunkKey> keys;
+  for (int table_id = 1; table_id <= 3; ++table_id) {
+    for (int frag_id = 0; frag_id < 2; ++frag_id) {
+      keys.push_back({1, table_id, 1, frag_id});
+      auto disk_buf = data_mgr_->createChunkBuffer(keys.back(), MemoryLevel::DISK_LEVEL);
+      const int8_t val = table_id * 10 + frag_id;
+      disk_buf->append(std::vector<int8_t>(4, val).data(), 4U);
+    }
+  }
+  std::vector<std::future<void>> threads;
+  for (size_t thread_idx = 0; thread_idx < 4; ++thread_idx) {
+    threads.push_back(std::async(std::launch::async, [&, thread_idx] {
+      for (size_t i = 0; i < 1000; ++i) {
+        // most lookups go to the first four chunks, which mostly stay resident
+        const auto& key = keys[(i + thread_idx) % 7 == 6 ? 4 + i % 2 : i % 4];
+        auto buffer = data_mgr_->getChunkBuffer(key, MemoryLevel::CPU_LEVEL, 0, 4);
+        std::vector<int8_t> data(4);
+        buffer->read(data.data(), 4);
+        EXPECT_EQ(std::vector<int8_t>(4, key[1] * 10 + key[3]), data);
+        buffer->unPin();
+      }
+    }));
+  }
+  for (auto& thread : threads) {
+    thread.get();
+  }
+  for (const auto& key : keys) {
+    if (data_mgr_->isBufferOnDevice(key, MemoryLevel::CPU_LEVEL, 0)) {
+      auto buffer = data_mgr_->getChunkBuffer(key, MemoryLevel::CPU_LEVEL, 0, 4);
+      EXPECT_EQ(1, buffer->getPinCount());
+      buffer->unPin();
+    }
+  }
+}
+
+TEST_F(DataMgrTest, LRUKEvictionKeepsWorkingSet) {
+  system_params_.cpu_buffer_eviction_policy = "lru-k";
+  resetDataMgr(3);
+  std::vector<ChunkKey> keys;
+  for (int frag_id = 0; frag_id < 6; ++frag_id) {
+    keys.push_back({1, 1, 1, frag_id});
+    auto disk_buf = data_mgr_->createChunkBuffer(keys.back(), MemoryLevel::DISK_LEVEL);
+    disk_buf->append(std::vector<int8_t>{1, 2, 3, 4}.data(), 4U);
+  }
+  auto get_chunk = [this](const ChunkKey& key) {
+    data_mgr_->getChunkBuffer(key, MemoryLevel::CPU_LEVEL, 0, 4)->unPin();
+  };
+  // the working set is touched twice, then scanned chunks evict each other
+  for (size_t i = 0; i < 2; ++i) {
+    get_chunk(keys[0]);
+    get_chunk(keys[1]);
+  }
+  for (size_t i = 2; i < keys.size(); ++i) {
+    get_chunk(keys[i]);
+  }
+  EXPECT_TRUE(data_mgr_->isBufferOnDevice(keys[0], MemoryLevel::CPU_LEVEL, 0));
+  EXPECT_TRUE(data_mgr_->isBufferOnDevice(keys[1], MemoryLevel::CPU_LEVEL, 0));
+  EXPECT_TRUE(data_mgr_->isBufferOnDevice(keys[5], MemoryLevel::CPU_LEVEL, 0));
+  EXPECT_FALSE(data_mgr_->isBufferOnDevice(keys[2], MemoryLevel::CPU_LEVEL, 0));
+}
+
+TEST(LRUKEvictionAlgorithmTest, Order) {
+  const ChunkKey key1{1, 1, 1, 1}, key2{1, 1, 1, 2}, key3{1, 1, 1, 3};
+  LRUKEvictionAlgorithm alg;
+  alg.touchChunk(key1);
+  alg.touchChunk(key1);
+  alg.touchChunk(key2);
+  alg.touchChunk(key3);
+  // the chunks touched once go first, least recently touched first
+  EXPECT_EQ(key2, alg.evictNextChunk());
+  EXPECT_EQ(key3, alg.evictNextChunk());
+  EXPECT_EQ(key1, alg.evictNextChunk());
+  EXPECT_THROW(alg.evictNextChunk(), NoEntryFoundException);
+
+  // the history of the evicted chunks is retained
+  const ChunkKey key4{1, 1, 1, 4};
+  alg.touchChunk(key1);
+  alg.touchChunk(key4);
+  EXPECT_LT(alg.getRetentionScore(key4), alg.getRetentionScore(key1));
+  alg.removeChunk(key1);
+  EXPECT_EQ(size_t(0), alg.getRetentionScore(key1));
+}
+
+TEST(LRUKEvictionAlgorithmTest, RefetchCost) {
+  const ChunkKey key1{1, 1, 1, 1}, key2{1, 1, 1, 2}, key3{1, 1, 1, 3};
+  LRUKEvictionAlgorithm alg;
+  alg.touchChunk(key1);
+  alg.setRefetchCost(key1, 4);
+  alg.touchChunk(key2);
+  alg.touchChunk(key3);
+  alg.touchChunk(key3);
+  alg.touchChunk(key3);
+  // key1 is the least recently touched, but the most expensive to fetch again
+  EXPECT_EQ(key2, alg.evictNextChunk());
+  EXPECT_EQ(key1, alg.evictNextChunk());
+}
+
 TEST_F(TieredCpuBufferMgrTest, AllocateInOrder) {
   // Two buffers will each allocate a new slab, so they should use new allocators for
   // each.
@@ -18,10 +18,12 @@
 
 #include "Logger/Logger.h"
 #include "QueryEngine/CompilationOptions.h"
+#include "QueryEngine/DataRecycler/ResultSetRecycler.h"
 #include "QueryEngine/Execute.h"
 #include "QueryEngine/QueryPlanDagCache.h"
 #include "QueryEngine/QueryPlanDagExtractor.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
 
 #include <gtest/gtest.h>
 #include <boost/algorithm/string/join.hpp>
@@ -1588,6 +1590,78 @@ TEST(DataRecycler, Hashtable_From_Subqueries) {
   }
 }
 
+TEST(DataRecycler, Query_Resultset_Cache) {
+  const auto use_query_resultset_cache_state = g_use_query_resultset_cache;
+  auto resultset_cache = ResultSetRecyclerHolder::getResultSetRecycler();
+  ScopeGuard reset_state = [&use_query_resultset_cache_state, &resultset_cache] {
+    g_use_query_resultset_cache = use_query_resultset_cache_state;
+    resultset_cache->clearCache();
+    run_ddl_statement("DROP TABLE IF EXISTS rs_cache_t;");
+  };
+  g_use_query_resultset_cache = true;
+  resultset_cache->clearCache();
+  auto get_num_cached_resultsets = [&resultset_cache] {
+    return resultset_cache->getCurrentNumCachedItems(
+        CacheItemType::QUERY_RESULTSET, DataRecyclerUtil::CPU_DEVICE_IDENTIFIER);
+  };
+  run_ddl_statement("DROP TABLE IF EXISTS rs_cache_t;");
+  run_ddl_statement("CREATE TABLE rs_cache_t (x int, y int);");
+  for (int i = 1; i <= 3; ++i) {
+    QR::get()->runSQL("INSERT INTO rs_cache_t VALUES(" + std::to_string(i) + ", 1);",
+                      ExecutorDeviceType::CPU);
+  }
+
+  for (auto dt : {ExecutorDeviceType::CPU}) {
+    // test1. recycle the resultset of the same query
+    auto q1 = "SELECT count(*) FROM rs_cache_t WHERE x > 1;";
+    ASSERT_EQ(static_cast<int64_t>(2), v<int64_t>(run_simple_query(q1, dt)));
+    ASSERT_EQ(static_cast<size_t>(1), get_num_cached_resultsets());
+    ASSERT_EQ(static_cast<int64_t>(2), v<int64_t>(run_simple_query(q1, dt)));
+    ASSERT_EQ(static_cast<size_t>(1), get_num_cached_resultsets());
+
+    // test2. a recycled resultset is independent of the previously returned one
+    auto q2 = "SELECT x FROM rs_cache_t ORDER BY x DESC LIMIT 2;";
+    for (int i = 0; i < 2; ++i) {
+      auto rows = QR::get()->runSQL(q2, dt);
+      ASSERT_EQ(static_cast<size_t>(2), rows->rowCount());
+      ASSERT_EQ(static_cast<int64_t>(3), v<int64_t>(rows->getNextRow(true, true)[0]));
+      ASSERT_EQ(static_cast<int64_t>(2), v<int64_t>(rows->getNextRow(true, true)[0]));
+      ASSERT_TRUE(rows->getNextRow(true, true).empty());
+    }
+    ASSERT_EQ(static_cast<size_t>(2), get_num_cached_resultsets());
+
+    // test3. skip caching the resultset of a query having non-deterministic function
+    auto q3 =
+        "SELECT count(*) FROM rs_cache_t WHERE x > 1 AND NOW() > TIMESTAMP '2000-01-01 "
+        "00:00:00';";
+    ASSERT_EQ(static_cast<int64_t>(2), v<int64_t>(run_simple_query(q3, dt)));
+    ASSERT_EQ(static_cast<size_t>(2), get_num_cached_resultsets());
+    // DATETIME('NOW') is the current timestamp as well
+    for (int i = 0; i < 2; ++i) {
+      QR::get()->runSQL("SELECT DATETIME('NOW');", dt);
+      ASSERT_EQ(static_cast<size_t>(2), get_num_cached_resultsets());
+    }
+    auto q3_datetime =
+        "SELECT count(*) FROM rs_cache_t WHERE x > 1 AND DATETIME('NOW') > TIMESTAMP "
+        "'2000-01-01 00:00:00';";
+    for (int i = 0; i < 2; ++i) {
+      ASSERT_EQ(static_cast<int64_t>(2), v<int64_t>(run_simple_query(q3_datetime, dt)));
+      ASSERT_EQ(static_cast<size_t>(2), get_num_cached_resultsets());
+    }
+
+    // test4. appending rows makes the cached resultset unreachable
+    QR::get()->runSQL("INSERT INTO rs_cache_t VALUES(4, 2);", ExecutorDeviceType::CPU);
+    ASSERT_EQ(static_cast<int64_t>(3), v<int64_t>(run_simple_query(q1, dt)));
+    ASSERT_EQ(static_cast<size_t>(3), get_num_cached_resultsets());
+
+    // test5. update query invalidates the cache
+    QR::get()->runSQL("UPDATE rs_cache_t SET y = 3 WHERE x = 4;", ExecutorDeviceType::CPU);
+    ASSERT_EQ(static_cast<size_t>(0), get_num_cached_resultsets());
+    auto q4 = "SELECT count(*) FROM rs_cache_t WHERE y = 3;";
+    ASSERT_EQ(static_cast<int64_t>(1), v<int64_t>(run_simple_query(q4, dt)));
+  }
+}
+
 int main(int argc, char* argv[]) {
   testing::InitGoogleTest(&argc, argv);
   TestHelpers::init_logger_stderr_only(argc, argv);
@@ -61,12 +61,21 @@ extern unsigned g_trivial_loop_join_threshold;
 extern bool g_enable_overlaps_hashjoin;
 extern double g_gpu_mem_limit_percent;
 extern size_t g_parallel_top_min;
+extern size_t g_parallel_window_partition_sort_min;
 
 extern bool g_enable_window_functions;
 extern bool g_enable_calcite_view_optimize;
 extern bool g_enable_bump_allocator;
 extern bool g_enable_interop;
 extern bool g_enable_union;
+extern bool g_enable_group_by_partitioning;
+extern int64_t g_bitmap_memory_limit;
+extern bool g_enable_adaptive_group_by;
+extern bool g_enable_late_materialization;
+extern bool g_enable_partitioned_reduction;
+extern size_t g_partitioned_reduction_min_entries;
+extern size_t g_sort_merge_join_max_hash_table_bytes;
+extern size_t g_default_max_groups_buffer_entry_guess;
 
 extern size_t g_leaf_count;
 extern bool g_cluster;
@@ -8587,6 +8596,28 @@ TEST(Select, SpeculativeTopNSort) {
   }
 }
 
+TEST(Select, ParallelSort) {
+  ScopeGuard reset = [orig = g_parallel_top_min] { g_parallel_top_min = orig; };
+  const auto dt = ExecutorDeviceType::CPU;
+  for (auto parallel_top_min : {size_t(0), size_t(100), g_parallel_top_min}) {
+    g_parallel_top_min = parallel_top_min;
+    c("SELECT x1, x2, x3, x4, x5 FROM random_test ORDER BY x2 DESC, x3, x1, x4, x5;",
+      dt);
+    c("SELECT x1, x2, x3, x4, x5 FROM random_test ORDER BY x3, x2 DESC, x1, x4, x5 "
+      "LIMIT 50;",
+      dt);
+    c("SELECT x1, x2, x3, x4, x5 FROM random_test ORDER BY x3, x2 DESC, x1, x4, x5 "
+      "LIMIT 1000;",
+      dt);
+    c("SELECT x2, x3, COUNT(*) AS n FROM random_test GROUP BY x2, x3 "
+      "ORDER BY n DESC, x2, x3;",
+      dt);
+    c("SELECT x2, x3, COUNT(*) AS n FROM random_test GROUP BY x2, x3 "
+      "ORDER BY n DESC, x2, x3 LIMIT 7;",
+      dt);
+  }
+}
+
 TEST(Select, GroupByPerfectHash) {
   const auto default_bigint_flag = g_bigint_count;
   ScopeGuard reset = [default_bigint_flag] { g_bigint_count = default_bigint_flag; };
@@ -8705,6 +8736,117 @@ TEST(Select, GroupByBaselineHash) {
   }
 }
 
+TEST(Select, GroupByBaselineHashByPartitions) {
+  SKIP_ALL_ON_AGGREGATOR();
+  ScopeGuard reset = [orig_partitioning = g_enable_group_by_partitioning,
+                      orig_bitmap_memory_limit = g_bitmap_memory_limit] {
+    g_enable_group_by_partitioning = orig_partitioning;
+    g_bitmap_memory_limit = orig_bitmap_memory_limit;
+  };
+  // the count distinct bitmaps of the 34 groups of x5 exceed the limit, those of a few
+  // groups do not
+  g_bitmap_memory_limit = 32;
+  const auto dt = ExecutorDeviceType::CPU;
+  const std::string query(
+      "SELECT x5, COUNT(*), COUNT(DISTINCT x1), SUM(x2) FROM random_test GROUP BY x5 "
+      "ORDER BY x5;");
+  g_enable_group_by_partitioning = false;
+  EXPECT_ANY_THROW(run_multiple_agg(query, dt));
+  g_enable_group_by_partitioning = true;
+  c(query, dt);
+  c("SELECT x4, x5, COUNT(DISTINCT x1) FROM random_test GROUP BY x4, x5 ORDER BY x4, "
+    "x5;",
+    dt);
+}
+
+TEST(Select, GroupByBaselineHashByPartitionsPartitionedReduction) {
+  SKIP_ALL_ON_AGGREGATOR();
+  ScopeGuard reset = [orig_partitioning = g_enable_group_by_partitioning,
+                      orig_bitmap_memory_limit = g_bitmap_memory_limit,
+                      orig_enable = g_enable_partitioned_reduction,
+                      orig_min_entries = g_partitioned_reduction_min_entries] {
+    g_enable_group_by_partitioning = orig_partitioning;
+    g_bitmap_memory_limit = orig_bitmap_memory_limit;
+    g_enable_partitioned_reduction = orig_enable;
+    g_partitioned_reduction_min_entries = orig_min_entries;
+  };
+  // the query is retried by partitions of its groups, and the result of every partition
+  // keeps part of its groups in the storages appended by the partitioned reduction
+  g_bitmap_memory_limit = 32;
+  g_enable_group_by_partitioning = true;
+  g_enable_partitioned_reduction = true;
+  g_partitioned_reduction_min_entries = 0;
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT x5, COUNT(*), COUNT(DISTINCT x1), SUM(x2) FROM random_test GROUP BY x5 "
+    "ORDER BY x5;",
+    dt);
+  c("SELECT x4, x5, COUNT(DISTINCT x1) FROM random_test GROUP BY x4, x5 ORDER BY x4, "
+    "x5;",
+    dt);
+  c("SELECT COUNT(*), SUM(n) FROM (SELECT x5, COUNT(DISTINCT x1) AS n FROM random_test "
+    "GROUP BY x5);",
+    dt);
+}
+
+TEST(Select, GroupByBaselineHashAdaptive) {
+  SKIP_ALL_ON_AGGREGATOR();
+  ScopeGuard reset = [orig_adaptive = g_enable_adaptive_group_by,
+                      orig_guess = g_default_max_groups_buffer_entry_guess,
+                      orig_big_group_threshold = g_big_group_threshold] {
+    g_enable_adaptive_group_by = orig_adaptive;
+    g_default_max_groups_buffer_entry_guess = orig_guess;
+    g_big_group_threshold = orig_big_group_threshold;
+  };
+  g_enable_adaptive_group_by = true;
+  // start from a tiny buffer without a cardinality estimation, so that the kernels
+  // grow their buffers several times
+  g_default_max_groups_buffer_entry_guess = 16;
+  g_big_group_threshold = 1;
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT x1, x2, x3, x4, COUNT(*), MIN(x5) FROM random_test "
+    "GROUP BY x1, x2, x3, x4 ORDER BY x1, x2, x3, x4;",
+    dt);
+  c("SELECT cast(x3 as double) as key, COUNT(*), AVG(x2), MIN(x1), COUNT(x4) FROM "
+    "random_test GROUP BY key ORDER BY key;",
+    dt);
+  c("SELECT x5 as key, COUNT(*), MAX(x1), MIN(x2), SUM(x3) FROM random_test WHERE x1 > 1 "
+    "GROUP BY key ORDER BY key;",
+    dt);
+}
+
+TEST(Select, GroupByBaselineHashPartitionedReduction) {
+  SKIP_ALL_ON_AGGREGATOR();
+  ScopeGuard reset = [orig_enable = g_enable_partitioned_reduction,
+                      orig_min_entries = g_partitioned_reduction_min_entries] {
+    g_enable_partitioned_reduction = orig_enable;
+    g_partitioned_reduction_min_entries = orig_min_entries;
+  };
+  g_enable_partitioned_reduction = true;
+  g_partitioned_reduction_min_entries = 0;
+  const auto dt = ExecutorDeviceType::CPU;
+  c("SELECT x1, x2, x3, x4, COUNT(*), MIN(x5) FROM random_test "
+    "GROUP BY x1, x2, x3, x4 ORDER BY x1, x2, x3, x4;",
+    dt);
+  c("SELECT cast(x3 as double) as key, COUNT(*), AVG(x2), MIN(x1), COUNT(x4) FROM "
+    "random_test GROUP BY key ORDER BY key;",
+    dt);
+  c("SELECT x5 as key, COUNT(*) AS n FROM random_test GROUP BY key "
+    "ORDER BY n DESC, key LIMIT 5;",
+    dt);
+  c("SELECT COUNT(*) FROM (SELECT x1, x2, COUNT(*) FROM random_test GROUP BY x1, x2);",
+    dt);
+  // the outer queries read the columns of the partitioned result, which get
+  // columnarized from all its storages
+  c("SELECT SUM(n), MIN(x1), MAX(x2) FROM (SELECT x1, x2, COUNT(*) AS n FROM "
+    "random_test GROUP BY x1, x2);",
+    dt);
+  c("SELECT x2, SUM(n), COUNT(*) FROM (SELECT x1, x2, COUNT(*) AS n FROM random_test "
+    "GROUP BY x1, x2) GROUP BY x2 ORDER BY x2;",
+    dt);
+  // no group passes the filter
+  c("SELECT x1, x2, COUNT(*) FROM random_test WHERE x1 < -1000 GROUP BY x1, x2;", dt);
+}
+
 TEST(Select, GroupByConstrainedByInQueryRewrite) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -10962,6 +11104,88 @@ TEST(Select, Joins_BuildHashTable) {
   }
 }
 
+TEST(Select, Joins_SortMerge) {
+  ScopeGuard reset = [orig_max_bytes = g_sort_merge_join_max_hash_table_bytes] {
+    g_sort_merge_join_max_hash_table_bytes = orig_max_bytes;
+  };
+  // the keys are too sparse for a perfect hash table, use a sort-merge join instead of
+  // the keyed hash table
+  g_sort_merge_join_max_hash_table_bytes = 0;
+  const std::vector<std::pair<std::string, std::string>> tables{
+      {"smj_outer", "fragment_size=4"},
+      {"smj_inner", "fragment_size=4"},
+      {"smj_inner_sorted", "fragment_size=4, sort_column='k'"}};
+  for (const auto& [table_name, table_options] : tables) {
+    const auto drop = "DROP TABLE IF EXISTS " + table_name + ";";
+    run_ddl_statement(drop);
+    g_sqlite_comparator.query(drop);
+    const auto create = "CREATE TABLE " + table_name + " (k BIGINT, v INT)";
+    run_ddl_statement(create + " WITH (" + table_options + ");");
+    g_sqlite_comparator.query(create + ";");
+  }
+  ScopeGuard drop_tables = [&tables] {
+    for (const auto& table : tables) {
+      run_ddl_statement("DROP TABLE IF EXISTS " + table.first + ";");
+      g_sqlite_comparator.query("DROP TABLE IF EXISTS " + table.first + ";");
+    }
+  };
+  const auto insert = [](const std::string& table_name, const int i, const int mod) {
+    const auto key = i % 6 == 5 ? std::string("NULL")
+                                : std::to_string(int64_t(i % mod) * 1000000007);
+    const auto stmt = "INSERT INTO " + table_name + " VALUES (" + key + ", " +
+                      std::to_string(i) + ");";
+    run_multiple_agg(stmt, ExecutorDeviceType::CPU);
+    g_sqlite_comparator.query(stmt);
+  };
+  for (int i = 0; i < 20; ++i) {
+    insert("smj_outer", i, 7);
+  }
+  for (int i = 17; i >= 0; --i) {
+    insert("smj_inner", i, 4);
+    insert("smj_inner_sorted", i, 4);
+  }
+
+  if (!g_aggregator) {
+    // the equijoin must have fallen back to the sorted keys, not to a keyed hash table
+    auto& cat = QR::get()->getSession()->getCatalog();
+    auto executor = Executor::getExecutor(Executor::UNITARY_EXECUTOR_ID);
+    executor->setCatalog(&cat);
+    for (const std::string inner : {"smj_inner", "smj_inner_sorted"}) {
+      ColumnCacheMap column_cache;
+      const auto join_hash_table =
+          HashJoin::getSyntheticInstance("smj_outer",
+                                         "k",
+                                         inner,
+                                         "k",
+                                         Data_Namespace::CPU_LEVEL,
+                                         HashType::OneToOne,
+                                         1,
+                                         column_cache,
+                                         executor.get());
+      ASSERT_TRUE(join_hash_table);
+      EXPECT_EQ("SortMerge", join_hash_table->getHashJoinType()) << inner;
+    }
+  }
+
+  for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
+    SKIP_NO_GPU();
+    for (const std::string inner : {"smj_inner", "smj_inner_sorted"}) {
+      c("SELECT COUNT(*), SUM(o.v), SUM(i.v) FROM smj_outer o JOIN " + inner +
+            " i ON o.k = i.k;",
+        dt);
+      c("SELECT o.v, COUNT(i.v), SUM(i.v) FROM smj_outer o LEFT JOIN " + inner +
+            " i ON o.k = i.k GROUP BY o.v ORDER BY o.v;",
+        dt);
+      c("SELECT COUNT(*), SUM(v) FROM smj_outer WHERE k IN (SELECT k FROM " + inner +
+            ");",
+        dt);
+      c("SELECT COUNT(*), SUM(v) FROM smj_outer WHERE k NOT IN (SELECT k FROM " +
+            inner + " WHERE k IS NOT NULL);",
+        dt);
+    }
+  }
+}
+
 TEST(Select, Joins_CoalesceColumns) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -19790,6 +20014,93 @@ TEST(Select, WindowFunctionAggregateNoOrder) {
   }
 }
 
+TEST(Select, WindowFunctionFrames) {
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  for (std::string table_name : {"test_window_func", "test_window_func_multi_frag"}) {
+    {
+      const std::string w =
+          " OVER (PARTITION BY y ORDER BY x ASC NULLS FIRST, t ASC ROWS BETWEEN 1 "
+          "PRECEDING AND 1 FOLLOWING)";
+      std::string query = "SELECT x, y, t, SUM(x)" + w + " s, MIN(x)" + w +
+                          " m1, MAX(x)" + w + " m2, AVG(x)" + w + " a, COUNT(x)" + w +
+                          " c FROM " + table_name + " ORDER BY t ASC;";
+      c(query, query, dt);
+    }
+    {
+      const std::string w =
+          " OVER (ORDER BY t ASC ROWS BETWEEN 3 PRECEDING AND 1 PRECEDING)";
+      std::string query = "SELECT t, SUM(dd)" + w + " s, MIN(f)" + w + " m1, MAX(dd)" +
+                          w + " m2, AVG(f)" + w + " a, COUNT(*)" + w + " c FROM " +
+                          table_name + " ORDER BY t ASC;";
+      c(query, query, dt);
+    }
+    {
+      std::string query =
+          "SELECT t, SUM(t) OVER (ORDER BY t DESC ROWS BETWEEN CURRENT ROW AND UNBOUNDED "
+          "FOLLOWING) s, MAX(x) OVER (ORDER BY t ASC ROWS BETWEEN 2 FOLLOWING AND 4 "
+          "FOLLOWING) m FROM " +
+          table_name + " ORDER BY t ASC;";
+      c(query, query, dt);
+    }
+    {
+      const std::string w =
+          " OVER (PARTITION BY y ORDER BY x ASC NULLS FIRST RANGE BETWEEN 3 PRECEDING "
+          "AND 1 FOLLOWING)";
+      std::string query = "SELECT x, y, t, SUM(t)" + w + " s, MIN(t)" + w +
+                          " m1, MAX(t)" + w + " m2, COUNT(t)" + w + " c FROM " +
+                          table_name + " ORDER BY t ASC;";
+      c(query, query, dt);
+    }
+    {
+      std::string query =
+          "SELECT x, t, SUM(t) OVER (ORDER BY x DESC NULLS LAST RANGE BETWEEN 1 "
+          "PRECEDING AND CURRENT ROW) s, COUNT(*) OVER (ORDER BY dd ASC NULLS FIRST "
+          "RANGE BETWEEN CURRENT ROW AND 2 FOLLOWING) c, AVG(t) OVER (ORDER BY x ASC "
+          "NULLS FIRST RANGE BETWEEN UNBOUNDED PRECEDING AND UNBOUNDED FOLLOWING) a "
+          "FROM " +
+          table_name + " ORDER BY t ASC;";
+      c(query, query, dt);
+    }
+    EXPECT_ANY_THROW(run_multiple_agg(
+        "SELECT SUM(x + 1) OVER (ORDER BY t ROWS BETWEEN 1 PRECEDING AND CURRENT ROW) "
+        "FROM " +
+            table_name + ";",
+        dt));
+    EXPECT_ANY_THROW(run_multiple_agg(
+        "SELECT LAG(x) OVER (ORDER BY t ROWS BETWEEN 1 PRECEDING AND CURRENT ROW) FROM " +
+            table_name + ";",
+        dt));
+  }
+}
+
+TEST(Select, WindowFunctionParallelSort) {
+  const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
+  ScopeGuard reset = [orig = g_parallel_window_partition_sort_min] {
+    g_parallel_window_partition_sort_min = orig;
+  };
+  for (auto parallel_sort_min :
+       {size_t(0), size_t(2), g_parallel_window_partition_sort_min}) {
+    g_parallel_window_partition_sort_min = parallel_sort_min;
+    for (std::string table_name : {"test_window_func", "test_window_func_multi_frag"}) {
+      {
+        std::string query =
+            "SELECT x, y, t, ROW_NUMBER() OVER (PARTITION BY y ORDER BY x ASC NULLS "
+            "FIRST, t ASC) r, LAG(t) OVER (PARTITION BY y ORDER BY t ASC) l, SUM(x) OVER "
+            "(PARTITION BY y ORDER BY x ASC NULLS FIRST) s FROM " +
+            table_name + " ORDER BY t ASC;";
+        c(query, query, dt);
+      }
+      {
+        std::string query =
+            "SELECT t, RANK() OVER (ORDER BY x DESC NULLS LAST) r, MAX(t) OVER (ORDER BY "
+            "x ASC NULLS FIRST) m FROM " +
+            table_name + " ORDER BY t ASC;";
+        c(query, query, dt);
+      }
+    }
+  }
+}
+
 TEST(Select, WindowFunctionSum) {
   const ExecutorDeviceType dt = ExecutorDeviceType::CPU;
   for (std::string table_name : {"test_window_func", "test_window_func_multi_frag"}) {
@@ -20739,6 +21050,44 @@ TEST(Select, VarlenLazyFetch) {
   }
 }
 
+TEST(Select, LateMaterialization) {
+  SKIP_ALL_ON_AGGREGATOR();
+  ScopeGuard reset = [orig = g_enable_late_materialization] {
+    g_enable_late_materialization = orig;
+  };
+  const auto dt = ExecutorDeviceType::CPU;
+  // runs the query against sqlite and returns the number of columns fetched late
+  auto check_deferred_fetches = [dt](const std::string& query) {
+    const auto num_fetches_before = Executor::getNumDeferredColumnFetches();
+    c(query, dt);
+    return Executor::getNumDeferredColumnFetches() - num_fetches_before;
+  };
+  for (const bool enable : {true, false}) {
+    g_enable_late_materialization = enable;
+    // the columns which are not filtered are read from disk for the selected rows only
+    QR::get()->clearCpuMemory();
+    const auto sorted_fetches = check_deferred_fetches(
+        "SELECT x1, x2, x3, x4, x5 FROM random_test WHERE x2 = 9 ORDER BY x3, x4, x5;");
+    QR::get()->clearCpuMemory();
+    const auto few_rows_fetches = check_deferred_fetches(
+        "SELECT x1, x3, x4 FROM random_test WHERE x5 > 999000000 ORDER BY x1, x3, x4;");
+    // no fragment holds selected rows, nothing is fetched late
+    EXPECT_EQ(size_t(0),
+              check_deferred_fetches("SELECT x1, x3 FROM random_test WHERE x2 < -1000;"));
+    const auto limit_fetches = check_deferred_fetches(
+        "SELECT * FROM random_test WHERE x1 = 3 ORDER BY x2, x3, x4, x5 LIMIT 10;");
+    if (enable) {
+      EXPECT_GT(sorted_fetches, size_t(0));
+      EXPECT_GT(few_rows_fetches, size_t(0));
+      EXPECT_GT(limit_fetches, size_t(0));
+    } else {
+      EXPECT_EQ(size_t(0), sorted_fetches);
+      EXPECT_EQ(size_t(0), few_rows_fetches);
+      EXPECT_EQ(size_t(0), limit_fetches);
+    }
+  }
+}
+
 TEST(Select, SampleRatio) {
   for (auto dt : {ExecutorDeviceType::CPU, ExecutorDeviceType::GPU}) {
     SKIP_NO_GPU();
@@ -1120,6 +1120,51 @@ TEST_F(FileMgrUnitTest, InitializeWithUncheckpointedAppendPages) {
   ASSERT_EQ(buffer->pageCount(), 1U);
 }
 
+TEST_F(FileMgrUnitTest, ReadPagesWithReaderThreads) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  constexpr size_t num_pages{8};
+  initializeGFM(fsi, num_pages);
+  for (const size_t num_reader_threads : {size_t(1), size_t(3), size_t(16)}) {
+    File_Namespace::GlobalFileMgr gfm(
+        0, fsi, file_mgr_path, num_reader_threads, page_size_);
+    auto buffer = gfm.getBuffer({1, 1, 1, 1});
+    ASSERT_EQ(buffer->pageCount(), num_pages);
+    // a read starting and ending in the middle of pages
+    const size_t offset = 6;
+    std::vector<int8_t> read_buffer(buffer->size() - offset - 10);
+    buffer->read(read_buffer.data(), read_buffer.size(), offset);
+    for (size_t i = 0; i < read_buffer.size(); ++i) {
+      ASSERT_EQ(read_buffer[i], static_cast<int8_t>((offset + i) % 4 + 1));
+    }
+  }
+}
+
+TEST_F(FileMgrUnitTest, ReadUncheckpointedAppend) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  auto gfm = initializeGFM(fsi, 1);
+  auto buffer = gfm->getBuffer({1, 1, 1, 1});
+  std::vector<int8_t> write_buffer{5, 6, 7, 8};
+  buffer->append(write_buffer.data(), 4);
+  // the pages are read through the file descriptor, bypassing the buffered stream
+  std::vector<int8_t> read_buffer(4);
+  buffer->read(read_buffer.data(), 4, buffer->size() - 4);
+  ASSERT_EQ(read_buffer, write_buffer);
+}
+
+TEST_F(FileMgrUnitTest, PrefetchBuffers) {
+  auto fsi = std::make_shared<ForeignStorageInterface>();
+  initializeGFM(fsi, 4);
+  File_Namespace::GlobalFileMgr gfm(0, fsi, file_mgr_path, 0, page_size_);
+  auto buffer = gfm.getBuffer({1, 1, 1, 1});
+  // unknown chunks and tables are ignored
+  gfm.prefetchBuffers({{1, 1, 1}, {1, 1, 2, 1}, {1, 2, 1, 1}});
+  std::vector<int8_t> read_buffer(buffer->size());
+  buffer->read(read_buffer.data(), read_buffer.size());
+  for (size_t i = 0; i < read_buffer.size(); ++i) {
+    ASSERT_EQ(read_buffer[i], static_cast<int8_t>(i % 4 + 1));
+  }
+}
+
 int main(int argc, char** argv) {
   TestHelpers::init_logger_stderr_only(argc, argv);
   testing::InitGoogleTest(&argc, argv);
@@ -34,6 +34,7 @@
 #include "QueryEngine/JoinHashTable/OverlapsJoinHashTable.h"
 #include "QueryEngine/ResultSet.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
 #include "Shared/thread_count.h"
 #include "TestHelpers.h"
 
@@ -46,6 +47,9 @@ using namespace TestHelpers;
 
 using QR = QueryRunner::QueryRunner;
 
+extern bool g_enable_radix_partitioned_join_build;
+extern size_t g_radix_partitioned_join_build_threshold;
+
 namespace {
 ExecutorDeviceType g_device_type;
 }
@@ -577,6 +581,72 @@ TEST(Build, KeyedOneToMany) {
   }
 }
 
+TEST(Build, KeyedRadixPartitioned) {
+  auto catalog = QR::get()->getCatalog();
+  CHECK(catalog);
+
+  auto executor = Executor::getExecutor(catalog->getCurrentDB().dbId);
+  CHECK(executor);
+  executor->setCatalog(catalog.get());
+
+  g_device_type = ExecutorDeviceType::CPU;
+  ScopeGuard reset_flags = [orig_enable = g_enable_radix_partitioned_join_build,
+                            orig_threshold = g_radix_partitioned_join_build_threshold] {
+    g_enable_radix_partitioned_join_build = orig_enable;
+    g_radix_partitioned_join_build_threshold = orig_threshold;
+  };
+  g_radix_partitioned_join_build_threshold = 0;
+
+  // 2^17 distinct keys, enough for the table to span several partitions
+  constexpr size_t num_keys{size_t(1) << 17};
+  sql(R"(
+      drop table if exists table1;
+      drop table if exists table2;
+
+      create table table1 (a1 integer, a2 integer);
+      create table table2 (b integer);
+
+      insert into table1 values (1, 1);
+      insert into table2 values (0);
+    )");
+  for (size_t i = 1; i < num_keys; i <<= 1) {
+    sql("insert into table2 select b + " + std::to_string(i) + " from table2;");
+  }
+
+  auto a1 = getSyntheticColumnVar("table1", "a1", 0, executor.get());
+  auto a2 = getSyntheticColumnVar("table1", "a2", 0, executor.get());
+  auto b = getSyntheticColumnVar("table2", "b", 1, executor.get());
+
+  using VE = std::vector<std::shared_ptr<Analyzer::Expr>>;
+  auto et1 = std::make_shared<Analyzer::ExpressionTuple>(VE{a1, a2});
+  auto et2 = std::make_shared<Analyzer::ExpressionTuple>(VE{b, b});
+
+  // a1 = b and a2 = b
+  auto op = std::make_shared<Analyzer::BinOper>(kBOOLEAN, kEQ, kONE, et1, et2);
+  auto build = [&op](const bool partitioned, const HashType expected_layout) {
+    g_enable_radix_partitioned_join_build = partitioned;
+    JoinHashTableCacheInvalidator::invalidateCaches();
+    auto hash_table = buildKeyed(op);
+    EXPECT_EQ(hash_table->getHashType(), expected_layout);
+    return hash_table->toSet(g_device_type, 0);
+  };
+
+  const auto one_to_one = build(false, HashType::OneToOne);
+  EXPECT_EQ(num_keys, one_to_one.size());
+  EXPECT_EQ(one_to_one, build(true, HashType::OneToOne));
+
+  // the duplicate keys fail the one-to-one build, which is retried as one-to-many
+  sql("insert into table2 select b from table2 where b < 1000;");
+  const auto one_to_many = build(false, HashType::OneToMany);
+  EXPECT_EQ(num_keys, one_to_many.size());
+  EXPECT_EQ(one_to_many, build(true, HashType::OneToMany));
+
+  sql(R"(
+      drop table if exists table1;
+      drop table if exists table2;
+    )");
+}
+
 TEST(Build, GeoOneToMany1) {
   auto catalog = QR::get()->getCatalog();
   CHECK(catalog);
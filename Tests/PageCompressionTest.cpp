@@ -0,0 +1,215 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include "Catalog/Catalog.h"
+#include "DataMgr/FileMgr/FileBuffer.h"
+#include "DataMgr/FileMgr/GlobalFileMgr.h"
+#include "QueryEngine/ResultSet.h"
+#include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using QR = QueryRunner::QueryRunner;
+using namespace TestHelpers;
+
+namespace {
+
+constexpr size_t kNumSourceRows{64};
+constexpr size_t kNumInserts{32};
+constexpr size_t kNumRows{kNumSourceRows * kNumInserts};
+
+inline void run_ddl_statement(const std::string& stmt) {
+  QR::get()->runDDLStatement(stmt);
+}
+
+std::shared_ptr<ResultSet> run_query(const std::string& query_str) {
+  return QR::get()->runSQL(query_str, ExecutorDeviceType::CPU, true, true);
+}
+
+int64_t run_scalar_query(const std::string& query_str) {
+  const auto rows = run_query(query_str);
+  const auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size());
+  return v<int64_t>(crt_row[0]);
+}
+
+// the disk level buffer of the first fragment of the column, `sub_key` selects the data
+// (1) or index (2) buffer of variable length columns
+File_Namespace::FileBuffer* get_file_buffer(const std::string& table_name,
+                                            const std::string& column_name,
+                                            const int sub_key = 0) {
+  const auto catalog = QR::get()->getCatalog();
+  const auto td = catalog->getMetadataForTable(table_name);
+  CHECK(td);
+  const auto cd = catalog->getMetadataForColumn(td->tableId, column_name);
+  CHECK(cd);
+  ChunkKey chunk_key{catalog->getCurrentDB().dbId, td->tableId, cd->columnId, 0};
+  if (sub_key) {
+    chunk_key.push_back(sub_key);
+  }
+  auto buffer = dynamic_cast<File_Namespace::FileBuffer*>(
+      catalog->getDataMgr().getGlobalFileMgr()->getBuffer(chunk_key));
+  CHECK(buffer);
+  return buffer;
+}
+
+void create_table(const std::string& table_name, const std::string& page_compression) {
+  run_ddl_statement("DROP TABLE IF EXISTS " + table_name + ";");
+  run_ddl_statement("CREATE TABLE " + table_name +
+                    " (x INT, big BIGINT, s TEXT ENCODING NONE, d TEXT ENCODING "
+                    "DICT(32)) WITH (PAGE_SIZE=1024" +
+                    (page_compression.empty()
+                         ? ""
+                         : ", PAGE_COMPRESSION='" + page_compression + "'") +
+                    ");");
+  // appends to the last, partially filled, compressed pages
+  for (size_t i = 0; i < kNumInserts; ++i) {
+    run_query("INSERT INTO " + table_name + " SELECT * FROM pc_source;");
+  }
+}
+
+}  // namespace
+
+class PageCompressionTest : public ::testing::TestWithParam<std::string> {
+ protected:
+  static void SetUpTestSuite() {
+    run_ddl_statement("DROP TABLE IF EXISTS pc_source;");
+    run_ddl_statement(
+        "CREATE TABLE pc_source (x INT, big BIGINT, s TEXT ENCODING NONE, d TEXT "
+        "ENCODING DICT(32));");
+    for (size_t i = 0; i < kNumSourceRows; ++i) {
+      run_query("INSERT INTO pc_source VALUES (" + std::to_string(i % 8) + ", " +
+                std::to_string(1000000 + i) + ", 'str" + std::to_string(i % 4) +
+                "', 'dict" + std::to_string(i % 2) + "');");
+    }
+    create_table("pc_uncompressed", "");
+  }
+
+  static void TearDownTestSuite() {
+    run_ddl_statement("DROP TABLE IF EXISTS pc_source;");
+    run_ddl_statement("DROP TABLE IF EXISTS pc_uncompressed;");
+  }
+
+  void SetUp() override { create_table("pc_test", GetParam()); }
+
+  void TearDown() override { run_ddl_statement("DROP TABLE IF EXISTS pc_test;"); }
+
+  static void checkResults(const std::string& table_name, const int64_t num_rows) {
+    EXPECT_EQ(num_rows, run_scalar_query("SELECT COUNT(*) FROM " + table_name + ";"));
+    EXPECT_EQ(int64_t(kNumInserts) * 28 * 8,
+              run_scalar_query("SELECT SUM(x) FROM " + table_name + ";"));
+    EXPECT_EQ(int64_t(1000000 + kNumSourceRows - 1),
+              run_scalar_query("SELECT MAX(big) FROM " + table_name + ";"));
+    EXPECT_EQ(num_rows / 4,
+              run_scalar_query("SELECT COUNT(*) FROM " + table_name +
+                               " WHERE s = 'str3';"));
+    EXPECT_EQ(num_rows / 2,
+              run_scalar_query("SELECT COUNT(*) FROM " + table_name +
+                               " WHERE d = 'dict1';"));
+  }
+};
+
+TEST_P(PageCompressionTest, Storage) {
+  const auto expected = File_Namespace::parse_page_compression(GetParam());
+  for (const auto& [column_name, sub_key] :
+       std::vector<std::pair<std::string, int>>{{"x", 0}, {"big", 0}, {"s", 1}}) {
+    const auto buffer = get_file_buffer("pc_test", column_name, sub_key);
+    const auto uncompressed_buffer =
+        get_file_buffer("pc_uncompressed", column_name, sub_key);
+    EXPECT_EQ(expected, buffer->getPageCompression());
+    EXPECT_EQ(uncompressed_buffer->size(), buffer->size());
+    EXPECT_LT(buffer->storedSize(), buffer->size() / 2);
+    EXPECT_LT(buffer->pageCount(), uncompressed_buffer->pageCount());
+  }
+}
+
+TEST_P(PageCompressionTest, Queries) {
+  checkResults("pc_test", kNumRows);
+  // decompress from disk
+  QR::get()->clearCpuMemory();
+  checkResults("pc_test", kNumRows);
+  EXPECT_EQ(run_scalar_query("SELECT SUM(big * x) FROM pc_uncompressed;"),
+            run_scalar_query("SELECT SUM(big * x) FROM pc_test;"));
+}
+
+TEST_P(PageCompressionTest, Update) {
+  run_query("UPDATE pc_test SET big = big + 1 WHERE x = 3;");
+  run_query("UPDATE pc_test SET s = 'updated' WHERE x = 5;");
+  QR::get()->clearCpuMemory();
+  EXPECT_EQ(int64_t(kNumRows / 8),
+            run_scalar_query("SELECT COUNT(*) FROM pc_test WHERE s = 'updated';"));
+  EXPECT_EQ(run_scalar_query("SELECT SUM(big) FROM pc_uncompressed;") +
+                int64_t(kNumRows / 8),
+            run_scalar_query("SELECT SUM(big) FROM pc_test;"));
+
+  run_query("DELETE FROM pc_test WHERE x < 4;");
+  run_ddl_statement("OPTIMIZE TABLE pc_test WITH (VACUUM='true');");
+  QR::get()->clearCpuMemory();
+  EXPECT_EQ(int64_t(kNumRows / 2), run_scalar_query("SELECT COUNT(*) FROM pc_test;"));
+  EXPECT_EQ(int64_t(kNumInserts) * 22 * 8,
+            run_scalar_query("SELECT SUM(x) FROM pc_test;"));
+  EXPECT_EQ(int64_t(kNumRows / 8),
+            run_scalar_query("SELECT COUNT(*) FROM pc_test WHERE s = 'updated';"));
+}
+
+INSTANTIATE_TEST_SUITE_P(Codecs,
+                         PageCompressionTest,
+                         ::testing::Values("lz4", "zstd", "blosclz"));
+
+TEST(PageCompression, Schema) {
+  ScopeGuard drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS pc_schema_test;");
+  };
+  run_ddl_statement(
+      "CREATE TABLE pc_schema_test (x INT) WITH (PAGE_COMPRESSION='zstd');");
+  const auto catalog = QR::get()->getCatalog();
+  const auto td = catalog->getMetadataForTable("pc_schema_test");
+  CHECK(td);
+  EXPECT_EQ("ZSTD", td->pageCompression);
+  EXPECT_NE(std::string::npos,
+            catalog->dumpCreateTable(td).find("PAGE_COMPRESSION='ZSTD'"));
+}
+
+TEST(PageCompression, InvalidCodec) {
+  ScopeGuard drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS pc_invalid_test;");
+  };
+  EXPECT_ANY_THROW(run_ddl_statement(
+      "CREATE TABLE pc_invalid_test (x INT) WITH (PAGE_COMPRESSION='snappy');"));
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  QR::init(BASE_PATH);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  QR::reset();
+  return err;
+}
@@ -0,0 +1,200 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestHelpers.h"
+
+#include <boost/filesystem.hpp>
+#include <gtest/gtest.h>
+
+#include "QueryEngine/Execute.h"
+#include "QueryEngine/LLVMGlobalContext.h"
+#include "QueryEngine/PersistentCodeCache.h"
+#include "QueryEngine/ResultSet.h"
+#include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using QR = QueryRunner::QueryRunner;
+using namespace TestHelpers;
+
+namespace {
+
+inline void run_ddl_statement(const std::string& stmt) {
+  QR::get()->runDDLStatement(stmt);
+}
+
+std::shared_ptr<ResultSet> run_query(const std::string& query_str) {
+  return QR::get()->runSQL(query_str, ExecutorDeviceType::CPU, true, true);
+}
+
+int64_t run_count_query(const std::string& query_str) {
+  const auto rows = run_query(query_str);
+  const auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size());
+  return v<int64_t>(crt_row[0]);
+}
+
+size_t count_cached_objects() {
+  size_t num_objects{0};
+  for (boost::filesystem::directory_iterator it(g_persistent_code_cache_path), end;
+       it != end;
+       ++it) {
+    if (it->path().extension() == ".o") {
+      ++num_objects;
+    }
+  }
+  return num_objects;
+}
+
+}  // namespace
+
+class PersistentCodeCacheTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    run_ddl_statement("DROP TABLE IF EXISTS pcc_test;");
+    run_ddl_statement("CREATE TABLE pcc_test (x INT, y BIGINT);");
+    for (int i = 0; i < 10; ++i) {
+      run_query("INSERT INTO pcc_test VALUES (" + std::to_string(i) + ", " +
+                std::to_string(i * 10) + ");");
+    }
+  }
+
+  static void TearDownTestSuite() { run_ddl_statement("DROP TABLE IF EXISTS pcc_test;"); }
+
+  void SetUp() override {
+    g_enable_persistent_code_cache = true;
+    auto persistent_code_cache = PersistentCodeCache::get();
+    ASSERT_TRUE(persistent_code_cache);
+    persistent_code_cache->clear();
+    // drops the in-memory code caches of the executors
+    Executor::nukeCacheOfExecutors();
+  }
+
+  void TearDown() override { g_enable_persistent_code_cache = false; }
+};
+
+TEST_F(PersistentCodeCacheTest, ReuseAfterRestart) {
+  const std::string query_str{"SELECT COUNT(*) FROM pcc_test WHERE x > 4 AND y < 80;"};
+  auto persistent_code_cache = PersistentCodeCache::get();
+  ASSERT_EQ(size_t(0), count_cached_objects());
+  const auto num_hits = persistent_code_cache->getNumHits();
+  const auto expected = run_count_query(query_str);
+  EXPECT_EQ(int64_t(3), expected);
+  const auto num_objects = count_cached_objects();
+  EXPECT_GT(num_objects, size_t(0));
+  EXPECT_EQ(num_hits, persistent_code_cache->getNumHits());
+
+  // the in-memory code cache is empty after a restart, the object code is loaded from
+  // the persistent code cache instead
+  Executor::nukeCacheOfExecutors();
+  EXPECT_EQ(expected, run_count_query(query_str));
+  EXPECT_GT(persistent_code_cache->getNumHits(), num_hits);
+  EXPECT_EQ(num_objects, count_cached_objects());
+}
+
+TEST_F(PersistentCodeCacheTest, Disabled) {
+  g_enable_persistent_code_cache = false;
+  EXPECT_FALSE(PersistentCodeCache::get());
+  EXPECT_EQ(int64_t(7), run_count_query("SELECT COUNT(*) FROM pcc_test WHERE x < 7;"));
+  EXPECT_EQ(size_t(0), count_cached_objects());
+}
+
+TEST_F(PersistentCodeCacheTest, Eviction) {
+  // the size limit of the global cache is read once, use a separate cache instance
+  const auto path =
+      (boost::filesystem::path(BASE_PATH) / "omnisci_code_cache_eviction").string();
+  ScopeGuard remove_cache_dir = [&path] { boost::filesystem::remove_all(path); };
+  const std::string object{"object code"};
+  PersistentCodeCache persistent_code_cache(path, 2 * object.size() + 1);
+  std::vector<std::unique_ptr<llvm::Module>> modules;
+  for (size_t i = 0; i < 3; ++i) {
+    modules.emplace_back(std::make_unique<llvm::Module>(
+        PersistentCodeCache::getObjectKey({"eviction_test_" + std::to_string(i)},
+                                          CompilationOptions::defaults(),
+                                          {}),
+        getGlobalLLVMContext()));
+    persistent_code_cache.notifyObjectCompiled(
+        modules.back().get(), llvm::MemoryBufferRef(object, "eviction_test"));
+    EXPECT_TRUE(persistent_code_cache.loadObject(modules.back().get()));
+  }
+  // only two objects fit into the cache
+  size_t num_objects{0};
+  for (const auto& module : modules) {
+    num_objects += persistent_code_cache.loadObject(module.get()) ? 1 : 0;
+  }
+  EXPECT_EQ(size_t(2), num_objects);
+
+  // larger than the entire cache, not added
+  const std::string large_object(4 * object.size(), 'x');
+  auto large_module = std::make_unique<llvm::Module>(
+      PersistentCodeCache::getObjectKey({"eviction_test_large"},
+                                        CompilationOptions::defaults(),
+                                        {}),
+      getGlobalLLVMContext());
+  persistent_code_cache.notifyObjectCompiled(
+      large_module.get(), llvm::MemoryBufferRef(large_object, "eviction_test_large"));
+  EXPECT_FALSE(persistent_code_cache.loadObject(large_module.get()));
+}
+
+TEST_F(PersistentCodeCacheTest, LoadObject) {
+  const auto path =
+      (boost::filesystem::path(BASE_PATH) / "omnisci_code_cache_load").string();
+  ScopeGuard remove_cache_dir = [&path] { boost::filesystem::remove_all(path); };
+  const std::string object{"object code"};
+  PersistentCodeCache persistent_code_cache(path, 1024);
+  const CodeCacheKey key{"load_test"};
+  const auto co = CompilationOptions::defaults();
+  // the kernel links a different runtime, the object code cannot be shared
+  EXPECT_NE(PersistentCodeCache::getObjectKey(key, co, {"runtime_a"}),
+            PersistentCodeCache::getObjectKey(key, co, {"runtime_b"}));
+
+  auto module = std::make_unique<llvm::Module>(
+      PersistentCodeCache::getObjectKey(key, co, {"runtime_a"}), getGlobalLLVMContext());
+  EXPECT_FALSE(persistent_code_cache.loadObject(module.get()));
+  EXPECT_FALSE(persistent_code_cache.getObject(module.get()));
+  persistent_code_cache.notifyObjectCompiled(module.get(),
+                                             llvm::MemoryBufferRef(object, "load_test"));
+
+  // the loaded object is handed out even if its file is gone by then
+  EXPECT_TRUE(persistent_code_cache.loadObject(module.get()));
+  persistent_code_cache.clear();
+  auto loaded_object = persistent_code_cache.getObject(module.get());
+  ASSERT_TRUE(loaded_object);
+  EXPECT_EQ(object, loaded_object->getBuffer().str());
+  EXPECT_FALSE(persistent_code_cache.getObject(module.get()));
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  g_persistent_code_cache_path =
+      (boost::filesystem::path(BASE_PATH) / "omnisci_code_cache_test").string();
+  QR::init(BASE_PATH);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  QR::reset();
+  boost::filesystem::remove_all(g_persistent_code_cache_path);
+  return err;
+}
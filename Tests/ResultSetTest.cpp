@@ -29,11 +29,13 @@
 #include "QueryEngine/ResultSetReductionJIT.h"
 #include "QueryEngine/RuntimeFunctions.h"
 #include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
 #include "StringDictionary/StringDictionary.h"
 #include "Tests/TestHelpers.h"
 
 #include <gtest/gtest.h>
 #include <algorithm>
+#include <future>
 #include <queue>
 #include <random>
 
@@ -1847,6 +1849,57 @@ TEST(Reduce, BaselineHashColumnar) {
   test_reduce(target_infos, query_mem_desc, generator1, generator2, 1, true);
 }
 
+TEST(Reduce, AsyncCompilation) {
+  const auto enable_async_reduction_jit_state = g_enable_async_reduction_jit;
+  ScopeGuard reset_state = [&enable_async_reduction_jit_state] {
+    g_enable_async_reduction_jit = enable_async_reduction_jit_state;
+  };
+  g_enable_async_reduction_jit = true;
+  const auto target_infos = generate_test_target_infos();
+  {
+    // use an entry count no other test uses, to make sure the code isn't cached yet
+    const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 136);
+    const auto row_set_mem_owner =
+        std::make_shared<RowSetMemoryOwner>(Executor::getArenaBlockSize());
+    const auto rs = std::make_unique<ResultSet>(target_infos,
+                                                ExecutorDeviceType::CPU,
+                                                query_mem_desc,
+                                                row_set_mem_owner,
+                                                nullptr,
+                                                0,
+                                                0);
+    ResultSetReductionJIT reduction_jit(
+        rs->getQueryMemDesc(), rs->getTargetInfos(), rs->getTargetInitVals());
+    const auto reduction_code = [&reduction_jit] {
+      std::lock_guard<std::mutex> compilation_lock(Executor::compilation_mutex_);
+      return reduction_jit.codegen();
+    }();
+    ASSERT_FALSE(reduction_code.func_ptr);
+    ASSERT_TRUE(reduction_code.async_compilation.valid());
+    reduction_code.async_compilation.wait();
+    ASSERT_TRUE(reduction_code.getFuncPtr());
+    // the compiled code is in the cache now
+    const auto cached_reduction_code = [&reduction_jit] {
+      std::lock_guard<std::mutex> compilation_lock(Executor::compilation_mutex_);
+      return reduction_jit.codegen();
+    }();
+    ASSERT_EQ(cached_reduction_code.func_ptr, reduction_code.getFuncPtr());
+    ASSERT_FALSE(cached_reduction_code.async_compilation.valid());
+  }
+  {
+    const auto query_mem_desc = perfect_hash_one_col_desc(target_infos, 8, 0, 138);
+    EvenNumberGenerator generator1;
+    EvenNumberGenerator generator2;
+    test_reduce(target_infos, query_mem_desc, generator1, generator2, 2, false);
+  }
+  {
+    const auto query_mem_desc = baseline_hash_two_col_desc(target_infos, 4);
+    EvenNumberGenerator generator1;
+    ReverseOddOrEvenNumberGenerator generator2(2 * query_mem_desc.getEntryCount() - 1);
+    test_reduce(target_infos, query_mem_desc, generator1, generator2, 1, true);
+  }
+}
+
 #ifndef HAVE_TSAN
 // The large buffers tests allocate too much memory to instrument under TSAN
 TEST(ReduceLargeBuffers, PerfectHashOne_Overflow32) {
@@ -3228,6 +3281,38 @@ TEST(Util, PairToDouble) {
   EXPECT_EQ(2.5, pair_to_double({1000, 4}, SQLTypeInfo(kDECIMAL, 19, 2), true));
 }
 
+TEST(RowSetMemoryOwner, KernelThreadAllocations) {
+  constexpr size_t num_kernel_threads{4};
+  constexpr size_t num_buffers{1000};
+  constexpr size_t buffer_size{64};
+  auto row_set_mem_owner = std::make_shared<RowSetMemoryOwner>(
+      Executor::getArenaBlockSize(), num_kernel_threads);
+  // one thread per kernel thread arena and one more using the shared arena
+  std::vector<std::future<std::vector<int8_t*>>> threads;
+  for (size_t thread_idx = 0; thread_idx <= num_kernel_threads; ++thread_idx) {
+    threads.push_back(std::async(std::launch::async, [&row_set_mem_owner, thread_idx] {
+      std::vector<int8_t*> buffers;
+      for (size_t i = 0; i < num_buffers; ++i) {
+        auto buffer =
+            row_set_mem_owner->allocateCountDistinctBuffer(buffer_size, thread_idx);
+        EXPECT_TRUE(std::all_of(
+            buffer, buffer + buffer_size, [](const int8_t val) { return val == 0; }));
+        std::memset(buffer, static_cast<int>(thread_idx + 1), buffer_size);
+        buffers.push_back(buffer);
+      }
+      return buffers;
+    }));
+  }
+  for (size_t thread_idx = 0; thread_idx < threads.size(); ++thread_idx) {
+    for (const auto buffer : threads[thread_idx].get()) {
+      EXPECT_TRUE(
+          std::all_of(buffer, buffer + buffer_size, [thread_idx](const int8_t val) {
+            return val == static_cast<int8_t>(thread_idx + 1);
+          }));
+    }
+  }
+}
+
 int main(int argc, char** argv) {
   g_is_test_env = true;
 
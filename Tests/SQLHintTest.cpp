@@ -95,6 +95,17 @@ TEST(kCpuMode, ForceToCPUMode) {
   }
 }
 
+TEST(QueryHint, VectorizedInterpreter) {
+  const auto query_with_hint =
+      "SELECT /*+ vectorized_interpreter */ key FROM SQL_HINT_DUMMY WHERE key > 1";
+  const auto query_without_hint = "SELECT key FROM SQL_HINT_DUMMY WHERE key > 1";
+  auto query_hints = QR::get()->getParsedQueryHint(query_with_hint);
+  EXPECT_TRUE(query_hints.isHintRegistered(QueryHint::kVectorizedInterpreter));
+  EXPECT_TRUE(query_hints.vectorized_interpreter);
+  query_hints = QR::get()->getParsedQueryHint(query_without_hint);
+  EXPECT_FALSE(query_hints.isHintRegistered(QueryHint::kVectorizedInterpreter));
+}
+
 TEST(QueryHint, CheckQueryHintForOverlapsJoin) {
   const auto overlaps_join_status_backup = g_enable_overlaps_hashjoin;
   g_enable_overlaps_hashjoin = true;
@@ -0,0 +1,255 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include "Catalog/Catalog.h"
+#include "DataMgr/FileMgr/GlobalFileMgr.h"
+#include "QueryEngine/ResultSet.h"
+#include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+extern bool g_enable_late_materialization;
+
+using QR = QueryRunner::QueryRunner;
+using namespace TestHelpers;
+
+namespace {
+
+constexpr size_t kNumRows{60};
+
+inline void run_ddl_statement(const std::string& stmt) {
+  QR::get()->runDDLStatement(stmt);
+}
+
+std::shared_ptr<ResultSet> run_query(const std::string& query_str) {
+  return QR::get()->runSQL(query_str, ExecutorDeviceType::CPU, true, true);
+}
+
+int64_t run_scalar_query(const std::string& query_str) {
+  const auto rows = run_query(query_str);
+  const auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size());
+  return v<int64_t>(crt_row[0]);
+}
+
+const ColumnDescriptor* get_column_descriptor(const std::string& table_name,
+                                              const std::string& column_name) {
+  const auto catalog = QR::get()->getCatalog();
+  const auto td = catalog->getMetadataForTable(table_name);
+  CHECK(td);
+  const auto cd = catalog->getMetadataForColumn(td->tableId, column_name);
+  CHECK(cd);
+  return cd;
+}
+
+// size of the encoded chunk of the first fragment of the column on disk
+size_t get_disk_chunk_size(const std::string& table_name,
+                           const std::string& column_name) {
+  const auto catalog = QR::get()->getCatalog();
+  const auto cd = get_column_descriptor(table_name, column_name);
+  const ChunkKey chunk_key{catalog->getCurrentDB().dbId, cd->tableId, cd->columnId, 0};
+  return catalog->getDataMgr().getGlobalFileMgr()->getBuffer(chunk_key)->size();
+}
+
+size_t get_chunk_num_bytes(const std::string& table_name,
+                           const std::string& column_name) {
+  const auto catalog = QR::get()->getCatalog();
+  const auto td = catalog->getMetadataForTable(table_name);
+  const auto cd = get_column_descriptor(table_name, column_name);
+  const auto table_info = td->fragmenter->getFragmentsForQuery();
+  CHECK_EQ(size_t(1), table_info.fragments.size());
+  const auto& metadata_map = table_info.fragments.front().getChunkMetadataMapPhysical();
+  const auto it = metadata_map.find(cd->columnId);
+  CHECK(it != metadata_map.end());
+  return it->second->numBytes;
+}
+
+}  // namespace
+
+class StorageEncodingTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    run_ddl_statement("DROP TABLE IF EXISTS enc_test;");
+    run_ddl_statement(
+        "CREATE TABLE enc_test (x INT ENCODING RL, flag BOOLEAN ENCODING RL, big BIGINT "
+        "ENCODING DIFF, ts TIMESTAMP(0) ENCODING DIFF, y INT);");
+    // runs of 10 rows for x, increasing values with a few nulls for big and ts
+    for (size_t i = 0; i < kNumRows; ++i) {
+      const auto seconds = i * 30;
+      const std::string ts = "'2021-01-01 00:" + pad(seconds / 60) + ":" +
+                             pad(seconds % 60) + "'";
+      const std::string big =
+          i % 7 == 3 ? "NULL" : std::to_string(1600000000 + i * 60);
+      run_query("INSERT INTO enc_test VALUES (" + std::to_string(i / 10) + ", " +
+                (i < kNumRows / 2 ? "TRUE" : "FALSE") + ", " + big + ", " + ts +
+                ", " + std::to_string(i) + ");");
+    }
+  }
+
+  void TearDown() override { run_ddl_statement("DROP TABLE IF EXISTS enc_test;"); }
+
+  static std::string pad(const size_t val) {
+    return (val < 10 ? "0" : "") + std::to_string(val);
+  }
+
+  static void checkResults(const int64_t expected_x_sum) {
+    EXPECT_EQ(expected_x_sum, run_scalar_query("SELECT SUM(x) FROM enc_test;"));
+    EXPECT_EQ(int64_t(10),
+              run_scalar_query("SELECT COUNT(*) FROM enc_test WHERE x = 3;"));
+    EXPECT_EQ(int64_t(30), run_scalar_query("SELECT COUNT(*) FROM enc_test WHERE flag;"));
+    EXPECT_EQ(int64_t(9),
+              run_scalar_query("SELECT COUNT(*) FROM enc_test WHERE big IS NULL;"));
+    EXPECT_EQ(int64_t(1600003480), run_scalar_query("SELECT MAX(big) FROM enc_test;"));
+    EXPECT_EQ(int64_t(1600000000), run_scalar_query("SELECT MIN(big) FROM enc_test;"));
+    EXPECT_EQ(int64_t(30),
+              run_scalar_query(
+                  "SELECT COUNT(*) FROM enc_test WHERE ts >= '2021-01-01 00:15:00';"));
+    EXPECT_EQ(int64_t(25),
+              run_scalar_query("SELECT y FROM enc_test WHERE big = 1600001500;"));
+  }
+};
+
+TEST_F(StorageEncodingTest, Storage) {
+  const auto x_cd = get_column_descriptor("enc_test", "x");
+  EXPECT_EQ(kENCODING_RL, x_cd->columnType.get_compression());
+  EXPECT_EQ(4, x_cd->columnType.get_size());
+  EXPECT_EQ(kENCODING_DIFF,
+            get_column_descriptor("enc_test", "ts")->columnType.get_compression());
+
+  // the chunk metadata holds the decoded size
+  EXPECT_EQ(kNumRows * sizeof(int32_t), get_chunk_num_bytes("enc_test", "x"));
+  EXPECT_EQ(kNumRows * sizeof(int64_t), get_chunk_num_bytes("enc_test", "big"));
+
+  // one run per distinct value, made of the value and the run length
+  EXPECT_EQ(6 * (sizeof(int32_t) + sizeof(uint32_t)),
+            get_disk_chunk_size("enc_test", "x"));
+  EXPECT_EQ(2 * (sizeof(int8_t) + sizeof(uint32_t)),
+            get_disk_chunk_size("enc_test", "flag"));
+  EXPECT_LT(get_disk_chunk_size("enc_test", "big"), kNumRows * 2);
+  EXPECT_LT(get_disk_chunk_size("enc_test", "ts"), kNumRows * 2);
+  EXPECT_EQ(kNumRows * sizeof(int32_t), get_disk_chunk_size("enc_test", "y"));
+}
+
+TEST_F(StorageEncodingTest, Queries) {
+  checkResults(150);
+  // decode from disk again
+  QR::get()->clearCpuMemory();
+  checkResults(150);
+}
+
+TEST_F(StorageEncodingTest, Append) {
+  checkResults(150);
+  // extends the last run
+  run_query("INSERT INTO enc_test VALUES (5, FALSE, 1600003600, NULL, 60);");
+  run_query("INSERT INTO enc_test VALUES (6, FALSE, NULL, NULL, 61);");
+  EXPECT_EQ(7 * (sizeof(int32_t) + sizeof(uint32_t)),
+            get_disk_chunk_size("enc_test", "x"));
+  EXPECT_EQ(int64_t(161), run_scalar_query("SELECT SUM(x) FROM enc_test;"));
+  EXPECT_EQ(int64_t(1600003600), run_scalar_query("SELECT MAX(big) FROM enc_test;"));
+  EXPECT_EQ(int64_t(2),
+            run_scalar_query("SELECT COUNT(*) FROM enc_test WHERE ts IS NULL;"));
+  QR::get()->clearCpuMemory();
+  EXPECT_EQ(int64_t(11), run_scalar_query("SELECT COUNT(*) FROM enc_test WHERE x = 5;"));
+  EXPECT_EQ(int64_t(10),
+            run_scalar_query("SELECT COUNT(*) FROM enc_test WHERE big IS NULL;"));
+}
+
+TEST_F(StorageEncodingTest, Update) {
+  run_query("UPDATE enc_test SET x = 7 WHERE x = 2;");
+  run_query("UPDATE enc_test SET big = big + 1 WHERE y = 25;");
+  EXPECT_EQ(6 * (sizeof(int32_t) + sizeof(uint32_t)),
+            get_disk_chunk_size("enc_test", "x"));
+  EXPECT_EQ(int64_t(200), run_scalar_query("SELECT SUM(x) FROM enc_test;"));
+  EXPECT_EQ(int64_t(25),
+            run_scalar_query("SELECT y FROM enc_test WHERE big = 1600001501;"));
+  QR::get()->clearCpuMemory();
+  EXPECT_EQ(int64_t(200), run_scalar_query("SELECT SUM(x) FROM enc_test;"));
+  EXPECT_EQ(int64_t(0), run_scalar_query("SELECT COUNT(*) FROM enc_test WHERE x = 2;"));
+  EXPECT_EQ(int64_t(25),
+            run_scalar_query("SELECT y FROM enc_test WHERE big = 1600001501;"));
+
+  run_query("DELETE FROM enc_test WHERE x = 7;");
+  run_ddl_statement("OPTIMIZE TABLE enc_test WITH (VACUUM='true');");
+  QR::get()->clearCpuMemory();
+  EXPECT_EQ(int64_t(50), run_scalar_query("SELECT COUNT(*) FROM enc_test;"));
+  EXPECT_EQ(int64_t(130), run_scalar_query("SELECT SUM(x) FROM enc_test;"));
+  EXPECT_EQ(int64_t(8),
+            run_scalar_query("SELECT COUNT(*) FROM enc_test WHERE big IS NULL;"));
+}
+
+TEST_F(StorageEncodingTest, LateMaterialization) {
+  ScopeGuard reset = [orig = g_enable_late_materialization] {
+    g_enable_late_materialization = orig;
+    run_ddl_statement("DROP TABLE IF EXISTS enc_late_test;");
+  };
+  g_enable_late_materialization = true;
+  run_ddl_statement("DROP TABLE IF EXISTS enc_late_test;");
+  run_ddl_statement(
+      "CREATE TABLE enc_late_test (x INT ENCODING RL, big BIGINT ENCODING DIFF, y INT) "
+      "WITH (PAGE_SIZE=1024);");
+  run_query("INSERT INTO enc_late_test SELECT x, big, y FROM enc_test;");
+  // the decoded chunks span many pages, y stays unique
+  for (size_t num_rows = kNumRows; num_rows < 4096; num_rows *= 2) {
+    run_query("INSERT INTO enc_late_test SELECT x, big, y + " + std::to_string(num_rows) +
+              " FROM enc_late_test;");
+  }
+  // x and big are only read by the result set, the selected row is past the pages of
+  // the encoded chunks on disk
+  QR::get()->clearCpuMemory();
+  const auto rows = run_query("SELECT x, big FROM enc_late_test WHERE y = 2000;");
+  ASSERT_EQ(size_t(1), rows->rowCount());
+  const auto crt_row = rows->getNextRow(true, true);
+  EXPECT_EQ(int64_t(2), v<int64_t>(crt_row[0]));
+  EXPECT_EQ(int64_t(1600001200), v<int64_t>(crt_row[1]));
+  // the last row of the table
+  QR::get()->clearCpuMemory();
+  EXPECT_EQ(int64_t(5), run_scalar_query("SELECT x FROM enc_late_test WHERE y = 7679;"));
+}
+
+TEST(StorageEncoding, InvalidTypes) {
+  ScopeGuard drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS enc_invalid_test;");
+  };
+  EXPECT_ANY_THROW(
+      run_ddl_statement("CREATE TABLE enc_invalid_test (f FLOAT ENCODING RL);"));
+  EXPECT_ANY_THROW(
+      run_ddl_statement("CREATE TABLE enc_invalid_test (s TEXT ENCODING DIFF);"));
+  EXPECT_ANY_THROW(
+      run_ddl_statement("CREATE TABLE enc_invalid_test (a INT[] ENCODING RL);"));
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  QR::init(BASE_PATH);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  QR::reset();
+  return err;
+}
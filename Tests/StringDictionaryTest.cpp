@@ -16,8 +16,13 @@
 
 #include "TestHelpers.h"
 
+#include "../Shared/scope.h"
 #include "../StringDictionary/StringDictionary.h"
+#include "../StringDictionary/StringDictionaryProxy.h"
 
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
 #include <cstdlib>
 #include <limits>
 
@@ -101,6 +106,207 @@ TEST(StringDictionary, RecoverMany) {
   }
 }
 
+TEST(StringDictionary, GetLikeAndRegexpLike) {
+  StringDictionary string_dict(BASE_PATH, true, false, g_cache_string_hash);
+  const std::vector<std::string> strings{"apple",
+                                         "Apple pie",
+                                         "pineapple",
+                                         "grape",
+                                         "APPLE",
+                                         "crab apple tree",
+                                         "a",
+                                         "100% apple_juice"};
+  for (const auto& str : strings) {
+    string_dict.getOrAdd(str);
+  }
+  const auto generation = string_dict.storageEntryCount();
+  const auto ids_of = [&string_dict](const std::vector<std::string>& matches) {
+    std::vector<int32_t> ids;
+    for (const auto& str : matches) {
+      ids.push_back(string_dict.getIdOfString(str));
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+  const auto like = [&string_dict, generation](const std::string& pattern,
+                                               const bool icase,
+                                               const bool is_simple) {
+    auto ids = string_dict.getLike(pattern, icase, is_simple, '\\', generation);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+  ASSERT_EQ(ids_of({"apple"}), like("apple", false, false));
+  ASSERT_EQ(ids_of({"apple", "APPLE"}), like("apple", true, false));
+  ASSERT_EQ(ids_of({"apple"}), like("app%", false, false));
+  ASSERT_EQ(ids_of({"apple", "Apple pie", "APPLE"}), like("app%", true, false));
+  ASSERT_EQ(ids_of({"apple", "pineapple", "APPLE"}), like("%apple", true, false));
+  ASSERT_EQ(ids_of({"apple", "pineapple", "crab apple tree", "100% apple_juice"}),
+            like("%apple%", false, false));
+  ASSERT_EQ(ids_of({"apple", "pineapple", "crab apple tree", "100% apple_juice"}),
+            like("apple", false, true));
+  ASSERT_EQ(ids_of({"grape"}), like("gr_pe", false, false));
+  ASSERT_EQ(ids_of({"100% apple_juice"}), like("%\\%%", false, false));
+  ASSERT_EQ(ids_of(strings), like("%", false, false));
+  ASSERT_TRUE(like("", false, false).empty());
+  // cached results
+  ASSERT_EQ(ids_of({"apple", "Apple pie", "APPLE"}), like("app%", true, false));
+
+  auto regexp_ids = string_dict.getRegexpLike("[Aa]pple.*", '\\', generation);
+  std::sort(regexp_ids.begin(), regexp_ids.end());
+  ASSERT_EQ(ids_of({"apple", "Apple pie"}), regexp_ids);
+  ASSERT_TRUE(string_dict.getRegexpLike("(unbalanced", '\\', generation).empty());
+
+  // new strings invalidate the cached results
+  string_dict.getOrAdd("applesauce");
+  ASSERT_EQ(ids_of({"apple", "applesauce"}),
+            string_dict.getLike("app%", false, false, '\\', generation + 1));
+}
+
+TEST(StringDictionary, GetLikeLongStrings) {
+  // long enough for the vectorized substring search to compare several whole registers
+  // before the scalar tail
+  StringDictionary string_dict(BASE_PATH, true, false, g_cache_string_hash);
+  const size_t str_len{80};
+  const auto with_literal = [str_len](const std::string& literal, const size_t offset) {
+    std::string str(str_len, 'x');
+    str.replace(offset, literal.size(), literal);
+    return str;
+  };
+  const auto at_start = with_literal("needle", 0);
+  const auto in_middle = with_literal("needle", 37);
+  const auto across_16 = with_literal("needle", 13);
+  const auto across_32 = with_literal("needle", 29);
+  const auto in_tail = with_literal("needle", str_len - 6);
+  const auto mixed_case = with_literal("NeEdLe", 40);
+  const auto upper_case = with_literal("NEEDLE", 45);
+  // the first and the last characters match, the middle doesn't
+  const auto near_miss = with_literal("neeble", 20) + with_literal("nEEBLe", 50);
+  const auto long_literal = with_literal("needle in a haystack", 27);
+  const auto long_near_miss = with_literal("needle in a haystock", 27);
+  const std::vector<std::string> strings{at_start,
+                                         in_middle,
+                                         across_16,
+                                         across_32,
+                                         in_tail,
+                                         mixed_case,
+                                         upper_case,
+                                         near_miss,
+                                         long_literal,
+                                         long_near_miss};
+  for (const auto& str : strings) {
+    string_dict.getOrAdd(str);
+  }
+  const auto generation = string_dict.storageEntryCount();
+  const auto ids_of = [&string_dict](const std::vector<std::string>& matches) {
+    std::vector<int32_t> ids;
+    for (const auto& str : matches) {
+      ids.push_back(string_dict.getIdOfString(str));
+    }
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+  const auto like = [&string_dict, generation](const std::string& pattern,
+                                               const bool icase,
+                                               const bool is_simple) {
+    auto ids = string_dict.getLike(pattern, icase, is_simple, '\\', generation);
+    std::sort(ids.begin(), ids.end());
+    return ids;
+  };
+  const std::vector<std::string> case_sensitive_matches{
+      at_start, in_middle, across_16, across_32, in_tail, long_literal, long_near_miss};
+  ASSERT_EQ(ids_of(case_sensitive_matches), like("%needle%", false, false));
+  ASSERT_EQ(ids_of(case_sensitive_matches), like("needle", false, true));
+  auto icase_matches = case_sensitive_matches;
+  icase_matches.push_back(mixed_case);
+  icase_matches.push_back(upper_case);
+  ASSERT_EQ(ids_of(icase_matches), like("%needle%", true, false));
+  ASSERT_EQ(ids_of(icase_matches), like("needle", true, true));
+  ASSERT_EQ(ids_of({near_miss}), like("%neeble%", false, false));
+  ASSERT_EQ(ids_of({near_miss}), like("%eebl%", true, false));
+  ASSERT_TRUE(like("%neexle%", true, false).empty());
+  ASSERT_EQ(ids_of({long_literal}), like("%needle in a haystack%", false, false));
+  ASSERT_EQ(ids_of({long_literal}), like("%needle in a haystack%", true, false));
+  ASSERT_EQ(ids_of({in_tail}), like("%xneedle", false, false));
+}
+
+TEST(StringDictionary, TrigramIndex) {
+  const auto enable_trigram_index = g_enable_stringdict_trigram_index;
+  ScopeGuard reset = [enable_trigram_index] {
+    g_enable_stringdict_trigram_index = enable_trigram_index;
+  };
+  g_enable_stringdict_trigram_index = true;
+  const auto dict_path = boost::filesystem::path(BASE_PATH) / "trigram_index";
+  boost::filesystem::remove_all(dict_path);
+  boost::filesystem::create_directories(dict_path);
+  const auto like = [](const StringDictionary& string_dict, const std::string& pattern) {
+    return string_dict.getLike(
+        pattern, true, false, '\\', string_dict.storageEntryCount());
+  };
+  {
+    StringDictionary string_dict(dict_path.string(), false, false, g_cache_string_hash);
+    ASSERT_EQ(0, string_dict.getOrAdd("GET /index.html 200"));
+    std::vector<std::string> strings{"POST /login 403", "GET /login 200"};
+    std::vector<int32_t> string_ids(strings.size());
+    string_dict.getOrAddBulk(strings, string_ids.data());
+    ASSERT_EQ(std::vector<int32_t>({1, 2}), string_ids);
+    ASSERT_EQ(std::vector<int32_t>({1, 2}), like(string_dict, "%login%"));
+    ASSERT_EQ(std::vector<int32_t>({0, 2}), like(string_dict, "get %200"));
+    ASSERT_EQ(std::vector<int32_t>({0}), like(string_dict, "%/index.%"));
+    ASSERT_TRUE(like(string_dict, "%logout%").empty());
+    ASSERT_TRUE(string_dict.checkpoint());
+    // not checkpointed, indexed again on recovery
+    string_dict.getOrAdd("DELETE /login 405");
+  }
+  ASSERT_TRUE(boost::filesystem::exists(dict_path / "DictTrigrams"));
+  StringDictionary string_dict(dict_path.string(), false, true, g_cache_string_hash);
+  ASSERT_EQ(size_t(4), string_dict.storageEntryCount());
+  ASSERT_EQ(4, string_dict.getOrAdd("PUT /login 201"));
+  ASSERT_EQ(std::vector<int32_t>({1, 2, 3, 4}), like(string_dict, "%login%"));
+  ASSERT_EQ(std::vector<int32_t>({1, 3}),
+            string_dict.getRegexpLike(
+                "[A-Z]+ /login 40[0-9]", '\\', string_dict.storageEntryCount()));
+  ASSERT_EQ(std::vector<int32_t>({2}),
+            string_dict.getRegexpLike("GET /log.n 200", '\\', 3));
+}
+
+TEST(StringDictionaryProxy, TransientStrings) {
+  auto string_dict =
+      std::make_shared<StringDictionary>(BASE_PATH, true, false, g_cache_string_hash);
+  ASSERT_EQ(0, string_dict->getOrAdd("foo"));
+  ASSERT_EQ(1, string_dict->getOrAdd("bar"));
+  StringDictionaryProxy sdp(string_dict, 1, 1);
+  // "bar" is past the proxy generation
+  ASSERT_EQ(-2, sdp.getOrAddTransient("bar"));
+  ASSERT_EQ(0, sdp.getOrAddTransient("foo"));
+  ASSERT_EQ(-2, sdp.getOrAddTransient("bar"));
+  ASSERT_EQ(std::vector<int32_t>({-3, 0, -2, -4, -3}),
+            sdp.getOrAddTransientBulk({"baz", "foo", "bar", "", "baz"}));
+  ASSERT_EQ(std::vector<int32_t>({-4, -3, StringDictionary::INVALID_STR_ID, 0}),
+            sdp.getIdsOfStrings({"", "baz", "qux", "foo"}));
+  ASSERT_EQ(-3, sdp.getIdOfString("baz"));
+  ASSERT_EQ("baz", sdp.getString(-3));
+  ASSERT_EQ("foo", sdp.getString(0));
+  const auto empty_bytes = sdp.getStringBytes(-4);
+  ASSERT_TRUE(empty_bytes.first);
+  ASSERT_EQ(size_t(0), empty_bytes.second);
+  const std::map<int32_t, std::string> transient_mapping{
+      {-2, "bar"}, {-3, "baz"}, {-4, ""}};
+  ASSERT_EQ(transient_mapping, sdp.getTransientMapping());
+  ASSERT_EQ(std::vector<int32_t>({-2, -3}), sdp.getLike("ba%", false, false, '\\'));
+
+  constexpr int transient_count{100000};
+  std::vector<std::string> strings;
+  for (int i = 0; i < transient_count; ++i) {
+    strings.push_back("transient " + std::to_string(i));
+  }
+  const auto string_ids = sdp.getOrAddTransientBulk(strings);
+  for (int i = 0; i < transient_count; ++i) {
+    ASSERT_EQ(-5 - i, string_ids[i]);
+    ASSERT_EQ(strings[i], sdp.getString(string_ids[i]));
+  }
+  ASSERT_EQ(string_ids, sdp.getIdsOfStrings(strings));
+}
+
 int main(int argc, char** argv) {
   testing::InitGoogleTest(&argc, argv);
 
@@ -0,0 +1,237 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include "QueryEngine/ResultSet.h"
+#include "QueryEngine/VectorizedInterpreter.h"
+#include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using QR = QueryRunner::QueryRunner;
+using namespace TestHelpers;
+
+namespace {
+
+inline void run_ddl_statement(const std::string& stmt) {
+  QR::get()->runDDLStatement(stmt);
+}
+
+std::shared_ptr<ResultSet> run_query(const std::string& query_str) {
+  return QR::get()->runSQL(query_str, ExecutorDeviceType::CPU, true, true);
+}
+
+void compare_scalar_values(const TargetValue& lhs, const TargetValue& rhs) {
+  const auto lhs_scalar = boost::get<ScalarTargetValue>(&lhs);
+  const auto rhs_scalar = boost::get<ScalarTargetValue>(&rhs);
+  ASSERT_TRUE(lhs_scalar && rhs_scalar);
+  ASSERT_EQ(lhs_scalar->which(), rhs_scalar->which());
+  if (const auto lhs_int = boost::get<int64_t>(lhs_scalar)) {
+    EXPECT_EQ(*lhs_int, *boost::get<int64_t>(rhs_scalar));
+  } else if (const auto lhs_float = boost::get<float>(lhs_scalar)) {
+    EXPECT_FLOAT_EQ(*lhs_float, *boost::get<float>(rhs_scalar));
+  } else if (const auto lhs_double = boost::get<double>(lhs_scalar)) {
+    EXPECT_DOUBLE_EQ(*lhs_double, *boost::get<double>(rhs_scalar));
+  } else {
+    FAIL() << "Unexpected target value type";
+  }
+}
+
+void compare_results(const std::shared_ptr<ResultSet>& expected,
+                     const std::shared_ptr<ResultSet>& actual) {
+  ASSERT_EQ(expected->rowCount(), actual->rowCount());
+  ASSERT_EQ(expected->colCount(), actual->colCount());
+  while (true) {
+    const auto expected_row = expected->getNextRow(true, true);
+    const auto actual_row = actual->getNextRow(true, true);
+    ASSERT_EQ(expected_row.empty(), actual_row.empty());
+    if (expected_row.empty()) {
+      break;
+    }
+    for (size_t i = 0; i < expected_row.size(); ++i) {
+      compare_scalar_values(expected_row[i], actual_row[i]);
+    }
+  }
+}
+
+// whether the interpreter executes (part of) a query or falls back to the JIT path
+enum class Interpretation {
+  kInterpreted,
+  kFallback,
+  // the subquery is interpreted, the outer query reads its result and can't be; a
+  // hint on the outer query doesn't apply to the subquery
+  kSubqueryOnly
+};
+
+// runs the query via the regular JIT path first, and then via the interpreter
+// forced by both the global flag and the query hint
+void check_query(const std::string& query_str,
+                 const Interpretation interpretation = Interpretation::kInterpreted) {
+  SCOPED_TRACE(query_str);
+  const auto enable_vectorized_interpreter_state = g_enable_vectorized_interpreter;
+  ScopeGuard reset_state = [&enable_vectorized_interpreter_state] {
+    g_enable_vectorized_interpreter = enable_vectorized_interpreter_state;
+  };
+  g_enable_vectorized_interpreter = false;
+  auto num_executed_units = VectorizedInterpreter::getNumExecutedUnits();
+  const auto expected = run_query(query_str);
+  EXPECT_EQ(num_executed_units, VectorizedInterpreter::getNumExecutedUnits());
+
+  g_enable_vectorized_interpreter = true;
+  num_executed_units = VectorizedInterpreter::getNumExecutedUnits();
+  compare_results(expected, run_query(query_str));
+  if (interpretation == Interpretation::kFallback) {
+    EXPECT_EQ(num_executed_units, VectorizedInterpreter::getNumExecutedUnits());
+  } else {
+    EXPECT_LT(num_executed_units, VectorizedInterpreter::getNumExecutedUnits());
+  }
+
+  g_enable_vectorized_interpreter = false;
+  auto hinted_query_str = query_str;
+  hinted_query_str.insert(std::string("SELECT").size(), " /*+ vectorized_interpreter */");
+  num_executed_units = VectorizedInterpreter::getNumExecutedUnits();
+  compare_results(expected, run_query(hinted_query_str));
+  if (interpretation == Interpretation::kFallback) {
+    EXPECT_EQ(num_executed_units, VectorizedInterpreter::getNumExecutedUnits());
+  } else if (interpretation == Interpretation::kInterpreted) {
+    EXPECT_LT(num_executed_units, VectorizedInterpreter::getNumExecutedUnits());
+  }
+}
+
+}  // namespace
+
+class VectorizedInterpreterTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    run_ddl_statement("DROP TABLE IF EXISTS vi_test;");
+    run_ddl_statement(
+        "CREATE TABLE vi_test (t TINYINT, s SMALLINT, i INT, b BIGINT, f FLOAT, d "
+        "DOUBLE, bo BOOLEAN, nn INT NOT NULL, str TEXT ENCODING DICT(32)) WITH "
+        "(fragment_size=3);");
+    run_query("INSERT INTO vi_test VALUES (1, 10, 100, 1000, 1.5, 2.5, true, 1, 'a');");
+    run_query("INSERT INTO vi_test VALUES (2, 20, 200, 2000, 2.5, 3.5, false, 2, 'b');");
+    run_query(
+        "INSERT INTO vi_test VALUES (NULL, NULL, NULL, NULL, NULL, NULL, NULL, 3, "
+        "NULL);");
+    run_query("INSERT INTO vi_test VALUES (3, 30, 300, 3000, 3.5, 4.5, true, 4, 'c');");
+    run_query(
+        "INSERT INTO vi_test VALUES (-4, -40, -400, -4000, -4.5, -5.5, false, 5, "
+        "'d');");
+    run_query("INSERT INTO vi_test VALUES (5, 50, 500, 5000, 5.5, 6.5, true, 6, 'e');");
+    run_query(
+        "INSERT INTO vi_test VALUES (6, 60, 600, 6000, 6.5, 7.5, false, 7, 'f');");
+  }
+
+  static void TearDownTestSuite() { run_ddl_statement("DROP TABLE IF EXISTS vi_test;"); }
+};
+
+TEST_F(VectorizedInterpreterTest, NonGroupedAggregates) {
+  check_query("SELECT COUNT(*) FROM vi_test;");
+  check_query("SELECT COUNT(*), COUNT(i), COUNT(f) FROM vi_test;");
+  check_query(
+      "SELECT SUM(t), SUM(s), SUM(i), SUM(b), SUM(nn) FROM vi_test WHERE i > 0;");
+  check_query("SELECT MIN(t), MAX(s), MIN(b), MAX(i) FROM vi_test;");
+  check_query("SELECT MIN(f), MAX(f), MIN(d), MAX(d) FROM vi_test;");
+  check_query("SELECT AVG(i), AVG(d), AVG(f) FROM vi_test;");
+  check_query("SELECT SUM(d), SUM(f) FROM vi_test WHERE d < 5.0;");
+  // no qualified rows
+  check_query(
+      "SELECT COUNT(*), SUM(i), MIN(d), MAX(b), AVG(i) FROM vi_test WHERE i > 1000;");
+}
+
+TEST_F(VectorizedInterpreterTest, Filters) {
+  check_query("SELECT COUNT(*) FROM vi_test WHERE i = 200;");
+  check_query("SELECT COUNT(*) FROM vi_test WHERE 200 < i;");
+  check_query("SELECT COUNT(*) FROM vi_test WHERE i <> 200;");
+  check_query("SELECT COUNT(*) FROM vi_test WHERE b >= 2000 AND s <= 50;");
+  check_query("SELECT COUNT(*) FROM vi_test WHERE t > 1 AND t < 6 AND nn <> 4;");
+  check_query("SELECT COUNT(*) FROM vi_test WHERE d > 3.0;");
+  check_query("SELECT COUNT(*) FROM vi_test WHERE f <= 3.5;");
+  check_query("SELECT COUNT(*) FROM vi_test WHERE bo = true;");
+  check_query("SELECT COUNT(*) FROM vi_test WHERE i IS NULL;");
+  check_query("SELECT COUNT(*) FROM vi_test WHERE i IS NOT NULL;");
+  // not supported by the interpreter, falls back to the JIT path
+  check_query("SELECT COUNT(*) FROM vi_test WHERE i + 1 > 200;",
+              Interpretation::kFallback);
+  check_query("SELECT COUNT(*) FROM vi_test WHERE str = 'b';", Interpretation::kFallback);
+  check_query("SELECT COUNT(*) FROM vi_test WHERE i > 100 OR b < 0;",
+              Interpretation::kFallback);
+}
+
+TEST_F(VectorizedInterpreterTest, Projections) {
+  check_query("SELECT i, b, f, d, bo, nn FROM vi_test ORDER BY nn;");
+  check_query("SELECT t, s FROM vi_test WHERE i > 100 ORDER BY nn;");
+  check_query("SELECT i FROM vi_test WHERE i IS NULL;");
+  check_query("SELECT b FROM vi_test WHERE b > 100000;");
+  check_query("SELECT nn, d FROM vi_test ORDER BY d DESC NULLS LAST LIMIT 3;");
+  check_query("SELECT nn FROM vi_test WHERE nn > 2 ORDER BY nn LIMIT 2 OFFSET 1;");
+  check_query("SELECT COUNT(*) FROM (SELECT i FROM vi_test WHERE i > 0 LIMIT 3);",
+              Interpretation::kSubqueryOnly);
+  check_query("SELECT nn, str FROM vi_test ORDER BY nn;", Interpretation::kFallback);
+}
+
+TEST_F(VectorizedInterpreterTest, DeletedRows) {
+  run_ddl_statement("DROP TABLE IF EXISTS vi_delete_test;");
+  ScopeGuard drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS vi_delete_test;");
+  };
+  run_ddl_statement(
+      "CREATE TABLE vi_delete_test (i INT, d DOUBLE) WITH (fragment_size=2);");
+  for (int i = 0; i < 5; ++i) {
+    run_query("INSERT INTO vi_delete_test VALUES (" + std::to_string(i) + ", " +
+              std::to_string(i) + ".5);");
+  }
+  run_query("DELETE FROM vi_delete_test WHERE i = 1 OR i = 4;");
+  check_query("SELECT COUNT(*), SUM(i), MAX(d) FROM vi_delete_test;");
+  check_query("SELECT i, d FROM vi_delete_test ORDER BY i;");
+}
+
+TEST_F(VectorizedInterpreterTest, Overflow) {
+  run_ddl_statement("DROP TABLE IF EXISTS vi_overflow_test;");
+  ScopeGuard drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS vi_overflow_test;");
+  };
+  run_ddl_statement("CREATE TABLE vi_overflow_test (b BIGINT);");
+  run_query("INSERT INTO vi_overflow_test VALUES (9223372036854775000);");
+  run_query("INSERT INTO vi_overflow_test VALUES (9223372036854775000);");
+  // the interpreter gives up and the JIT path reports the overflow
+  const auto num_executed_units = VectorizedInterpreter::getNumExecutedUnits();
+  EXPECT_ANY_THROW(
+      run_query("SELECT /*+ vectorized_interpreter */ SUM(b) FROM vi_overflow_test;"));
+  EXPECT_EQ(VectorizedInterpreter::getNumExecutedUnits(), num_executed_units);
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  QR::init(BASE_PATH);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  QR::reset();
+  return err;
+}
@@ -0,0 +1,248 @@
+/*
+ * Copyright 2021 OmniSci, Inc.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "TestHelpers.h"
+
+#include <gtest/gtest.h>
+
+#include "Catalog/Catalog.h"
+#include "DataMgr/ZoneMap.h"
+#include "QueryEngine/ResultSet.h"
+#include "QueryRunner/QueryRunner.h"
+#include "Shared/scope.h"
+
+#ifndef BASE_PATH
+#define BASE_PATH "./tmp"
+#endif
+
+using QR = QueryRunner::QueryRunner;
+using namespace TestHelpers;
+
+namespace {
+
+constexpr size_t kRowsPerZone{4};
+
+inline void run_ddl_statement(const std::string& stmt) {
+  QR::get()->runDDLStatement(stmt);
+}
+
+std::shared_ptr<ResultSet> run_query(const std::string& query_str) {
+  return QR::get()->runSQL(query_str, ExecutorDeviceType::CPU, true, true);
+}
+
+int64_t run_count_query(const std::string& query_str) {
+  const auto rows = run_query(query_str);
+  const auto crt_row = rows->getNextRow(true, true);
+  CHECK_EQ(size_t(1), crt_row.size());
+  return v<int64_t>(crt_row[0]);
+}
+
+// returns the chunk metadata of the given column for every fragment of the table
+std::vector<std::shared_ptr<ChunkMetadata>> get_chunk_metadata(
+    const std::string& table_name,
+    const std::string& column_name) {
+  const auto catalog = QR::get()->getCatalog();
+  const auto td = catalog->getMetadataForTable(table_name);
+  CHECK(td);
+  const auto cd = catalog->getMetadataForColumn(td->tableId, column_name);
+  CHECK(cd);
+  std::vector<std::shared_ptr<ChunkMetadata>> chunk_metadata;
+  const auto table_info = td->fragmenter->getFragmentsForQuery();
+  for (const auto& fragment : table_info.fragments) {
+    const auto& metadata_map = fragment.getChunkMetadataMapPhysical();
+    const auto it = metadata_map.find(cd->columnId);
+    CHECK(it != metadata_map.end());
+    chunk_metadata.push_back(it->second);
+  }
+  return chunk_metadata;
+}
+
+}  // namespace
+
+TEST(ZoneMap, MergeZones) {
+  ZoneMap<int32_t> zone_map;
+  const size_t num_rows = (ZoneMap<int32_t>::kMaxZones + 1) * kRowsPerZone;
+  for (size_t i = 0; i < num_rows; ++i) {
+    zone_map.update(i, static_cast<int32_t>(i), false);
+  }
+  ChunkMetadata chunk_metadata;
+  chunk_metadata.sqlType = SQLTypeInfo(kINT, false);
+  zone_map.fillMetadata(chunk_metadata, num_rows);
+  // one zone too many, the adjacent zones got merged
+  ASSERT_EQ(2 * kRowsPerZone, chunk_metadata.rowsPerZone);
+  ASSERT_EQ(ZoneMap<int32_t>::kMaxZones / 2 + 1, chunk_metadata.zoneStats.size());
+  for (size_t i = 0; i < chunk_metadata.zoneStats.size(); ++i) {
+    const auto& zone_stats = chunk_metadata.zoneStats[i];
+    EXPECT_EQ(static_cast<int32_t>(i * chunk_metadata.rowsPerZone), zone_stats.min.intval);
+    EXPECT_EQ(static_cast<int32_t>(
+                  std::min((i + 1) * chunk_metadata.rowsPerZone, num_rows) - 1),
+              zone_stats.max.intval);
+    EXPECT_FALSE(zone_stats.has_nulls);
+  }
+
+  // the zone maps do not cover all the rows of the chunk
+  zone_map.fillMetadata(chunk_metadata, num_rows + 1);
+  EXPECT_TRUE(chunk_metadata.zoneStats.empty());
+  EXPECT_EQ(size_t(0), chunk_metadata.rowsPerZone);
+}
+
+TEST(ZoneMap, Invalidate) {
+  ZoneMap<int64_t> zone_map;
+  for (size_t i = 0; i < 3 * kRowsPerZone; ++i) {
+    zone_map.update(i, i, i == 1);
+  }
+  ChunkMetadata chunk_metadata;
+  chunk_metadata.sqlType = SQLTypeInfo(kBIGINT, false);
+  zone_map.fillMetadata(chunk_metadata, 3 * kRowsPerZone);
+  ASSERT_EQ(size_t(3), chunk_metadata.zoneStats.size());
+  EXPECT_TRUE(chunk_metadata.zoneStats[0].has_nulls);
+  EXPECT_FALSE(chunk_metadata.zoneStats[1].has_nulls);
+
+  // a gap in the rows
+  zone_map.update(3 * kRowsPerZone + 1, 0, false);
+  zone_map.fillMetadata(chunk_metadata, 3 * kRowsPerZone + 2);
+  EXPECT_TRUE(chunk_metadata.zoneStats.empty());
+
+  // stays invalid until the chunk is rewritten
+  zone_map.update(0, 0, false);
+  zone_map.fillMetadata(chunk_metadata, 3 * kRowsPerZone + 2);
+  EXPECT_TRUE(chunk_metadata.zoneStats.empty());
+}
+
+TEST(ZoneMap, ReadWrite) {
+  ZoneMap<int16_t> zone_map;
+  for (size_t i = 0; i < 5 * kRowsPerZone; ++i) {
+    zone_map.update(i, static_cast<int16_t>(100 - i), false);
+  }
+  FILE* f = tmpfile();
+  ASSERT_TRUE(f);
+  ScopeGuard close_file = [f] { fclose(f); };
+  zone_map.write(f);
+  rewind(f);
+  ZoneMap<int16_t> read_zone_map;
+  read_zone_map.read(f);
+
+  ChunkMetadata chunk_metadata;
+  chunk_metadata.sqlType = SQLTypeInfo(kSMALLINT, false);
+  zone_map.fillMetadata(chunk_metadata, 5 * kRowsPerZone);
+  ChunkMetadata read_chunk_metadata;
+  read_chunk_metadata.sqlType = chunk_metadata.sqlType;
+  read_zone_map.fillMetadata(read_chunk_metadata, 5 * kRowsPerZone);
+  ASSERT_EQ(chunk_metadata.rowsPerZone, read_chunk_metadata.rowsPerZone);
+  ASSERT_EQ(chunk_metadata.zoneStats.size(), read_chunk_metadata.zoneStats.size());
+  for (size_t i = 0; i < chunk_metadata.zoneStats.size(); ++i) {
+    EXPECT_EQ(chunk_metadata.zoneStats[i].min.smallintval,
+              read_chunk_metadata.zoneStats[i].min.smallintval);
+    EXPECT_EQ(chunk_metadata.zoneStats[i].max.smallintval,
+              read_chunk_metadata.zoneStats[i].max.smallintval);
+  }
+}
+
+class ZoneMapQueryTest : public ::testing::Test {
+ protected:
+  static void SetUpTestSuite() {
+    run_ddl_statement("DROP TABLE IF EXISTS zm_test;");
+    run_ddl_statement("CREATE TABLE zm_test (x INT, y BIGINT) WITH (fragment_size=20);");
+    // sorted on x, the zone of rows 8 to 11 only holds nulls in y
+    for (int i = 0; i < 40; ++i) {
+      const auto y = i >= 8 && i < 12 ? std::string("NULL") : std::to_string(i * 10);
+      run_query("INSERT INTO zm_test VALUES (" + std::to_string(i) + ", " + y + ");");
+    }
+  }
+
+  static void TearDownTestSuite() { run_ddl_statement("DROP TABLE IF EXISTS zm_test;"); }
+};
+
+TEST_F(ZoneMapQueryTest, Metadata) {
+  for (const auto& chunk_metadata : get_chunk_metadata("zm_test", "x")) {
+    EXPECT_EQ(kRowsPerZone, chunk_metadata->rowsPerZone);
+    EXPECT_EQ(size_t(5), chunk_metadata->zoneStats.size());
+  }
+  const auto chunk_metadata = get_chunk_metadata("zm_test", "y");
+  ASSERT_EQ(size_t(2), chunk_metadata.size());
+  const auto& null_zone_stats = chunk_metadata.front()->zoneStats[2];
+  EXPECT_TRUE(null_zone_stats.has_nulls);
+  EXPECT_GT(null_zone_stats.min.bigintval, null_zone_stats.max.bigintval);
+}
+
+TEST_F(ZoneMapQueryTest, Filters) {
+  EXPECT_EQ(int64_t(10), run_count_query("SELECT COUNT(*) FROM zm_test WHERE x >= 30;"));
+  EXPECT_EQ(int64_t(1), run_count_query("SELECT COUNT(*) FROM zm_test WHERE x = 7;"));
+  EXPECT_EQ(int64_t(5), run_count_query("SELECT COUNT(*) FROM zm_test WHERE x < 5;"));
+  EXPECT_EQ(int64_t(0), run_count_query("SELECT COUNT(*) FROM zm_test WHERE x > 100;"));
+  EXPECT_EQ(int64_t(4),
+            run_count_query("SELECT COUNT(*) FROM zm_test WHERE x >= 6 AND x <= 9;"));
+  EXPECT_EQ(int64_t(2),
+            run_count_query("SELECT COUNT(*) FROM zm_test WHERE x >= 6 AND y < 120;"));
+  // the zone of null values does not qualify
+  EXPECT_EQ(int64_t(0),
+            run_count_query("SELECT COUNT(*) FROM zm_test WHERE y >= 80 AND y < 120;"));
+  EXPECT_EQ(int64_t(4),
+            run_count_query("SELECT COUNT(*) FROM zm_test WHERE y IS NULL AND x < 20;"));
+
+  const auto rows = run_query("SELECT x FROM zm_test WHERE x > 12 AND x < 16 ORDER BY x;");
+  ASSERT_EQ(size_t(3), rows->rowCount());
+  for (int64_t x = 13; x < 16; ++x) {
+    const auto crt_row = rows->getNextRow(true, true);
+    EXPECT_EQ(x, v<int64_t>(crt_row[0]));
+  }
+
+  const auto agg_rows = run_query(
+      "SELECT x / 4 AS g, SUM(y) FROM zm_test WHERE x >= 21 AND x < 26 GROUP BY g "
+      "ORDER BY g;");
+  ASSERT_EQ(size_t(2), agg_rows->rowCount());
+  EXPECT_EQ(int64_t(210 + 220 + 230), v<int64_t>(agg_rows->getRowAt(0, 1, true)));
+  EXPECT_EQ(int64_t(240 + 250), v<int64_t>(agg_rows->getRowAt(1, 1, true)));
+}
+
+TEST_F(ZoneMapQueryTest, Update) {
+  run_ddl_statement("DROP TABLE IF EXISTS zm_update_test;");
+  ScopeGuard drop_table = [] {
+    run_ddl_statement("DROP TABLE IF EXISTS zm_update_test;");
+  };
+  run_ddl_statement("CREATE TABLE zm_update_test (x INT) WITH (fragment_size=20);");
+  for (int i = 0; i < 12; ++i) {
+    run_query("INSERT INTO zm_update_test VALUES (" + std::to_string(i) + ");");
+  }
+  EXPECT_EQ(size_t(3), get_chunk_metadata("zm_update_test", "x").front()->zoneStats.size());
+
+  // the updated row position is unknown to the encoder, the zone maps are dropped
+  run_query("UPDATE zm_update_test SET x = 100 WHERE x = 2;");
+  EXPECT_TRUE(get_chunk_metadata("zm_update_test", "x").front()->zoneStats.empty());
+  EXPECT_EQ(int64_t(1),
+            run_count_query("SELECT COUNT(*) FROM zm_update_test WHERE x = 100;"));
+  EXPECT_EQ(int64_t(2),
+            run_count_query("SELECT COUNT(*) FROM zm_update_test WHERE x > 9;"));
+}
+
+int main(int argc, char** argv) {
+  TestHelpers::init_logger_stderr_only(argc, argv);
+  testing::InitGoogleTest(&argc, argv);
+
+  // must be set before the chunks of the test tables are created
+  g_enable_zone_maps = true;
+  g_zone_map_min_rows = kRowsPerZone;
+  QR::init(BASE_PATH);
+
+  int err{0};
+  try {
+    err = RUN_ALL_TESTS();
+  } catch (const std::exception& e) {
+    LOG(ERROR) << e.what();
+  }
+  QR::reset();
+  return err;
+}
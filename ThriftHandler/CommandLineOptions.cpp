@@ -49,6 +49,11 @@ extern size_t g_approx_quantile_centroids;
 extern size_t g_parallel_top_min;
 extern size_t g_parallel_top_max;
 extern size_t g_estimator_failure_max_groupby_size;
+extern bool g_enable_group_by_partitioning;
+extern size_t g_max_group_by_partitions;
+extern bool g_enable_adaptive_group_by;
+extern bool g_enable_partitioned_reduction;
+extern size_t g_partitioned_reduction_min_entries;
 extern bool g_enable_system_tables;
 
 namespace Catalog_Namespace {
@@ -159,6 +164,23 @@ void CommandLineOptions::fillOptions() {
                               ->implicit_value(2147483648),
                           "The maximum size of hashtable that is available to cache, in "
                           "bytes (default: 2GB).");
+  help_desc.add_options()("use-query-resultset-cache",
+                          po::value<bool>(&use_query_resultset_cache)
+                              ->default_value(use_query_resultset_cache)
+                              ->implicit_value(true),
+                          "Use query resultset cache.");
+  help_desc.add_options()(
+      "query-resultset-cache-total-bytes",
+      po::value<size_t>(&query_resultset_cache_total_bytes)
+          ->default_value(query_resultset_cache_total_bytes)
+          ->implicit_value(4294967296),
+      "Size of total memory space for query resultset cache, in bytes (default: 4GB).");
+  help_desc.add_options()("max-cacheable-query-resultset-size-bytes",
+                          po::value<size_t>(&max_cacheable_query_resultset_size_bytes)
+                              ->default_value(max_cacheable_query_resultset_size_bytes)
+                              ->implicit_value(2147483648),
+                          "The maximum size of query resultset that is available to "
+                          "cache, in bytes (default: 2GB).");
   help_desc.add_options()("enable-debug-timer",
                           po::value<bool>(&g_enable_debug_timer)
                               ->default_value(g_enable_debug_timer)
@@ -192,6 +214,14 @@ void CommandLineOptions::fillOptions() {
                               ->implicit_value(true),
                           "Enable accelerating point distance joins with a hash table. "
                           "This rewrites ST_Distance when using an upperbound (<= X).");
+  help_desc.add_options()(
+      "enable-sort-merge-join",
+      po::value<bool>(&g_enable_sort_merge_join)
+          ->default_value(g_enable_sort_merge_join)
+          ->implicit_value(true),
+      "Enable sort-merge joins on CPU for equijoins on a column which can't use a "
+      "perfect hash table, when the inner table is sorted on the join column or its "
+      "keyed hash table would be too large.");
   help_desc.add_options()("enable-runtime-query-interrupt",
                           po::value<bool>(&enable_runtime_query_interrupt)
                               ->default_value(enable_runtime_query_interrupt)
@@ -322,6 +352,12 @@ void CommandLineOptions::fillOptions() {
       po::value<size_t>(&g_overlaps_max_table_size_bytes)
           ->default_value(g_overlaps_max_table_size_bytes),
       "The maximum size in bytes of the hash table for an overlaps hash join.");
+  help_desc.add_options()(
+      "sort-merge-join-max-hash-table-bytes",
+      po::value<size_t>(&g_sort_merge_join_max_hash_table_bytes)
+          ->default_value(g_sort_merge_join_max_hash_table_bytes),
+      "The estimated size in bytes of the keyed hash table for an equijoin above which "
+      "a sort-merge join is used instead.");
   help_desc.add_options()("overlaps-target-entries-per-bin",
                           po::value<double>(&g_overlaps_target_entries_per_bin)
                               ->default_value(g_overlaps_target_entries_per_bin),
@@ -404,6 +440,22 @@ void CommandLineOptions::fillOptions() {
                           po::value<size_t>(&(disk_cache_config.size_limit)),
                           "Specify a maximum size for the disk cache in bytes.");
 
+  help_desc.add_options()(
+      "enable-persistent-code-cache",
+      po::value<bool>(&g_enable_persistent_code_cache)
+          ->default_value(g_enable_persistent_code_cache)
+          ->implicit_value(true),
+      "Keep the object code of compiled CPU kernels on disk, so it can be reused after "
+      "a server restart.");
+  help_desc.add_options()("persistent-code-cache-path",
+                          po::value<std::string>(&g_persistent_code_cache_path),
+                          "Specify the path for the persistent code cache.");
+  help_desc.add_options()(
+      "persistent-code-cache-size",
+      po::value<size_t>(&g_persistent_code_cache_max_size_bytes)
+          ->default_value(g_persistent_code_cache_max_size_bytes),
+      "Specify a maximum size for the persistent code cache in bytes.");
+
 #ifdef HAVE_AWS_S3
   help_desc.add_options()(
       "allow-s3-server-privileges",
@@ -444,6 +496,19 @@ void CommandLineOptions::fillOptions() {
           ->default_value(g_enable_stringdict_parallel)
           ->implicit_value(true),
       "Allow StringDictionary to parallelize loads using multiple threads");
+  help_desc.add_options()(
+      "stringdict-pattern-cache-entries",
+      po::value<size_t>(&g_string_dictionary_pattern_cache_entries)
+          ->default_value(g_string_dictionary_pattern_cache_entries),
+      "Number of LIKE and REGEXP results each StringDictionary caches, least recently "
+      "used first out (0 disables the caches).");
+  help_desc.add_options()(
+      "stringdict-trigram-index",
+      po::value<bool>(&g_enable_stringdict_trigram_index)
+          ->default_value(g_enable_stringdict_trigram_index)
+          ->implicit_value(true),
+      "Maintain a trigram index of every StringDictionary to narrow down the strings "
+      "LIKE and REGEXP filters match.");
   help_desc.add_options()(
       "log-user-id",
       po::value<bool>(&Catalog_Namespace::g_log_user_id)
@@ -635,6 +700,18 @@ void CommandLineOptions::fillAdvancedOptions() {
       "there is not enough free memory to accomodate the target slab size, smaller "
       "slabs will be allocated, down to the minimum size speified by "
       "min-gpu-slab-size.");
+  developer_desc.add_options()(
+      "cpu-buffer-eviction-policy",
+      po::value<std::string>(&system_parameters.cpu_buffer_eviction_policy)
+          ->default_value(system_parameters.cpu_buffer_eviction_policy),
+      "Eviction policy of the CPU buffer pool: lru evicts the least recently used "
+      "chunks, lru-k evicts the chunks touched fewer than twice first, so that scans do "
+      "not evict the working set, and keeps the chunks expensive to fetch again longer.");
+  developer_desc.add_options()(
+      "gpu-buffer-eviction-policy",
+      po::value<std::string>(&system_parameters.gpu_buffer_eviction_policy)
+          ->default_value(system_parameters.gpu_buffer_eviction_policy),
+      "Eviction policy of the GPU buffer pools, see cpu-buffer-eviction-policy.");
 
   developer_desc.add_options()(
       "max-output-projection-allocation-bytes",
@@ -666,6 +743,82 @@ void CommandLineOptions::fillAdvancedOptions() {
                                "to CPU after execution. When disabled, pre-flight "
                                "count queries are used to size "
                                "the output buffer for projection queries.");
+  developer_desc.add_options()(
+      "enable-vectorized-interpreter",
+      po::value<bool>(&g_enable_vectorized_interpreter)
+          ->default_value(g_enable_vectorized_interpreter)
+          ->implicit_value(true),
+      "Run simple filter, projection and non-grouped aggregate queries over small "
+      "tables on the CPU with precompiled vectorized kernels instead of generating and "
+      "compiling code for them.");
+  developer_desc.add_options()(
+      "vectorized-interpreter-max-rows",
+      po::value<size_t>(&g_vectorized_interpreter_max_rows)
+          ->default_value(g_vectorized_interpreter_max_rows),
+      "Maximum number of input rows of a query to run it on the vectorized interpreter. "
+      "Requires enable-vectorized-interpreter.");
+  developer_desc.add_options()(
+      "enable-async-reduction-jit",
+      po::value<bool>(&g_enable_async_reduction_jit)
+          ->default_value(g_enable_async_reduction_jit)
+          ->implicit_value(true),
+      "Run the result set reduction on the interpreter while its native code is "
+      "compiled in the background, and switch to the native code once it is ready.");
+  developer_desc.add_options()(
+      "enable-zone-maps",
+      po::value<bool>(&g_enable_zone_maps)
+          ->default_value(g_enable_zone_maps)
+          ->implicit_value(true),
+      "Keep min/max stats of blocks of rows of each chunk of fixed width columns, to "
+      "skip fragments and restrict fragment scans using filters on the column. Changes "
+      "the format of the chunk metadata on disk.");
+  developer_desc.add_options()(
+      "zone-map-min-rows",
+      po::value<size_t>(&g_zone_map_min_rows)->default_value(g_zone_map_min_rows),
+      "Initial number of rows per zone map block, doubled as needed to keep the number "
+      "of blocks per chunk bounded. Requires enable-zone-maps.");
+  developer_desc.add_options()(
+      "bloom-filter-bits-per-value",
+      po::value<size_t>(&g_bloom_filter_bits_per_value)
+          ->default_value(g_bloom_filter_bits_per_value),
+      "Size of the Bloom filters of the columns listed in the BLOOM_FILTER_COLUMNS table "
+      "option, in bits per value. 10 bits give a false positive rate of about 1%.");
+  developer_desc.add_options()(
+      "enable-chunk-prefetch",
+      po::value<bool>(&g_enable_chunk_prefetch)
+          ->default_value(g_enable_chunk_prefetch)
+          ->implicit_value(true),
+      "Hint the disk reads of the chunks of the next fragment of a scan while the "
+      "current fragment executes.");
+  developer_desc.add_options()(
+      "enable-late-materialization",
+      po::value<bool>(&g_enable_late_materialization)
+          ->default_value(g_enable_late_materialization)
+          ->implicit_value(true),
+      "Fetch the lazily fetched columns of CPU projections after the filters ran, only "
+      "for the fragments with selected rows and, from disk, only the pages holding "
+      "them.");
+  developer_desc.add_options()(
+      "enable-mmap-reads",
+      po::value<bool>(&g_enable_mmap_reads)
+          ->default_value(g_enable_mmap_reads)
+          ->implicit_value(true),
+      "Read the table data files through memory maps on read-only servers. The CPU "
+      "buffers of chunks stored in a single page then point into the page cache "
+      "instead of holding a copy.");
+  developer_desc.add_options()(
+      "enable-radix-partitioned-join-build",
+      po::value<bool>(&g_enable_radix_partitioned_join_build)
+          ->default_value(g_enable_radix_partitioned_join_build)
+          ->implicit_value(true),
+      "Build the large keyed CPU join hash tables by partitions of their slots, inserted "
+      "in parallel, instead of from all the threads into the whole table.");
+  developer_desc.add_options()(
+      "radix-partitioned-join-build-threshold",
+      po::value<size_t>(&g_radix_partitioned_join_build_threshold)
+          ->default_value(g_radix_partitioned_join_build_threshold),
+      "Minimum number of build side rows of a keyed CPU join hash table to build it by "
+      "partitions.");
   developer_desc.add_options()(
       "code-cache-eviction-percent",
       po::value<float>(&g_fraction_code_cache_to_evict)
@@ -794,7 +947,7 @@ void CommandLineOptions::fillAdvancedOptions() {
       "parallel-top-min",
       po::value<size_t>(&g_parallel_top_min)->default_value(g_parallel_top_min),
       "For ResultSets requiring a heap sort, the number of rows necessary to trigger "
-      "parallelTop() to sort.");
+      "parallelTop() to sort. Full sorts of more rows use a parallel merge sort.");
   developer_desc.add_options()(
       "parallel-top-max",
       po::value<size_t>(&g_parallel_top_max)->default_value(g_parallel_top_max),
@@ -820,6 +973,40 @@ void CommandLineOptions::fillAdvancedOptions() {
           ->default_value(g_estimator_failure_max_groupby_size),
       "Maximum size of the groupby buffer if the estimator fails. By default we use the "
       "number of tuples in the table up to this value.");
+  developer_desc.add_options()(
+      "enable-group-by-partitioning",
+      po::value<bool>(&g_enable_group_by_partitioning)
+          ->default_value(g_enable_group_by_partitioning)
+          ->implicit_value(true),
+      "Retry the group by queries which run out of CPU memory by partitions of their "
+      "groups, scanning the input once per partition.");
+  developer_desc.add_options()(
+      "max-group-by-partitions",
+      po::value<size_t>(&g_max_group_by_partitions)
+          ->default_value(g_max_group_by_partitions),
+      "Maximum number of partitions of a group by query retried by partitions. A "
+      "partition which runs out of CPU memory is split in two up to this number.");
+  developer_desc.add_options()(
+      "enable-adaptive-group-by",
+      po::value<bool>(&g_enable_adaptive_group_by)
+          ->default_value(g_enable_adaptive_group_by)
+          ->implicit_value(true),
+      "Grow the baseline hash group by buffers of CPU kernels in place when they run out "
+      "of slots instead of estimating the number of groups up front or retrying the "
+      "query with a bigger buffer.");
+  developer_desc.add_options()(
+      "enable-partitioned-reduction",
+      po::value<bool>(&g_enable_partitioned_reduction)
+          ->default_value(g_enable_partitioned_reduction)
+          ->implicit_value(true),
+      "Reduce the baseline hash group by results of the kernels in parallel, by "
+      "partitions of the hash of their group keys.");
+  developer_desc.add_options()(
+      "partitioned-reduction-min-entries",
+      po::value<size_t>(&g_partitioned_reduction_min_entries)
+          ->default_value(g_partitioned_reduction_min_entries),
+      "Minimum number of entries over the results of the kernels to reduce them by "
+      "partitions.");
   help_desc.add_options()(
       "allow-query-step-cpu-retry",
       po::value<bool>(&g_allow_query_step_cpu_retry)
@@ -1019,6 +1206,11 @@ void CommandLineOptions::validate() {
   }
   ddl_utils::FilePathBlacklist::addToBlacklist(disk_cache_config.path);
 
+  if (g_persistent_code_cache_path.empty()) {
+    g_persistent_code_cache_path = base_path + "/omnisci_code_cache";
+  }
+  ddl_utils::FilePathBlacklist::addToBlacklist(g_persistent_code_cache_path);
+
   ddl_utils::FilePathBlacklist::addToBlacklist("/etc/passwd");
   ddl_utils::FilePathBlacklist::addToBlacklist("/etc/shadow");
 
@@ -1130,6 +1322,9 @@ boost::optional<int> CommandLineOptions::parse_command_line(
     g_use_hashtable_cache = use_hashtable_cache;
     g_max_cacheable_hashtable_size_bytes = max_cacheable_hashtable_size_bytes;
     g_hashtable_cache_total_bytes = hashtable_cache_total_bytes;
+    g_use_query_resultset_cache = use_query_resultset_cache;
+    g_query_resultset_cache_total_bytes = query_resultset_cache_total_bytes;
+    g_max_cacheable_query_resultset_size_bytes = max_cacheable_query_resultset_size_bytes;
 
   } catch (po::error& e) {
     std::cerr << "Usage Error: " << e.what() << std::endl;
@@ -1249,6 +1444,14 @@ boost::optional<int> CommandLineOptions::parse_command_line(
       LOG(INFO) << " \t\t Per-hashtable size limit: "
                 << g_max_cacheable_hashtable_size_bytes / (1024 * 1024) << " MB.";
     }
+    LOG(INFO) << " \t Use query resultset cache: "
+              << (g_use_query_resultset_cache ? "enabled" : "disabled");
+    if (g_use_query_resultset_cache) {
+      LOG(INFO) << " \t\t Total amount of bytes that query resultset cache keeps: "
+                << g_query_resultset_cache_total_bytes / (1024 * 1024) << " MB.";
+      LOG(INFO) << " \t\t Per-query resultset size limit: "
+                << g_max_cacheable_query_resultset_size_bytes / (1024 * 1024) << " MB.";
+    }
   }
 
   boost::algorithm::trim_if(authMetadata.distinguishedName, boost::is_any_of("\"'"));
@@ -86,6 +86,9 @@ class CommandLineOptions {
   bool use_hashtable_cache = true;
   size_t hashtable_cache_total_bytes = 4294967296;         // 4GB
   size_t max_cacheable_hashtable_size_bytes = 2147483648;  // 2GB
+  bool use_query_resultset_cache = false;
+  size_t query_resultset_cache_total_bytes = 4294967296;          // 4GB
+  size_t max_cacheable_query_resultset_size_bytes = 2147483648;  // 2GB
 
   /**
    * Number of threads used when loading data
@@ -170,6 +173,8 @@ extern bool g_enable_hashjoin_many_to_many;
 extern bool g_enable_distance_rangejoin;
 extern size_t g_overlaps_max_table_size_bytes;
 extern double g_overlaps_target_entries_per_bin;
+extern bool g_enable_sort_merge_join;
+extern size_t g_sort_merge_join_max_hash_table_bytes;
 extern bool g_strip_join_covered_quals;
 extern size_t g_constrained_by_in_threshold;
 extern size_t g_big_group_threshold;
@@ -194,6 +199,20 @@ extern size_t g_leaf_count;
 extern size_t g_compression_limit_bytes;
 extern bool g_skip_intermediate_count;
 extern bool g_enable_bump_allocator;
+extern bool g_enable_vectorized_interpreter;
+extern size_t g_vectorized_interpreter_max_rows;
+extern bool g_enable_async_reduction_jit;
+extern bool g_enable_persistent_code_cache;
+extern std::string g_persistent_code_cache_path;
+extern size_t g_persistent_code_cache_max_size_bytes;
+extern bool g_enable_zone_maps;
+extern size_t g_zone_map_min_rows;
+extern size_t g_bloom_filter_bits_per_value;
+extern bool g_enable_chunk_prefetch;
+extern bool g_enable_late_materialization;
+extern bool g_enable_mmap_reads;
+extern bool g_enable_radix_partitioned_join_build;
+extern size_t g_radix_partitioned_join_build_threshold;
 extern size_t g_max_memory_allocation_size;
 extern size_t g_min_memory_allocation_size;
 extern bool g_enable_experimental_string_functions;
@@ -221,3 +240,6 @@ extern bool g_enable_data_recycler;
 extern bool g_use_hashtable_cache;
 extern size_t g_hashtable_cache_total_bytes;
 extern size_t g_max_cacheable_hashtable_size_bytes;
+extern bool g_use_query_resultset_cache;
+extern size_t g_query_resultset_cache_total_bytes;
+extern size_t g_max_cacheable_query_resultset_size_bytes;
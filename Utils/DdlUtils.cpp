@@ -372,6 +372,22 @@ void validate_and_set_none_encoding(ColumnDescriptor& cd) {
   cd.columnType.set_comp_param(0);
 }
 
+void validate_and_set_storage_encoding(ColumnDescriptor& cd,
+                                       const EncodingType encoding,
+                                       const std::string& encoding_name) {
+  // run length and differential encodings compress the chunks on disk only, the chunks
+  // are fetched into memory decoded and scanned as ENCODING NONE columns
+  const auto& type = cd.columnType;
+  if (!type.is_integer() && !type.is_decimal() && !type.is_boolean() &&
+      !type.is_time()) {
+    throw std::runtime_error(cd.columnName + ": " + encoding_name +
+                             " encoding is only supported on integer, decimal, boolean, "
+                             "time, date or timestamp columns.");
+  }
+  cd.columnType.set_compression(encoding);
+  cd.columnType.set_comp_param(0);
+}
+
 void validate_and_set_sparse_encoding(ColumnDescriptor& cd, int encoding_size) {
   // sparse column encoding with mostly NULL values
   if (cd.columnType.get_notnull()) {
@@ -439,14 +455,10 @@ void validate_and_set_encoding(ColumnDescriptor& cd,
       validate_and_set_fixed_encoding(cd, encoding->get_encoding_param(), column_type);
     } else if (boost::iequals(comp, "rl")) {
       // run length encoding
-      cd.columnType.set_compression(kENCODING_RL);
-      cd.columnType.set_comp_param(0);
-      // throw std::runtime_error("RL(Run Length) encoding not supported yet.");
+      validate_and_set_storage_encoding(cd, kENCODING_RL, "RL");
     } else if (boost::iequals(comp, "diff")) {
       // differential encoding
-      cd.columnType.set_compression(kENCODING_DIFF);
-      cd.columnType.set_comp_param(0);
-      // throw std::runtime_error("DIFF(differential) encoding not supported yet.");
+      validate_and_set_storage_encoding(cd, kENCODING_DIFF, "DIFF");
     } else if (boost::iequals(comp, "dict")) {
       validate_and_set_dictionary_encoding(cd, encoding->get_encoding_param());
     } else if (boost::iequals(comp, "NONE")) {
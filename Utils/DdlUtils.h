@@ -116,6 +116,10 @@ void validate_and_set_dictionary_encoding(ColumnDescriptor& cd, int encoding_siz
 
 void validate_and_set_none_encoding(ColumnDescriptor& cd);
 
+void validate_and_set_storage_encoding(ColumnDescriptor& cd,
+                                       const EncodingType encoding,
+                                       const std::string& encoding_name);
+
 void validate_and_set_sparse_encoding(ColumnDescriptor& cd, int encoding_size);
 
 void validate_and_set_compressed_encoding(ColumnDescriptor& cd, int encoding_size);
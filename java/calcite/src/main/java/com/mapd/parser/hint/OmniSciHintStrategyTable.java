@@ -19,6 +19,7 @@ public class OmniSciHintStrategyTable {
             .hintStrategy("overlaps_allow_gpu_build", HintPredicates.SET_VAR)
             .hintStrategy("overlaps_no_cache", HintPredicates.SET_VAR)
             .hintStrategy("overlaps_keys_per_bin", HintPredicates.SET_VAR)
+            .hintStrategy("vectorized_interpreter", HintPredicates.SET_VAR)
             .build();
   }
 }